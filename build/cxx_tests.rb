@@ -41,6 +41,8 @@
     "test/cxx/Core/SpawningKit/DirectSpawnerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/SmartSpawnerTest.o" =>
     "test/cxx/Core/SpawningKit/SmartSpawnerTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/SpawningKit/ShellEnvironmentCacheTest.o" =>
+    "test/cxx/Core/SpawningKit/ShellEnvironmentCacheTest.cpp",
 
   "#{TEST_OUTPUT_DIR}cxx/Core/UnionStationTest.o" =>
     "test/cxx/Core/UnionStationTest.cpp",
@@ -51,6 +53,8 @@
   "#{TEST_OUTPUT_DIR}cxx/Core/ControllerTest.o" =>
     "test/cxx/Core/ControllerTest.cpp",
 
+  "#{TEST_OUTPUT_DIR}cxx/UstRouter/RemoteSenderTest.o" =>
+    "test/cxx/UstRouter/RemoteSenderTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/UstRouter/TransactionTest.o" =>
     "test/cxx/UstRouter/TransactionTest.cpp",
 
@@ -60,17 +64,29 @@
     "test/cxx/ServerKit/FileBufferedChannelTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HeaderTableTest.o" =>
     "test/cxx/ServerKit/HeaderTableTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/TimerWheelTest.o" =>
+    "test/cxx/ServerKit/TimerWheelTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/MemoryReclaimerTest.o" =>
+    "test/cxx/ServerKit/MemoryReclaimerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/ServerTest.o" =>
     "test/cxx/ServerKit/ServerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpServerTest.o" =>
     "test/cxx/ServerKit/HttpServerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/ServerKit/CookieUtilsTest.o" =>
     "test/cxx/ServerKit/CookieUtilsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HttpScanningTest.o" =>
+    "test/cxx/ServerKit/HttpScanningTest.cpp",
 
+  "#{TEST_OUTPUT_DIR}cxx/Algorithms/CoDelTest.o" =>
+    "test/cxx/Algorithms/CoDelTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Algorithms/LatencyHistogramTest.o" =>
+    "test/cxx/Algorithms/LatencyHistogramTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/MemoryKit/MbufTest.o" =>
     "test/cxx/MemoryKit/MbufTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/MemoryKit/PallocTest.o" =>
     "test/cxx/MemoryKit/PallocTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/DataStructures/IndexedMinHeapTest.o" =>
+    "test/cxx/DataStructures/IndexedMinHeapTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/DataStructures/LStringTest.o" =>
     "test/cxx/DataStructures/LStringTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/DataStructures/StringKeyTableTest.o" =>
@@ -83,6 +99,8 @@
     "test/cxx/FileChangeCheckerTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/FileDescriptorTest.o" =>
     "test/cxx/FileDescriptorTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/LoggingTest.o" =>
+    "test/cxx/LoggingTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/SystemTimeTest.o" =>
     "test/cxx/SystemTimeTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/FilterSupportTest.o" =>
@@ -105,6 +123,8 @@
     "test/cxx/DateParsingTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/UtilsTest.o" =>
     "test/cxx/UtilsTest.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Utils/HasherTest.o" =>
+    "test/cxx/Utils/HasherTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/Utils/StrIntUtilsTest.o" =>
     "test/cxx/Utils/StrIntUtilsTest.cpp",
   "#{TEST_OUTPUT_DIR}cxx/IOUtilsTest.o" =>
@@ -241,3 +261,71 @@ def test_cxx_ldflags
     ].flatten
   )
 end
+
+
+### C++ components benchmarks ###
+
+TEST_CXX_BENCHMARKS = {
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/CheckoutContentionBenchmark" =>
+    "test/cxx/Core/ApplicationPool/CheckoutContentionBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/PoolInspectionBenchmark" =>
+    "test/cxx/Core/ApplicationPool/PoolInspectionBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/RestartFileCheckBenchmark" =>
+    "test/cxx/Core/ApplicationPool/RestartFileCheckBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/RoutingBenchmark" =>
+    "test/cxx/Core/ApplicationPool/RoutingBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/ApplicationPool/ScaleUpBenchmark" =>
+    "test/cxx/Core/ApplicationPool/ScaleUpBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Core/BodyForwardingBenchmark" =>
+    "test/cxx/Core/BodyForwardingBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/LoggingBenchmark" =>
+    "test/cxx/LoggingBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ProcessMetricsCollectorBenchmark" =>
+    "test/cxx/ProcessMetricsCollectorBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/AcceptBenchmark" =>
+    "test/cxx/ServerKit/AcceptBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/HeaderParsingBenchmark" =>
+    "test/cxx/ServerKit/HeaderParsingBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/ServerKit/MbufSizeClassBenchmark" =>
+    "test/cxx/ServerKit/MbufSizeClassBenchmark.cpp",
+  "#{TEST_OUTPUT_DIR}cxx/Utils/HasherBenchmark" =>
+    "test/cxx/Utils/HasherBenchmark.cpp"
+}
+
+# Define compilation and linking tasks for the benchmark executables.
+# Benchmarks are standalone programs, so they're not compiled against
+# the test framework's precompiled header.
+TEST_CXX_BENCHMARKS.each_pair do |target, source|
+  object = "#{target}.o"
+  define_cxx_object_compilation_task(
+    object,
+    source,
+    :include_paths => test_cxx_include_paths,
+    :flags => basic_test_cxx_flags
+  )
+
+  dependencies = [
+    object,
+    LIBEV_TARGET,
+    LIBUV_TARGET,
+    TEST_BOOST_OXT_LIBRARY,
+    TEST_COMMON_LIBRARY.link_objects,
+    AGENT_OBJECTS.keys - [AGENT_MAIN_OBJECT]
+  ].flatten.compact
+  file(target => dependencies) do
+    create_cxx_executable(
+      target,
+      [object] + AGENT_OBJECTS.keys - [AGENT_MAIN_OBJECT],
+      :flags => test_cxx_ldflags
+    )
+  end
+end
+
+desc "Run benchmarks for the C++ components"
+task 'test:cxx:benchmark' => TEST_CXX_BENCHMARKS.keys do
+  only = ENV['BENCHMARKS'].to_s.split(";")
+  TEST_CXX_BENCHMARKS.each_key do |target|
+    next if !only.empty? && !only.include?(File.basename(target))
+    sh "cd test && #{File.expand_path(target)}"
+  end
+end
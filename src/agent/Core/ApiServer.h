@@ -63,6 +63,7 @@ public:
 	Authorization authorization;
 	unsigned int controllerStatesGathered;
 	vector<Json::Value> controllerStates;
+	RequestLatencyStatsSetPtr latencyStats;
 
 	DEFINE_SERVER_KIT_BASE_HTTP_REQUEST_FOOTER(Passenger::Core::ApiServer::Request);
 };
@@ -99,6 +100,8 @@ private:
 	void route(Client *client, Request *req, const StaticString &path) {
 		if (path == P_STATIC_STRING("/server.json")) {
 			processServerStatus(client, req);
+		} else if (path == P_STATIC_STRING("/latency.json")) {
+			processLatency(client, req);
 		} else if (regex_match(path, serverConnectionPath)) {
 			processServerConnectionOperation(client, req);
 		} else if (path == P_STATIC_STRING("/pool.xml")) {
@@ -230,6 +233,63 @@ private:
 		}
 	}
 
+	void gatherControllerLatencyStats(Client *client, Request *req,
+		Controller *controller)
+	{
+		RequestLatencyStatsSetPtr stats = boost::make_shared<RequestLatencyStatsSet>();
+		stats->merge(controller->getLatencyStats());
+		getContext()->libev->runLater(boost::bind(&ApiServer::controllerLatencyStatsGathered,
+			this, client, req, stats));
+	}
+
+	void controllerLatencyStatsGathered(Client *client, Request *req,
+		RequestLatencyStatsSetPtr stats)
+	{
+		if (req->ended()) {
+			unrefRequest(req, __FILE__, __LINE__);
+			return;
+		}
+
+		req->controllerStatesGathered++;
+		req->latencyStats->merge(*stats);
+
+		if (req->controllerStatesGathered == controllers.size()) {
+			HeaderTable headers;
+			headers.insert(req->pool, "Content-Type", "application/json");
+
+			Json::Value response = req->latencyStats->inspectAsJson();
+			response["threads"] = (Json::UInt) controllers.size();
+
+			writeSimpleResponse(client, 200, &headers,
+				psg_pstrdup(req->pool, response.toStyledString()));
+			if (!req->ended()) {
+				Request *req2 = req;
+				endRequest(&client, &req2);
+			}
+		}
+
+		unrefRequest(req, __FILE__, __LINE__);
+	}
+
+	/**
+	 * Responds with the request latency histograms of all Controllers,
+	 * merged together. Each Controller's histograms are copied from within
+	 * its own event loop thread, so recording latencies requires no locking.
+	 */
+	void processLatency(Client *client, Request *req) {
+		if (authorizeStateInspectionOperation(this, client, req)) {
+			req->latencyStats = boost::make_shared<RequestLatencyStatsSet>();
+			for (unsigned int i = 0; i < controllers.size(); i++) {
+				refRequest(req, __FILE__, __LINE__);
+				controllers[i]->getContext()->libev->runLater(boost::bind(
+					&ApiServer::gatherControllerLatencyStats, this,
+					client, req, controllers[i]));
+			}
+		} else {
+			apiServerRespondWith401(this, client, req);
+		}
+	}
+
 	void processPoolStatusXml(Client *client, Request *req) {
 		Authorization auth(authorize(this, client, req));
 		if (auth.canReadPool) {
@@ -241,7 +301,7 @@ private:
 			HeaderTable headers;
 			headers.insert(req->pool, "Content-Type", "text/xml");
 			writeSimpleResponse(client, 200, &headers,
-				psg_pstrdup(req->pool, appPool->toXml(options)));
+				psg_pstrdup(req->pool, appPool->getSnapshot()->toXml(options)));
 			if (!req->ended()) {
 				endRequest(&client, &req);
 			}
@@ -273,7 +333,7 @@ private:
 			HeaderTable headers;
 			headers.insert(req->pool, "Content-Type", "text/plain");
 			writeSimpleResponse(client, 200, &headers,
-				psg_pstrdup(req->pool, appPool->inspect(options)));
+				psg_pstrdup(req->pool, appPool->getSnapshot()->inspect(options)));
 			if (!req->ended()) {
 				endRequest(&client, &req);
 			}
@@ -634,6 +694,7 @@ protected:
 		}
 		req->authorization = Authorization();
 		req->controllerStates.clear();
+		req->latencyStats.reset();
 		ParentClass::deinitializeRequest(client, req);
 	}
 
@@ -42,6 +42,18 @@ namespace ApplicationPool2 {
  */
 class AbstractSession {
 public:
+	enum InitiateResult {
+		/** The session is initiated and fd() can be used. */
+		INITIATED,
+		/** A connect is in progress. Call continueInitiate() once fd() is writable. */
+		INITIATE_WAIT_WRITABLE,
+		/**
+		 * The application's listen backlog is full. Call continueInitiate()
+		 * again a little later.
+		 */
+		INITIATE_RETRY_LATER
+	};
+
 	virtual ~AbstractSession() {}
 
 	virtual void ref() const = 0;
@@ -57,6 +69,37 @@ public:
 
 	virtual void initiate(bool blocking = true) = 0;
 
+	/**
+	 * Non-blocking version of `initiate(false)`. If no pooled connection is
+	 * available, this starts a non-blocking connect instead of waiting for it.
+	 * On failure, an exception is thrown just like initiate() does.
+	 *
+	 * @param timeout The connect must finish within this many microseconds.
+	 */
+	virtual InitiateResult initiateNonBlocking(unsigned long long timeout) {
+		initiate(false);
+		return INITIATED;
+	}
+
+	/**
+	 * Continues an initiation that initiateNonBlocking() or a previous call
+	 * did not finish.
+	 *
+	 * @throws TimeoutException The timeout given to initiateNonBlocking()
+	 *                          has passed.
+	 */
+	virtual InitiateResult continueInitiate() {
+		return INITIATED;
+	}
+
+	/**
+	 * Returns how many microseconds are left of the timeout given to
+	 * initiateNonBlocking().
+	 */
+	virtual unsigned long long getConnectTimeRemaining() const {
+		return 0;
+	}
+
 	virtual void requestOOBW() { /* Do nothing */ }
 
 	/**
@@ -37,6 +37,8 @@
 #include <MemoryKit/palloc.h>
 #include <DataStructures/StringKeyTable.h>
 #include <Utils/VariantMap.h>
+#include <Utils/ShardedSharedMutex.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Options.h>
 #include <Core/SpawningKit/Config.h>
 #include <Core/UnionStation/Context.h>
@@ -59,6 +61,9 @@ class Process;
 class Socket;
 class AbstractSession;
 class Session;
+struct PoolSnapshot;
+struct GroupSnapshot;
+struct ProcessSnapshot;
 
 /**
  * The result of a Group::spawn() call.
@@ -162,7 +167,19 @@ enum RestartMethod {
 	RM_ROLLING
 };
 
+/**
+ * Determines how Group::route() picks a process among the enabled processes.
+ * See Options::routingPolicy.
+ */
+enum RoutingPolicy {
+	// Route to the process with the lowest busyness.
+	RP_LEAST_BUSY,
+	// Route to the less busy one of two randomly chosen processes.
+	RP_POWER_OF_TWO
+};
+
 typedef boost::shared_ptr<Pool> PoolPtr;
+typedef boost::shared_ptr<const PoolSnapshot> PoolSnapshotPtr;
 typedef boost::shared_ptr<Group> GroupPtr;
 typedef boost::intrusive_ptr<Process> ProcessPtr;
 typedef boost::intrusive_ptr<AbstractSession> AbstractSessionPtr;
@@ -172,10 +189,44 @@ typedef StringKeyTable<GroupPtr> GroupMap;
 typedef boost::function<void (const ProcessPtr &process, DisableResult result)> DisableCallback;
 typedef boost::function<void ()> Callback;
 
+/**
+ * The type of `Pool::syncher`. See the Pool class for the locking rules.
+ */
+typedef ShardedSharedMutex PoolMutex;
+typedef boost::lock_guard<PoolMutex> PoolLockGuard;
+typedef boost::unique_lock<PoolMutex> PoolScopedLock;
+typedef boost::shared_lock<PoolMutex> PoolSharedLock;
+
+/** Nicer syntax for conditionally locking the pool mutex during construction. */
+class DynamicPoolScopedLock: public PoolScopedLock {
+public:
+	DynamicPoolScopedLock(PoolMutex &m, bool lockNow = true)
+		: PoolScopedLock(m, boost::defer_lock)
+	{
+		if (lockNow) {
+			lock();
+		}
+	}
+};
+
 struct GetCallback {
 	void (*func)(const AbstractSessionPtr &session, const ExceptionPtr &e, void *userData);
+	/**
+	 * Optional. Called (with the pool lock held, from any thread) before a
+	 * queued get request is assigned a session. If it returns true, then the
+	 * caller is no longer interested in a session (e.g. because the client
+	 * disconnected), so the request is removed from the queue without
+	 * occupying a process. `func` is still called, with a GetAbortedException.
+	 */
+	bool (*isAbandoned)(void *userData);
 	mutable void *userData;
 
+	GetCallback()
+		: func(NULL),
+		  isAbandoned(NULL),
+		  userData(NULL)
+		{ }
+
 	void operator()(const AbstractSessionPtr &session, const ExceptionPtr &e) const {
 		func(session, e, userData);
 	}
@@ -188,10 +239,13 @@ struct GetCallback {
 struct GetWaiter {
 	Options options;
 	GetCallback callback;
+	/** Time at which this waiter was queued. Microseconds resolution. */
+	unsigned long long enqueueTime;
 
 	GetWaiter(const Options &o, const GetCallback &cb)
 		: options(o),
-		  callback(cb)
+		  callback(cb),
+		  enqueueTime(SystemTime::getUsec())
 	{
 		options.persist(o);
 	}
@@ -209,6 +263,8 @@ void rethrowException(const ExceptionPtr &e);
 void processAndLogNewSpawnException(SpawnException &e, const Options &options,
 	const SpawningKit::ConfigPtr &config);
 void recreateString(psg_pool_t *pool, StaticString &str);
+RoutingPolicy parseRoutingPolicy(const StaticString &name);
+const char *getRoutingPolicyName(RoutingPolicy policy);
 
 } // namespace ApplicationPool2
 } // namespace Passenger
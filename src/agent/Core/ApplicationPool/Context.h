@@ -31,6 +31,7 @@
 #include <Exceptions.h>
 #include <Utils/ClassUtils.h>
 #include <Core/SpawningKit/Factory.h>
+#include <Core/ApplicationPool/RestartFileWatcher.h>
 
 namespace Passenger {
 namespace ApplicationPool2 {
@@ -61,6 +62,12 @@ private:
 	P_RO_PROPERTY_REF(private, object_pool<Process>, ProcessObjectPool);
 
 
+	/****** Restart file monitoring *****/
+
+	/** Thread-safe; has its own mutex. */
+	P_RO_PROPERTY_REF(private, RestartFileWatcher, RestartFileWatcher);
+
+
 	/****** Configuration objects ******/
 
 	P_PROPERTY_CONST_REF(private, SpawningKit::FactoryPtr, SpawningKitFactory);
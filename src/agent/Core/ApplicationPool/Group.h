@@ -48,6 +48,9 @@
 #include <MemoryKit/palloc.h>
 #include <Hooks.h>
 #include <Utils.h>
+#include <Algorithms/CoDel.h>
+#include <Algorithms/LatencyHistogram.h>
+#include <DataStructures/IndexedMinHeap.h>
 #include <Core/ApplicationPool/Common.h>
 #include <Core/ApplicationPool/Context.h>
 #include <Core/ApplicationPool/BasicGroupInfo.h>
@@ -77,6 +80,7 @@ public:
 	struct GetAction {
 		GetCallback callback;
 		SessionPtr session;
+		ExceptionPtr exception;
 	};
 
 	struct DisableWaiter {
@@ -125,8 +129,15 @@ public:
 	 * Read-only; only set during initialization.
 	 */
 	Pool *pool;
+	/**
+	 * Protects this Group's session statistics while the pool lock is
+	 * only held in shared mode. See Pool::syncher.
+	 */
+	boost::mutex syncher;
 	time_t lastRestartFileMtime;
 	time_t lastRestartFileCheckTime;
+	/** Whether `restartFileWatch` was active during the last needsRestart() call. */
+	bool restartFileWatchWasActive;
 
 	/** Number of times a restart has been initiated so far. This is incremented immediately
 	 * in Group::restart(), and is used to abort the restarter thread that was active at the
@@ -134,12 +145,45 @@ public:
 	 */
 	unsigned int restartsInitiated;
 	/**
-	 * The number of processes that are being spawned right now.
+	 * The number of processes that are being spawned right now. Each
+	 * process is spawned by its own spawner thread. See `spawn()`.
 	 *
 	 * Invariant:
 	 *     if processesBeingSpawned > 0: m_spawning
 	 */
 	short processesBeingSpawned;
+	/**
+	 * The number of spawner threads that are currently working. Unlike
+	 * `processesBeingSpawned`, this includes threads that are attaching the
+	 * process that they just spawned.
+	 *
+	 * Invariant:
+	 *     m_spawning == (spawnThreadCount > 0)
+	 */
+	unsigned short spawnThreadCount;
+	/**
+	 * Time-to-capacity metrics. A spawn burst starts when `m_spawning`
+	 * becomes true and ends when all spawner threads are done. These
+	 * fields record when the current burst started and how many processes
+	 * it has attached so far, and the duration (in microseconds) and
+	 * number of attached processes of the last completed burst.
+	 */
+	unsigned long long spawnBurstStartTime;
+	unsigned int spawnBurstProcessCount;
+	unsigned long long lastSpawnBurstDuration;
+	unsigned int lastSpawnBurstProcessCount;
+	/**
+	 * Request queue metrics and load shedding state. `queueWaitTimes` is the
+	 * distribution of the time (in microseconds) that requests spent in
+	 * `getWaitlist` before being assigned a session. The counters record how
+	 * many requests were removed from `getWaitlist` without being served,
+	 * per reason. See `shouldShedGetWaiter()`.
+	 */
+	LatencyHistogram queueWaitTimes;
+	CoDel queueCoDel;
+	unsigned long long requestsTimedOutInQueue;
+	unsigned long long requestsShedFromQueue;
+	unsigned long long requestsAbandonedInQueue;
 	/**
 	 * A Group object progresses through a life.
 	 *
@@ -154,7 +198,7 @@ public:
 	 */
 	boost::atomic<boost::uint8_t> lifeStatus;
 	/**
-	 * Whether the spawner thread is currently working. Note that even
+	 * Whether at least one spawner thread is currently working. Note that even
 	 * if it's working, it doesn't necessarily mean that processes are
 	 * being spawned (i.e. that processesBeingSpawned > 0). After the
 	 * thread is done spawning a process, it will attempt to attach
@@ -175,18 +219,22 @@ public:
 	bool m_restarting: 1;
 	bool alwaysRestartFileExists: 1;
 
-	/** Contains the spawn loop thread and the restarter thread. */
+	/** Contains the spawn loop threads and the restarter thread. */
 	dynamic_thread_group interruptableThreads;
 
 	string restartFile;
 	string alwaysRestartFile;
+	/** Never NULL. If active, then the restart files are monitored by the
+	 * Context's RestartFileWatcher and needsRestart() doesn't stat() them.
+	 */
+	RestartFileWatchPtr restartFileWatch;
 	ProcessPtr nullProcess;
 
 	/** This timer scans `detachedProcesses` periodically to see
 	 * whether any of the Processes can be shut down.
 	 */
 	bool detachedProcessesCheckerActive;
-	boost::condition_variable detachedProcessesCheckerCond;
+	boost::condition_variable_any detachedProcessesCheckerCond;
 	Callback shutdownCallback;
 	GroupPtr selfPointer;
 
@@ -203,6 +251,8 @@ public:
 
 	RouteResult route(const Options &options) const;
 	SessionPtr newSession(Process *process, unsigned long long now = 0);
+	bool sessionCloseIsTrivial(const Process *process) const;
+	void updateStatisticsOnSessionClose(Process *process, Session *session);
 	static void _onSessionInitiateFailure(Session *session);
 	static void _onSessionClose(Session *session);
 	OXT_FORCE_INLINE void onSessionInitiateFailure(Process *process, Session *session);
@@ -217,6 +267,10 @@ public:
 	void finalizeRestart(GroupPtr self, Options oldOptions, Options newOptions,
 		RestartMethod method, SpawningKit::FactoryPtr spawningKitFactory,
 		unsigned int restartsInitiated, boost::container::vector<Callback> postLockActions);
+	void startSpawnThread();
+	bool shouldSpawnConcurrently() const;
+	bool spawnLoopShouldContinue() const;
+	void finishSpawnBurst();
 
 	/****** Process list management ******/
 
@@ -224,6 +278,7 @@ public:
 	Process *findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const;
 	Process *findProcessWithLowestBusyness(const ProcessList &processes) const;
 	Process *findEnabledProcessWithLowestBusyness() const;
+	Process *findEnabledProcessWithPowerOfTwoChoices() const;
 
 	void addProcessToList(const ProcessPtr &process, ProcessList &destination);
 	void removeProcessFromList(const ProcessPtr &process, ProcessList &source);
@@ -269,6 +324,10 @@ public:
 	Group *findOtherGroupWaitingForCapacity() const;
 	bool pushGetWaiter(const Options &newOptions, const GetCallback &callback,
 		boost::container::vector<Callback> &postLockActions);
+	ExceptionPtr shouldShedGetWaiter(const GetWaiter &waiter, unsigned long long now);
+	void recordGetWaiterDequeued(const GetWaiter &waiter, unsigned long long now);
+	void shedGetWaitersAtFront(boost::container::vector<Callback> &postLockActions);
+	unsigned long long getNextGetWaiterShedTime(unsigned long long now) const;
 	template<typename Lock> void assignSessionsToGetWaitersQuickly(Lock &lock);
 	void assignSessionsToGetWaiters(boost::container::vector<Callback> &postLockActions);
 	bool testOverflowRequestQueue() const;
@@ -360,11 +419,23 @@ public:
 	ProcessList detachedProcesses;
 
 	/**
-	 * A cache of the processes' busyness. It's in a compact structure
-	 * so that `findProcessWithLowestBusyness()` can work very quickly
-	 * when there are a large number of processes.
+	 * A cache of the enabled processes' busyness, indexed like
+	 * `enabledProcesses`. It's kept in a min-heap so that
+	 * `findEnabledProcessWithLowestBusyness()` takes constant time
+	 * regardless of the number of processes, and its keys are stored in
+	 * a compact array so that the sticky session lookup can scan them quickly.
+	 *
+	 * Must be updated whenever the busyness of an enabled process changes.
+	 */
+	IndexedMinHeap enabledProcessBusynessLevels;
+
+	/**
+	 * The policy with which `route()` picks among the enabled processes,
+	 * parsed from `options.routingPolicy`, and the state of the random
+	 * number generator used by the power-of-two-choices policy.
 	 */
-	boost::container::vector<int> enabledProcessBusynessLevels;
+	RoutingPolicy routingPolicy;
+	mutable boost::uint32_t routingRandomState;
 
 	/**
 	 * get() requests for this group that cannot be immediately satisfied are
@@ -441,12 +512,14 @@ public:
 
 	SessionPtr get(const Options &newOptions, const GetCallback &callback,
 		boost::container::vector<Callback> &postLockActions);
+	SessionPtr tryGetQuickly(const Options &newOptions);
 
 	/****** Spawning and restarting ******/
 
 	void restart(const Options &options, RestartMethod method = RM_DEFAULT);
 	bool restarting() const;
 	bool needsRestart(const Options &options);
+	bool restartFilesCheckDue(const Options &options) const;
 
 	SpawnResult spawn();
 	bool spawning() const;
@@ -477,6 +550,7 @@ public:
 	bool isWaitingForCapacity() const;
 	bool garbageCollectable(unsigned long long now = 0) const;
 
+	void snapshot(GroupSnapshot &snapshot) const;
 	void inspectXml(std::ostream &stream, bool includeSecrets = true) const;
 
 	/****** Out-of-band work ******/
@@ -491,6 +565,53 @@ public:
 };
 
 
+/**
+ * A copy of the inspectable state of a Group and its processes. It's taken
+ * with the pool lock held by `Group::snapshot()`. Everything else, including
+ * `finalize()`, may be called after the lock has been released.
+ */
+struct GroupSnapshot {
+	string name;
+	string uuid;
+	ApiKey apiKey;
+	/** A persisted copy of the Group's options. */
+	Options options;
+	const ResourceLocator *resourceLocator;
+	/** Only available after `finalize()`. */
+	SpawningKit::UserSwitchingInfo userSwitchingInfo;
+
+	int enabledCount;
+	int disablingCount;
+	int disabledCount;
+	unsigned int capacityUsed;
+	unsigned int getWaitlistSize;
+	unsigned int disableWaitlistSize;
+	short processesBeingSpawned;
+	unsigned short spawnThreadCount;
+	RoutingPolicy routingPolicy;
+	unsigned long long lastSpawnBurstDuration;
+	unsigned int lastSpawnBurstProcessCount;
+	LatencyHistogram queueWaitTimes;
+	bool overloaded;
+	unsigned long long requestsTimedOutInQueue;
+	unsigned long long requestsShedFromQueue;
+	unsigned long long requestsAbandonedInQueue;
+	bool spawning;
+	bool restarting;
+	Group::LifeStatus lifeStatus;
+
+	vector<ProcessSnapshot> enabledProcesses;
+	vector<ProcessSnapshot> disablingProcesses;
+	vector<ProcessSnapshot> disabledProcesses;
+	vector<ProcessSnapshot> detachedProcesses;
+
+	void finalize();
+	bool authorizeByUid(uid_t uid) const;
+	bool authorizeByApiKey(const ApiKey &key) const;
+	void inspectXml(std::ostream &stream, bool includeSecrets = true) const;
+};
+
+
 } // namespace ApplicationPool2
 } // namespace Passenger
 
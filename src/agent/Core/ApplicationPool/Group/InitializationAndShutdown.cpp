@@ -112,22 +112,38 @@ Group::Group(Pool *_pool, const Options &_options)
 	spawner        = getContext()->getSpawningKitFactory()->create(options);
 	restartsInitiated = 0;
 	processesBeingSpawned = 0;
+	spawnThreadCount = 0;
+	spawnBurstStartTime = 0;
+	spawnBurstProcessCount = 0;
+	lastSpawnBurstDuration = 0;
+	lastSpawnBurstProcessCount = 0;
+	requestsTimedOutInQueue = 0;
+	requestsShedFromQueue = 0;
+	requestsAbandonedInQueue = 0;
+	routingPolicy = parseRoutingPolicy(options.routingPolicy);
+	routingRandomState = (boost::uint32_t) (uintptr_t) this ^ (boost::uint32_t) getpid();
+	if (routingRandomState == 0) {
+		routingRandomState = 1;
+	}
 	m_spawning     = false;
 	m_restarting   = false;
 	lifeStatus.store(ALIVE, boost::memory_order_relaxed);
 	lastRestartFileMtime = 0;
 	lastRestartFileCheckTime = 0;
+	restartFileWatchWasActive = false;
 	alwaysRestartFileExists = false;
+	string restartDir;
 	if (options.restartDir.empty()) {
-		restartFile = options.appRoot + "/tmp/restart.txt";
-		alwaysRestartFile = options.appRoot + "/tmp/always_restart.txt";
+		restartDir = options.appRoot + "/tmp";
 	} else if (options.restartDir[0] == '/') {
-		restartFile = options.restartDir + "/restart.txt";
-		alwaysRestartFile = options.restartDir + "/always_restart.txt";
+		restartDir = options.restartDir;
 	} else {
-		restartFile = options.appRoot + "/" + options.restartDir + "/restart.txt";
-		alwaysRestartFile = options.appRoot + "/" + options.restartDir + "/always_restart.txt";
+		restartDir = options.appRoot + "/" + options.restartDir;
 	}
+	restartFile = restartDir + "/restart.txt";
+	alwaysRestartFile = restartDir + "/always_restart.txt";
+	restartFileWatch = getContext()->getRestartFileWatcher().watch(restartDir,
+		restartFile, alwaysRestartFile);
 
 	detachedProcessesCheckerActive = false;
 }
@@ -181,6 +197,7 @@ Group::shutdown(const Callback &callback,
 	interruptableThreads.interrupt_all();
 	postLockActions.push_back(boost::bind(doCleanupSpawner, spawner));
 	spawner.reset();
+	getContext()->getRestartFileWatcher().unwatch(restartFileWatch);
 	selfPointer = shared_from_this();
 	assert(disableWaitlist.empty());
 	lifeStatus.store(SHUTTING_DOWN, boost::memory_order_seq_cst);
@@ -88,6 +88,9 @@ Group::mergeOptions(const Options &other) {
 	options.minProcesses     = other.minProcesses;
 	options.statThrottleRate = other.statThrottleRate;
 	options.maxPreloaderIdleTime = other.maxPreloaderIdleTime;
+	options.maxRequestQueueTime = other.maxRequestQueueTime;
+	options.requestQueueTargetDelay = other.requestQueueTargetDelay;
+	routingPolicy = parseRoutingPolicy(other.routingPolicy);
 }
 
 /* Given a hook name like "queue_full_error", we return HookScriptOptions filled in with this name and a spec
@@ -214,10 +217,125 @@ Group::findOtherGroupWaitingForCapacity() const {
 	return NULL;
 }
 
+/**
+ * Checks whether the given get waiter should be removed from `getWaitlist`
+ * instead of being assigned a session, because the caller isn't interested
+ * anymore, because it has been waiting longer than `maxRequestQueueTime`, or
+ * because the queue is overloaded and it has been waiting longer than the
+ * target delay (see Algorithms/CoDel.h). If so, returns the exception to
+ * pass to its callback, and updates the statistics.
+ */
+ExceptionPtr
+Group::shouldShedGetWaiter(const GetWaiter &waiter, unsigned long long now) {
+	if (waiter.callback.isAbandoned != NULL
+	 && waiter.callback.isAbandoned(waiter.callback.userData))
+	{
+		requestsAbandonedInQueue++;
+		return boost::make_shared<GetAbortedException>(
+			"The request was abandoned while waiting in the queue");
+	}
+
+	unsigned long long waitTime = (now > waiter.enqueueTime)
+		? now - waiter.enqueueTime
+		: 0;
+	if (options.maxRequestQueueTime != 0
+	 && waitTime >= options.maxRequestQueueTime * 1000000ull)
+	{
+		requestsTimedOutInQueue++;
+		queueCoDel.update(now, waitTime);
+		return boost::make_shared<RequestQueueFullException>(
+			"Request waited in the queue for longer than the configured "
+			"maximum queue time (" + toString(options.maxRequestQueueTime) + " sec)");
+	}
+	if (queueCoDel.shouldShed(waitTime)) {
+		requestsShedFromQueue++;
+		queueCoDel.update(now, waitTime);
+		return boost::make_shared<RequestQueueFullException>(
+			"Request queue overloaded: requests have been waiting for longer than "
+			"the configured target delay (" + toString(options.requestQueueTargetDelay)
+			+ " msec) for a while");
+	}
+	return ExceptionPtr();
+}
+
+void
+Group::recordGetWaiterDequeued(const GetWaiter &waiter, unsigned long long now) {
+	unsigned long long waitTime = (now > waiter.enqueueTime)
+		? now - waiter.enqueueTime
+		: 0;
+	queueWaitTimes.record(waitTime);
+	queueCoDel.update(now, waitTime);
+}
+
+/**
+ * Removes waiters that should be shed (see `shouldShedGetWaiter()`) from the
+ * front of `getWaitlist`. This makes sure that requests are rejected in time,
+ * even if no process becomes available to trigger
+ * `assignSessionsToGetWaiters()`.
+ */
+void
+Group::shedGetWaitersAtFront(boost::container::vector<Callback> &postLockActions) {
+	unsigned long long now = SystemTime::getUsec();
+	while (!getWaitlist.empty()) {
+		const GetWaiter &waiter = getWaitlist.front();
+		ExceptionPtr e = shouldShedGetWaiter(waiter, now);
+		if (e == NULL) {
+			break;
+		}
+		postLockActions.push_back(boost::bind(GetCallback::call,
+			waiter.callback, SessionPtr(), e));
+		getWaitlist.pop_front();
+	}
+}
+
+/**
+ * Returns the time at which the front of `getWaitlist` should be checked
+ * again with `shedGetWaitersAtFront()`, or 0 if it never needs to be (because
+ * the wait list is empty, or because no queue time limits are configured).
+ * The Pool's garbage collector uses this to shed waiters when no process
+ * becomes available and no new requests come in.
+ */
+unsigned long long
+Group::getNextGetWaiterShedTime(unsigned long long now) const {
+	if (getWaitlist.empty()) {
+		return 0;
+	}
+
+	unsigned long long enqueueTime = getWaitlist.front().enqueueTime;
+	unsigned long long result = 0;
+
+	if (options.requestQueueTargetDelay != 0) {
+		// CoDel only sheds waiters that have been waiting longer than the
+		// target delay, and only once that has been the case for a while.
+		unsigned long long target = options.requestQueueTargetDelay * 1000ull;
+		result = enqueueTime + target;
+		if (result <= now) {
+			result = now + target;
+		}
+	}
+	if (options.maxRequestQueueTime != 0) {
+		unsigned long long deadline = enqueueTime + options.maxRequestQueueTime * 1000000ull;
+		if (deadline > now && (result == 0 || deadline < result)) {
+			result = deadline;
+		}
+	}
+	return result;
+}
+
 bool
 Group::pushGetWaiter(const Options &newOptions, const GetCallback &callback,
 	boost::container::vector<Callback> &postLockActions)
 {
+	if (queueCoDel.getTarget() != options.requestQueueTargetDelay * 1000ull) {
+		queueCoDel.setTarget(options.requestQueueTargetDelay * 1000ull);
+	}
+	bool wasEmpty = getWaitlist.empty();
+	if (wasEmpty) {
+		queueCoDel.update(SystemTime::getUsec(), 0);
+	} else {
+		shedGetWaitersAtFront(postLockActions);
+	}
+
 	if (OXT_LIKELY(!testOverflowRequestQueue()
 		&& (newOptions.maxRequestQueueSize == 0
 		    || getWaitlist.size() < newOptions.maxRequestQueueSize)))
@@ -225,6 +343,12 @@ Group::pushGetWaiter(const Options &newOptions, const GetCallback &callback,
 		getWaitlist.push_back(GetWaiter(
 			newOptions.copyAndPersist().detachFromUnionStationTransaction(),
 			callback));
+		if (wasEmpty) {
+			// Make sure that this waiter is shed in time even if nothing
+			// else happens in this Group.
+			getPool()->scheduleGarbageCollection(
+				getNextGetWaiterShedTime(getWaitlist.back().enqueueTime));
+		}
 		return true;
 	} else {
 		postLockActions.push_back(boost::bind(GetCallback::call,
@@ -250,6 +374,7 @@ Group::assignSessionsToGetWaitersQuickly(Lock &lock) {
 	}
 
 	SmallVector<GetAction, 8> actions;
+	unsigned long long now = SystemTime::getUsec();
 	unsigned int i = 0;
 	bool done = false;
 
@@ -257,11 +382,22 @@ Group::assignSessionsToGetWaitersQuickly(Lock &lock) {
 
 	while (!done && i < getWaitlist.size()) {
 		const GetWaiter &waiter = getWaitlist[i];
+		ExceptionPtr e = shouldShedGetWaiter(waiter, now);
+		if (e != NULL) {
+			GetAction action;
+			action.callback  = waiter.callback;
+			action.exception = e;
+			getWaitlist.erase(getWaitlist.begin() + i);
+			actions.push_back(action);
+			continue;
+		}
+
 		RouteResult result = route(waiter.options);
 		if (result.process != NULL) {
 			GetAction action;
 			action.callback = waiter.callback;
 			action.session  = newSession(result.process);
+			recordGetWaiterDequeued(waiter, now);
 			getWaitlist.erase(getWaitlist.begin() + i);
 			actions.push_back(action);
 		} else {
@@ -276,17 +412,29 @@ Group::assignSessionsToGetWaitersQuickly(Lock &lock) {
 	lock.unlock();
 	SmallVector<GetAction, 50>::const_iterator it, end = actions.end();
 	for (it = actions.begin(); it != end; it++) {
-		it->callback(it->session, ExceptionPtr());
+		it->callback(it->session, it->exception);
 	}
 }
 
 void
 Group::assignSessionsToGetWaiters(boost::container::vector<Callback> &postLockActions) {
+	unsigned long long now = SystemTime::getUsec();
 	unsigned int i = 0;
 	bool done = false;
 
 	while (!done && i < getWaitlist.size()) {
 		const GetWaiter &waiter = getWaitlist[i];
+		ExceptionPtr e = shouldShedGetWaiter(waiter, now);
+		if (e != NULL) {
+			postLockActions.push_back(boost::bind(
+				GetCallback::call,
+				waiter.callback,
+				SessionPtr(),
+				e));
+			getWaitlist.erase(getWaitlist.begin() + i);
+			continue;
+		}
+
 		RouteResult result = route(waiter.options);
 		if (result.process != NULL) {
 			postLockActions.push_back(boost::bind(
@@ -294,6 +442,7 @@ Group::assignSessionsToGetWaiters(boost::container::vector<Callback> &postLockAc
 				waiter.callback,
 				newSession(result.process),
 				ExceptionPtr()));
+			recordGetWaiterDequeued(waiter, now);
 			getWaitlist.erase(getWaitlist.begin() + i);
 		} else {
 			done = result.finished;
@@ -62,7 +62,7 @@ Group::findProcessWithStickySessionIdOrLowestBusyness(unsigned int id) const {
 	int leastBusyProcessIndex = -1;
 	int lowestBusyness = 0;
 	unsigned int i, size = enabledProcessBusynessLevels.size();
-	const int *enabledProcessBusynessLevels = &this->enabledProcessBusynessLevels[0];
+	const int *enabledProcessBusynessLevels = this->enabledProcessBusynessLevels.data();
 
 	for (i = 0; i < size; i++) {
 		Process *process = enabledProcesses[i].get();
@@ -103,26 +103,46 @@ Group::findProcessWithLowestBusyness(const ProcessList &processes) const {
 }
 
 /**
- * Cache-optimized version of findProcessWithLowestBusyness() for the common case.
+ * Optimized version of findProcessWithLowestBusyness() for the common case.
+ * Returns the same process as a linear scan would, in constant time.
  */
 Process *
 Group::findEnabledProcessWithLowestBusyness() const {
 	if (enabledProcesses.empty()) {
 		return NULL;
 	}
+	return enabledProcesses[enabledProcessBusynessLevels.top()].get();
+}
 
-	int leastBusyProcessIndex = -1;
-	int lowestBusyness = 0;
-	unsigned int i, size = enabledProcessBusynessLevels.size();
-	const int *enabledProcessBusynessLevels = &this->enabledProcessBusynessLevels[0];
+/**
+ * Picks two different enabled processes at random and returns the less
+ * busy one ("power of two choices"). Unlike always picking the least busy
+ * process, this does not send all requests to the same process when
+ * several processes are equally busy.
+ */
+Process *
+Group::findEnabledProcessWithPowerOfTwoChoices() const {
+	unsigned int size = enabledProcessBusynessLevels.size();
+	if (size == 0) {
+		return NULL;
+	} else if (size == 1) {
+		return enabledProcesses[0].get();
+	}
 
-	for (i = 0; i < size; i++) {
-		if (leastBusyProcessIndex == -1 || enabledProcessBusynessLevels[i] < lowestBusyness) {
-			leastBusyProcessIndex = i;
-			lowestBusyness = enabledProcessBusynessLevels[i];
-		}
+	// xorshift32
+	boost::uint32_t x = routingRandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	routingRandomState = x;
+
+	unsigned int i = x % size;
+	unsigned int j = (i + 1 + (x >> 16) % (size - 1)) % size;
+	if (enabledProcessBusynessLevels[j] < enabledProcessBusynessLevels[i]) {
+		return enabledProcesses[j].get();
+	} else {
+		return enabledProcesses[i].get();
 	}
-	return enabledProcesses[leastBusyProcessIndex].get();
 }
 
 /**
@@ -172,8 +192,9 @@ Group::addProcessToList(const ProcessPtr &process, ProcessList &destination) {
 void
 Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 	ProcessPtr p = process; // Keep an extra reference count just in case.
+	unsigned int index = process->getIndex();
 
-	source.erase(source.begin() + process->getIndex());
+	source.erase(source.begin() + index);
 	process->setIndex(-1);
 
 	switch (process->enabled) {
@@ -207,13 +228,8 @@ Group::removeProcessFromList(const ProcessPtr &process, ProcessList &source) {
 		process->setIndex(i);
 	}
 
-	// Rebuild enabledProcessBusynessLevels
 	if (&source == &enabledProcesses) {
-		enabledProcessBusynessLevels.clear();
-		for (it = source.begin(); it != end; it++, i++) {
-			const ProcessPtr &process = *it;
-			enabledProcessBusynessLevels.push_back(process->busyness());
-		}
+		enabledProcessBusynessLevels.erase(index);
 		enabledProcessBusynessLevels.shrink_to_fit();
 	}
 }
@@ -301,7 +317,7 @@ Group::detachedProcessesCheckerMain(GroupPtr self) {
 		debug->messages->recv("Proceed with starting detached processes checker");
 	}
 
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	while (true) {
 		assert(detachedProcessesCheckerActive);
 
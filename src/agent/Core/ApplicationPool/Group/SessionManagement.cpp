@@ -53,12 +53,25 @@ using namespace boost;
  * If there are no enabled process, then waiting for one to spawn is too
  * expensive. The next best thing is to route to disabling processes
  * until more processes have been spawned.
+ *
+ * Among the enabled processes, the least busy one is picked, unless the
+ * routing policy is RP_POWER_OF_TWO. In that case the less busy one of two
+ * random processes is picked, falling back to the least busy process if
+ * that one is totally busy. This spreads load more evenly over processes
+ * with the same busyness, e.g. when there are many idle processes.
  */
 Group::RouteResult
 Group::route(const Options &options) const {
 	if (OXT_LIKELY(enabledCount > 0)) {
 		if (options.stickySessionId == 0) {
-			Process *process = findEnabledProcessWithLowestBusyness();
+			Process *process;
+			if (routingPolicy == RP_POWER_OF_TWO) {
+				process = findEnabledProcessWithPowerOfTwoChoices();
+				if (process->canBeRoutedTo()) {
+					return RouteResult(process);
+				}
+			}
+			process = findEnabledProcessWithLowestBusyness();
 			if (process->canBeRoutedTo()) {
 				return RouteResult(process);
 			} else {
@@ -94,7 +107,7 @@ Group::newSession(Process *process, unsigned long long now) {
 	session->onInitiateFailure = _onSessionInitiateFailure;
 	session->onClose   = _onSessionClose;
 	if (process->enabled == Process::ENABLED) {
-		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
+		enabledProcessBusynessLevels.set(process->getIndex(), process->busyness());
 		if (!wasTotallyBusy && process->isTotallyBusy()) {
 			nEnabledProcessesTotallyBusy++;
 		}
@@ -102,6 +115,39 @@ Group::newSession(Process *process, unsigned long long now) {
 	return session;
 }
 
+/* Whether closing a session on the given process requires nothing more than
+ * updating statistics, so that onSessionClose() can do its work while holding
+ * the pool lock in shared mode. This mirrors the conditions checked by the
+ * slow path in onSessionClose(), but evaluated against the state from before
+ * the session is closed.
+ */
+bool
+Group::sessionCloseIsTrivial(const Process *process) const {
+	return process->enabled == Process::ENABLED
+		&& process->oobwStatus == Process::OOBW_NOT_ACTIVE
+		&& getWaitlist.empty()
+		&& (options.maxRequests == 0 || process->processed + 1 < options.maxRequests)
+		&& (process->sessions > 1
+			|| (getPool()->getWaitlist.empty() && !anotherGroupIsWaitingForCapacity()));
+}
+
+void
+Group::updateStatisticsOnSessionClose(Process *process, Session *session) {
+	bool wasTotallyBusy = process->isTotallyBusy();
+	process->sessionClosed(session);
+	assert(process->getLifeStatus() == Process::ALIVE);
+	assert(process->enabled == Process::ENABLED
+		|| process->enabled == Process::DISABLING
+		|| process->enabled == Process::DETACHED);
+	if (process->enabled == Process::ENABLED) {
+		enabledProcessBusynessLevels.set(process->getIndex(), process->busyness());
+		if (wasTotallyBusy) {
+			assert(nEnabledProcessesTotallyBusy >= 1);
+			nEnabledProcessesTotallyBusy--;
+		}
+	}
+}
+
 void
 Group::_onSessionInitiateFailure(Session *session) {
 	Process *process = session->getProcess();
@@ -123,7 +169,7 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 	TRACE_POINT();
 	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -141,9 +187,29 @@ Group::onSessionInitiateFailure(Process *process, Session *session) {
 OXT_FORCE_INLINE void
 Group::onSessionClose(Process *process, Session *session) {
 	TRACE_POINT();
-	// Standard resource management boilerplate stuff...
 	Pool *pool = getPool();
-	boost::unique_lock<boost::mutex> lock(pool->syncher);
+
+	{
+		/* Fast path: if there's nothing to do besides updating statistics,
+		 * then holding the pool lock in shared mode suffices.
+		 */
+		PoolSharedLock sharedLock(pool->syncher);
+		boost::lock_guard<boost::mutex> groupLock(syncher);
+		assert(process->isAlive());
+		assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
+
+		if (OXT_LIKELY(sessionCloseIsTrivial(process))) {
+			P_TRACE(2, "Session closed for process " << process->inspect());
+			verifyInvariants();
+			updateStatisticsOnSessionClose(process, session);
+			verifyInvariants();
+			return;
+		}
+	}
+
+	// Standard resource management boilerplate stuff...
+	UPDATE_TRACE_POINT();
+	PoolScopedLock lock(pool->syncher);
 	assert(process->isAlive());
 	assert(isAlive() || getLifeStatus() == SHUTTING_DOWN);
 
@@ -151,20 +217,7 @@ Group::onSessionClose(Process *process, Session *session) {
 	verifyInvariants();
 	UPDATE_TRACE_POINT();
 
-	/* Update statistics. */
-	bool wasTotallyBusy = process->isTotallyBusy();
-	process->sessionClosed(session);
-	assert(process->getLifeStatus() == Process::ALIVE);
-	assert(process->enabled == Process::ENABLED
-		|| process->enabled == Process::DISABLING
-		|| process->enabled == Process::DETACHED);
-	if (process->enabled == Process::ENABLED) {
-		enabledProcessBusynessLevels[process->getIndex()] = process->busyness();
-		if (wasTotallyBusy) {
-			assert(nEnabledProcessesTotallyBusy >= 1);
-			nEnabledProcessesTotallyBusy--;
-		}
-	}
+	updateStatisticsOnSessionClose(process, session);
 
 	/* This group now has a process that's guaranteed to be not
 	 * totally busy.
@@ -252,6 +305,43 @@ Group::onSessionClose(Process *process, Session *session) {
  ****************************/
 
 
+/**
+ * Checks out a session like get() does, but only if that can be done without
+ * touching anything outside this Group: no spawning, restarting, queueing or
+ * checking the restart files. Returns NULL if that's not possible, in which
+ * case the caller should call get(). Besides merging `newOptions`, this
+ * method has no side effects in that case.
+ *
+ * Must be called while holding the pool lock in shared mode, and this Group's
+ * `syncher`. See Pool::syncher.
+ */
+SessionPtr
+Group::tryGetQuickly(const Options &newOptions) {
+	assert(isAlive());
+
+	if (OXT_UNLIKELY(restarting()
+		|| newOptions.noop
+		|| restartFilesCheckDue(newOptions)))
+	{
+		return SessionPtr();
+	}
+
+	mergeOptions(newOptions);
+	if (OXT_UNLIKELY(shouldSpawnForGetAction())) {
+		return SessionPtr();
+	}
+
+	// !shouldSpawnForGetAction() implies enabledCount > 0.
+	RouteResult result = route(newOptions);
+	if (OXT_LIKELY(result.process != NULL)) {
+		P_DEBUG("Session checked out from process " << result.process->inspect());
+		return newSession(result.process, newOptions.currentTime);
+	} else {
+		return SessionPtr();
+	}
+}
+
+
 SessionPtr
 Group::get(const Options &newOptions, const GetCallback &callback,
 	boost::container::vector<Callback> &postLockActions)
@@ -112,7 +112,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		UPDATE_TRACE_POINT();
 		ScopeGuard guard(boost::bind(Process::forceTriggerShutdownAndCleanup, process));
-		boost::unique_lock<boost::mutex> lock(pool->syncher);
+		PoolScopedLock lock(pool->syncher);
 
 		if (!isAlive()) {
 			if (process != NULL) {
@@ -142,10 +142,10 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 
 		verifyInvariants();
 		assert(m_spawning);
+		assert(spawnThreadCount > 0);
 		assert(processesBeingSpawned > 0);
 
 		processesBeingSpawned--;
-		assert(processesBeingSpawned == 0);
 
 		UPDATE_TRACE_POINT();
 		boost::container::vector<Callback> actions;
@@ -153,6 +153,7 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 			AttachResult result = attach(process, actions);
 			if (result == AR_OK) {
 				guard.clear();
+				spawnBurstProcessCount++;
 				if (getWaitlist.empty()) {
 					pool->assignSessionsToGetWaiters(actions);
 				} else {
@@ -179,12 +180,16 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 		}
 
 		done = done
-			|| (processLowerLimitsSatisfied() && getWaitlist.empty())
+			|| !spawnLoopShouldContinue()
 			|| processUpperLimitsReached()
 			|| pool->atFullCapacityUnlocked();
-		m_spawning = !done;
 		if (done) {
 			P_DEBUG("Spawn loop done");
+			spawnThreadCount--;
+			pool->spawnThreadCount--;
+			if (spawnThreadCount == 0) {
+				finishSpawnBurst();
+			}
 		} else {
 			processesBeingSpawned++;
 			P_DEBUG("Continue spawning");
@@ -203,6 +208,64 @@ Group::spawnThreadRealMain(const SpawningKit::SpawnerPtr &spawner,
 	}
 }
 
+void
+Group::startSpawnThread() {
+	P_DEBUG("Requested spawning of new process for group " << info.name);
+	interruptableThreads.create_thread(
+		boost::bind(&Group::spawnThreadMain,
+			this, shared_from_this(), spawner,
+			options.copyAndPersist().clearPerRequestFields(),
+			restartsInitiated),
+		"Group process spawner: " + info.name,
+		POOL_HELPER_THREAD_STACK_SIZE);
+	if (!m_spawning) {
+		m_spawning = true;
+		spawnBurstStartTime = SystemTime::getUsec();
+		spawnBurstProcessCount = 0;
+	}
+	spawnThreadCount++;
+	getPool()->spawnThreadCount++;
+	processesBeingSpawned++;
+}
+
+/**
+ * Whether there is demand for more processes than the ones that are being
+ * spawned right now. Each process that is being spawned is expected to take
+ * at least one request off the get wait list.
+ */
+bool
+Group::spawnLoopShouldContinue() const {
+	return !processLowerLimitsSatisfied()
+		|| getWaitlist.size() > (unsigned int) processesBeingSpawned;
+}
+
+/**
+ * Whether `spawn()` should start another spawner thread while there are
+ * already spawner threads working.
+ */
+bool
+Group::shouldSpawnConcurrently() const {
+	return spawnThreadCount < std::max(options.spawnConcurrency, 1u)
+		&& (!processLowerLimitsSatisfied()
+			// The get() request that we're handling right now may be
+			// about to be put on the wait list as well.
+			|| getWaitlist.size() >= (unsigned int) processesBeingSpawned)
+		&& !processUpperLimitsReached()
+		&& !poolAtFullCapacity()
+		&& !getPool()->concurrentSpawnLimitReached();
+}
+
+void
+Group::finishSpawnBurst() {
+	assert(spawnThreadCount == 0);
+	m_spawning = false;
+	lastSpawnBurstDuration = SystemTime::getUsec() - spawnBurstStartTime;
+	lastSpawnBurstProcessCount = spawnBurstProcessCount;
+	P_DEBUG("Group " << info.name << " spawned " << spawnBurstProcessCount << " " <<
+		Pool::maybePluralize(spawnBurstProcessCount, "process", "processes") <<
+		" in " << (lastSpawnBurstDuration / 1000) << " msec");
+}
+
 // The 'self' parameter is for keeping the current Group object alive while this thread is running.
 void
 Group::finalizeRestart(GroupPtr self,
@@ -238,7 +301,7 @@ Group::finalizeRestart(GroupPtr self,
 		debug->messages->recv("Finish restarting");
 	}
 
-	ScopedLock l(pool->syncher);
+	PoolScopedLock l(pool->syncher);
 	if (!isAlive()) {
 		P_DEBUG("Group " << getName() << " is shutting down, so aborting restart");
 		return;
@@ -307,6 +370,8 @@ Group::restart(const Options &options, RestartMethod method) {
 	restartsInitiated++;
 
 	processesBeingSpawned = 0;
+	getPool()->spawnThreadCount -= spawnThreadCount;
+	spawnThreadCount = 0;
 	m_spawning   = false;
 	m_restarting = true;
 	uuid         = generateUuid(pool);
@@ -341,9 +406,39 @@ Group::needsRestart(const Options &options) {
 			now = SystemTime::get();
 		}
 
+		if (restartFileWatch->active.load(boost::memory_order_acquire)) {
+			// The RestartFileWatcher monitors the restart files for us.
+			// Keep our own state up to date in case the watch becomes
+			// inactive later.
+			time_t watchedMtime = restartFileWatch->lastRestartFileMtime.load(
+				boost::memory_order_relaxed);
+			bool restart = false;
+
+			if (!restartFileWatchWasActive && lastRestartFileCheckTime != 0) {
+				// The watch has just become active, e.g. because the restart
+				// directory was created. Until now we've been checking
+				// restart.txt ourselves, while the watcher only recorded the
+				// current mtime as its baseline. So restart.txt may have been
+				// touched without the watcher noticing.
+				restart = watchedMtime != 0 && watchedMtime != lastRestartFileMtime;
+			}
+			restartFileWatchWasActive = true;
+			lastRestartFileMtime = watchedMtime;
+			lastRestartFileCheckTime = now;
+			alwaysRestartFileExists = restartFileWatch->alwaysRestartFileExists.load(
+				boost::memory_order_acquire);
+			if (restartFileWatch->restartPending.load(boost::memory_order_acquire)
+			 && restartFileWatch->restartPending.exchange(false, boost::memory_order_acq_rel))
+			{
+				return true;
+			}
+			return restart || alwaysRestartFileExists;
+		}
+
+		restartFileWatchWasActive = false;
 		if (lastRestartFileCheckTime == 0) {
 			// First time we call needsRestart() for this group.
-			if (syscalls::stat(restartFile.c_str(), &buf) == 0) {
+			if (RestartFileWatcher::statFile(restartFile.c_str(), &buf) == 0) {
 				lastRestartFileMtime = buf.st_mtime;
 			} else {
 				lastRestartFileMtime = 0;
@@ -360,7 +455,7 @@ Group::needsRestart(const Options &options) {
 
 			if (lastRestartFileMtime > 0) {
 				// restart.txt existed before
-				if (syscalls::stat(restartFile.c_str(), &buf) == -1) {
+				if (RestartFileWatcher::statFile(restartFile.c_str(), &buf) == -1) {
 					// restart.txt no longer exists
 					lastRestartFileMtime = buf.st_mtime;
 					restart = false;
@@ -373,7 +468,7 @@ Group::needsRestart(const Options &options) {
 				}
 			} else {
 				// restart.txt didn't exist before
-				if (syscalls::stat(restartFile.c_str(), &buf) == 0) {
+				if (RestartFileWatcher::statFile(restartFile.c_str(), &buf) == 0) {
 					// restart.txt now exists
 					lastRestartFileMtime = buf.st_mtime;
 					restart = true;
@@ -386,7 +481,7 @@ Group::needsRestart(const Options &options) {
 
 			if (!restart) {
 				alwaysRestartFileExists = restart =
-					syscalls::stat(alwaysRestartFile.c_str(), &buf) == 0;
+					RestartFileWatcher::statFile(alwaysRestartFile.c_str(), &buf) == 0;
 			}
 
 			return restart;
@@ -396,7 +491,7 @@ Group::needsRestart(const Options &options) {
 			// Still within stat throttling window.
 			if (alwaysRestartFileExists) {
 				// always_restart.txt existed before
-				alwaysRestartFileExists = syscalls::stat(
+				alwaysRestartFileExists = RestartFileWatcher::statFile(
 					alwaysRestartFile.c_str(), &buf) == 0;
 				return alwaysRestartFileExists;
 			} else {
@@ -408,35 +503,62 @@ Group::needsRestart(const Options &options) {
 }
 
 /**
- * Attempts to increase the number of processes by one, while respecting the
+ * Whether needsRestart() would check the restart files on the filesystem
+ * right now. Unlike needsRestart(), this method has no side effects.
+ */
+bool
+Group::restartFilesCheckDue(const Options &options) const {
+	if (m_restarting) {
+		return false;
+	} else if (restartFileWatch->active.load(boost::memory_order_acquire)) {
+		return (!restartFileWatchWasActive && lastRestartFileCheckTime != 0)
+			|| restartFileWatch->restartPending.load(boost::memory_order_acquire)
+			|| restartFileWatch->alwaysRestartFileExists.load(boost::memory_order_acquire);
+	} else if (lastRestartFileCheckTime == 0 || alwaysRestartFileExists) {
+		return true;
+	} else {
+		time_t now;
+		if (options.currentTime != 0) {
+			now = options.currentTime / 1000000;
+		} else {
+			now = SystemTime::get();
+		}
+		return lastRestartFileCheckTime <= now - (time_t) options.statThrottleRate;
+	}
+}
+
+/**
+ * Attempts to increase the number of processes, while respecting the
  * resource limits. That is, this method will ensure that there are at least
  * `minProcesses` processes, but no more than `maxProcesses` processes, and no
  * more than `pool->max` processes in the entire pool.
+ *
+ * Processes are spawned by spawner threads, which keep spawning processes one
+ * by one for as long as there is demand. If there is more demand than the
+ * processes that are being spawned can satisfy, e.g. because the get wait
+ * list is growing, then this method starts additional spawner threads, up to
+ * `options.spawnConcurrency` threads and as long as the pool-wide limit on
+ * concurrent spawns allows it.
  */
 SpawnResult
 Group::spawn() {
 	assert(isAlive());
 	if (m_spawning) {
-		return SR_IN_PROGRESS;
+		if (!shouldSpawnConcurrently()) {
+			return SR_IN_PROGRESS;
+		}
 	} else if (restarting()) {
 		return SR_ERR_RESTARTING;
 	} else if (processUpperLimitsReached()) {
 		return SR_ERR_GROUP_UPPER_LIMITS_REACHED;
 	} else if (poolAtFullCapacity()) {
 		return SR_ERR_POOL_AT_FULL_CAPACITY;
-	} else {
-		P_DEBUG("Requested spawning of new process for group " << info.name);
-		interruptableThreads.create_thread(
-			boost::bind(&Group::spawnThreadMain,
-				this, shared_from_this(), spawner,
-				options.copyAndPersist().clearPerRequestFields(),
-				restartsInitiated),
-			"Group process spawner: " + info.name,
-			POOL_HELPER_THREAD_STACK_SIZE);
-		m_spawning = true;
-		processesBeingSpawned++;
-		return SR_OK;
 	}
+
+	do {
+		startSpawnThread();
+	} while (shouldSpawnConcurrently());
+	return SR_OK;
 }
 
 bool
@@ -116,77 +116,175 @@ Group::garbageCollectable(unsigned long long now) const {
 }
 
 void
-Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
+Group::snapshot(GroupSnapshot &snapshot) const {
 	ProcessList::const_iterator it;
 
-	stream << "<name>" << escapeForXml(info.name) << "</name>";
-	stream << "<component_name>" << escapeForXml(info.name) << "</component_name>";
+	snapshot.name = info.name;
+	snapshot.uuid = uuid;
+	snapshot.apiKey = getApiKey();
+	snapshot.options = options.copyAndPersist();
+	snapshot.resourceLocator = &getResourceLocator();
+	snapshot.enabledCount = enabledCount;
+	snapshot.disablingCount = disablingCount;
+	snapshot.disabledCount = disabledCount;
+	snapshot.capacityUsed = capacityUsed();
+	snapshot.getWaitlistSize = getWaitlist.size();
+	snapshot.disableWaitlistSize = disableWaitlist.size();
+	snapshot.processesBeingSpawned = processesBeingSpawned;
+	snapshot.spawnThreadCount = spawnThreadCount;
+	snapshot.routingPolicy = routingPolicy;
+	snapshot.lastSpawnBurstDuration = lastSpawnBurstDuration;
+	snapshot.lastSpawnBurstProcessCount = lastSpawnBurstProcessCount;
+	snapshot.queueWaitTimes = queueWaitTimes;
+	snapshot.overloaded = queueCoDel.isOverloaded();
+	snapshot.requestsTimedOutInQueue = requestsTimedOutInQueue;
+	snapshot.requestsShedFromQueue = requestsShedFromQueue;
+	snapshot.requestsAbandonedInQueue = requestsAbandonedInQueue;
+	snapshot.spawning = m_spawning;
+	snapshot.restarting = m_restarting;
+	snapshot.lifeStatus = (LifeStatus) lifeStatus.load(boost::memory_order_relaxed);
+
+	snapshot.enabledProcesses.resize(enabledProcesses.size());
+	for (it = enabledProcesses.begin(); it != enabledProcesses.end(); it++) {
+		(*it)->snapshot(snapshot.enabledProcesses[it - enabledProcesses.begin()]);
+	}
+	snapshot.disablingProcesses.resize(disablingProcesses.size());
+	for (it = disablingProcesses.begin(); it != disablingProcesses.end(); it++) {
+		(*it)->snapshot(snapshot.disablingProcesses[it - disablingProcesses.begin()]);
+	}
+	snapshot.disabledProcesses.resize(disabledProcesses.size());
+	for (it = disabledProcesses.begin(); it != disabledProcesses.end(); it++) {
+		(*it)->snapshot(snapshot.disabledProcesses[it - disabledProcesses.begin()]);
+	}
+	snapshot.detachedProcesses.resize(detachedProcesses.size());
+	for (it = detachedProcesses.begin(); it != detachedProcesses.end(); it++) {
+		(*it)->snapshot(snapshot.detachedProcesses[it - detachedProcesses.begin()]);
+	}
+}
+
+void
+Group::inspectXml(std::ostream &stream, bool includeSecrets) const {
+	GroupSnapshot snapshot;
+	this->snapshot(snapshot);
+	snapshot.finalize();
+	snapshot.inspectXml(stream, includeSecrets);
+}
+
+
+/**
+ * Looks up the user and group that the application runs as. This may
+ * access the user database, which is why it's not done by `Group::snapshot()`.
+ */
+void
+GroupSnapshot::finalize() {
+	userSwitchingInfo = SpawningKit::prepareUserSwitching(options);
+}
+
+bool
+GroupSnapshot::authorizeByUid(uid_t uid) const {
+	return uid == 0 || userSwitchingInfo.uid == uid;
+}
+
+bool
+GroupSnapshot::authorizeByApiKey(const ApiKey &key) const {
+	return key.isSuper() || key == apiKey;
+}
+
+void
+GroupSnapshot::inspectXml(std::ostream &stream, bool includeSecrets) const {
+	vector<ProcessSnapshot>::const_iterator it;
+
+	stream << "<name>" << escapeForXml(name) << "</name>";
+	stream << "<component_name>" << escapeForXml(name) << "</component_name>";
 	stream << "<app_root>" << escapeForXml(options.appRoot) << "</app_root>";
 	stream << "<app_type>" << escapeForXml(options.appType) << "</app_type>";
 	stream << "<environment>" << escapeForXml(options.environment) << "</environment>";
-	stream << "<uuid>" << toString(uuid) << "</uuid>";
+	stream << "<uuid>" << uuid << "</uuid>";
 	stream << "<enabled_process_count>" << enabledCount << "</enabled_process_count>";
 	stream << "<disabling_process_count>" << disablingCount << "</disabling_process_count>";
 	stream << "<disabled_process_count>" << disabledCount << "</disabled_process_count>";
-	stream << "<capacity_used>" << capacityUsed() << "</capacity_used>";
-	stream << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
-	stream << "<disable_wait_list_size>" << disableWaitlist.size() << "</disable_wait_list_size>";
+	stream << "<capacity_used>" << capacityUsed << "</capacity_used>";
+	stream << "<get_wait_list_size>" << getWaitlistSize << "</get_wait_list_size>";
+	stream << "<disable_wait_list_size>" << disableWaitlistSize << "</disable_wait_list_size>";
 	stream << "<processes_being_spawned>" << processesBeingSpawned << "</processes_being_spawned>";
-	if (m_spawning) {
+	stream << "<spawn_thread_count>" << spawnThreadCount << "</spawn_thread_count>";
+	stream << "<routing_policy>" << getRoutingPolicyName(routingPolicy) << "</routing_policy>";
+	if (lastSpawnBurstDuration != 0) {
+		stream << "<last_spawn_burst>";
+		stream << "<duration>" << lastSpawnBurstDuration << "</duration>";
+		stream << "<processes_spawned>" << lastSpawnBurstProcessCount << "</processes_spawned>";
+		stream << "</last_spawn_burst>";
+	}
+	stream << "<request_queue>";
+	stream << "<timed_out>" << requestsTimedOutInQueue << "</timed_out>";
+	stream << "<shed>" << requestsShedFromQueue << "</shed>";
+	stream << "<abandoned>" << requestsAbandonedInQueue << "</abandoned>";
+	if (overloaded) {
+		stream << "<overloaded/>";
+	}
+	stream << "<wait_time>";
+	stream << "<count>" << queueWaitTimes.getCount() << "</count>";
+	stream << "<min>" << queueWaitTimes.getMin() << "</min>";
+	stream << "<mean>" << (unsigned long long) queueWaitTimes.getMean() << "</mean>";
+	stream << "<p50>" << queueWaitTimes.getValueAtPercentile(50) << "</p50>";
+	stream << "<p90>" << queueWaitTimes.getValueAtPercentile(90) << "</p90>";
+	stream << "<p99>" << queueWaitTimes.getValueAtPercentile(99) << "</p99>";
+	stream << "<max>" << queueWaitTimes.getMax() << "</max>";
+	stream << "</wait_time>";
+	stream << "</request_queue>";
+	if (spawning) {
 		stream << "<spawning/>";
 	}
-	if (restarting()) {
+	if (restarting) {
 		stream << "<restarting/>";
 	}
 	if (includeSecrets) {
-		stream << "<secret>" << escapeForXml(getApiKey().toStaticString()) << "</secret>";
-		stream << "<api_key>" << escapeForXml(getApiKey().toStaticString()) << "</api_key>";
+		stream << "<secret>" << escapeForXml(apiKey.toStaticString()) << "</secret>";
+		stream << "<api_key>" << escapeForXml(apiKey.toStaticString()) << "</api_key>";
 	}
-	LifeStatus lifeStatus = (LifeStatus) this->lifeStatus.load(boost::memory_order_relaxed);
 	switch (lifeStatus) {
-	case ALIVE:
+	case Group::ALIVE:
 		stream << "<life_status>ALIVE</life_status>";
 		break;
-	case SHUTTING_DOWN:
+	case Group::SHUTTING_DOWN:
 		stream << "<life_status>SHUTTING_DOWN</life_status>";
 		break;
-	case SHUT_DOWN:
+	case Group::SHUT_DOWN:
 		stream << "<life_status>SHUT_DOWN</life_status>";
 		break;
 	default:
 		P_BUG("Unknown 'lifeStatus' state " << lifeStatus);
 	}
 
-	SpawningKit::UserSwitchingInfo usInfo(SpawningKit::prepareUserSwitching(options));
-	stream << "<user>" << escapeForXml(usInfo.username) << "</user>";
-	stream << "<uid>" << usInfo.uid << "</uid>";
-	stream << "<group>" << escapeForXml(usInfo.groupname) << "</group>";
-	stream << "<gid>" << usInfo.gid << "</gid>";
+	stream << "<user>" << escapeForXml(userSwitchingInfo.username) << "</user>";
+	stream << "<uid>" << userSwitchingInfo.uid << "</uid>";
+	stream << "<group>" << escapeForXml(userSwitchingInfo.groupname) << "</group>";
+	stream << "<gid>" << userSwitchingInfo.gid << "</gid>";
 
 	stream << "<options>";
-	options.toXml(stream, getResourceLocator());
+	options.toXml(stream, *resourceLocator);
 	stream << "</options>";
 
 	stream << "<processes>";
 
 	for (it = enabledProcesses.begin(); it != enabledProcesses.end(); it++) {
 		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
+		it->inspectXml(stream, includeSecrets);
 		stream << "</process>";
 	}
 	for (it = disablingProcesses.begin(); it != disablingProcesses.end(); it++) {
 		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
+		it->inspectXml(stream, includeSecrets);
 		stream << "</process>";
 	}
 	for (it = disabledProcesses.begin(); it != disabledProcesses.end(); it++) {
 		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
+		it->inspectXml(stream, includeSecrets);
 		stream << "</process>";
 	}
 	for (it = detachedProcesses.begin(); it != detachedProcesses.end(); it++) {
 		stream << "<process>";
-		(*it)->inspectXml(stream, includeSecrets);
+		it->inspectXml(stream, includeSecrets);
 		stream << "</process>";
 	}
 
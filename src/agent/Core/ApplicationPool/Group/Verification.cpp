@@ -79,6 +79,7 @@ Group::verifyInvariants() const {
 
 	// Verify processesBeingSpawned, m_spawning and m_restarting.
 	assert(!( processesBeingSpawned > 0 ) || ( m_spawning ));
+	assert(m_spawning == ( spawnThreadCount > 0 ));
 	assert(!( m_restarting ) || ( processesBeingSpawned == 0 ));
 
 	// Verify lifeStatus.
@@ -46,6 +46,7 @@
 #include <Core/ApplicationPool/Pool.h>
 #include <Core/ApplicationPool/Group.h>
 #include <Core/ApplicationPool/ErrorRenderer.h>
+#include <Core/ApplicationPool/RestartFileWatcher.cpp>
 #include <Core/ApplicationPool/Pool/InitializationAndShutdown.cpp>
 #include <Core/ApplicationPool/Pool/AnalyticsCollection.cpp>
 #include <Core/ApplicationPool/Pool/GarbageCollection.cpp>
@@ -323,6 +324,31 @@ recreateString(psg_pool_t *pool, StaticString &str) {
 	str = psg_pstrdup(pool, str);
 }
 
+/**
+ * Parses the value of Options::routingPolicy. Unknown values are
+ * treated as the default policy.
+ */
+RoutingPolicy
+parseRoutingPolicy(const StaticString &name) {
+	if (name == P_STATIC_STRING("power_of_two")) {
+		return RP_POWER_OF_TWO;
+	} else {
+		return RP_LEAST_BUSY;
+	}
+}
+
+const char *
+getRoutingPolicyName(RoutingPolicy policy) {
+	switch (policy) {
+	case RP_LEAST_BUSY:
+		return "least_busy";
+	case RP_POWER_OF_TWO:
+		return "power_of_two";
+	default:
+		return "unknown";
+	}
+}
+
 
 void
 Session::requestOOBW() {
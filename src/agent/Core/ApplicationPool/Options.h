@@ -92,6 +92,7 @@ private:
 		result.push_back(&options.environment);
 		result.push_back(&options.baseURI);
 		result.push_back(&options.spawnMethod);
+		result.push_back(&options.routingPolicy);
 
 		result.push_back(&options.user);
 		result.push_back(&options.group);
@@ -352,6 +353,14 @@ public:
 	/** The number of seconds that preloader processes may stay alive idling. */
 	long maxPreloaderIdleTime;
 
+	/**
+	 * The maximum number of processes that may be spawned concurrently for
+	 * this group, e.g. when scaling up during a traffic burst. This is further
+	 * limited by `maxProcesses`, the pool size and the pool-wide limit on
+	 * concurrent spawns.
+	 */
+	unsigned int spawnConcurrency;
+
 	/**
 	 * The maximum number of processes inside a group that may be performing
 	 * out-of-band work at the same time.
@@ -364,6 +373,29 @@ public:
 	 */
 	unsigned int maxRequestQueueSize;
 
+	/**
+	 * The maximum number of seconds that a request may spend in the
+	 * Group.getWaitlist queue. Requests that waited longer are rejected
+	 * the same way as when the queue is full. A value of 0 means unlimited.
+	 */
+	unsigned int maxRequestQueueTime;
+
+	/**
+	 * The target queueing delay, in milliseconds, for adaptive load shedding
+	 * of the Group.getWaitlist queue (see Algorithms/CoDel.h). When
+	 * requests keep waiting longer than this, requests that waited longer
+	 * than this are rejected. A value of 0 disables adaptive load shedding.
+	 */
+	unsigned int requestQueueTargetDelay;
+
+	/**
+	 * How requests are routed to the group's processes. Either "least_busy",
+	 * which always picks the process with the lowest busyness, or
+	 * "power_of_two", which picks the less busy one of two randomly
+	 * chosen processes. See Group::route().
+	 */
+	StaticString routingPolicy;
+
 	/**
 	 * Whether websocket connections should be aborted on process shutdown
 	 * or restart.
@@ -493,8 +525,12 @@ public:
 		  minProcesses(1),
 		  maxProcesses(0),
 		  maxPreloaderIdleTime(-1),
+		  spawnConcurrency(DEFAULT_SPAWN_CONCURRENCY),
 		  maxOutOfBandWorkInstances(1),
 		  maxRequestQueueSize(100),
+		  maxRequestQueueTime(0),
+		  requestQueueTargetDelay(0),
+		  routingPolicy(DEFAULT_ROUTING_POLICY, sizeof(DEFAULT_ROUTING_POLICY) - 1),
 		  abortWebsocketsOnProcessShutdown(true),
 
 		  stickySessionId(0),
@@ -632,6 +668,7 @@ public:
 			appendKeyValue3(vec, "min_processes",       minProcesses);
 			appendKeyValue3(vec, "max_processes",       maxProcesses);
 			appendKeyValue2(vec, "max_preloader_idle_time", maxPreloaderIdleTime);
+			appendKeyValue3(vec, "spawn_concurrency",   spawnConcurrency);
 			appendKeyValue3(vec, "max_out_of_band_work_instances", maxOutOfBandWorkInstances);
 		}
 		if ((fields & SPAWN_OPTIONS) || (fields & PER_GROUP_POOL_OPTIONS)) {
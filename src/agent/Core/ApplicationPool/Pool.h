@@ -38,6 +38,7 @@
 #include <boost/make_shared.hpp>
 #include <boost/function.hpp>
 #include <boost/foreach.hpp>
+#include <boost/atomic.hpp>
 #include <boost/pool/object_pool.hpp>
 // We use boost::container::vector instead of std::vector, because the
 // former does not allocate memory in its default constructor. This is
@@ -158,8 +159,40 @@ public:
 	friend class Process;
 	friend struct tut::ApplicationPool2_PoolTest;
 
-	mutable boost::mutex syncher;
+	/**
+	 * Protects all Pool, Group and Process state. It is normally locked
+	 * exclusively.
+	 *
+	 * The hot paths, namely checking out a session from an existing Group that
+	 * can route the request right away (`tryGetQuickly()`) and closing a session
+	 * when nothing but statistics need updating (`Group::onSessionClose()`),
+	 * lock it in shared mode instead, together with that Group's `syncher`.
+	 * That way threads which check out sessions from different Groups don't
+	 * serialize on each other. This works because of the following rules:
+	 *
+	 * - Code that holds `syncher` exclusively may access everything, and must
+	 *   not lock any Group's `syncher`.
+	 * - Code that holds `syncher` in shared mode may read Pool state and the
+	 *   process lists, counters and wait lists of any Group. It may only modify
+	 *   the Group whose `syncher` it also holds, and only the state that is not
+	 *   read by other Groups: process busyness and session counters, merged
+	 *   options and restart file check times. Anything else, like spawning,
+	 *   queueing or detaching, requires relocking `syncher` exclusively.
+	 */
+	mutable PoolMutex syncher;
 	unsigned int max;
+	/**
+	 * The maximum number of spawner threads in the entire pool. 0 means
+	 * unlimited. Every Group may always have at least one spawner thread,
+	 * so this only limits concurrent spawning within Groups.
+	 * See Group::spawn().
+	 */
+	unsigned int maxConcurrentSpawns;
+	/**
+	 * The sum of `spawnThreadCount` over all Groups in `groups`. Kept up to
+	 * date by the Groups so that spawn decisions don't have to walk all Groups.
+	 */
+	unsigned int spawnThreadCount;
 	unsigned long long maxIdleTime;
 	bool selfchecking;
 
@@ -227,6 +260,17 @@ public:
 
 	const VariantMap *agentsOptions;
 
+	/**
+	 * The snapshot returned by `getSnapshot()`, and whether a thread is busy
+	 * replacing it. Protected by `snapshotSyncher`, not by `syncher`.
+	 */
+	boost::mutex snapshotSyncher;
+	PoolSnapshotPtr snapshot;
+	bool creatingSnapshot;
+	/** Maximum age (in microseconds) of the snapshot returned by `getSnapshot()`. */
+	boost::atomic<unsigned long long> snapshotMaxAge;
+	mutable boost::atomic<unsigned long long> lastSnapshotVersion;
+
 // Actually private, but marked public so that unit tests can access the fields.
 public:
 	/****** Debugging support *******/
@@ -298,7 +342,12 @@ public:
 		boost::container::vector<Callback> actions;
 	};
 
-	boost::condition_variable garbageCollectionCond;
+	boost::condition_variable_any garbageCollectionCond;
+	/**
+	 * When the garbage collector runs next, or 0 if it isn't waiting for
+	 * that right now. Protected by `syncher`.
+	 */
+	unsigned long long nextGarbageCollectionTime;
 
 	void initializeGarbageCollection();
 	static void garbageCollect(PoolPtr self);
@@ -308,8 +357,10 @@ public:
 	void garbageCollectProcessesInGroup(GarbageCollectorState &state,
 		const GroupPtr &group);
 	void maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group);
+	void shedGetWaiters(GarbageCollectorState &state, const GroupPtr &group);
 	unsigned long long realGarbageCollect();
 	void wakeupGarbageCollector();
+	void scheduleGarbageCollection(unsigned long long time);
 
 
 	/****** General utilities ******/
@@ -329,6 +380,9 @@ public:
 		boost::container::vector<Callback> &postLockActions);
 	static void syncGetCallback(const AbstractSessionPtr &session, const ExceptionPtr &e,
 		void *userData);
+	SessionPtr tryGetQuickly(const Options &options, UnionStation::StopwatchLog **stopwatchLog);
+	UnionStation::StopwatchLog *createGetStopwatchLog(const Options &options,
+		const Group *existingGroup) const;
 
 
 	/****** Group data structure utilities ******/
@@ -383,8 +437,9 @@ public:
 
 	unsigned int capacityUsedUnlocked() const;
 	bool atFullCapacityUnlocked() const;
-	void inspectProcessList(const InspectOptions &options, stringstream &result,
-		const Group *group, const ProcessList &processes) const;
+	unsigned int getSpawnThreadCountUnlocked() const;
+	bool concurrentSpawnLimitReached() const;
+	PoolSnapshotPtr createSnapshot(bool lock) const;
 
 public:
 	typedef void (*AbortLongRunningConnectionsCallback)(const ProcessPtr &process);
@@ -445,6 +500,8 @@ public:
 		bool lock = true) const;
 	string toXml(const ToXmlOptions &options = ToXmlOptions::makeAuthorized(),
 		bool lock = true) const;
+	PoolSnapshotPtr getSnapshot();
+	void setSnapshotMaxAge(unsigned long long value);
 
 
 	/****** Miscellaneous ******/
@@ -453,13 +510,44 @@ public:
 	SessionPtr get(const Options &options, Ticket *ticket);
 	void setMax(unsigned int max);
 	void setMaxIdleTime(unsigned long long value);
+	void setMaxConcurrentSpawns(unsigned int value);
 	void enableSelfChecking(bool enabled);
+	void enableRestartFileWatching(bool enabled);
 	bool isSpawning(bool lock = true) const;
 	bool authorizeByApiKey(const ApiKey &key, bool lock = true) const;
 	bool authorizeByUid(uid_t uid, bool lock = true) const;
 };
 
 
+/**
+ * An immutable copy of the state of a Pool and all its Groups and Processes.
+ * It's taken with the pool lock held, but formatting it with `inspect()` or
+ * `toXml()` doesn't require the pool lock. See `Pool::getSnapshot()`.
+ */
+struct PoolSnapshot {
+	/** Snapshots of the same Pool that were taken later have higher versions. */
+	unsigned long long version;
+	/** The monotonic time (in microseconds) at which this snapshot was taken. */
+	unsigned long long createdAt;
+
+	unsigned int max;
+	unsigned int processCount;
+	unsigned int capacityUsed;
+	/** The app group names of the requests in the top-level wait list. */
+	vector<string> getWaitlist;
+	vector<GroupSnapshot> groups;
+
+	bool authorizeByUid(uid_t uid) const;
+	bool authorizeByApiKey(const ApiKey &key) const;
+	string inspect(const Pool::InspectOptions &options = Pool::InspectOptions::makeAuthorized()) const;
+	string toXml(const Pool::ToXmlOptions &options = Pool::ToXmlOptions::makeAuthorized()) const;
+
+private:
+	void inspectProcessList(const Pool::InspectOptions &options, stringstream &result,
+		const GroupSnapshot &group, const vector<ProcessSnapshot> &processes) const;
+};
+
+
 } // namespace ApplicationPool2
 } // namespace Passenger
 
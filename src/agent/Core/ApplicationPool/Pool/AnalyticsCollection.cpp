@@ -158,13 +158,13 @@ Pool::realCollectAnalytics() {
 	// Collect all the PIDs.
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		max = this->max;
 	}
 	pids.reserve(max);
 	{
 		UPDATE_TRACE_POINT();
-		LockGuard l(syncher);
+		PoolLockGuard l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		while (*g_it != NULL) {
@@ -184,7 +184,7 @@ Pool::realCollectAnalytics() {
 		P_DEBUG("Collecting process metrics");
 		processMetrics = ProcessMetricsCollector().collect(pids);
 	} catch (const ParseException &) {
-		P_WARN("Unable to collect process metrics: cannot parse 'ps' output.");
+		P_WARN("Unable to collect process metrics: cannot parse 'ps' output or /proc data.");
 		return;
 	}
 	try {
@@ -201,7 +201,7 @@ Pool::realCollectAnalytics() {
 		vector<UnionStationLogEntry> logEntries;
 		vector<ProcessPtr> processesToDetach;
 		boost::container::vector<Callback> actions;
-		ScopedLock l(syncher);
+		PoolScopedLock l(syncher);
 		GroupMap::ConstIterator g_it(groups);
 
 		UPDATE_TRACE_POINT();
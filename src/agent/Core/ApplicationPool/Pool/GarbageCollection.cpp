@@ -51,18 +51,24 @@ void
 Pool::garbageCollect(PoolPtr self) {
 	TRACE_POINT();
 	{
-		ScopedLock lock(self->syncher);
+		PoolScopedLock lock(self->syncher);
+		self->nextGarbageCollectionTime = SystemTime::getUsec() + 5000000;
 		self->garbageCollectionCond.timed_wait(lock,
 			posix_time::seconds(5));
 	}
 	while (!this_thread::interruption_requested()) {
 		try {
 			UPDATE_TRACE_POINT();
-			unsigned long long sleepTime = self->realGarbageCollect();
+			self->realGarbageCollect();
 			UPDATE_TRACE_POINT();
-			ScopedLock lock(self->syncher);
-			self->garbageCollectionCond.timed_wait(lock,
-				posix_time::microseconds(sleepTime));
+			// scheduleGarbageCollection() may have moved the next run
+			// forward since realGarbageCollect() scheduled it.
+			PoolScopedLock lock(self->syncher);
+			unsigned long long now = SystemTime::getUsec();
+			if (self->nextGarbageCollectionTime > now) {
+				self->garbageCollectionCond.timed_wait(lock,
+					posix_time::microseconds(self->nextGarbageCollectionTime - now));
+			}
 		} catch (const thread_interrupted &) {
 			break;
 		} catch (const tracable_exception &e) {
@@ -138,10 +144,26 @@ Pool::maybeCleanPreloader(GarbageCollectorState &state, const GroupPtr &group) {
 	}
 }
 
+/**
+ * Sheds get waiters that have been waiting for too long, even if no process
+ * becomes available and no new requests come in to trigger that.
+ */
+void
+Pool::shedGetWaiters(GarbageCollectorState &state, const GroupPtr &group) {
+	if (group->getWaitlist.empty()) {
+		return;
+	}
+	group->shedGetWaitersAtFront(state.actions);
+	unsigned long long shedTime = group->getNextGetWaiterShedTime(state.now);
+	if (shedTime != 0) {
+		maybeUpdateNextGcRuntime(state, shedTime);
+	}
+}
+
 unsigned long long
 Pool::realGarbageCollect() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	GroupMap::ConstIterator g_it(groups);
 	GarbageCollectorState state;
 	state.now = SystemTime::getUsec();
@@ -164,11 +186,13 @@ Pool::realGarbageCollect() {
 		// ...cleanup the spawner if it's been idle for more than preloaderIdleTime.
 		maybeCleanPreloader(state, group);
 
+		// ...reject requests that have been queued for too long.
+		shedGetWaiters(state, group);
+
 		g_it.next();
 	}
 
 	verifyInvariants();
-	lock.unlock();
 
 	// Schedule next garbage collection run.
 	unsigned long long sleepTime;
@@ -181,6 +205,8 @@ Pool::realGarbageCollect() {
 	} else {
 		sleepTime = state.nextGcRunTime - state.now;
 	}
+	nextGarbageCollectionTime = state.now + sleepTime;
+	lock.unlock();
 	P_DEBUG("Garbage collection done; next garbage collect in " <<
 		std::fixed << std::setprecision(3) << (sleepTime / 1000000.0) << " sec");
 
@@ -196,6 +222,18 @@ Pool::wakeupGarbageCollector() {
 	garbageCollectionCond.notify_all();
 }
 
+/**
+ * Makes sure that the garbage collector runs no later than the given time.
+ * Must be called with `syncher` locked.
+ */
+void
+Pool::scheduleGarbageCollection(unsigned long long time) {
+	if (time != 0 && time < nextGarbageCollectionTime) {
+		nextGarbageCollectionTime = time;
+		garbageCollectionCond.notify_all();
+	}
+}
+
 
 } // namespace ApplicationPool2
 } // namespace Passenger
@@ -122,6 +122,14 @@ Pool::verifyExpensiveInvariants() const {
 		const GroupPtr *group;
 		assert(!groups.lookup(waiter.options.getAppGroupName(), &group));
 	}
+
+	GroupMap::ConstIterator g_it(groups);
+	unsigned int totalSpawnThreadCount = 0;
+	while (*g_it != NULL) {
+		totalSpawnThreadCount += g_it.getValue()->spawnThreadCount;
+		g_it.next();
+	}
+	assert(spawnThreadCount == totalSpawnThreadCount);
 	#endif
 }
 
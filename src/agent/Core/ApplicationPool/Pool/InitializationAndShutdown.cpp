@@ -55,9 +55,15 @@ Pool::Pool(const SpawningKit::FactoryPtr &spawningKitFactory,
 
 	lifeStatus   = ALIVE;
 	max          = 6;
+	maxConcurrentSpawns = 0;
+	spawnThreadCount = 0;
+	nextGarbageCollectionTime = 0;
 	maxIdleTime  = 60 * 1000000;
 	selfchecking = true;
 	palloc       = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+	creatingSnapshot = false;
+	snapshotMaxAge = 1000000;
+	lastSnapshotVersion = 0;
 
 	// The following code only serve to instantiate certain inline methods
 	// so that they can be invoked from gdb.
@@ -76,14 +82,14 @@ Pool::~Pool() {
 /** Must be called right after construction. */
 void
 Pool::initialize() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	initializeAnalyticsCollection();
 	initializeGarbageCollection();
 }
 
 void
 Pool::initDebugging() {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	debugSupport = boost::make_shared<DebugSupport>();
 }
 
@@ -97,7 +103,7 @@ Pool::initDebugging() {
 void
 Pool::prepareForShutdown() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE);
 	lifeStatus = PREPARED_FOR_SHUTDOWN;
 	if (abortLongRunningConnectionsCallback != NULL) {
@@ -114,7 +120,7 @@ Pool::prepareForShutdown() {
 void
 Pool::destroy() {
 	TRACE_POINT();
-	ScopedLock lock(syncher);
+	PoolScopedLock lock(syncher);
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 
 	lifeStatus = SHUTTING_DOWN;
@@ -133,6 +139,7 @@ Pool::destroy() {
 	P_DEBUG("Shutting down ApplicationPool background threads...");
 	interruptableThreads.interrupt_and_join_all();
 	nonInterruptableThreads.join_all();
+	context.getRestartFileWatcher().shutdown();
 	lock.lock();
 
 	lifeStatus = SHUT_DOWN;
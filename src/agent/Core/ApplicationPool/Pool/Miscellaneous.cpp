@@ -38,11 +38,76 @@ using namespace std;
 using namespace boost;
 
 
+/**
+ * The asyncGet() fast path. Checks out a session from an existing Group while
+ * holding `syncher` only in shared mode, so that get() requests for different
+ * Groups don't serialize on each other. Returns NULL if the request needs more
+ * work than that (e.g. creating the Group, spawning or queueing), in which case
+ * the caller must fall back to the exclusively locked slow path.
+ */
+SessionPtr
+Pool::tryGetQuickly(const Options &options, UnionStation::StopwatchLog **stopwatchLog) {
+	PoolSharedLock lock(syncher);
+	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
+
+	Group *existingGroup = findMatchingGroup(options);
+	if (OXT_UNLIKELY(existingGroup == NULL)) {
+		return SessionPtr();
+	}
+
+	boost::lock_guard<boost::mutex> groupLock(existingGroup->syncher);
+	SessionPtr session = existingGroup->tryGetQuickly(options);
+	if (session != NULL) {
+		P_TRACE(2, "asyncGet(appGroupName=" << options.getAppGroupName() <<
+			") finished through the fast path");
+		if (stopwatchLog != NULL) {
+			*stopwatchLog = createGetStopwatchLog(options, existingGroup);
+		}
+	}
+	return session;
+}
+
+UnionStation::StopwatchLog *
+Pool::createGetStopwatchLog(const Options &options, const Group *existingGroup) const {
+	// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
+	// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
+	// but also indicates the server has headroom to handle the load).
+	Json::Value data;
+	if (!existingGroup) {
+		data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
+	} else {
+		char queueMaxStr[10];
+		int queueMax = existingGroup->options.maxRequestQueueSize;
+		if (queueMax > 0) {
+			snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
+		}
+		char message[50];
+		snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
+				(queueMax == 0 ? "inf" : queueMaxStr),
+				(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
+		data["message"] = message;
+	}
+	Json::Value json;
+	json["data"] = data;
+	json["data_type"] = "generic";
+	json["name"] = "Await available process";
+
+	return new UnionStation::StopwatchLog(options.transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+}
+
 // 'lockNow == false' may only be used during unit tests. Normally we
 // should never call the callback while holding the lock.
 void
 Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow, UnionStation::StopwatchLog **stopwatchLog) {
-	DynamicScopedLock lock(syncher, lockNow);
+	if (OXT_LIKELY(lockNow)) {
+		SessionPtr session = tryGetQuickly(options, stopwatchLog);
+		if (session != NULL) {
+			callback(session, ExceptionPtr());
+			return;
+		}
+	}
+
+	DynamicPoolScopedLock lock(syncher, lockNow);
 
 	assert(lifeStatus == ALIVE || lifeStatus == PREPARED_FOR_SHUTDOWN);
 	verifyInvariants();
@@ -51,30 +116,7 @@ Pool::asyncGet(const Options &options, const GetCallback &callback, bool lockNow
 
 	Group *existingGroup = findMatchingGroup(options);
 	if (stopwatchLog != NULL) {
-		// Log some essentials stats about what this request is facing in its upcoming journey through the queue:
-		// 1) position in the queue upon entry, and 2) whether spawning activity is occurring (which takes cycles
-		// but also indicates the server has headroom to handle the load).
-		Json::Value data;
-		if (!existingGroup) {
-			data["message"] = "spawning.."; // the first of this group, so keep it simple (also: we don't know maxQ yet)
-		} else {
-			char queueMaxStr[10];
-			int queueMax = existingGroup->options.maxRequestQueueSize;
-			if (queueMax > 0) {
-				snprintf(queueMaxStr, sizeof(queueMaxStr), "%d", queueMax);
-			}
-			char message[50];
-			snprintf(message, sizeof(message), "queue: %zu / %s, spawning: %s", existingGroup->getWaitlist.size(),
-					(queueMax == 0 ? "inf" : queueMaxStr),
-					(existingGroup->processesBeingSpawned == 0 ? "no" : "yes"));
-			data["message"] = message;
-		}
-		Json::Value json;
-		json["data"] = data;
-		json["data_type"] = "generic";
-		json["name"] = "Await available process";
-
-		*stopwatchLog = new UnionStation::StopwatchLog(options.transaction, "Pool::asyncGet", stringifyJson(json).c_str());
+		*stopwatchLog = createGetStopwatchLog(options, existingGroup);
 	}
 
 	if (OXT_LIKELY(existingGroup != NULL)) {
@@ -193,7 +235,7 @@ Pool::get(const Options &options, Ticket *ticket) {
 
 void
 Pool::setMax(unsigned int max) {
-	ScopedLock l(syncher);
+	PoolScopedLock l(syncher);
 	assert(max > 0);
 	fullVerifyInvariants();
 	bool bigger = max > this->max;
@@ -222,23 +264,39 @@ Pool::setMax(unsigned int max) {
 
 void
 Pool::setMaxIdleTime(unsigned long long value) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	maxIdleTime = value;
 	wakeupGarbageCollector();
 }
 
+void
+Pool::setMaxConcurrentSpawns(unsigned int value) {
+	PoolLockGuard l(syncher);
+	maxConcurrentSpawns = value;
+}
+
 void
 Pool::enableSelfChecking(bool enabled) {
-	LockGuard l(syncher);
+	PoolLockGuard l(syncher);
 	selfchecking = enabled;
 }
 
+/**
+ * Sets whether restart.txt and always_restart.txt are monitored with inotify
+ * instead of being stat()ed by get(). Only affects groups that are created
+ * afterwards.
+ */
+void
+Pool::enableRestartFileWatching(bool enabled) {
+	context.getRestartFileWatcher().setEnabled(enabled);
+}
+
 /**
  * Checks whether at least one process is being spawned.
  */
 bool
 Pool::isSpawning(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -261,7 +319,7 @@ Pool::authorizeByUid(uid_t uid, bool lock) const {
 		return true;
 	}
 
-	DynamicScopedLock l(syncher, lock);
+	DynamicPoolScopedLock l(syncher, lock);
 	GroupMap::ConstIterator g_it(groups);
 	while (*g_it != NULL) {
 		const GroupPtr &group = g_it.getValue();
@@ -68,14 +68,168 @@ Pool::atFullCapacityUnlocked() const {
 	return capacityUsedUnlocked() >= max;
 }
 
+unsigned int
+Pool::getSpawnThreadCountUnlocked() const {
+	return spawnThreadCount;
+}
+
+bool
+Pool::concurrentSpawnLimitReached() const {
+	return maxConcurrentSpawns != 0
+		&& getSpawnThreadCountUnlocked() >= maxConcurrentSpawns;
+}
+
+PoolSnapshotPtr
+Pool::createSnapshot(bool lock) const {
+	boost::shared_ptr<PoolSnapshot> result = boost::make_shared<PoolSnapshot>();
+	vector<GroupSnapshot>::iterator it;
+
+	{
+		DynamicPoolScopedLock l(syncher, lock);
+		vector<GetWaiter>::const_iterator w_it, w_end = getWaitlist.end();
+		GroupMap::ConstIterator g_it(groups);
+
+		result->version = ++lastSnapshotVersion;
+		result->createdAt = SystemTime::getMonotonicUsec();
+		result->max = max;
+		result->processCount = getProcessCount(false);
+		result->capacityUsed = capacityUsedUnlocked();
+		for (w_it = getWaitlist.begin(); w_it != w_end; w_it++) {
+			result->getWaitlist.push_back(w_it->options.getAppGroupName());
+		}
+
+		result->groups.resize(groups.size());
+		it = result->groups.begin();
+		while (*g_it != NULL) {
+			g_it.getValue()->snapshot(*it);
+			it++;
+			g_it.next();
+		}
+	}
+
+	// Looking up users may be slow, so do it after unlocking.
+	for (it = result->groups.begin(); it != result->groups.end(); it++) {
+		it->finalize();
+	}
+	return result;
+}
+
+
+/****************************
+ *
+ * Public methods
+ *
+ ****************************/
+
+
+string
+Pool::inspect(const InspectOptions &options, bool lock) const {
+	return createSnapshot(lock)->inspect(options);
+}
+
+string
+Pool::toXml(const ToXmlOptions &options, bool lock) const {
+	return createSnapshot(lock)->toXml(options);
+}
+
+/**
+ * Returns a snapshot of the pool's state, for state inspection without
+ * holding the pool lock. Snapshots are reused until they're older than the
+ * maximum age (see `setSnapshotMaxAge()`), so frequent state inspection
+ * (e.g. by monitoring tools) only copies the pool's state at a bounded rate.
+ * While one thread replaces an expired snapshot, other threads keep getting
+ * the expired one instead of waiting.
+ */
+PoolSnapshotPtr
+Pool::getSnapshot() {
+	boost::unique_lock<boost::mutex> l(snapshotSyncher);
+	if (snapshot != NULL
+	 && (creatingSnapshot
+		|| SystemTime::getMonotonicUsec() - snapshot->createdAt < snapshotMaxAge.load()))
+	{
+		return snapshot;
+	}
+
+	PoolSnapshotPtr result;
+	creatingSnapshot = true;
+	l.unlock();
+	try {
+		result = createSnapshot(true);
+	} catch (...) {
+		l.lock();
+		creatingSnapshot = false;
+		throw;
+	}
+	l.lock();
+	creatingSnapshot = false;
+	if (snapshot == NULL || snapshot->version < result->version) {
+		snapshot = result;
+	}
+	return result;
+}
+
+/**
+ * Sets the maximum age (in microseconds) of the snapshots returned by
+ * `getSnapshot()`. 0 means that every call takes a new snapshot.
+ */
+void
+Pool::setSnapshotMaxAge(unsigned long long value) {
+	snapshotMaxAge.store(value);
+}
+
+
+unsigned int
+Pool::capacityUsed() const {
+	PoolLockGuard l(syncher);
+	return capacityUsedUnlocked();
+}
+
+bool
+Pool::atFullCapacity() const {
+	PoolLockGuard l(syncher);
+	return atFullCapacityUnlocked();
+}
+
+/**
+ * Returns the total number of processes in the pool, including all disabling and
+ * disabled processes, but excluding processes that are shutting down and excluding
+ * processes that are being spawned.
+ */
+unsigned int
+Pool::getProcessCount(bool lock) const {
+	DynamicPoolScopedLock l(syncher, lock);
+	unsigned int result = 0;
+	GroupMap::ConstIterator g_it(groups);
+	while (*g_it != NULL) {
+		const GroupPtr &group = g_it.getValue();
+		result += group->getProcessCount();
+		g_it.next();
+	}
+	return result;
+}
+
+unsigned int
+Pool::getGroupCount() const {
+	PoolLockGuard l(syncher);
+	return groups.size();
+}
+
+
+/****************************
+ *
+ * PoolSnapshot
+ *
+ ****************************/
+
+
 void
-Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
-	const Group *group, const ProcessList &processes) const
+PoolSnapshot::inspectProcessList(const Pool::InspectOptions &options, stringstream &result,
+	const GroupSnapshot &group, const vector<ProcessSnapshot> &processes) const
 {
-	ProcessList::const_iterator p_it;
+	vector<ProcessSnapshot>::const_iterator p_it;
 	for (p_it = processes.begin(); p_it != processes.end(); p_it++) {
-		const ProcessPtr &process = *p_it;
-		char buf[128];
+		const ProcessSnapshot *process = &(*p_it);
+		char buf[256];
 		char cpubuf[10];
 		char membuf[10];
 
@@ -90,7 +244,7 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 		snprintf(buf, sizeof(buf),
 			"  * PID: %-5lu   Sessions: %-2u      Processed: %-5u   Uptime: %s\n"
 			"    CPU: %-5s   Memory  : %-5s   Last used: %s ago",
-			(unsigned long) process->getPid(),
+			(unsigned long) process->pid,
 			process->sessions,
 			process->processed,
 			process->uptime().c_str(),
@@ -107,31 +261,64 @@ Pool::inspectProcessList(const InspectOptions &options, stringstream &result,
 			result << "    Shutting down..." << endl;
 		}
 
-		const Socket *socket;
-		if (options.verbose && (socket = process->getSockets().findSocketWithName("http")) != NULL) {
+		const ProcessSnapshot::SocketSnapshot *socket;
+		if (options.verbose && (socket = process->findSocketWithName("http")) != NULL) {
 			result << "    URL     : http://" << replaceString(socket->address, "tcp://", "") << endl;
-			result << "    Password: " << group->getApiKey().toStaticString() << endl;
+			result << "    Password: " << group.apiKey.toStaticString() << endl;
+		}
+		if (options.verbose) {
+			const SpawningKit::SpawnTimings &timings = process->spawnTimings;
+			snprintf(buf, sizeof(buf),
+				"    Spawn   : preparation %.1fms, preloader start %.1fms, fork %.1fms, "
+				"handshake %.1fms, app startup %.1fms",
+				timings.preparation / 1000.0,
+				timings.preloaderStart / 1000.0,
+				timings.fork / 1000.0,
+				timings.handshake / 1000.0,
+				timings.appStartup / 1000.0);
+			result << buf << endl;
 		}
 	}
 }
 
+bool
+PoolSnapshot::authorizeByUid(uid_t uid) const {
+	if (uid == 0 || uid == geteuid()) {
+		return true;
+	}
 
-/****************************
- *
- * Public methods
- *
- ****************************/
+	vector<GroupSnapshot>::const_iterator it;
+	for (it = groups.begin(); it != groups.end(); it++) {
+		if (it->authorizeByUid(uid)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool
+PoolSnapshot::authorizeByApiKey(const ApiKey &key) const {
+	if (key.isSuper()) {
+		return true;
+	}
 
+	vector<GroupSnapshot>::const_iterator it;
+	for (it = groups.begin(); it != groups.end(); it++) {
+		if (it->apiKey == key) {
+			return true;
+		}
+	}
+	return false;
+}
 
 string
-Pool::inspect(const InspectOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+PoolSnapshot::inspect(const Pool::InspectOptions &options) const {
 	stringstream result;
-	const char *headerColor = maybeColorize(options, ANSI_COLOR_YELLOW ANSI_COLOR_BLUE_BG ANSI_COLOR_BOLD);
-	const char *resetColor  = maybeColorize(options, ANSI_COLOR_RESET);
+	const char *headerColor = Pool::maybeColorize(options, ANSI_COLOR_YELLOW ANSI_COLOR_BLUE_BG ANSI_COLOR_BOLD);
+	const char *resetColor  = Pool::maybeColorize(options, ANSI_COLOR_RESET);
 
-	if (!authorizeByUid(options.uid, false)
-	 && !authorizeByApiKey(options.apiKey, false))
+	if (!authorizeByUid(options.uid)
+	 && !authorizeByApiKey(options.apiKey))
 	{
 		throw SecurityException("Operation unauthorized");
 	}
@@ -139,65 +326,80 @@ Pool::inspect(const InspectOptions &options, bool lock) const {
 	result << headerColor << "----------- General information -----------" << resetColor << endl;
 	result << "Max pool size : " << max << endl;
 	result << "App groups    : " << groups.size() << endl;
-	result << "Processes     : " << getProcessCount(false) << endl;
+	result << "Processes     : " << processCount << endl;
 	result << "Requests in top-level queue : " << getWaitlist.size() << endl;
 	if (options.verbose) {
 		unsigned int i = 0;
-		foreach (const GetWaiter &waiter, getWaitlist) {
-			result << "  " << i << ": " << waiter.options.getAppGroupName() << endl;
+		foreach (const string &appGroupName, getWaitlist) {
+			result << "  " << i << ": " << appGroupName << endl;
 			i++;
 		}
 	}
 	result << endl;
 
 	result << headerColor << "----------- Application groups -----------" << resetColor << endl;
-	GroupMap::ConstIterator g_it(groups);
-	while (*g_it != NULL) {
-		const GroupPtr &group = g_it.getValue();
+	vector<GroupSnapshot>::const_iterator g_it;
+	for (g_it = groups.begin(); g_it != groups.end(); g_it++) {
+		const GroupSnapshot *group = &(*g_it);
 		if (!group->authorizeByUid(options.uid)
 		 && !group->authorizeByApiKey(options.apiKey))
 		{
-			g_it.next();
 			continue;
 		}
 
-		ProcessList::const_iterator p_it;
-
-		result << group->getName() << ":" << endl;
+		result << group->name << ":" << endl;
 		result << "  App root: " << group->options.appRoot << endl;
-		if (group->restarting()) {
+		if (group->restarting) {
 			result << "  (restarting...)" << endl;
 		}
-		if (group->spawning()) {
+		if (group->spawning) {
 			if (group->processesBeingSpawned == 0) {
 				result << "  (spawning...)" << endl;
 			} else {
 				result << "  (spawning " << group->processesBeingSpawned << " new " <<
-					maybePluralize(group->processesBeingSpawned, "process", "processes") <<
+					Pool::maybePluralize(group->processesBeingSpawned, "process", "processes") <<
 					"...)" << endl;
 			}
 		}
-		result << "  Requests in queue: " << group->getWaitlist.size() << endl;
-		inspectProcessList(options, result, group.get(), group->enabledProcesses);
-		inspectProcessList(options, result, group.get(), group->disablingProcesses);
-		inspectProcessList(options, result, group.get(), group->disabledProcesses);
-		inspectProcessList(options, result, group.get(), group->detachedProcesses);
+		result << "  Requests in queue: " << group->getWaitlistSize << endl;
+		if (group->queueWaitTimes.getCount() > 0) {
+			char buf[128];
+			snprintf(buf, sizeof(buf), "%.1fms (p50), %.1fms (p99), %.1fms (max)",
+				group->queueWaitTimes.getValueAtPercentile(50) / 1000.0,
+				group->queueWaitTimes.getValueAtPercentile(99) / 1000.0,
+				group->queueWaitTimes.getMax() / 1000.0);
+			result << "  Queue wait time  : " << buf << endl;
+		}
+		if (group->requestsTimedOutInQueue + group->requestsShedFromQueue
+			+ group->requestsAbandonedInQueue > 0)
+		{
+			result << "  Queue drops      : " << group->requestsTimedOutInQueue
+				<< " timed out, " << group->requestsShedFromQueue << " shed, "
+				<< group->requestsAbandonedInQueue << " abandoned" << endl;
+		}
+		if (group->lastSpawnBurstDuration != 0) {
+			char buf[64];
+			snprintf(buf, sizeof(buf), "%.1fs", group->lastSpawnBurstDuration / 1000000.0);
+			result << "  Last scale-up: " << group->lastSpawnBurstProcessCount << " " <<
+				Pool::maybePluralize(group->lastSpawnBurstProcessCount, "process", "processes") <<
+				" in " << buf << endl;
+		}
+		inspectProcessList(options, result, *group, group->enabledProcesses);
+		inspectProcessList(options, result, *group, group->disablingProcesses);
+		inspectProcessList(options, result, *group, group->disabledProcesses);
+		inspectProcessList(options, result, *group, group->detachedProcesses);
 		result << endl;
-
-		g_it.next();
 	}
 	return result.str();
 }
 
 string
-Pool::toXml(const ToXmlOptions &options, bool lock) const {
-	DynamicScopedLock l(syncher, lock);
+PoolSnapshot::toXml(const Pool::ToXmlOptions &options) const {
 	stringstream result;
-	GroupMap::ConstIterator g_it(groups);
-	ProcessList::const_iterator p_it;
+	vector<GroupSnapshot>::const_iterator g_it;
 
-	if (!authorizeByUid(options.uid, false)
-	 && !authorizeByApiKey(options.apiKey, false))
+	if (!authorizeByUid(options.uid)
+	 && !authorizeByApiKey(options.apiKey))
 	{
 		throw SecurityException("Operation unauthorized");
 	}
@@ -207,41 +409,39 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 
 	result << "<passenger_version>" << PASSENGER_VERSION << "</passenger_version>";
 	result << "<group_count>" << groups.size() << "</group_count>";
-	result << "<process_count>" << getProcessCount(false) << "</process_count>";
+	result << "<process_count>" << processCount << "</process_count>";
 	result << "<max>" << max << "</max>";
-	result << "<capacity_used>" << capacityUsedUnlocked() << "</capacity_used>";
+	result << "<capacity_used>" << capacityUsed << "</capacity_used>";
 	result << "<get_wait_list_size>" << getWaitlist.size() << "</get_wait_list_size>";
 
 	if (options.secrets) {
-		vector<GetWaiter>::const_iterator w_it, w_end = getWaitlist.end();
+		vector<string>::const_iterator w_it, w_end = getWaitlist.end();
 
 		result << "<get_wait_list>";
 		for (w_it = getWaitlist.begin(); w_it != w_end; w_it++) {
-			const GetWaiter &waiter = *w_it;
 			result << "<item>";
-			result << "<app_group_name>" << escapeForXml(waiter.options.getAppGroupName()) << "</app_group_name>";
+			result << "<app_group_name>" << escapeForXml(*w_it) << "</app_group_name>";
 			result << "</item>";
 		}
 		result << "</get_wait_list>";
 	}
 
 	result << "<supergroups>";
-	while (*g_it != NULL) {
-		const GroupPtr &group = g_it.getValue();
+	for (g_it = groups.begin(); g_it != groups.end(); g_it++) {
+		const GroupSnapshot *group = &(*g_it);
 		if (!group->authorizeByUid(options.uid)
 		 && !group->authorizeByApiKey(options.apiKey))
 		{
-			g_it.next();
 			continue;
 		}
 
 		result << "<supergroup>";
-		result << "<name>" << escapeForXml(group->getName()) << "</name>";
+		result << "<name>" << escapeForXml(group->name) << "</name>";
 		result << "<state>READY</state>";
 		result << "<get_wait_list_size>0</get_wait_list_size>";
-		result << "<capacity_used>" << group->capacityUsed() << "</capacity_used>";
+		result << "<capacity_used>" << group->capacityUsed << "</capacity_used>";
 		if (options.secrets) {
-			result << "<secret>" << escapeForXml(group->getApiKey().toStaticString()) << "</secret>";
+			result << "<secret>" << escapeForXml(group->apiKey.toStaticString()) << "</secret>";
 		}
 
 		result << "<group default=\"true\">";
@@ -249,8 +449,6 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 		result << "</group>";
 
 		result << "</supergroup>";
-
-		g_it.next();
 	}
 	result << "</supergroups>";
 
@@ -259,42 +457,5 @@ Pool::toXml(const ToXmlOptions &options, bool lock) const {
 }
 
 
-unsigned int
-Pool::capacityUsed() const {
-	LockGuard l(syncher);
-	return capacityUsedUnlocked();
-}
-
-bool
-Pool::atFullCapacity() const {
-	LockGuard l(syncher);
-	return atFullCapacityUnlocked();
-}
-
-/**
- * Returns the total number of processes in the pool, including all disabling and
- * disabled processes, but excluding processes that are shutting down and excluding
- * processes that are being spawned.
- */
-unsigned int
-Pool::getProcessCount(bool lock) const {
-	DynamicScopedLock l(syncher, lock);
-	unsigned int result = 0;
-	GroupMap::ConstIterator g_it(groups);
-	while (*g_it != NULL) {
-		const GroupPtr &group = g_it.getValue();
-		result += group->getProcessCount();
-		g_it.next();
-	}
-	return result;
-}
-
-unsigned int
-Pool::getGroupCount() const {
-	LockGuard l(syncher);
-	return groups.size();
-}
-
-
 } // namespace ApplicationPool2
 } // namespace Passenger
@@ -159,6 +159,9 @@ private:
 	 */
 	unsigned long long spawnEndTime;
 
+	/** How long the individual stages of spawning this process took. */
+	SpawningKit::SpawnTimings spawnTimings;
+
 	/**
 	 * If true, then indicates that this Process does not refer to a real OS
 	 * process. The sockets in the socket list are fake and need not be deleted,
@@ -220,6 +223,19 @@ private:
 		buffer.append(1, '\0');
 	}
 
+	void initializeSpawnTimings(const Json::Value &json) {
+		if (!json.isMember("spawn_timings")) {
+			return;
+		}
+
+		const Json::Value &timings = json["spawn_timings"];
+		spawnTimings.preparation = getJsonUint64Field(timings, "preparation", 0);
+		spawnTimings.preloaderStart = getJsonUint64Field(timings, "preloader_start", 0);
+		spawnTimings.fork = getJsonUint64Field(timings, "fork", 0);
+		spawnTimings.handshake = getJsonUint64Field(timings, "handshake", 0);
+		spawnTimings.appStartup = getJsonUint64Field(timings, "app_startup", 0);
+	}
+
 	void initializeSocketsAndStringFields(const Json::Value &json) {
 		InitializationLog log;
 		string buffer;
@@ -447,6 +463,7 @@ public:
 	{
 		initializeSocketsAndStringFields(json);
 		indexSessionSockets();
+		initializeSpawnTimings(json);
 
 		const SpawningKit::Result *skResult = dynamic_cast<const SpawningKit::Result *>(&json);
 		if (skResult != NULL) {
@@ -629,6 +646,10 @@ public:
 		return spawnerCreationTime;
 	}
 
+	const SpawningKit::SpawnTimings &getSpawnTimings() const {
+		return spawnTimings;
+	}
+
 	bool isDummy() const {
 		return dummy;
 	}
@@ -820,18 +841,84 @@ public:
 		return result.str();
 	}
 
+	void snapshot(ProcessSnapshot &snapshot) const;
+
+	template<typename Stream>
+	void inspectXml(Stream &stream, bool includeSockets = true) const;
+};
+
+
+/**
+ * A copy of the inspectable state of a Process. It's taken with the pool
+ * lock held, and can be formatted after the lock has been released.
+ */
+struct ProcessSnapshot {
+	struct SocketSnapshot {
+		string name;
+		string address;
+		string protocol;
+		int concurrency;
+		int sessions;
+		int connections;
+		int idleConnections;
+		boost::uint64_t poolHits;
+		boost::uint64_t poolMisses;
+		boost::uint64_t connects;
+		boost::uint64_t averageConnectTime;
+		boost::uint64_t maxConnectTime;
+	};
+
+	pid_t pid;
+	unsigned int stickySessionId;
+	string gupid;
+	int concurrency;
+	int sessions;
+	int busyness;
+	unsigned int processed;
+	unsigned long long spawnerCreationTime;
+	unsigned long long spawnStartTime;
+	unsigned long long spawnEndTime;
+	SpawningKit::SpawnTimings spawnTimings;
+	unsigned long long lastUsed;
+	string codeRevision;
+	Process::LifeStatus lifeStatus;
+	Process::EnabledStatus enabled;
+	ProcessMetrics metrics;
+	vector<SocketSnapshot> sockets;
+
+	string uptime() const {
+		return distanceOfTimeInWords(spawnEndTime / 1000000);
+	}
+
+	const SocketSnapshot *findSocketWithName(const StaticString &name) const {
+		vector<SocketSnapshot>::const_iterator it;
+		for (it = sockets.begin(); it != sockets.end(); it++) {
+			if (it->name == name) {
+				return &(*it);
+			}
+		}
+		return NULL;
+	}
+
 	template<typename Stream>
 	void inspectXml(Stream &stream, bool includeSockets = true) const {
-		stream << "<pid>" << getPid() << "</pid>";
-		stream << "<sticky_session_id>" << getStickySessionId() << "</sticky_session_id>";
-		stream << "<gupid>" << getGupid() << "</gupid>";
+		stream << "<pid>" << pid << "</pid>";
+		stream << "<sticky_session_id>" << stickySessionId << "</sticky_session_id>";
+		stream << "<gupid>" << gupid << "</gupid>";
 		stream << "<concurrency>" << concurrency << "</concurrency>";
 		stream << "<sessions>" << sessions << "</sessions>";
-		stream << "<busyness>" << busyness() << "</busyness>";
+		stream << "<busyness>" << busyness << "</busyness>";
 		stream << "<processed>" << processed << "</processed>";
 		stream << "<spawner_creation_time>" << spawnerCreationTime << "</spawner_creation_time>";
 		stream << "<spawn_start_time>" << spawnStartTime << "</spawn_start_time>";
 		stream << "<spawn_end_time>" << spawnEndTime << "</spawn_end_time>";
+		stream << "<spawn_timings>";
+		stream << "<preparation>" << spawnTimings.preparation << "</preparation>";
+		stream << "<preloader_start>" << spawnTimings.preloaderStart << "</preloader_start>";
+		stream << "<fork>" << spawnTimings.fork << "</fork>";
+		stream << "<handshake>" << spawnTimings.handshake << "</handshake>";
+		stream << "<app_startup>" << spawnTimings.appStartup << "</app_startup>";
+		stream << "</spawn_timings>";
 		stream << "<last_used>" << lastUsed << "</last_used>";
 		stream << "<last_used_desc>" << distanceOfTimeInWords(lastUsed / 1000000).c_str() << " ago</last_used_desc>";
 		stream << "<uptime>" << uptime() << "</uptime>";
@@ -839,29 +926,29 @@ public:
 			stream << "<code_revision>" << escapeForXml(codeRevision) << "</code_revision>";
 		}
 		switch (lifeStatus) {
-		case ALIVE:
+		case Process::ALIVE:
 			stream << "<life_status>ALIVE</life_status>";
 			break;
-		case SHUTDOWN_TRIGGERED:
+		case Process::SHUTDOWN_TRIGGERED:
 			stream << "<life_status>SHUTDOWN_TRIGGERED</life_status>";
 			break;
-		case DEAD:
+		case Process::DEAD:
 			stream << "<life_status>DEAD</life_status>";
 			break;
 		default:
 			P_BUG("Unknown 'lifeStatus' state " << (int) lifeStatus);
 		}
 		switch (enabled) {
-		case ENABLED:
+		case Process::ENABLED:
 			stream << "<enabled>ENABLED</enabled>";
 			break;
-		case DISABLING:
+		case Process::DISABLING:
 			stream << "<enabled>DISABLING</enabled>";
 			break;
-		case DISABLED:
+		case Process::DISABLED:
 			stream << "<enabled>DISABLED</enabled>";
 			break;
-		case DETACHED:
+		case Process::DETACHED:
 			stream << "<enabled>DETACHED</enabled>";
 			break;
 		default:
@@ -880,17 +967,24 @@ public:
 			stream << "<command>" << escapeForXml(metrics.command) << "</command>";
 		}
 		if (includeSockets) {
-			SocketList::const_iterator it;
+			vector<SocketSnapshot>::const_iterator it;
 
 			stream << "<sockets>";
 			for (it = sockets.begin(); it != sockets.end(); it++) {
-				const Socket &socket = *it;
+				const SocketSnapshot &socket = *it;
 				stream << "<socket>";
 				stream << "<name>" << escapeForXml(socket.name) << "</name>";
 				stream << "<address>" << escapeForXml(socket.address) << "</address>";
 				stream << "<protocol>" << escapeForXml(socket.protocol) << "</protocol>";
 				stream << "<concurrency>" << socket.concurrency << "</concurrency>";
 				stream << "<sessions>" << socket.sessions << "</sessions>";
+				stream << "<connections>" << socket.connections << "</connections>";
+				stream << "<idle_connections>" << socket.idleConnections << "</idle_connections>";
+				stream << "<connection_pool_hits>" << socket.poolHits << "</connection_pool_hits>";
+				stream << "<connection_pool_misses>" << socket.poolMisses << "</connection_pool_misses>";
+				stream << "<connects>" << socket.connects << "</connects>";
+				stream << "<avg_connect_time>" << socket.averageConnectTime << "</avg_connect_time>";
+				stream << "<max_connect_time>" << socket.maxConnectTime << "</max_connect_time>";
 				stream << "</socket>";
 			}
 			stream << "</sockets>";
@@ -899,6 +993,56 @@ public:
 };
 
 
+inline void
+Process::snapshot(ProcessSnapshot &snapshot) const {
+	SocketList::const_iterator it;
+
+	snapshot.pid = getPid();
+	snapshot.stickySessionId = getStickySessionId();
+	snapshot.gupid = getGupid();
+	snapshot.concurrency = concurrency;
+	snapshot.sessions = sessions;
+	snapshot.busyness = busyness();
+	snapshot.processed = processed;
+	snapshot.spawnerCreationTime = spawnerCreationTime;
+	snapshot.spawnStartTime = spawnStartTime;
+	snapshot.spawnEndTime = spawnEndTime;
+	snapshot.spawnTimings = spawnTimings;
+	snapshot.lastUsed = lastUsed;
+	snapshot.codeRevision = codeRevision;
+	snapshot.lifeStatus = lifeStatus;
+	snapshot.enabled = enabled;
+	snapshot.metrics = metrics;
+
+	snapshot.sockets.resize(sockets.size());
+	for (it = sockets.begin(); it != sockets.end(); it++) {
+		const Socket &socket = *it;
+		ProcessSnapshot::SocketSnapshot &socketSnapshot =
+			snapshot.sockets[it - sockets.begin()];
+		socketSnapshot.name = socket.name;
+		socketSnapshot.address = socket.address;
+		socketSnapshot.protocol = socket.protocol;
+		socketSnapshot.concurrency = socket.concurrency;
+		socketSnapshot.sessions = socket.sessions;
+		socketSnapshot.connections = socket.totalConnections.load();
+		socketSnapshot.idleConnections = socket.totalIdleConnections.load();
+		socketSnapshot.poolHits = socket.getPoolHits();
+		socketSnapshot.poolMisses = socket.getPoolMisses();
+		socketSnapshot.connects = socket.getConnectCount();
+		socketSnapshot.averageConnectTime = socket.getAverageConnectTime();
+		socketSnapshot.maxConnectTime = socket.getMaxConnectTime();
+	}
+}
+
+template<typename Stream>
+inline void
+Process::inspectXml(Stream &stream, bool includeSockets) const {
+	ProcessSnapshot snapshot;
+	this->snapshot(snapshot);
+	snapshot.inspectXml(stream, includeSockets);
+}
+
+
 inline void
 intrusive_ptr_add_ref(const Process *process) {
 	process->ref();
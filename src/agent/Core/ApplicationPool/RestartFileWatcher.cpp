@@ -0,0 +1,640 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <oxt/system_calls.hpp>
+#include <oxt/backtrace.hpp>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#ifdef __linux__
+	#include <sys/inotify.h>
+	#include <sys/vfs.h>
+#endif
+#include <Logging.h>
+#include <Constants.h>
+#include <Utils/SystemTime.h>
+#include <Core/ApplicationPool/RestartFileWatcher.h>
+
+/*************************************************************************
+ *
+ * Implementation of ApplicationPool2::RestartFileWatcher
+ *
+ *************************************************************************/
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+using namespace boost;
+using namespace oxt;
+
+
+static RestartFileWatcher::StatFunction restartFileStatFunction = syscalls::stat;
+
+#ifdef __linux__
+	static const uint32_t RESTART_DIR_EVENTS = IN_ONLYDIR | IN_ATTRIB | IN_CLOSE_WRITE
+		| IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO;
+#endif
+
+
+/**
+ * inotify only sees changes that are made through the local kernel, so
+ * restart.txt being touched on another NFS or CIFS client (e.g. the deploy
+ * host) would go unnoticed. Such directories must be checked with stat().
+ */
+static bool
+isOnNetworkFilesystem(const string &dir) {
+	#ifdef __linux__
+		struct statfs buf;
+
+		if (statfs(dir.c_str(), &buf) == -1) {
+			return false;
+		}
+		switch ((uint32_t) buf.f_type) {
+		case 0x6969:     // NFS_SUPER_MAGIC
+		case 0xFF534D42: // CIFS_MAGIC_NUMBER
+		case 0x517B:     // SMB_SUPER_MAGIC
+		case 0xFE534D42: // SMB2_MAGIC_NUMBER
+		case 0x65735546: // FUSE_SUPER_MAGIC
+			return true;
+		default:
+			return false;
+		}
+	#else
+		return false;
+	#endif
+}
+
+
+/****************************
+ *
+ * Private methods
+ *
+ ****************************/
+
+
+/**
+ * Lazily creates the inotify instance and the background thread. Returns
+ * whether watches can be activated.
+ *
+ * Must be called while holding the lock.
+ */
+bool
+RestartFileWatcher::initialize() {
+	#ifdef __linux__
+		if (!enabled || shuttingDown) {
+			return false;
+		} else if (fd != -1) {
+			return true;
+		}
+
+		fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd == -1) {
+			int e = errno;
+			P_WARN("Unable to initialize inotify: " << strerror(e) << " (errno=" << e
+				<< "). Falling back to checking restart.txt with stat()");
+			enabled = false;
+			return false;
+		}
+
+		thread = new oxt::thread(
+			boost::bind(&RestartFileWatcher::threadMain, this),
+			"Restart file watcher",
+			POOL_HELPER_THREAD_STACK_SIZE);
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+/**
+ * Starts monitoring the watch's directory. On success, adds the watch to
+ * `activeWatches`, but leaves it to the caller to check the restart files and
+ * to set the `active` flag. Fails for directories on network filesystems.
+ *
+ * Must be called while holding the lock.
+ */
+bool
+RestartFileWatcher::activate(const RestartFileWatchPtr &watch) {
+	#ifdef __linux__
+		struct stat before, after;
+		int wd;
+
+		if (restartFileStatFunction(watch->dir.c_str(), &before) == -1
+		 || isOnNetworkFilesystem(watch->dir))
+		{
+			return false;
+		}
+
+		wd = inotify_add_watch(fd, watch->dir.c_str(), RESTART_DIR_EVENTS);
+		if (wd == -1) {
+			int e = errno;
+			if (e == ENOSPC && !warnedAboutWatchLimit) {
+				P_WARN("The inotify watch limit has been reached, so restart.txt "
+					"of some applications will be checked with stat() instead. "
+					"Consider increasing fs.inotify.max_user_watches");
+				warnedAboutWatchLimit = true;
+			}
+			return false;
+		}
+
+		if (restartFileStatFunction(watch->dir.c_str(), &after) == -1
+		 || after.st_dev != before.st_dev
+		 || after.st_ino != before.st_ino)
+		{
+			// The directory was replaced while we were adding the watch,
+			// so we may be monitoring the wrong one.
+			if (activeWatches.find(wd) == activeWatches.end()) {
+				inotify_rm_watch(fd, wd);
+			}
+			return false;
+		}
+
+		watch->wd = wd;
+		watch->dev = after.st_dev;
+		watch->ino = after.st_ino;
+		activeWatches[wd].push_back(watch);
+		return true;
+	#else
+		return false;
+	#endif
+}
+
+/**
+ * Moves all watches on the given inotify watch descriptor to
+ * `inactiveWatches`. Used when the kernel has removed the inotify watch,
+ * e.g. because the directory was deleted.
+ *
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::deactivateAll(int wd) {
+	WatchMap::iterator it = activeWatches.find(wd);
+	if (it == activeWatches.end()) {
+		return;
+	}
+
+	vector<RestartFileWatchPtr> &watches = it->second;
+	vector<RestartFileWatchPtr>::iterator w_it, w_end = watches.end();
+	for (w_it = watches.begin(); w_it != w_end; w_it++) {
+		(*w_it)->active.store(false, boost::memory_order_release);
+		(*w_it)->wd = -1;
+		inactiveWatches.push_back(*w_it);
+	}
+	activeWatches.erase(it);
+}
+
+/**
+ * Makes all watches inactive, so that the Groups fall back to stat().
+ *
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::deactivateEverything() {
+	while (!activeWatches.empty()) {
+		int wd = activeWatches.begin()->first;
+		deactivateAll(wd);
+		#ifdef __linux__
+			inotify_rm_watch(fd, wd);
+		#endif
+	}
+}
+
+/**
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::removeActiveWatch(const RestartFileWatchPtr &watch) {
+	WatchMap::iterator it = activeWatches.find(watch->wd);
+	if (it == activeWatches.end()) {
+		return;
+	}
+
+	vector<RestartFileWatchPtr> &watches = it->second;
+	watches.erase(std::remove(watches.begin(), watches.end(), watch),
+		watches.end());
+	if (watches.empty()) {
+		activeWatches.erase(it);
+		#ifdef __linux__
+			inotify_rm_watch(fd, watch->wd);
+		#endif
+	}
+	watch->wd = -1;
+}
+
+/**
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::removeInactiveWatch(const RestartFileWatchPtr &watch) {
+	inactiveWatches.erase(std::remove(inactiveWatches.begin(),
+		inactiveWatches.end(), watch), inactiveWatches.end());
+}
+
+/**
+ * Sets `restartPending` if restart.txt has been created or if its mtime has
+ * changed, just like Group::needsRestart() would have concluded when
+ * checking the file with stat(). If `baselineOnly` is true, only the current
+ * mtime is recorded.
+ *
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::checkRestartFile(RestartFileWatch *watch, bool baselineOnly) {
+	struct stat buf;
+	time_t mtime;
+	time_t previousMtime = watch->lastRestartFileMtime.load(boost::memory_order_relaxed);
+
+	if (restartFileStatFunction(watch->restartFile.c_str(), &buf) == 0) {
+		mtime = buf.st_mtime;
+	} else {
+		mtime = 0;
+	}
+	watch->lastRestartFileMtime.store(mtime, boost::memory_order_relaxed);
+	if (!baselineOnly && mtime != 0 && mtime != previousMtime) {
+		watch->restartPending.store(true, boost::memory_order_release);
+	}
+}
+
+/**
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::checkAlwaysRestartFile(RestartFileWatch *watch) {
+	struct stat buf;
+	watch->alwaysRestartFileExists.store(
+		restartFileStatFunction(watch->alwaysRestartFile.c_str(), &buf) == 0,
+		boost::memory_order_release);
+}
+
+/**
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::processEvents(const char *buf, size_t size) {
+	#ifdef __linux__
+		const char *pos = buf;
+		const char *end = buf + size;
+
+		while (pos < end) {
+			const struct inotify_event *event = (const struct inotify_event *) pos;
+			pos += sizeof(struct inotify_event) + event->len;
+
+			if (event->mask & IN_Q_OVERFLOW) {
+				// Events have been lost, so we don't know which
+				// restart files have changed.
+				rescan();
+				continue;
+			}
+
+			WatchMap::iterator it = activeWatches.find(event->wd);
+			if (it == activeWatches.end()) {
+				continue;
+			} else if (event->mask & IN_IGNORED) {
+				deactivateAll(event->wd);
+				continue;
+			} else if (event->len == 0) {
+				continue;
+			}
+
+			// Group always names the restart files like this.
+			bool isRestartFile = strcmp(event->name, "restart.txt") == 0;
+			bool isAlwaysRestartFile = !isRestartFile
+				&& strcmp(event->name, "always_restart.txt") == 0;
+			if (!isRestartFile && !isAlwaysRestartFile) {
+				continue;
+			}
+
+			vector<RestartFileWatchPtr> &watches = it->second;
+			vector<RestartFileWatchPtr>::iterator w_it, w_end = watches.end();
+			for (w_it = watches.begin(); w_it != w_end; w_it++) {
+				if (isRestartFile) {
+					checkRestartFile(w_it->get(), false);
+				} else {
+					checkAlwaysRestartFile(w_it->get());
+				}
+			}
+		}
+	#endif
+}
+
+/**
+ * Must be called while holding the lock.
+ */
+void
+RestartFileWatcher::rescan() {
+	WatchMap::iterator it, end = activeWatches.end();
+	for (it = activeWatches.begin(); it != end; it++) {
+		vector<RestartFileWatchPtr> &watches = it->second;
+		vector<RestartFileWatchPtr>::iterator w_it, w_end = watches.end();
+		for (w_it = watches.begin(); w_it != w_end; w_it++) {
+			checkRestartFile(w_it->get(), false);
+			checkAlwaysRestartFile(w_it->get());
+		}
+	}
+}
+
+/**
+ * Checks whether the directories of active watches have been replaced (in
+ * which case we're monitoring a stale directory), and whether the
+ * directories of inactive watches have appeared. The directories are
+ * stat()ed without holding the lock, so that slow filesystems don't block
+ * watch() and unwatch().
+ */
+void
+RestartFileWatcher::revalidate() {
+	TRACE_POINT();
+	vector<RestartFileWatchPtr> watches;
+	vector<RestartFileWatchPtr> changed;
+	vector<dev_t> devs;
+	vector<ino_t> inos;
+	unsigned int i;
+
+	{
+		boost::lock_guard<boost::mutex> l(syncher);
+		WatchMap::const_iterator it, end = activeWatches.end();
+		for (it = activeWatches.begin(); it != end; it++) {
+			const vector<RestartFileWatchPtr> &activeList = it->second;
+			for (i = 0; i < activeList.size(); i++) {
+				watches.push_back(activeList[i]);
+				devs.push_back(activeList[i]->dev);
+				inos.push_back(activeList[i]->ino);
+			}
+		}
+		for (i = 0; i < inactiveWatches.size(); i++) {
+			watches.push_back(inactiveWatches[i]);
+			devs.push_back(0);
+			inos.push_back(0);
+		}
+	}
+
+	UPDATE_TRACE_POINT();
+	for (i = 0; i < watches.size(); i++) {
+		struct stat buf;
+		int ret;
+
+		boost::this_thread::interruption_point();
+		ret = restartFileStatFunction(watches[i]->dir.c_str(), &buf);
+		if (devs[i] == 0 && inos[i] == 0) {
+			// Inactive watch.
+			if (ret == 0) {
+				changed.push_back(watches[i]);
+			}
+		} else if (ret == -1 || buf.st_dev != devs[i] || buf.st_ino != inos[i]) {
+			changed.push_back(watches[i]);
+		}
+	}
+	if (changed.empty()) {
+		return;
+	}
+
+	UPDATE_TRACE_POINT();
+	boost::lock_guard<boost::mutex> l(syncher);
+	for (i = 0; i < changed.size(); i++) {
+		const RestartFileWatchPtr &watch = changed[i];
+
+		if (!watch->registered || shuttingDown) {
+			continue;
+		} else if (watch->active.load(boost::memory_order_relaxed)) {
+			// The directory has been replaced. Its restart.txt may have
+			// been touched already, so compare it against the mtime that
+			// we knew.
+			removeActiveWatch(watch);
+			if (activate(watch)) {
+				checkRestartFile(watch.get(), false);
+				checkAlwaysRestartFile(watch.get());
+			} else {
+				watch->active.store(false, boost::memory_order_release);
+				inactiveWatches.push_back(watch);
+			}
+		} else if (activate(watch)) {
+			// The Group has been checking the restart files itself
+			// in the mean time, so only record the baseline.
+			removeInactiveWatch(watch);
+			checkRestartFile(watch.get(), true);
+			checkAlwaysRestartFile(watch.get());
+			watch->active.store(true, boost::memory_order_release);
+		}
+	}
+}
+
+void
+RestartFileWatcher::threadMain() {
+	#ifdef __linux__
+		TRACE_POINT();
+		union {
+			struct inotify_event event;
+			char data[16 * 1024];
+		} buf;
+		unsigned long long lastRevalidationTime = SystemTime::getMonotonicUsec();
+
+		try {
+			while (true) {
+				struct pollfd pfd;
+				int ret;
+
+				UPDATE_TRACE_POINT();
+				pfd.fd = fd;
+				pfd.events = POLLIN;
+				pfd.revents = 0;
+				ret = syscalls::poll(&pfd, 1, REVALIDATION_INTERVAL * 1000);
+				if (ret == -1) {
+					int e = errno;
+					P_ERROR("Restart file watcher: poll() failed: " << strerror(e)
+						<< " (errno=" << e << "). Falling back to checking restart.txt "
+						"with stat()");
+					boost::lock_guard<boost::mutex> l(syncher);
+					deactivateEverything();
+					enabled = false;
+					return;
+				} else if (ret > 0) {
+					ssize_t size = syscalls::read(fd, buf.data, sizeof(buf.data));
+					if (size > 0) {
+						boost::lock_guard<boost::mutex> l(syncher);
+						processEvents(buf.data, size);
+					}
+				}
+
+				unsigned long long now = SystemTime::getMonotonicUsec();
+				if (now - lastRevalidationTime >= REVALIDATION_INTERVAL * 1000000ull) {
+					revalidate();
+					lastRevalidationTime = now;
+				}
+			}
+		} catch (const thread_interrupted &) {
+			// Shutting down.
+		}
+	#endif
+}
+
+
+/****************************
+ *
+ * Public methods
+ *
+ ****************************/
+
+
+RestartFileWatcher::RestartFileWatcher()
+	: enabled(true),
+	  shuttingDown(false),
+	  warnedAboutWatchLimit(false),
+	  fd(-1),
+	  thread(NULL)
+	{ }
+
+RestartFileWatcher::~RestartFileWatcher() {
+	shutdown();
+}
+
+/**
+ * Enables or disables restart file watching. Only affects watches that are
+ * created afterwards.
+ */
+void
+RestartFileWatcher::setEnabled(bool enabled) {
+	boost::lock_guard<boost::mutex> l(syncher);
+	this->enabled = enabled;
+}
+
+bool
+RestartFileWatcher::isEnabled() const {
+	boost::lock_guard<boost::mutex> l(syncher);
+	return enabled;
+}
+
+unsigned int
+RestartFileWatcher::getActiveWatchCount() const {
+	boost::lock_guard<boost::mutex> l(syncher);
+	WatchMap::const_iterator it, end = activeWatches.end();
+	unsigned int result = 0;
+	for (it = activeWatches.begin(); it != end; it++) {
+		result += it->second.size();
+	}
+	return result;
+}
+
+/**
+ * Starts monitoring the restart files in the given directory. The returned
+ * watch is never NULL, but it may be inactive, in which case the caller must
+ * check the restart files itself. The caller must call `unwatch()` when it no
+ * longer needs the watch.
+ */
+RestartFileWatchPtr
+RestartFileWatcher::watch(const string &dir, const string &restartFile,
+	const string &alwaysRestartFile)
+{
+	RestartFileWatchPtr watch = boost::make_shared<RestartFileWatch>(dir,
+		restartFile, alwaysRestartFile);
+	boost::lock_guard<boost::mutex> l(syncher);
+
+	if (!initialize()) {
+		return watch;
+	}
+
+	watch->registered = true;
+	if (activate(watch)) {
+		checkRestartFile(watch.get(), true);
+		checkAlwaysRestartFile(watch.get());
+		watch->active.store(true, boost::memory_order_release);
+	} else {
+		inactiveWatches.push_back(watch);
+	}
+	return watch;
+}
+
+void
+RestartFileWatcher::unwatch(const RestartFileWatchPtr &watch) {
+	boost::lock_guard<boost::mutex> l(syncher);
+	if (!watch->registered) {
+		return;
+	}
+
+	if (watch->active.load(boost::memory_order_relaxed)) {
+		removeActiveWatch(watch);
+	} else {
+		removeInactiveWatch(watch);
+	}
+	watch->registered = false;
+	watch->active.store(false, boost::memory_order_release);
+}
+
+/**
+ * Stops the background thread. All watches become inactive. It is safe to
+ * call this method multiple times.
+ */
+void
+RestartFileWatcher::shutdown() {
+	oxt::thread *thr;
+
+	{
+		boost::lock_guard<boost::mutex> l(syncher);
+		shuttingDown = true;
+		thr = thread;
+		thread = NULL;
+	}
+
+	if (thr != NULL) {
+		thr->interrupt_and_join();
+		delete thr;
+	}
+
+	boost::lock_guard<boost::mutex> l(syncher);
+	deactivateEverything();
+	if (fd != -1) {
+		close(fd);
+		fd = -1;
+	}
+}
+
+/**
+ * The stat() function that all restart file checks should use.
+ */
+int
+RestartFileWatcher::statFile(const char *path, struct stat *buf) {
+	return restartFileStatFunction(path, buf);
+}
+
+/**
+ * Sets a stat-emulating function that restart file checks should call
+ * instead of the real stat(). Useful for unit tests and benchmarks. Pass
+ * NULL to restore back to the real stat().
+ */
+void
+RestartFileWatcher::setStatFunction(StatFunction func) {
+	if (func != NULL) {
+		restartFileStatFunction = func;
+	} else {
+		restartFileStatFunction = syscalls::stat;
+	}
+}
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
@@ -0,0 +1,167 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_APPLICATION_POOL2_RESTART_FILE_WATCHER_H_
+#define _PASSENGER_APPLICATION_POOL2_RESTART_FILE_WATCHER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/thread.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <ctime>
+
+namespace Passenger {
+namespace ApplicationPool2 {
+
+using namespace std;
+
+
+/**
+ * The state of a Group's restart.txt and always_restart.txt, as maintained
+ * by the RestartFileWatcher.
+ *
+ * The atomic fields may be read by the Group without any locks. All other
+ * fields are owned by the RestartFileWatcher and are only accessed while
+ * holding its mutex.
+ */
+struct RestartFileWatch {
+	/**
+	 * Whether the RestartFileWatcher is currently monitoring the restart
+	 * directory. If not, then the Group must stat() the restart files itself.
+	 */
+	boost::atomic<bool> active;
+	/**
+	 * Set when restart.txt is created or when its mtime changes. The Group
+	 * clears it when it initiates the restart.
+	 */
+	boost::atomic<bool> restartPending;
+	boost::atomic<bool> alwaysRestartFileExists;
+	/** Only written by the RestartFileWatcher. 0 if restart.txt doesn't exist. */
+	boost::atomic<time_t> lastRestartFileMtime;
+
+	const string dir;
+	const string restartFile;
+	const string alwaysRestartFile;
+
+	bool registered;
+	int wd;
+	dev_t dev;
+	ino_t ino;
+
+	RestartFileWatch(const string &_dir, const string &_restartFile,
+		const string &_alwaysRestartFile)
+		: dir(_dir),
+		  restartFile(_restartFile),
+		  alwaysRestartFile(_alwaysRestartFile),
+		  registered(false),
+		  wd(-1),
+		  dev(0),
+		  ino(0)
+	{
+		active.store(false, boost::memory_order_relaxed);
+		restartPending.store(false, boost::memory_order_relaxed);
+		alwaysRestartFileExists.store(false, boost::memory_order_relaxed);
+		lastRestartFileMtime.store(0, boost::memory_order_relaxed);
+	}
+};
+
+typedef boost::shared_ptr<RestartFileWatch> RestartFileWatchPtr;
+
+
+/**
+ * Monitors the restart directories of all Groups with a single inotify
+ * instance and a single background thread, so that Group::get() only has to
+ * read an atomic flag instead of stat()ing restart.txt and always_restart.txt.
+ *
+ * A watch is only active while its directory is being monitored. Watches are
+ * inactive when inotify is not available (e.g. on non-Linux systems, or when
+ * the inotify watch limit is reached), when restart file watching is
+ * disabled, or when the restart directory does not exist. The Group falls
+ * back to its throttled stat() checks for inactive watches. The background
+ * thread periodically retries inactive watches, and revalidates active ones
+ * so that a restart directory which is swapped out from under us (e.g.
+ * because the app root is a symlink that a deployment tool has updated) is
+ * picked up within REVALIDATION_INTERVAL seconds.
+ *
+ * This class is thread-safe.
+ */
+class RestartFileWatcher {
+public:
+	typedef int (*StatFunction)(const char *path, struct stat *buf);
+
+	static const unsigned int REVALIDATION_INTERVAL = 1;
+
+private:
+	typedef map< int, vector<RestartFileWatchPtr> > WatchMap;
+
+	mutable boost::mutex syncher;
+	bool enabled;
+	bool shuttingDown;
+	bool warnedAboutWatchLimit;
+	int fd;
+	oxt::thread *thread;
+	WatchMap activeWatches;
+	vector<RestartFileWatchPtr> inactiveWatches;
+
+	bool initialize();
+	bool activate(const RestartFileWatchPtr &watch);
+	void deactivateAll(int wd);
+	void deactivateEverything();
+	void removeActiveWatch(const RestartFileWatchPtr &watch);
+	void removeInactiveWatch(const RestartFileWatchPtr &watch);
+	void checkRestartFile(RestartFileWatch *watch, bool baselineOnly);
+	void checkAlwaysRestartFile(RestartFileWatch *watch);
+	void processEvents(const char *buf, size_t size);
+	void rescan();
+	void revalidate();
+	void threadMain();
+
+public:
+	RestartFileWatcher();
+	~RestartFileWatcher();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const;
+	unsigned int getActiveWatchCount() const;
+
+	RestartFileWatchPtr watch(const string &dir, const string &restartFile,
+		const string &alwaysRestartFile);
+	void unwatch(const RestartFileWatchPtr &watch);
+	void shutdown();
+
+	static int statFile(const char *path, struct stat *buf);
+	static void setStatFunction(StatFunction func);
+};
+
+
+} // namespace ApplicationPool2
+} // namespace Passenger
+
+#endif /* _PASSENGER_APPLICATION_POOL2_RESTART_FILE_WATCHER_H_ */
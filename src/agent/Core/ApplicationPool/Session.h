@@ -33,6 +33,8 @@
 #include <oxt/backtrace.hpp>
 #include <Utils/ScopeGuard.h>
 #include <Utils/Lock.h>
+#include <Utils/IOUtils.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Context.h>
 #include <Core/ApplicationPool/BasicProcessInfo.h>
 #include <Core/ApplicationPool/BasicGroupInfo.h>
@@ -85,9 +87,43 @@ private:
 	Socket *socket;
 
 	Connection connection;
+	/** Non-NULL while a non-blocking connect is in progress. */
+	NConnect_State *connectState;
+	MonotonicTimeUsec connectStartTime;
+	MonotonicTimeUsec connectDeadline;
 	mutable boost::atomic<int> refcount;
 	bool closed;
 
+	void abortConnect() {
+		delete connectState;
+		connectState = NULL;
+	}
+
+	InitiateResult driveConnect() {
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		ScopeGuard g2(boost::bind(&Session::abortConnect, this));
+
+		if (socket->continueConnect(*connectState)) {
+			Connection connection = socket->finishConnect(*connectState,
+				connectStartTime);
+			g.clear();
+			this->connection = connection;
+			return INITIATED;
+		}
+
+		g.clear();
+		g2.clear();
+		if (connectState->type == SAT_UNIX) {
+			// Unix domain sockets do not support asynchronous connects on
+			// all platforms: if the backlog is full, connect() fails with
+			// EAGAIN instead of EINPROGRESS, and the socket is writable
+			// right away. So the connect must be retried.
+			return INITIATE_RETRY_LATER;
+		} else {
+			return INITIATE_WAIT_WRITABLE;
+		}
+	}
+
 	void deinitiate(bool success, bool wantKeepAlive) {
 		connection.fail = !success;
 		connection.wantKeepAlive = wantKeepAlive;
@@ -122,6 +158,9 @@ public:
 		: context(_context),
 		  processInfo(_processInfo),
 		  socket(_socket),
+		  connectState(NULL),
+		  connectStartTime(0),
+		  connectDeadline(0),
 		  refcount(1),
 		  closed(false),
 		  onInitiateFailure(NULL),
@@ -130,6 +169,7 @@ public:
 
 	~Session() {
 		TRACE_POINT();
+		abortConnect();
 		// If user doesn't close() explicitly, we penalize performance.
 		if (OXT_LIKELY(initiated())) {
 			deinitiate(false, false);
@@ -196,19 +236,80 @@ public:
 		this->connection = connection;
 	}
 
+	virtual InitiateResult initiateNonBlocking(unsigned long long timeout) {
+		assert(!closed);
+		assert(connectState == NULL);
+		ScopeGuard g(boost::bind(&Session::callOnInitiateFailure, this));
+		Connection connection;
+
+		if (socket->checkoutIdleConnection(connection)) {
+			connection.fail = true;
+			if (connection.blocking) {
+				FdGuard g2(connection.fd, NULL, 0);
+				setNonBlocking(connection.fd);
+				g2.clear();
+				connection.blocking = false;
+			}
+			g.clear();
+			this->connection = connection;
+			return INITIATED;
+		}
+
+		connectState = new NConnect_State();
+		connectStartTime = SystemTime::getMonotonicUsec();
+		connectDeadline = connectStartTime + timeout;
+		try {
+			socket->beginConnect(*connectState);
+		} catch (...) {
+			abortConnect();
+			throw;
+		}
+		g.clear();
+		return driveConnect();
+	}
+
+	virtual InitiateResult continueInitiate() {
+		assert(!closed);
+		assert(connectState != NULL);
+		if (SystemTime::getMonotonicUsec() >= connectDeadline) {
+			abortConnect();
+			callOnInitiateFailure();
+			throw TimeoutException("timed out connecting to the application");
+		}
+		return driveConnect();
+	}
+
+	virtual unsigned long long getConnectTimeRemaining() const {
+		MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+		if (connectState == NULL || now >= connectDeadline) {
+			return 0;
+		} else {
+			return connectDeadline - now;
+		}
+	}
+
 	bool initiated() const {
 		return connection.fd != -1;
 	}
 
 	virtual int fd() const {
 		assert(!closed);
-		return connection.fd;
+		if (connectState != NULL) {
+			if (connectState->type == SAT_UNIX) {
+				return connectState->s_unix.fd;
+			} else {
+				return connectState->s_tcp.fd;
+			}
+		} else {
+			return connection.fd;
+		}
 	}
 
 	/**
 	 * This Session object becomes fully unsable after closing.
 	 */
 	virtual void close(bool success, bool wantKeepAlive = false) {
+		abortConnect();
 		if (OXT_LIKELY(initiated())) {
 			deinitiate(success, wantKeepAlive);
 		}
@@ -31,6 +31,8 @@
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <climits>
 #include <cassert>
 #include <SmallVector.h>
@@ -38,6 +40,7 @@
 #include <StaticString.h>
 #include <MemoryKit/palloc.h>
 #include <Utils/IOUtils.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Common.h>
 
 namespace Passenger {
@@ -74,25 +77,142 @@ struct Connection {
 /**
  * Not thread-safe except for the connection pooling methods, so only use
  * within the ApplicationPool lock.
+ *
+ * The connection pool does not use a lock. Idle connections are kept in a
+ * fixed array of slots (one per allowed idle connection), and checking a
+ * connection in or out only takes a compare-and-swap on a slot. This matters
+ * because connections are checked out from the Controller event loop threads.
  */
 class Socket {
 private:
-	boost::mutex connectionPoolLock;
-	vector<Connection> idleConnections;
+	/**
+	 * Each slot is either EMPTY_SLOT or an encoded idle connection,
+	 * see encodeIdleConnection(). There are connectionPoolLimit() slots.
+	 */
+	boost::atomic<int> *idleSlots;
+
+	// Statistics. Only approximate when read concurrently with updates.
+	boost::atomic<boost::uint64_t> poolHits;
+	boost::atomic<boost::uint64_t> poolMisses;
+	boost::atomic<boost::uint64_t> connects;
+	boost::atomic<boost::uint64_t> totalConnectTime;
+	boost::atomic<boost::uint64_t> maxConnectTime;
+
+	static const int EMPTY_SLOT = -1;
 
 	OXT_FORCE_INLINE
 	int connectionPoolLimit() const {
 		return concurrency;
 	}
 
-	Connection connect() const {
+	static int encodeIdleConnection(const Connection &connection) {
+		return (connection.fd << 1) | (int) connection.blocking;
+	}
+
+	static Connection decodeIdleConnection(int value) {
+		Connection connection;
+		connection.fd = value >> 1;
+		connection.blocking = value & 1;
+		return connection;
+	}
+
+	void allocateIdleSlots() {
+		if (connectionPoolLimit() > 0) {
+			idleSlots = new boost::atomic<int>[connectionPoolLimit()];
+			for (int i = 0; i < connectionPoolLimit(); i++) {
+				idleSlots[i].store(EMPTY_SLOT, boost::memory_order_relaxed);
+			}
+		} else {
+			idleSlots = NULL;
+		}
+	}
+
+	void copyFrom(const Socket &other) {
+		name = other.name;
+		address = other.address;
+		protocol = other.protocol;
+		pid = other.pid;
+		concurrency = other.concurrency;
+		totalConnections.store(other.totalConnections.load());
+		totalIdleConnections.store(other.totalIdleConnections.load());
+		sessions = other.sessions;
+		poolHits.store(other.poolHits.load());
+		poolMisses.store(other.poolMisses.load());
+		connects.store(other.connects.load());
+		totalConnectTime.store(other.totalConnectTime.load());
+		maxConnectTime.store(other.maxConnectTime.load());
+		allocateIdleSlots();
+		for (int i = 0; i < connectionPoolLimit(); i++) {
+			idleSlots[i].store(other.idleSlots[i].load());
+		}
+	}
+
+	bool takeIdleConnection(Connection &connection) {
+		if (totalIdleConnections.load(boost::memory_order_relaxed) <= 0) {
+			return false;
+		}
+		for (int i = 0; i < connectionPoolLimit(); i++) {
+			int value = idleSlots[i].load(boost::memory_order_relaxed);
+			if (value != EMPTY_SLOT
+			 && idleSlots[i].compare_exchange_strong(value, EMPTY_SLOT,
+				boost::memory_order_acquire, boost::memory_order_relaxed))
+			{
+				totalIdleConnections.fetch_sub(1, boost::memory_order_relaxed);
+				connection = decodeIdleConnection(value);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Puts the connection in an empty slot. Incrementing totalIdleConnections
+	 * reserves a slot, but concurrent checkins and checkouts may keep
+	 * moving the empty slot ahead of us. We only make one pass over the
+	 * slots, and return false if we didn't find an empty one.
+	 */
+	bool addIdleConnection(const Connection &connection) {
+		if (totalIdleConnections.fetch_add(1, boost::memory_order_relaxed) >= connectionPoolLimit()) {
+			totalIdleConnections.fetch_sub(1, boost::memory_order_relaxed);
+			return false;
+		}
+
+		int value = encodeIdleConnection(connection);
+		for (int i = 0; i < connectionPoolLimit(); i++) {
+			int expected = EMPTY_SLOT;
+			if (idleSlots[i].load(boost::memory_order_relaxed) == EMPTY_SLOT
+			 && idleSlots[i].compare_exchange_strong(expected, value,
+				boost::memory_order_release, boost::memory_order_relaxed))
+			{
+				return true;
+			}
+		}
+
+		totalIdleConnections.fetch_sub(1, boost::memory_order_relaxed);
+		return false;
+	}
+
+	void recordConnectTime(boost::uint64_t usec) {
+		connects.fetch_add(1, boost::memory_order_relaxed);
+		totalConnectTime.fetch_add(usec, boost::memory_order_relaxed);
+		boost::uint64_t max = maxConnectTime.load(boost::memory_order_relaxed);
+		while (usec > max && !maxConnectTime.compare_exchange_weak(max, usec,
+			boost::memory_order_relaxed))
+		{
+			// Retry.
+		}
+	}
+
+	Connection connect() {
 		Connection connection;
+		MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
 		P_TRACE(3, "Connecting to " << address);
 		connection.fd = connectToServer(address, __FILE__, __LINE__);
 		connection.fail = true;
 		connection.wantKeepAlive = false;
 		connection.blocking = true;
 		P_LOG_FILE_DESCRIPTOR_PURPOSE(connection.fd, "App " << pid << " connection");
+		recordConnectTime(SystemTime::getMonotonicUsec() - startTime);
 		return connection;
 	}
 
@@ -105,20 +225,34 @@ public:
 	int concurrency;
 
 	// Private. In public section as alignment optimization.
-	int totalConnections;
-	int totalIdleConnections;
+	boost::atomic<int> totalConnections;
+	boost::atomic<int> totalIdleConnections;
 
 	/** Invariant: sessions >= 0 */
 	int sessions;
 
 	Socket()
-		: pid(-1),
-		  concurrency(0)
+		: idleSlots(NULL),
+		  poolHits(0),
+		  poolMisses(0),
+		  connects(0),
+		  totalConnectTime(0),
+		  maxConnectTime(0),
+		  pid(-1),
+		  concurrency(0),
+		  totalConnections(0),
+		  totalIdleConnections(0),
+		  sessions(0)
 		{ }
 
 	Socket(pid_t _pid, const StaticString &_name, const StaticString &_address,
 		const StaticString &_protocol, int _concurrency)
-		: name(_name),
+		: poolHits(0),
+		  poolMisses(0),
+		  connects(0),
+		  totalConnectTime(0),
+		  maxConnectTime(0),
+		  name(_name),
 		  address(_address),
 		  protocol(_protocol),
 		  pid(_pid),
@@ -126,96 +260,155 @@ public:
 		  totalConnections(0),
 		  totalIdleConnections(0),
 		  sessions(0)
-		{ }
+	{
+		allocateIdleSlots();
+	}
 
-	Socket(const Socket &other)
-		: idleConnections(other.idleConnections),
-		  name(other.name),
-		  address(other.address),
-		  protocol(other.protocol),
-		  pid(other.pid),
-		  concurrency(other.concurrency),
-		  totalConnections(other.totalConnections),
-		  totalIdleConnections(other.totalIdleConnections),
-		  sessions(other.sessions)
-		{ }
+	Socket(const Socket &other) {
+		copyFrom(other);
+	}
+
+	~Socket() {
+		delete[] idleSlots;
+	}
 
 	Socket &operator=(const Socket &other) {
-		totalConnections = other.totalConnections;
-		totalIdleConnections = other.totalIdleConnections;
-		idleConnections = other.idleConnections;
-		name = other.name;
-		address = other.address;
-		protocol = other.protocol;
-		pid = other.pid;
-		concurrency = other.concurrency;
-		sessions = other.sessions;
+		if (this != &other) {
+			delete[] idleSlots;
+			copyFrom(other);
+		}
 		return *this;
 	}
 
 	/**
-	 * Connect to this socket or reuse an existing connection.
+	 * Connect to this socket or reuse an existing connection. The connect
+	 * is blocking; see checkoutIdleConnection() and beginConnect() for
+	 * the non-blocking alternative.
 	 *
 	 * One MUST call checkinConnection() when one's done using the Connection.
 	 * Failure to do so will result in a resource leak.
 	 */
 	Connection checkoutConnection() {
-		boost::unique_lock<boost::mutex> l(connectionPoolLock);
-
-		if (!idleConnections.empty()) {
-			P_TRACE(3, "Socket " << address << ": checking out connection from connection pool (" <<
-				idleConnections.size() << " -> " << (idleConnections.size() - 1) <<
-				" items). Current total number of connections: " << totalConnections);
-			Connection connection = idleConnections.back();
-			idleConnections.pop_back();
-			totalIdleConnections--;
+		Connection connection;
+		if (checkoutIdleConnection(connection)) {
 			return connection;
 		} else {
-			Connection connection = connect();
-			totalConnections++;
+			poolMisses.fetch_add(1, boost::memory_order_relaxed);
+			connection = connect();
+			int total = totalConnections.fetch_add(1, boost::memory_order_relaxed) + 1;
 			P_TRACE(3, "Socket " << address << ": there are now " <<
-				totalConnections << " total connections");
-			l.unlock();
+				total << " total connections");
 			return connection;
 		}
 	}
 
-	void checkinConnection(Connection &connection) {
-		boost::unique_lock<boost::mutex> l(connectionPoolLock);
+	/**
+	 * Checks out a connection from the connection pool, if there is one.
+	 * Never blocks.
+	 */
+	bool checkoutIdleConnection(Connection &connection) {
+		if (takeIdleConnection(connection)) {
+			poolHits.fetch_add(1, boost::memory_order_relaxed);
+			P_TRACE(3, "Socket " << address << ": checked out connection from connection pool. " <<
+				"Current total number of connections: " << totalConnections.load());
+			return true;
+		} else {
+			return false;
+		}
+	}
+
+	/**
+	 * Starts a non-blocking connect to this socket, for when
+	 * checkoutIdleConnection() found nothing. Drive the connect with
+	 * continueConnect() and finish it with finishConnect().
+	 */
+	void beginConnect(NConnect_State &state) {
+		poolMisses.fetch_add(1, boost::memory_order_relaxed);
+		P_TRACE(3, "Connecting to " << address << " (non-blocking)");
+		setupNonBlockingSocket(state, address, __FILE__, __LINE__);
+	}
+
+	/**
+	 * @return Whether the connect has completed.
+	 * @throws SystemException The connect failed.
+	 */
+	bool continueConnect(NConnect_State &state) {
+		return connectToServer(state);
+	}
 
-		if (connection.fail || !connection.wantKeepAlive || totalIdleConnections >= connectionPoolLimit()) {
-			totalConnections--;
-			assert(totalConnections >= 0);
+	Connection finishConnect(NConnect_State &state, MonotonicTimeUsec startTime) {
+		Connection connection;
+		if (state.type == SAT_UNIX) {
+			connection.fd = state.s_unix.fd.detach();
+		} else {
+			connection.fd = state.s_tcp.fd.detach();
+		}
+		connection.fail = true;
+		connection.wantKeepAlive = false;
+		connection.blocking = false;
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(connection.fd, "App " << pid << " connection");
+		recordConnectTime(SystemTime::getMonotonicUsec() - startTime);
+		int total = totalConnections.fetch_add(1, boost::memory_order_relaxed) + 1;
+		P_TRACE(3, "Socket " << address << ": there are now " <<
+			total << " total connections");
+		return connection;
+	}
+
+	void checkinConnection(Connection &connection) {
+		if (!connection.fail && connection.wantKeepAlive && addIdleConnection(connection)) {
+			P_TRACE(3, "Socket " << address << ": checked in connection into connection pool. " <<
+				"Current total number of connections: " << totalConnections.load());
+		} else {
+			int total = totalConnections.fetch_sub(1, boost::memory_order_relaxed) - 1;
+			assert(total >= 0);
 			P_TRACE(3, "Socket " << address << ": connection not checked back into "
-				"connection pool. There are now " << totalConnections <<
+				"connection pool. There are now " << total <<
 				" connections in total");
-			l.unlock();
 			connection.close();
-		} else {
-			P_TRACE(3, "Socket " << address << ": checking in connection into connection pool (" <<
-				totalIdleConnections << " -> " << (totalIdleConnections + 1) <<
-				" items). Current total number of connections: " << totalConnections);
-			totalIdleConnections++;
-			idleConnections.push_back(connection);
 		}
 	}
 
 	void closeAllConnections() {
-		boost::unique_lock<boost::mutex> l(connectionPoolLock);
 		assert(sessions == 0);
-		assert(totalConnections == totalIdleConnections);
-		vector<Connection>::iterator it, end = idleConnections.end();
+		Connection connection;
 
-		for (it = idleConnections.begin(); it != end; it++) {
+		while (takeIdleConnection(connection)) {
 			try {
-				it->close();
+				connection.close();
 			} catch (const SystemException &e) {
 				P_ERROR("Cannot close a connection with socket " << address << ": " << e.what());
 			}
+			totalConnections.fetch_sub(1, boost::memory_order_relaxed);
 		}
-		idleConnections.clear();
-		totalConnections = 0;
-		totalIdleConnections = 0;
+		assert(totalConnections.load() == 0);
+		assert(totalIdleConnections.load() == 0);
+		totalConnections.store(0);
+		totalIdleConnections.store(0);
+	}
+
+	boost::uint64_t getPoolHits() const {
+		return poolHits.load(boost::memory_order_relaxed);
+	}
+
+	boost::uint64_t getPoolMisses() const {
+		return poolMisses.load(boost::memory_order_relaxed);
+	}
+
+	boost::uint64_t getConnectCount() const {
+		return connects.load(boost::memory_order_relaxed);
+	}
+
+	boost::uint64_t getAverageConnectTime() const {
+		boost::uint64_t count = connects.load(boost::memory_order_relaxed);
+		if (count == 0) {
+			return 0;
+		} else {
+			return totalConnectTime.load(boost::memory_order_relaxed) / count;
+		}
+	}
+
+	boost::uint64_t getMaxConnectTime() const {
+		return maxConnectTime.load(boost::memory_order_relaxed);
 	}
 
 
@@ -54,6 +54,7 @@
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <utility>
+#include <vector>
 #include <typeinfo>
 #include <cstdio>
 #include <cstdlib>
@@ -82,6 +83,8 @@
 #include <Core/Controller/Client.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/Controller/TurboCaching.h>
+#include <Core/Controller/LatencyStats.h>
+#include <Core/Controller/SplicePipePool.h>
 #include <Core/UnionStation/Context.h>
 
 namespace Passenger {
@@ -119,12 +122,49 @@ private:
 	typedef ServerKit::FileBufferedChannel FileBufferedChannel;
 	typedef ServerKit::FileBufferedFdSinkChannel FileBufferedFdSinkChannel;
 
+	struct PoolOptionsCacheEntry {
+		boost::shared_ptr<Options> options;
+		/** The !~PASSENGER_CONFIG_FINGERPRINT that `options` were parsed under. */
+		string configFingerprint;
+		ev_tstamp lastUsed;
+
+		PoolOptionsCacheEntry()
+			: lastUsed(0)
+			{ }
+	};
+
+	/**
+	 * The `!~` option headers that the web server sent along with a
+	 * configuration fingerprint, so that later requests only have to
+	 * send the fingerprint.
+	 */
+	struct ConfigHeadersCacheEntry {
+		vector< pair<string, string> > headers;
+		ev_tstamp lastUsed;
+
+		ConfigHeadersCacheEntry()
+			: lastUsed(0)
+			{ }
+	};
+
+	// Maximum number of entries in poolOptionsCache and in configHeadersCache.
+	// The least recently used entry is evicted when a table is full.
+	static const unsigned int MAX_CONFIG_CACHE_SIZE = 256;
+
 	// If you change this value, make sure that Request::sessionCheckoutTry
 	// has enough bits.
 	static const unsigned int MAX_SESSION_CHECKOUT_TRY = 10;
+	static const unsigned int SESSION_CONNECT_TIMEOUT_MSEC = 30000;
+	static const unsigned int SESSION_CONNECT_RETRY_INTERVAL_MSEC = 5;
 
 	unsigned int statThrottleRate;
 	unsigned int responseBufferHighWatermark;
+	// Request and response bodies with at least this many bytes remaining
+	// are forwarded with splice(). 0 means never.
+	unsigned int spliceThreshold;
+	// Maximum number of seconds that an application may take to begin its
+	// response after we've sent it (part of) the request. 0 means no limit.
+	unsigned int appResponseTimeout;
 	BenchmarkMode benchmarkMode: 3;
 	bool singleAppMode: 1;
 	bool showVersionInHeader: 1;
@@ -133,7 +173,13 @@ private:
 
 	const VariantMap *agentsOptions;
 	psg_pool_t *stringPool;
-	StringKeyTable< boost::shared_ptr<Options> > poolOptionsCache;
+	/**
+	 * Keyed by app group name, prefixed by the configuration fingerprint
+	 * (if any). See getPoolOptionsCacheKey().
+	 */
+	StringKeyTable<PoolOptionsCacheEntry> poolOptionsCache;
+	/** Keyed by configuration fingerprint. */
+	StringKeyTable<ConfigHeadersCacheEntry> configHeadersCache;
 
 	StaticString defaultRuby;
 	StaticString ustRouterAddress;
@@ -147,6 +193,10 @@ private:
 	StaticString defaultVaryTurbocacheByCookie;
 
 	HashedStaticString PASSENGER_APP_GROUP_NAME;
+	HashedStaticString PASSENGER_APP_ROOT;
+	HashedStaticString PASSENGER_APP_TYPE;
+	HashedStaticString PASSENGER_CACHED_CONFIG_FINGERPRINT;
+	HashedStaticString PASSENGER_CONFIG_FINGERPRINT;
 	HashedStaticString PASSENGER_ENV_VARS;
 	HashedStaticString PASSENGER_MAX_REQUESTS;
 	HashedStaticString PASSENGER_SHOW_VERSION_IN_HEADER;
@@ -154,6 +204,10 @@ private:
 	HashedStaticString PASSENGER_STICKY_SESSIONS_COOKIE_NAME;
 	HashedStaticString PASSENGER_REQUEST_OOB_WORK;
 	HashedStaticString UNION_STATION_SUPPORT;
+	HashedStaticString UNION_STATION_KEY;
+	HashedStaticString UNION_STATION_FILTERS;
+	HashedStaticString SCRIPT_NAME;
+	HashedStaticString DOCUMENT_ROOT;
 	HashedStaticString REMOTE_ADDR;
 	HashedStaticString REMOTE_PORT;
 	HashedStaticString REMOTE_USER;
@@ -175,6 +229,13 @@ private:
 	friend class ResponseCache<Request>;
 	struct ev_check checkWatcher;
 	TurboCaching<Request> turboCaching;
+	RequestLatencyStatsSet latencyStats;
+	SplicePipePool splicePipePool;
+	boost::uint64_t splicedRequestBodies;
+	boost::uint64_t splicedRequestBodyBytes;
+	boost::uint64_t splicedResponseBodies;
+	boost::uint64_t splicedResponseBodyBytes;
+	boost::uint64_t appResponseTimeouts;
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		struct ev_prepare prepareWatcher;
@@ -186,6 +247,9 @@ private:
 
 	struct RequestAnalysis;
 
+	bool isConfigHeader(const StaticString &name) const;
+	void cacheConfigHeaders(Request *req, const StaticString &configFingerprint);
+	bool restoreCachedConfigHeaders(Client *client, Request *req);
 	void initializeFlags(Client *client, Request *req, RequestAnalysis &analysis);
 	bool respondFromTurboCache(Client *client, Request *req);
 	void initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis);
@@ -204,8 +268,14 @@ private:
 		const HashedStaticString &name);
 	static void fillPoolOptionSecToMsec(Request *req, unsigned int &field,
 		const HashedStaticString &name);
+	StaticString getConfigFingerprint(Request *req);
+	static StaticString getPoolOptionsCacheKey(psg_pool_t *pool,
+		const StaticString &appGroupName, const StaticString &configFingerprint);
+	template<typename Entry>
+	static void evictLeastRecentlyUsedEntry(StringKeyTable<Entry> &table);
 	void createNewPoolOptions(Client *client, Request *req,
-		const HashedStaticString &appGroupName);
+		const HashedStaticString &appGroupName,
+		const StaticString &configFingerprint);
 	void initializeUnionStation(Client *client, Request *req, RequestAnalysis &analysis);
 	void setStickySessionId(Client *client, Request *req);
 	const LString *getStickySessionCookieName(Request *req);
@@ -224,12 +294,22 @@ private:
 	void checkoutSession(Client *client, Request *req);
 	static void sessionCheckedOut(const AbstractSessionPtr &session,
 		const ExceptionPtr &e, void *userData);
+	static bool isSessionCheckoutAbandoned(void *userData);
 	void sessionCheckedOutFromAnotherThread(Client *client, Request *req,
 		AbstractSessionPtr session, ExceptionPtr e);
 	void sessionCheckedOutFromEventLoopThread(Client *client, Request *req,
 		const AbstractSessionPtr &session, const ExceptionPtr &e);
 	void maybeSend100Continue(Client *client, Request *req);
 	void initiateSession(Client *client, Request *req);
+	void processSessionInitiateResult(Client *client, Request *req,
+		AbstractSession::InitiateResult result);
+	static void onSessionConnectWritable(EV_P_ struct ev_io *w, int revents);
+	static void onSessionConnectTimer(EV_P_ struct ev_timer *w, int revents);
+	void continueInitiatingSession(Client *client, Request *req);
+	void stopWaitingForSessionConnect(Request *req);
+	void handleSessionInitiateError(Client *client, Request *req,
+		const StaticString &error);
+	void sessionInitiated(Client *client, Request *req);
 	static void checkoutSessionLater(Request *req);
 	void reportSessionCheckoutError(Client *client, Request *req,
 		const ExceptionPtr &e);
@@ -272,6 +352,13 @@ private:
 		unsigned int size);
 	void startBodyChannel(Client *client, Request *req);
 	void stopBodyChannel(Client *client, Request *req);
+	bool shouldSpliceRequestBody(Client *client, Request *req) const;
+	bool beginSplicingRequestBody(Client *client, Request *req);
+	static void onRequestBodySpliceEvent(EV_P_ struct ev_io *w, int revents);
+	void continueSplicingRequestBody(Client *client, Request *req);
+	void waitForSpliceEvent(struct ev_io *watcher, int fd, int events);
+	void finishSplicingRequestBody(Client *client, Request *req);
+	void stopSplicingRequestBody(Request *req);
 	void logAppSocketWriteError(Client *client, int errcode);
 
 
@@ -282,6 +369,8 @@ private:
 	Channel::Result onAppSourceData(Client *client, Request *req,
 		const MemoryKit::mbuf &buffer, int errcode);
 	void onAppResponseBegin(Client *client, Request *req);
+	void armAppResponseTimeout(Request *req);
+	static void onAppResponseTimeout(ServerKit::Timer *timer);
 	void prepareAppResponseCaching(Client *client, Request *req);
 	void onAppResponse100Continue(Client *client, Request *req);
 	bool constructHeaderBuffersForResponse(Request *req, struct iovec *buffers,
@@ -310,6 +399,12 @@ private:
 	void markResponsePartForTurboCaching(Client *client, Request *req,
 		const MemoryKit::mbuf &buffer);
 	void maybeThrottleAppSource(Client *client, Request *req);
+	bool shouldSpliceResponseBody(Client *client, Request *req) const;
+	bool maybeBeginSplicingResponseBody(Client *client, Request *req);
+	bool beginSplicingResponseBody(Client *client, Request *req);
+	static void onResponseBodySpliceEvent(EV_P_ struct ev_io *w, int revents);
+	void continueSplicingResponseBody(Client *client, Request *req);
+	void stopSplicingResponseBody(Request *req);
 	static void _outputBuffersFlushed(FileBufferedChannel *_channel);
 	void outputBuffersFlushed(Client *client, Request *req);
 	static void _outputDataFlushed(FileBufferedChannel *_channel);
@@ -335,6 +430,7 @@ private:
 	static TurboCaching<Request>::State getTurboCachingInitialState(
 		const VariantMap *agentsOptions);
 	void generateServerLogName(unsigned int number);
+	void recordLatencyStats(Request *req);
 	void disconnectWithClientSocketWriteError(Client **client, int e);
 	void disconnectWithAppSocketIncompleteResponseError(Client **client);
 	void disconnectWithAppSocketReadError(Client **client, int e);
@@ -373,6 +469,8 @@ protected:
 
 	virtual void onClientAccepted(Client *client);
 	virtual void onRequestObjectCreated(Client *client, Request *req);
+	virtual Channel::Result onClientDataReceived(Client *client,
+		const MemoryKit::mbuf &buffer, int errcode);
 	virtual void deinitializeClient(Client *client);
 	virtual void reinitializeRequest(Client *client, Request *req);
 	virtual void deinitializeRequest(Client *client, Request *req);
@@ -418,6 +516,7 @@ public:
 	virtual Json::Value inspectStateAsJson() const;
 	virtual Json::Value inspectClientStateAsJson(const Client *client) const;
 	virtual Json::Value inspectRequestStateAsJson(const Request *req) const;
+	const RequestLatencyStatsSet &getLatencyStats() const;
 
 
 	/****** Miscellaneous *******/
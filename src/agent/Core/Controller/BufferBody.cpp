@@ -122,8 +122,7 @@ Controller::whenBufferingBody_onRequestBody(Client *client, Request *req,
 			psg_lstr_init(&header->val);
 			psg_lstr_append(&header->val, req->pool, contentLength, size);
 
-			header->hash = HashedStaticString("content-length",
-				sizeof("content-length") - 1).hash();
+			header->hash = HTTP_CONTENT_LENGTH.hash();
 
 			req->headers.erase(HTTP_TRANSFER_ENCODING);
 			req->headers.insert(&header, req->pool);
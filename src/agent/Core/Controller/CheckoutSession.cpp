@@ -62,9 +62,13 @@ Controller::checkoutSession(Client *client, Request *req) {
 	}
 
 	callback.func = sessionCheckedOut;
+	callback.isAbandoned = isSessionCheckoutAbandoned;
 	callback.userData = req;
 
 	options.currentTime = SystemTime::getUsec();
+	if (req->timestamps.checkoutBegun == 0) {
+		req->timestamps.checkoutBegun = SystemTime::getMonotonicUsec();
+	}
 
 	refRequest(req, __FILE__, __LINE__);
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
@@ -107,6 +111,17 @@ Controller::sessionCheckedOut(const AbstractSessionPtr &session, const Exception
 	}
 }
 
+/**
+ * Called by the ApplicationPool, possibly from another thread, while this
+ * request is in the queue. The request object stays valid until
+ * sessionCheckedOut() is called because we hold a reference to it.
+ */
+bool
+Controller::isSessionCheckoutAbandoned(void *userData) {
+	Request *req = static_cast<Request *>(userData);
+	return req->checkoutAbandoned.load(boost::memory_order_relaxed);
+}
+
 void
 Controller::sessionCheckedOutFromAnotherThread(Client *client, Request *req,
 	AbstractSessionPtr session, ExceptionPtr e)
@@ -140,6 +155,7 @@ Controller::sessionCheckedOutFromEventLoopThread(Client *client, Request *req,
 		SKC_DEBUG(client, "Session checked out: pid=" << session->getPid() <<
 			", gupid=" << session->getGupid());
 		req->session = session;
+		req->timestamps.sessionCheckedOut = SystemTime::getMonotonicUsec();
 		UPDATE_TRACE_POINT();
 		maybeSend100Continue(client, req);
 		UPDATE_TRACE_POINT();
@@ -178,25 +194,122 @@ Controller::maybeSend100Continue(Client *client, Request *req) {
 void
 Controller::initiateSession(Client *client, Request *req) {
 	TRACE_POINT();
+	AbstractSession::InitiateResult result;
+
 	req->sessionCheckoutTry++;
 	try {
-		req->session->initiate(false);
+		result = req->session->initiateNonBlocking(
+			SESSION_CONNECT_TIMEOUT_MSEC * 1000ull);
 	} catch (const SystemException &e2) {
-		if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
-			SKC_DEBUG(client, "Error checking out session (" << e2.what() <<
-				"); retrying (attempt " << req->sessionCheckoutTry << ")");
-			refRequest(req, __FILE__, __LINE__);
-			getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
-		} else {
-			string message = "could not initiate a session (";
-			message.append(e2.what());
-			message.append(")");
-			disconnectWithError(&client, message);
-		}
+		handleSessionInitiateError(client, req, e2.what());
 		return;
 	}
+	processSessionInitiateResult(client, req, result);
+}
+
+/**
+ * Connecting to the application happens asynchronously when there is no
+ * pooled connection, so that a slow application (e.g. one with a full
+ * listen backlog) does not block all the other clients of this event loop.
+ */
+void
+Controller::processSessionInitiateResult(Client *client, Request *req,
+	AbstractSession::InitiateResult result)
+{
+	switch (result) {
+	case AbstractSession::INITIATED:
+		sessionInitiated(client, req);
+		break;
+	case AbstractSession::INITIATE_WAIT_WRITABLE:
+		SKC_TRACE(client, 2, "Waiting for connect to application to complete");
+		ev_io_set(&req->sessionConnectWatcher, req->session->fd(), EV_WRITE);
+		ev_io_start(getLoop(), &req->sessionConnectWatcher);
+		ev_timer_set(&req->sessionConnectTimer,
+			req->session->getConnectTimeRemaining() / 1000000.0, 0);
+		ev_timer_start(getLoop(), &req->sessionConnectTimer);
+		break;
+	case AbstractSession::INITIATE_RETRY_LATER:
+		SKC_TRACE(client, 2, "Application listen backlog full; retrying connect later");
+		ev_timer_set(&req->sessionConnectTimer,
+			std::min<ev_tstamp>(SESSION_CONNECT_RETRY_INTERVAL_MSEC / 1000.0,
+				req->session->getConnectTimeRemaining() / 1000000.0),
+			0);
+		ev_timer_start(getLoop(), &req->sessionConnectTimer);
+		break;
+	default:
+		P_BUG("Unknown InitiateResult " << (int) result);
+		break;
+	}
+}
+
+void
+Controller::onSessionConnectWritable(EV_P_ struct ev_io *w, int revents) {
+	Request *req = static_cast<Request *>(w->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onSessionConnectWritable");
+
+	self->stopWaitingForSessionConnect(req);
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::onSessionConnectTimer(EV_P_ struct ev_timer *w, int revents) {
+	Request *req = static_cast<Request *>(w->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onSessionConnectTimer");
+
+	self->stopWaitingForSessionConnect(req);
+	// continueInitiate() checks whether the connect timed out.
+	self->continueInitiatingSession(client, req);
+}
+
+void
+Controller::continueInitiatingSession(Client *client, Request *req) {
+	TRACE_POINT();
+	AbstractSession::InitiateResult result;
+
+	try {
+		result = req->session->continueInitiate();
+	} catch (const SystemException &e2) {
+		handleSessionInitiateError(client, req, e2.what());
+		return;
+	} catch (const TimeoutException &e2) {
+		handleSessionInitiateError(client, req, e2.what());
+		return;
+	}
+	processSessionInitiateResult(client, req, result);
+}
+
+void
+Controller::stopWaitingForSessionConnect(Request *req) {
+	ev_io_stop(getLoop(), &req->sessionConnectWatcher);
+	ev_timer_stop(getLoop(), &req->sessionConnectTimer);
+}
+
+void
+Controller::handleSessionInitiateError(Client *client, Request *req,
+	const StaticString &error)
+{
+	if (req->sessionCheckoutTry < MAX_SESSION_CHECKOUT_TRY) {
+		SKC_DEBUG(client, "Error checking out session (" << error <<
+			"); retrying (attempt " << req->sessionCheckoutTry << ")");
+		refRequest(req, __FILE__, __LINE__);
+		getContext()->libev->runLater(boost::bind(checkoutSessionLater, req));
+	} else {
+		string message = "could not initiate a session (";
+		message.append(error.data(), error.size());
+		message.append(")");
+		disconnectWithError(&client, message);
+	}
+}
+
+void
+Controller::sessionInitiated(Client *client, Request *req) {
+	TRACE_POINT();
+	req->timestamps.sessionInitiated = SystemTime::getMonotonicUsec();
 
-	UPDATE_TRACE_POINT();
 	if (req->useUnionStation()) {
 		req->endStopwatchLog(&req->stopwatchLogs.getFromPool);
 		req->logMessage("Application PID: " +
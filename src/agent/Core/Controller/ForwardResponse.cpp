@@ -165,7 +165,7 @@ Controller::onAppSourceData(Client *client, Request *req, const MemoryKit::mbuf
 						SKC_TRACE(client, 2, "End of application response body reached");
 						handleAppResponseBodyEnd(client, req);
 						endRequest(&client, &req);
-					} else {
+					} else if (!maybeBeginSplicingResponseBody(client, req)) {
 						maybeThrottleAppSource(client, req);
 					}
 				}
@@ -319,6 +319,9 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	ssize_t bytesWritten;
 	bool oobw;
 
+	req->timestamps.appResponseBegun = SystemTime::getMonotonicUsec();
+	getContext()->timerWheel.cancel(&req->appResponseTimer);
+
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timeOnRequestHeaderSent = ev_now(getLoop());
 		reportLargeTimeDiff(client,
@@ -396,6 +399,36 @@ Controller::onAppResponseBegin(Client *client, Request *req) {
 	}
 }
 
+/**
+ * (Re)starts the app response timeout. Called whenever we send request data
+ * to the application, so that a slowly uploaded request body doesn't count
+ * against the application.
+ */
+void
+Controller::armAppResponseTimeout(Request *req) {
+	if (appResponseTimeout > 0 && req->timestamps.appResponseBegun == 0) {
+		getContext()->timerWheel.arm(&req->appResponseTimer, appResponseTimeout);
+	}
+}
+
+void
+Controller::onAppResponseTimeout(ServerKit::Timer *timer) {
+	Request *req = static_cast<Request *>(timer->userData);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onAppResponseTimeout");
+
+	self->appResponseTimeouts++;
+	if (req->responseBegun) {
+		self->disconnectWithError(&client, "timed out waiting for the application response");
+	} else {
+		SKC_WARN_FROM_STATIC(self, client, "Sending 504 response: application did not "
+			"respond within " << self->appResponseTimeout << " seconds");
+		self->endRequestWithSimpleResponse(&client, &req,
+			"<h2>Application did not respond in time</h2>", 504);
+	}
+}
+
 void
 Controller::prepareAppResponseCaching(Client *client, Request *req) {
 	if (turboCaching.isEnabled() && !req->cacheKey.empty()) {
@@ -406,10 +439,10 @@ Controller::prepareAppResponseCaching(Client *client, Request *req) {
 		 && turboCaching.responseCache.prepareRequestForStoring(req))
 		{
 			if (resp->bodyType == AppResponse::RBT_CONTENT_LENGTH
-			 && resp->aux.bodyInfo.contentLength > ResponseCache<Request>::MAX_BODY_SIZE)
+			 && resp->aux.bodyInfo.contentLength > turboCaching.responseCache.getMaxBodySize())
 			{
 				SKC_DEBUG(client, "Response body larger than " <<
-					ResponseCache<Request>::MAX_BODY_SIZE <<
+					turboCaching.responseCache.getMaxBodySize() <<
 					" bytes, so response is not eligible for turbocaching");
 				// Decrease store success ratio.
 				turboCaching.responseCache.incStores();
@@ -995,9 +1028,9 @@ Controller::markResponsePartForTurboCaching(Client *client, Request *req,
 {
 	if (!req->ended() && turboCaching.isEnabled() && !req->cacheKey.empty()) {
 		unsigned int totalSize = req->appResponse.bodyCacheBuffer.size + buffer.size();
-		if (totalSize > ResponseCache<Request>::MAX_BODY_SIZE) {
+		if (totalSize > turboCaching.responseCache.getMaxBodySize()) {
 			SKC_DEBUG(client, "Response body larger than " <<
-				ResponseCache<Request>::MAX_HEADER_SIZE <<
+				turboCaching.responseCache.getMaxBodySize() <<
 				" bytes, so response is not eligible for turbocaching");
 			// Decrease store success ratio.
 			turboCaching.responseCache.incStores();
@@ -1072,9 +1105,183 @@ void
 Controller::outputDataFlushed(Client *client, Request *req) {
 	if (!req->ended()) {
 		assert(!req->appSource.isStarted());
-		SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
 		client->output.setDataFlushedCallback(getClientOutputDataFlushedCallback());
-		req->appSource.start();
+		if (!maybeBeginSplicingResponseBody(client, req)) {
+			SKC_TRACE(client, 2, "The client is ready to receive more data. Resuming application socket");
+			req->appSource.start();
+		}
+	}
+}
+
+/**
+ * Whether the remainder of the response body should be forwarded with
+ * splice(), directly from the application socket to the client socket,
+ * instead of through appSource and client->output. This is only possible
+ * if we don't need to look at the body data: its length must be known,
+ * and it must not be stored in the turbocache.
+ */
+bool
+Controller::shouldSpliceResponseBody(Client *client, Request *req) const {
+	const AppResponse *resp = &req->appResponse;
+	return spliceThreshold > 0
+		&& resp->httpState == AppResponse::PARSING_BODY_WITH_LENGTH
+		&& resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead >= spliceThreshold
+		&& req->cacheKey.empty()
+		&& benchmarkMode != BM_RESPONSE_BEGIN
+		&& req->session != NULL
+		&& !req->responseBodySplicePipe.isOpen()
+		&& !client->output.ended();
+}
+
+/**
+ * Must only be called from onAppSourceData() after the data passed to it
+ * has been fully consumed, or from outputDataFlushed(). Returns whether the
+ * response body is (about to be) spliced, in which case appSource has been
+ * stopped.
+ *
+ * Data spliced into the client socket must come after the data that is
+ * still buffered in client->output. If there is any, we throttle the
+ * application socket until that data has been flushed, just like
+ * maybeThrottleAppSource() does, and try again in outputDataFlushed().
+ */
+bool
+Controller::maybeBeginSplicingResponseBody(Client *client, Request *req) {
+	if (req->ended() || !shouldSpliceResponseBody(client, req)) {
+		return false;
+	} else if (client->output.flushed()) {
+		return beginSplicingResponseBody(client, req);
+	} else {
+		assert(client->output.getBuffersFlushedCallback() == NULL);
+		assert(client->output.getDataFlushedCallback() == getClientOutputDataFlushedCallback());
+		SKC_TRACE(client, 2, "Waiting for buffered response data to be flushed "
+			"before forwarding the response body with splice()");
+		client->output.setDataFlushedCallback(_outputDataFlushed);
+		req->appSource.stop();
+		return true;
+	}
+}
+
+bool
+Controller::beginSplicingResponseBody(Client *client, Request *req) {
+	if (!splicePipePool.acquire(req->responseBodySplicePipe)) {
+		int e = errno;
+		SKC_DEBUG(client, "Cannot create a pipe for splicing the response body, "
+			"forwarding it normally instead: " << strerror(e) << " (errno=" << e << ")");
+		return false;
+	}
+
+	SKC_TRACE(client, 2, "Forwarding remaining " <<
+		(req->appResponse.aux.bodyInfo.contentLength - req->appResponse.bodyAlreadyRead) <<
+		" bytes of response body with splice()");
+	req->appSource.stop();
+	req->responseBodySplicePipeBytes = 0;
+	splicedResponseBodies++;
+	waitForSpliceEvent(&req->responseBodySpliceWatcher, req->session->fd(), EV_READ);
+	return true;
+}
+
+void
+Controller::onResponseBodySpliceEvent(EV_P_ struct ev_io *w, int revents) {
+	Request *req = static_cast<Request *>(w->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onResponseBodySpliceEvent");
+
+	self->continueSplicingResponseBody(client, req);
+}
+
+/**
+ * Alternately fills the pipe from the application socket and drains it into
+ * the client socket, until either socket would block. Because we only read
+ * from the application when the pipe is empty, the pipe takes the role of
+ * the response buffer: a slow client throttles the application, just like
+ * maybeThrottleAppSource() does.
+ */
+void
+Controller::continueSplicingResponseBody(Client *client, Request *req) {
+	TRACE_POINT();
+	// Limit the amount of work per event loop iteration so that
+	// other clients are not starved.
+	const unsigned int MAX_ITERATIONS = 16;
+	AppResponse *resp = &req->appResponse;
+	ssize_t ret;
+	int e;
+
+	for (unsigned int i = 0; i < MAX_ITERATIONS; i++) {
+		if (req->responseBodySplicePipeBytes > 0) {
+			ret = SplicePipePool::transfer(req->responseBodySplicePipe.readFd,
+				client->getFd(), req->responseBodySplicePipeBytes);
+			if (ret > 0) {
+				req->responseBodySplicePipeBytes -= ret;
+				splicedResponseBodyBytes += ret;
+				continue;
+			}
+
+			e = errno;
+			if (ret == -1 && (e == EAGAIN || e == EWOULDBLOCK)) {
+				waitForSpliceEvent(&req->responseBodySpliceWatcher, client->getFd(), EV_WRITE);
+			} else {
+				UPDATE_TRACE_POINT();
+				disconnectWithClientSocketWriteError(&client, (ret == 0) ? EPIPE : e);
+			}
+			return;
+		}
+
+		if (resp->bodyFullyRead()) {
+			UPDATE_TRACE_POINT();
+			SKC_TRACE(client, 2, "End of application response body reached");
+			stopSplicingResponseBody(req);
+			handleAppResponseBodyEnd(client, req);
+			endRequest(&client, &req);
+			return;
+		}
+
+		ret = SplicePipePool::transfer(req->session->fd(),
+			req->responseBodySplicePipe.writeFd,
+			std::min<boost::uint64_t>(
+				resp->aux.bodyInfo.contentLength - resp->bodyAlreadyRead,
+				req->responseBodySplicePipe.capacity));
+		if (ret > 0) {
+			resp->bodyAlreadyRead += ret;
+			req->responseBodySplicePipeBytes = ret;
+			SKC_TRACE(client, 3, "Spliced " << ret << " bytes of application response body (" <<
+				resp->bodyAlreadyRead << " of " << resp->aux.bodyInfo.contentLength <<
+				" bytes forwarded in total)");
+			continue;
+		}
+
+		// Handled just like an error reported by appSource.
+		UPDATE_TRACE_POINT();
+		e = errno;
+		if (ret == -1 && (e == EAGAIN || e == EWOULDBLOCK)) {
+			waitForSpliceEvent(&req->responseBodySpliceWatcher, req->session->fd(), EV_READ);
+		} else if (ret == 0 || e == ECONNRESET) {
+			SKC_WARN(client, "Application sent EOF before finishing response body: " <<
+				resp->bodyAlreadyRead << " bytes already read, " <<
+				resp->aux.bodyInfo.contentLength << " bytes expected");
+			endRequestWithAppSocketIncompleteResponse(&client, &req);
+		} else {
+			endRequestWithAppSocketReadError(&client, &req, e);
+		}
+		return;
+	}
+
+	// Both sockets are probably still ready, but give other
+	// clients a chance first.
+	if (req->responseBodySplicePipeBytes > 0) {
+		waitForSpliceEvent(&req->responseBodySpliceWatcher, client->getFd(), EV_WRITE);
+	} else {
+		waitForSpliceEvent(&req->responseBodySpliceWatcher, req->session->fd(), EV_READ);
+	}
+}
+
+void
+Controller::stopSplicingResponseBody(Request *req) {
+	if (req->responseBodySplicePipe.isOpen()) {
+		ev_io_stop(getLoop(), &req->responseBodySpliceWatcher);
+		splicePipePool.release(req->responseBodySplicePipe,
+			req->responseBodySplicePipeBytes == 0);
+		req->responseBodySplicePipeBytes = 0;
 	}
 }
 
@@ -1114,31 +1321,44 @@ Controller::storeAppResponseInTurboCache(Client *client, Request *req) {
 		TRACE_POINT();
 		AppResponse *resp = &req->appResponse;
 		unsigned int headerSize = 0;
+		unsigned int gzipBodySize = 0;
+		char *gzipBody = NULL;
 		unsigned int i;
 
 		for (i = 0; i < resp->nHeaderCacheBuffers; i++) {
 			headerSize += resp->headerCacheBuffers[i].iov_len;
 		}
+		if (turboCaching.isGzipEnabled()
+		 && resp->bodyCacheBuffer.size <= turboCaching.responseCache.getMaxBodySize()
+		 && turboCaching.responseCache.responseAllowsCompression(req))
+		{
+			gzipBodySize = turboCaching.compressBody(req, &resp->bodyCacheBuffer,
+				&gzipBody);
+		}
 		ResponseCache<Request>::Entry entry(
 			turboCaching.responseCache.store(req, ev_now(getLoop()),
-				headerSize, resp->bodyCacheBuffer.size));
+				headerSize, resp->bodyCacheBuffer.size, gzipBodySize));
 		if (entry.valid()) {
 			UPDATE_TRACE_POINT();
 			SKC_DEBUG(client, "Storing app response in turbocache");
 			SKC_TRACE(client, 2, "Turbocache entries:\n" << turboCaching.responseCache.inspect());
 
 			gatherBuffers(entry.body->httpHeaderData,
-				ResponseCache<Request>::MAX_HEADER_SIZE,
+				entry.body->httpHeaderSize,
 				resp->headerCacheBuffers, resp->nHeaderCacheBuffers);
 
 			char *pos = entry.body->httpBodyData;
 			const char *end = entry.body->httpBodyData
-				+ ResponseCache<Request>::MAX_BODY_SIZE;
+				+ entry.body->httpBodySize;
 			const LString::Part *part = resp->bodyCacheBuffer.start;
 			while (part != NULL) {
 				pos = appendData(pos, end, part->data, part->size);
 				part = part->next;
 			}
+
+			if (gzipBodySize > 0) {
+				memcpy(entry.body->httpGzipBodyData, gzipBody, gzipBodySize);
+			}
 		} else {
 			SKC_DEBUG(client, "Could not store app response for turbocaching");
 		}
@@ -107,6 +107,31 @@ Controller::onRequestObjectCreated(Client *client, Request *req) {
 	req->bodyBuffer.setContext(getContext());
 	req->bodyBuffer.setHooks(&req->hooks);
 	req->bodyBuffer.setDataCallback(onBodyBufferData);
+
+	ev_io_init(&req->sessionConnectWatcher, onSessionConnectWritable, -1, EV_WRITE);
+	req->sessionConnectWatcher.data = req;
+	ev_timer_init(&req->sessionConnectTimer, onSessionConnectTimer, 0, 0);
+	req->sessionConnectTimer.data = req;
+	req->appResponseTimer.callback = onAppResponseTimeout;
+	req->appResponseTimer.userData = req;
+	ev_io_init(&req->requestBodySpliceWatcher, onRequestBodySpliceEvent, -1, EV_READ);
+	req->requestBodySpliceWatcher.data = req;
+	ev_io_init(&req->responseBodySpliceWatcher, onResponseBodySpliceEvent, -1, EV_READ);
+	req->responseBodySpliceWatcher.data = req;
+}
+
+ServerKit::Channel::Result
+Controller::onClientDataReceived(Client *client, const MemoryKit::mbuf &buffer,
+	int errcode)
+{
+	Request *req = client->currentRequest;
+	if (req->httpState == Request::PARSING_HEADERS
+	 && req->timestamps.headerBegun == 0
+	 && buffer.size() > 0)
+	{
+		req->timestamps.headerBegun = SystemTime::getMonotonicUsec();
+	}
+	return ParentClass::onClientDataReceived(client, buffer, errcode);
 }
 
 void
@@ -135,11 +160,15 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 	req->strip100ContinueHeader = false;
 	req->hasPragmaHeader = false;
 	req->host = NULL;
+	req->requestBodySplicePipeBytes = 0;
+	req->responseBodySplicePipeBytes = 0;
 	req->bodyBytesBuffered = 0;
 	req->cacheKey = HashedStaticString();
 	req->cacheControl = NULL;
 	req->varyCookie = NULL;
 	req->envvars = NULL;
+	memset(&req->timestamps, 0, sizeof(req->timestamps));
+	req->checkoutAbandoned.store(false, boost::memory_order_relaxed);
 
 	#ifdef DEBUG_CC_EVENT_LOOP_BLOCKING
 		req->timedAppPoolGet = false;
@@ -153,6 +182,12 @@ Controller::reinitializeRequest(Client *client, Request *req) {
 
 void
 Controller::deinitializeRequest(Client *client, Request *req) {
+	req->checkoutAbandoned.store(true, boost::memory_order_relaxed);
+	recordLatencyStats(req);
+	stopWaitingForSessionConnect(req);
+	getContext()->timerWheel.cancel(&req->appResponseTimer);
+	stopSplicingRequestBody(req);
+	stopSplicingResponseBody(req);
 	req->session.reset();
 
 	req->endStopwatchLog(&req->stopwatchLogs.getFromPool, false);
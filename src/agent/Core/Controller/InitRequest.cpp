@@ -53,6 +53,145 @@ struct Controller::RequestAnalysis {
 };
 
 
+static void
+insertSecureHeader(Request *req, const StaticString &name, const StaticString &value) {
+	ServerKit::Header *header = (ServerKit::Header *) psg_palloc(req->pool,
+		sizeof(ServerKit::Header));
+	StaticString nameCopy = psg_pstrdup(req->pool, name);
+	StaticString valueCopy = psg_pstrdup(req->pool, value);
+
+	// Secure header keys are case sensitive, so unlike
+	// HeaderTable::insert(pool, name, value) we don't downcase the key.
+	psg_lstr_init(&header->key);
+	psg_lstr_append(&header->key, req->pool, nameCopy.data(), nameCopy.size());
+	psg_lstr_init(&header->origKey);
+	psg_lstr_append(&header->origKey, req->pool, nameCopy.data(), nameCopy.size());
+	psg_lstr_init(&header->val);
+	psg_lstr_append(&header->val, req->pool, valueCopy.data(), valueCopy.size());
+	header->hash = HashedStaticString(nameCopy).hash();
+
+	req->secureHeaders.insert(&header, req->pool);
+}
+
+template<typename Entry>
+void
+Controller::evictLeastRecentlyUsedEntry(StringKeyTable<Entry> &table) {
+	typename StringKeyTable<Entry>::Iterator it(table);
+	typename StringKeyTable<Entry>::Cell *oldest = NULL;
+
+	while (*it != NULL) {
+		if (oldest == NULL || it.getValue().lastUsed < oldest->value.lastUsed) {
+			oldest = *it;
+		}
+		it.next();
+	}
+	if (oldest != NULL) {
+		table.erase(oldest);
+		// Reclaims the storage of the erased key.
+		table.compact();
+	}
+}
+
+/**
+ * Whether `name` is one of the secure headers that the web server generates
+ * from its configuration, as opposed to the ones that it generates for
+ * every request.
+ */
+bool
+Controller::isConfigHeader(const StaticString &name) const {
+	return name.size() > 2
+		&& name != PASSENGER_CONFIG_FINGERPRINT
+		&& name != PASSENGER_CACHED_CONFIG_FINGERPRINT
+		&& name != PASSENGER_APP_TYPE
+		&& name != DOCUMENT_ROOT
+		&& name != SCRIPT_NAME
+		&& name != REMOTE_ADDR
+		&& name != REMOTE_PORT
+		&& name != REMOTE_USER
+		&& name != FLAGS;
+}
+
+void
+Controller::cacheConfigHeaders(Request *req, const StaticString &configFingerprint) {
+	HashedStaticString key(configFingerprint);
+	ConfigHeadersCacheEntry *entry;
+
+	if (configHeadersCache.lookup(key, &entry)) {
+		entry->lastUsed = ev_now(getLoop());
+		return;
+	}
+
+	ConfigHeadersCacheEntry newEntry;
+	ServerKit::HeaderTable::Iterator it(req->secureHeaders);
+
+	while (*it != NULL) {
+		const LString *name = psg_lstr_make_contiguous(&it->header->key, req->pool);
+		StaticString nameStr(name->start->data, name->size);
+		if (isConfigHeader(nameStr)) {
+			const LString *value = psg_lstr_make_contiguous(&it->header->val, req->pool);
+			newEntry.headers.push_back(make_pair(nameStr.toString(),
+				string(value->start->data, value->size)));
+		}
+		it.next();
+	}
+	newEntry.lastUsed = ev_now(getLoop());
+
+	if (configHeadersCache.size() >= MAX_CONFIG_CACHE_SIZE) {
+		evictLeastRecentlyUsedEntry(configHeadersCache);
+	}
+	configHeadersCache.insert(key, newEntry);
+}
+
+/**
+ * Once the web server has sent the option headers of a configuration along
+ * with `!~PASSENGER_CONFIG_FINGERPRINT`, it may send subsequent requests with
+ * just `!~PASSENGER_CACHED_CONFIG_FINGERPRINT`. Here we put the cached option
+ * headers back into such requests. If they are not cached (anymore), e.g.
+ * because the core was restarted, then we respond with a 503 that carries an
+ * `X-Passenger-Config-Miss` header. The web server then resends the request
+ * along with all option headers.
+ *
+ * Returns whether the request may proceed.
+ */
+bool
+Controller::restoreCachedConfigHeaders(Client *client, Request *req) {
+	const LString *fingerprint = req->secureHeaders.lookup(
+		PASSENGER_CACHED_CONFIG_FINGERPRINT);
+	if (fingerprint == NULL || fingerprint->size == 0) {
+		StaticString configFingerprint = getConfigFingerprint(req);
+		if (!configFingerprint.empty()) {
+			cacheConfigHeaders(req, configFingerprint);
+		}
+		return true;
+	}
+
+	fingerprint = psg_lstr_make_contiguous(fingerprint, req->pool);
+	StaticString configFingerprint(fingerprint->start->data, fingerprint->size);
+	ConfigHeadersCacheEntry *entry;
+
+	if (!configHeadersCache.lookup(configFingerprint, &entry)) {
+		SKC_DEBUG(client, "Configuration fingerprint " << configFingerprint
+			<< " is not cached; asking the web server to resend the options");
+		ServerKit::HeaderTable headers;
+		headers.insert(req->pool, "cache-control", "no-cache, no-store, must-revalidate");
+		headers.insert(req->pool, "x-passenger-config-miss", configFingerprint);
+		writeSimpleResponse(client, 503, &headers, "<h1>Service Unavailable</h1>");
+		endRequest(&client, &req);
+		return false;
+	}
+
+	vector< pair<string, string> >::const_iterator it, end = entry->headers.end();
+	for (it = entry->headers.begin(); it != end; it++) {
+		// Headers that the web server generated for this request take precedence.
+		if (req->secureHeaders.lookup(it->first) == NULL) {
+			insertSecureHeader(req, it->first, it->second);
+		}
+	}
+	insertSecureHeader(req, PASSENGER_CONFIG_FINGERPRINT, configFingerprint);
+	entry->lastUsed = ev_now(getLoop());
+	return true;
+}
+
 void
 Controller::initializeFlags(Client *client, Request *req, RequestAnalysis &analysis) {
 	if (analysis.flags != NULL) {
@@ -134,12 +273,12 @@ Controller::respondFromTurboCache(Client *client, Request *req) {
 
 void
 Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis &analysis) {
-	boost::shared_ptr<Options> *options;
+	PoolOptionsCacheEntry *entry;
 
 	if (singleAppMode) {
 		P_ASSERT_EQ(poolOptionsCache.size(), 1);
-		poolOptionsCache.lookupRandom(NULL, &options);
-		req->options = **options;
+		poolOptionsCache.lookupRandom(NULL, &entry);
+		req->options = *entry->options;
 	} else {
 		ServerKit::HeaderTable::Cell *appGroupNameCell = analysis.appGroupNameCell;
 		if (appGroupNameCell != NULL && appGroupNameCell->header->val.size > 0) {
@@ -148,13 +287,16 @@ Controller::initializePoolOptions(Client *client, Request *req, RequestAnalysis
 				req->pool);
 			HashedStaticString hAppGroupName(appGroupName->start->data,
 				appGroupName->size);
+			StaticString configFingerprint = getConfigFingerprint(req);
 
-			poolOptionsCache.lookup(hAppGroupName, &options);
+			poolOptionsCache.lookup(getPoolOptionsCacheKey(req->pool,
+				hAppGroupName, configFingerprint), &entry);
 
-			if (options != NULL) {
-				req->options = **options;
+			if (entry != NULL) {
+				entry->lastUsed = ev_now(getLoop());
+				req->options = *entry->options;
 			} else {
-				createNewPoolOptions(client, req, hAppGroupName);
+				createNewPoolOptions(client, req, hAppGroupName, configFingerprint);
 			}
 		} else {
 			disconnectWithError(&client, "the !~PASSENGER_APP_GROUP_NAME header must be set");
@@ -207,7 +349,15 @@ Controller::fillPoolOptionsFromAgentsOptions(Options &options) {
 	}
 	options.minProcesses = agentsOptions->getInt("min_instances");
 	options.maxPreloaderIdleTime = agentsOptions->getInt("max_preloader_idle_time");
+	options.spawnConcurrency = agentsOptions->getUint("spawn_concurrency",
+		false, DEFAULT_SPAWN_CONCURRENCY);
 	options.maxRequestQueueSize = agentsOptions->getInt("max_request_queue_size");
+	options.maxRequestQueueTime = agentsOptions->getUint("max_request_queue_time", false, 0);
+	options.requestQueueTargetDelay = agentsOptions->getUint("request_queue_target_delay",
+		false, 0);
+	if (agentsOptions->has("routing_policy")) {
+		options.routingPolicy = agentsOptions->get("routing_policy");
+	}
 	options.abortWebsocketsOnProcessShutdown = agentsOptions->getBool("abort_websockets_on_process_shutdown");
 	options.forceMaxConcurrentRequestsPerProcess = agentsOptions->getInt("force_max_concurrent_requests_per_process");
 	options.spawnMethod = agentsOptions->get("spawn_method");
@@ -293,9 +443,47 @@ Controller::fillPoolOptionSecToMsec(Request *req, unsigned int &field,
 	}
 }
 
+/**
+ * The Nginx module sends a fingerprint of the location configuration that
+ * the `!~PASSENGER_*` option headers were generated from. Pool options are
+ * cached per combination of app group and fingerprint, so that options that
+ * changed (e.g. because Nginx was reloaded with a different configuration)
+ * are parsed again, and so that multiple locations with different options
+ * can share an app group without evicting each other's entry. Requests
+ * without a fingerprint (e.g. from Apache) are cached per app group only.
+ */
+StaticString
+Controller::getConfigFingerprint(Request *req) {
+	const LString *fingerprint = req->secureHeaders.lookup(PASSENGER_CONFIG_FINGERPRINT);
+	if (fingerprint == NULL || fingerprint->size == 0) {
+		return StaticString();
+	}
+
+	fingerprint = psg_lstr_make_contiguous(fingerprint, req->pool);
+	return StaticString(fingerprint->start->data, fingerprint->size);
+}
+
+StaticString
+Controller::getPoolOptionsCacheKey(psg_pool_t *pool, const StaticString &appGroupName,
+	const StaticString &configFingerprint)
+{
+	if (configFingerprint.empty()) {
+		return appGroupName;
+	}
+
+	size_t size = configFingerprint.size() + 1 + appGroupName.size();
+	char *key = (char *) psg_pnalloc(pool, size);
+	char *pos = key;
+	char *end = key + size;
+	pos = appendData(pos, end, configFingerprint);
+	pos = appendData(pos, end, P_STATIC_STRING(":"));
+	pos = appendData(pos, end, appGroupName);
+	return StaticString(key, size);
+}
+
 void
 Controller::createNewPoolOptions(Client *client, Request *req,
-	const HashedStaticString &appGroupName)
+	const HashedStaticString &appGroupName, const StaticString &configFingerprint)
 {
 	ServerKit::HeaderTable &secureHeaders = req->secureHeaders;
 	Options &options = req->options;
@@ -304,11 +492,11 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 
 	options = Options();
 
-	const LString *scriptName = secureHeaders.lookup("!~SCRIPT_NAME");
-	const LString *appRoot = secureHeaders.lookup("!~PASSENGER_APP_ROOT");
+	const LString *scriptName = secureHeaders.lookup(SCRIPT_NAME);
+	const LString *appRoot = secureHeaders.lookup(PASSENGER_APP_ROOT);
 	if (scriptName == NULL || scriptName->size == 0) {
 		if (appRoot == NULL || appRoot->size == 0) {
-			const LString *documentRoot = secureHeaders.lookup("!~DOCUMENT_ROOT");
+			const LString *documentRoot = secureHeaders.lookup(DOCUMENT_ROOT);
 			if (OXT_UNLIKELY(documentRoot == NULL || documentRoot->size == 0)) {
 				disconnectWithError(&client, "client did not send a !~PASSENGER_APP_ROOT or a !~DOCUMENT_ROOT header");
 				return;
@@ -324,7 +512,7 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 		options.appRoot = HashedStaticString(appRoot->start->data, appRoot->size);
 	} else {
 		if (appRoot == NULL || appRoot->size == 0) {
-			const LString *documentRoot = secureHeaders.lookup("!~DOCUMENT_ROOT");
+			const LString *documentRoot = secureHeaders.lookup(DOCUMENT_ROOT);
 			if (OXT_UNLIKELY(documentRoot == NULL || documentRoot->size == 0)) {
 				disconnectWithError(&client, "client did not send a !~DOCUMENT_ROOT header");
 				return;
@@ -346,7 +534,7 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 
 	fillPoolOptionsFromAgentsOptions(options);
 
-	const LString *appType = secureHeaders.lookup("!~PASSENGER_APP_TYPE");
+	const LString *appType = secureHeaders.lookup(PASSENGER_APP_TYPE);
 	if (appType == NULL || appType->size == 0) {
 		AppTypeDetector detector;
 		PassengerAppType type = detector.checkAppRoot(options.appRoot);
@@ -375,7 +563,9 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	fillPoolOption(req, options.startCommand, "!~PASSENGER_START_COMMAND");
 	fillPoolOptionSecToMsec(req, options.startTimeout, "!~PASSENGER_START_TIMEOUT");
 	fillPoolOption(req, options.maxPreloaderIdleTime, "!~PASSENGER_MAX_PRELOADER_IDLE_TIME");
+	fillPoolOption(req, options.spawnConcurrency, "!~PASSENGER_SPAWN_CONCURRENCY");
 	fillPoolOption(req, options.maxRequestQueueSize, "!~PASSENGER_MAX_REQUEST_QUEUE_SIZE");
+	fillPoolOption(req, options.routingPolicy, "!~PASSENGER_ROUTING_POLICY");
 	fillPoolOption(req, options.abortWebsocketsOnProcessShutdown, "!~PASSENGER_ABORT_WEBSOCKETS_ON_PROCESS_SHUTDOWN");
 	fillPoolOption(req, options.forceMaxConcurrentRequestsPerProcess, "!~PASSENGER_FORCE_MAX_CONCURRENT_REQUESTS_PER_PROCESS");
 	fillPoolOption(req, options.restartDir, "!~PASSENGER_RESTART_DIR");
@@ -390,7 +580,16 @@ Controller::createNewPoolOptions(Client *client, Request *req,
 	optionsCopy->persist(options);
 	optionsCopy->clearPerRequestFields();
 	optionsCopy->detachFromUnionStationTransaction();
-	poolOptionsCache.insert(options.getAppGroupName(), optionsCopy);
+
+	PoolOptionsCacheEntry entry;
+	entry.options = optionsCopy;
+	entry.configFingerprint = configFingerprint;
+	entry.lastUsed = ev_now(getLoop());
+	if (poolOptionsCache.size() >= MAX_CONFIG_CACHE_SIZE) {
+		evictLeastRecentlyUsedEntry(poolOptionsCache);
+	}
+	poolOptionsCache.insert(getPoolOptionsCacheKey(req->pool,
+		options.getAppGroupName(), configFingerprint), entry);
 }
 
 void
@@ -399,14 +598,14 @@ Controller::initializeUnionStation(Client *client, Request *req, RequestAnalysis
 		Options &options = req->options;
 		ServerKit::HeaderTable &headers = req->secureHeaders;
 
-		const LString *key = headers.lookup("!~UNION_STATION_KEY");
+		const LString *key = headers.lookup(UNION_STATION_KEY);
 		if (key == NULL || key->size == 0) {
 			disconnectWithError(&client, "header !~UNION_STATION_KEY must be set.");
 			return;
 		}
 		key = psg_lstr_make_contiguous(key, req->pool);
 
-		const LString *filters = headers.lookup("!~UNION_STATION_FILTERS");
+		const LString *filters = headers.lookup(UNION_STATION_FILTERS);
 		if (filters != NULL) {
 			filters = psg_lstr_make_contiguous(filters, req->pool);
 		}
@@ -478,6 +677,10 @@ Controller::onRequestBegin(Client *client, Request *req) {
 	CC_BENCHMARK_POINT(client, req, BM_AFTER_ACCEPT);
 
 	{
+		if (!singleAppMode && !restoreCachedConfigHeaders(client, req)) {
+			return;
+		}
+
 		// Perform hash table operations as close to header parsing as possible,
 		// and localize them as much as possible, for better CPU caching.
 		RequestAnalysis analysis;
@@ -498,6 +701,7 @@ Controller::onRequestBegin(Client *client, Request *req) {
 
 		SKC_TRACE(client, 2, "Initiating request");
 		req->startedAt = ev_now(getLoop());
+		req->timestamps.requestBegun = SystemTime::getMonotonicUsec();
 		req->bodyChannel.stop();
 
 		initializeFlags(client, req, analysis);
@@ -51,6 +51,10 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 
 	  statThrottleRate(_agentsOptions->getInt("stat_throttle_rate")),
 	  responseBufferHighWatermark(_agentsOptions->getInt("response_buffer_high_watermark")),
+	  spliceThreshold(SplicePipePool::isAvailable()
+		? _agentsOptions->getUint("splice_threshold", false, DEFAULT_SPLICE_THRESHOLD)
+		: 0),
+	  appResponseTimeout(_agentsOptions->getUint("app_response_timeout", false, 0)),
 	  benchmarkMode(parseBenchmarkMode(_agentsOptions->get("benchmark_mode", false))),
 	  singleAppMode(false),
 	  showVersionInHeader(_agentsOptions->getBool("show_version_in_header")),
@@ -60,8 +64,13 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 	  agentsOptions(_agentsOptions),
 	  stringPool(psg_create_pool(1024 * 4)),
 	  poolOptionsCache(4),
+	  configHeadersCache(4),
 
 	  PASSENGER_APP_GROUP_NAME("!~PASSENGER_APP_GROUP_NAME"),
+	  PASSENGER_APP_ROOT("!~PASSENGER_APP_ROOT"),
+	  PASSENGER_APP_TYPE("!~PASSENGER_APP_TYPE"),
+	  PASSENGER_CACHED_CONFIG_FINGERPRINT("!~PASSENGER_CACHED_CONFIG_FINGERPRINT"),
+	  PASSENGER_CONFIG_FINGERPRINT("!~PASSENGER_CONFIG_FINGERPRINT"),
 	  PASSENGER_ENV_VARS("!~PASSENGER_ENV_VARS"),
 	  PASSENGER_MAX_REQUESTS("!~PASSENGER_MAX_REQUESTS"),
 	  PASSENGER_SHOW_VERSION_IN_HEADER("!~PASSENGER_SHOW_VERSION_IN_HEADER"),
@@ -69,6 +78,10 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 	  PASSENGER_STICKY_SESSIONS_COOKIE_NAME("!~PASSENGER_STICKY_SESSIONS_COOKIE_NAME"),
 	  PASSENGER_REQUEST_OOB_WORK("!~Request-OOB-Work"),
 	  UNION_STATION_SUPPORT("!~UNION_STATION_SUPPORT"),
+	  UNION_STATION_KEY("!~UNION_STATION_KEY"),
+	  UNION_STATION_FILTERS("!~UNION_STATION_FILTERS"),
+	  SCRIPT_NAME("!~SCRIPT_NAME"),
+	  DOCUMENT_ROOT("!~DOCUMENT_ROOT"),
 	  REMOTE_ADDR("!~REMOTE_ADDR"),
 	  REMOTE_PORT("!~REMOTE_PORT"),
 	  REMOTE_USER("!~REMOTE_USER"),
@@ -84,7 +97,12 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 	  HTTP_TRANSFER_ENCODING("transfer-encoding"),
 
 	  threadNumber(_threadNumber),
-	  turboCaching(getTurboCachingInitialState(_agentsOptions))
+	  turboCaching(getTurboCachingInitialState(_agentsOptions)),
+	  splicedRequestBodies(0),
+	  splicedRequestBodyBytes(0),
+	  splicedResponseBodies(0),
+	  splicedResponseBodyBytes(0),
+	  appResponseTimeouts(0)
 {
 	defaultRuby = psg_pstrdup(stringPool,
 		agentsOptions->get("default_ruby"));
@@ -109,6 +127,18 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 		defaultVaryTurbocacheByCookie = psg_pstrdup(stringPool,
 			agentsOptions->get("vary_turbocache_by_cookie"));
 	}
+	turboCaching.responseCache.configure(
+		agentsOptions->getUint("turbocache_max_entries", false,
+			DEFAULT_TURBOCACHE_MAX_ENTRIES),
+		agentsOptions->getUint("turbocache_max_body_size", false,
+			DEFAULT_TURBOCACHE_MAX_BODY_SIZE),
+		agentsOptions->getULL("turbocache_memory_limit", false,
+			DEFAULT_TURBOCACHE_MEMORY_LIMIT));
+	turboCaching.setGzipEnabled(agentsOptions->getBool("turbocache_gzip", false, false));
+
+	keepAliveTimeout = agentsOptions->getUint("keep_alive_timeout", false, 0);
+	requestHeaderTimeout = agentsOptions->getUint("request_header_timeout", false, 0);
+	requestBodyTimeout = agentsOptions->getUint("request_body_timeout", false, 0);
 
 	generateServerLogName(_threadNumber);
 
@@ -126,7 +156,9 @@ Controller::Controller(ServerKit::Context *context, const VariantMap *_agentsOpt
 			agentsOptions->get("app_type"));
 		options->startupFile = psg_pstrdup(stringPool,
 			agentsOptions->get("startup_file"));
-		poolOptionsCache.insert(options->getAppGroupName(), options);
+		PoolOptionsCacheEntry entry;
+		entry.options = options;
+		poolOptionsCache.insert(options->getAppGroupName(), entry);
 	}
 
 	ev_check_init(&checkWatcher, onEventLoopCheck);
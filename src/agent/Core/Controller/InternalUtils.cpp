@@ -61,6 +61,63 @@ Controller::generateServerLogName(unsigned int number) {
 	serverLogName = psg_pstrdup(stringPool, name);
 }
 
+/**
+ * Records the durations of the phases that this request went through into
+ * the latency histograms. Phases that the request didn't reach (e.g. because
+ * it was served from the turbocache, or because an error occurred) are
+ * skipped. Called from deinitializeRequest(), which may be called more than
+ * once per request, so this resets the timestamps afterwards.
+ */
+void
+Controller::recordLatencyStats(Request *req) {
+	const MonotonicTimeUsec headerBegun = req->timestamps.headerBegun;
+	const MonotonicTimeUsec requestBegun = req->timestamps.requestBegun;
+	const MonotonicTimeUsec checkoutBegun = req->timestamps.checkoutBegun;
+	const MonotonicTimeUsec sessionCheckedOut = req->timestamps.sessionCheckedOut;
+	const MonotonicTimeUsec sessionInitiated = req->timestamps.sessionInitiated;
+	const MonotonicTimeUsec appResponseBegun = req->timestamps.appResponseBegun;
+
+	if (requestBegun == 0) {
+		// The request header was never fully parsed.
+		memset(&req->timestamps, 0, sizeof(req->timestamps));
+		return;
+	}
+
+	MonotonicTimeUsec now = SystemTime::getMonotonicUsec();
+	RequestLatencyStats *stats[2];
+	unsigned int nstats = 0;
+
+	stats[nstats++] = &latencyStats.getOverall();
+	if (checkoutBegun != 0 && !req->options.getAppGroupName().empty()) {
+		// The pool options (and thus the app group name) are only
+		// initialized for requests that are forwarded to an application.
+		stats[nstats++] = &latencyStats.getForAppGroup(
+			req->options.getAppGroupName(), now);
+	}
+
+	for (unsigned int i = 0; i < nstats; i++) {
+		RequestLatencyStats *s = stats[i];
+		if (headerBegun != 0) {
+			s->headerParse.record(requestBegun - headerBegun);
+			s->total.record(now - headerBegun);
+		} else {
+			s->total.record(now - requestBegun);
+		}
+		if (checkoutBegun != 0 && sessionCheckedOut != 0) {
+			s->poolCheckout.record(sessionCheckedOut - checkoutBegun);
+		}
+		if (sessionCheckedOut != 0 && sessionInitiated != 0) {
+			s->appConnect.record(sessionInitiated - sessionCheckedOut);
+		}
+		if (appResponseBegun != 0) {
+			s->timeToFirstByte.record(appResponseBegun - requestBegun);
+			s->responseForwarding.record(now - appResponseBegun);
+		}
+	}
+
+	memset(&req->timestamps, 0, sizeof(req->timestamps));
+}
+
 void
 Controller::disconnectWithClientSocketWriteError(Client **client, int e) {
 	stringstream message;
@@ -0,0 +1,227 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_
+#define _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_
+
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <string>
+#include <jsoncpp/json.h>
+
+#include <StaticString.h>
+#include <DataStructures/StringKeyTable.h>
+#include <Algorithms/LatencyHistogram.h>
+#include <Utils/SystemTime.h>
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+
+
+/**
+ * Latency histograms for the phases that a request goes through in the
+ * Controller. All values are in microseconds.
+ *
+ *  - headerParse: from the first byte of the request header until the
+ *    header has been fully parsed.
+ *  - poolCheckout: from the moment a session is requested from the
+ *    ApplicationPool until it is handed to us (includes queueing and spawning).
+ *  - appConnect: from the moment the session is handed to us until the
+ *    connection to the application process has been established.
+ *  - timeToFirstByte: from the end of header parsing until the application's
+ *    response header begins.
+ *  - responseForwarding: from the beginning of the application's response
+ *    until the request ends.
+ *  - total: from the first byte of the request header until the request ends.
+ */
+struct RequestLatencyStats {
+	LatencyHistogram headerParse;
+	LatencyHistogram poolCheckout;
+	LatencyHistogram appConnect;
+	LatencyHistogram timeToFirstByte;
+	LatencyHistogram responseForwarding;
+	LatencyHistogram total;
+	/** When something was last recorded into these stats. */
+	MonotonicTimeUsec lastRecordTime;
+
+	RequestLatencyStats()
+		: lastRecordTime(0)
+		{ }
+
+	void merge(const RequestLatencyStats &other) {
+		headerParse.merge(other.headerParse);
+		poolCheckout.merge(other.poolCheckout);
+		appConnect.merge(other.appConnect);
+		timeToFirstByte.merge(other.timeToFirstByte);
+		responseForwarding.merge(other.responseForwarding);
+		total.merge(other.total);
+		lastRecordTime = std::max(lastRecordTime, other.lastRecordTime);
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc;
+		doc["header_parse"] = headerParse.inspectAsJson();
+		doc["pool_checkout"] = poolCheckout.inspectAsJson();
+		doc["app_connect"] = appConnect.inspectAsJson();
+		doc["time_to_first_byte"] = timeToFirstByte.inspectAsJson();
+		doc["response_forwarding"] = responseForwarding.inspectAsJson();
+		doc["total"] = total.inspectAsJson();
+		return doc;
+	}
+};
+
+typedef boost::shared_ptr<RequestLatencyStats> RequestLatencyStatsPtr;
+
+
+/**
+ * RequestLatencyStats for all requests, plus a breakdown per application group.
+ *
+ * Each Controller owns one of these and only touches it from its own event
+ * loop thread. To produce a report, copy the stats of every Controller
+ * into a new object with `merge()` (from within that Controller's thread),
+ * then merge those copies. `merge()` never shares RequestLatencyStats
+ * objects with the source, so the result can be safely handed to another
+ * thread.
+ *
+ * App groups are never told to us when they go away, so a Controller keeps
+ * stats for at most MAX_APP_GROUPS app groups. When a new app group comes in,
+ * the stats of the app group that was recorded into least recently are
+ * dropped.
+ */
+class RequestLatencyStatsSet {
+public:
+	static const unsigned int MAX_APP_GROUPS = 64;
+
+private:
+	RequestLatencyStats overall;
+	StringKeyTable<RequestLatencyStatsPtr> byAppGroup;
+
+	RequestLatencyStats &lookupOrCreate(const HashedStaticString &appGroupName) {
+		RequestLatencyStatsPtr *stats;
+
+		if (byAppGroup.lookup(appGroupName, &stats)) {
+			return **stats;
+		} else {
+			RequestLatencyStatsPtr newStats = boost::make_shared<RequestLatencyStats>();
+			byAppGroup.insert(appGroupName, newStats);
+			return *newStats;
+		}
+	}
+
+	void removeLeastRecentlyRecordedAppGroup() {
+		StringKeyTable<RequestLatencyStatsPtr>::Iterator it(byAppGroup);
+		StringKeyTable<RequestLatencyStatsPtr>::Cell *oldest = NULL;
+
+		while (*it != NULL) {
+			if (oldest == NULL
+			 || it.getValue()->lastRecordTime < oldest->value->lastRecordTime)
+			{
+				oldest = *it;
+			}
+			it.next();
+		}
+		if (oldest != NULL) {
+			byAppGroup.erase(oldest);
+			// Reclaims the storage of the erased key.
+			byAppGroup.compact();
+		}
+	}
+
+public:
+	RequestLatencyStatsSet()
+		: byAppGroup(4)
+		{ }
+
+	RequestLatencyStats &getOverall() {
+		return overall;
+	}
+
+	/**
+	 * Returns the stats for the given application group, creating them if
+	 * they don't exist yet, in order to record into them at time `now`.
+	 */
+	RequestLatencyStats &getForAppGroup(const HashedStaticString &appGroupName,
+		MonotonicTimeUsec now)
+	{
+		RequestLatencyStatsPtr *stats;
+
+		if (!byAppGroup.lookup(appGroupName, &stats)
+		 && byAppGroup.size() >= MAX_APP_GROUPS)
+		{
+			removeLeastRecentlyRecordedAppGroup();
+		}
+
+		RequestLatencyStats &result = lookupOrCreate(appGroupName);
+		result.lastRecordTime = now;
+		return result;
+	}
+
+	unsigned int getAppGroupCount() const {
+		return byAppGroup.size();
+	}
+
+	bool hasAppGroup(const HashedStaticString &appGroupName) const {
+		const RequestLatencyStatsPtr *stats;
+		return byAppGroup.lookup(appGroupName, &stats);
+	}
+
+	/**
+	 * Does not drop any app groups, so the result may contain more than
+	 * MAX_APP_GROUPS of them.
+	 */
+	void merge(const RequestLatencyStatsSet &other) {
+		StringKeyTable<RequestLatencyStatsPtr>::ConstIterator it(other.byAppGroup);
+
+		overall.merge(other.overall);
+		while (*it != NULL) {
+			lookupOrCreate(it.getKey()).merge(*it.getValue());
+			it.next();
+		}
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc = overall.inspectAsJson();
+		Json::Value groupsDoc(Json::objectValue);
+		StringKeyTable<RequestLatencyStatsPtr>::ConstIterator it(byAppGroup);
+
+		while (*it != NULL) {
+			groupsDoc[it.getKey().toString()] = it.getValue()->inspectAsJson();
+			it.next();
+		}
+		doc["app_groups"] = groupsDoc;
+		return doc;
+	}
+};
+
+typedef boost::shared_ptr<RequestLatencyStatsSet> RequestLatencyStatsSetPtr;
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_LATENCY_STATS_H_ */
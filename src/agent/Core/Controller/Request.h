@@ -27,18 +27,22 @@
 #define _PASSENGER_REQUEST_HANDLER_REQUEST_H_
 
 #include <ev++.h>
+#include <boost/atomic.hpp>
 #include <string>
 #include <cstring>
 
 #include <ServerKit/HttpRequest.h>
 #include <ServerKit/FdSinkChannel.h>
 #include <ServerKit/FdSourceChannel.h>
+#include <ServerKit/TimerWheel.h>
 #include <Logging.h>
+#include <Utils/SystemTime.h>
 #include <Core/ApplicationPool/Pool.h>
 #include <Core/UnionStation/Context.h>
 #include <Core/UnionStation/Transaction.h>
 #include <Core/UnionStation/StopwatchLog.h>
 #include <Core/Controller/AppResponse.h>
+#include <Core/Controller/SplicePipePool.h>
 
 namespace Passenger {
 namespace Core {
@@ -86,6 +90,41 @@ public:
 	AbstractSessionPtr session;
 	const LString *host;
 
+	// Used while a non-blocking connect to the application is in progress.
+	struct ev_io sessionConnectWatcher;
+	struct ev_timer sessionConnectTimer;
+	// Armed while the application owes us the beginning of a response.
+	// See Controller::armAppResponseTimeout().
+	ServerKit::Timer appResponseTimer;
+	// Set when the request ends. Read by the ApplicationPool (from any
+	// thread) to drop the request from its queue if we're no longer
+	// waiting for a session. See GetCallback::isAbandoned.
+	boost::atomic<bool> checkoutAbandoned;
+
+	// Used while the request body is forwarded with splice(), instead of
+	// through bodyChannel and appSink. The pipe is only open during that
+	// time, and `requestBodySplicePipeBytes` is the amount of body data in
+	// it that still has to be written to the application.
+	struct ev_io requestBodySpliceWatcher;
+	SplicePipePool::Pipe requestBodySplicePipe;
+	unsigned int requestBodySplicePipeBytes;
+	// Likewise for the response body, which is then forwarded without
+	// appSource and client->output.
+	struct ev_io responseBodySpliceWatcher;
+	SplicePipePool::Pipe responseBodySplicePipe;
+	unsigned int responseBodySplicePipeBytes;
+
+	// Monotonic timestamps of the request lifecycle phases, used for
+	// the latency histograms. 0 means that the phase has not been reached.
+	struct {
+		MonotonicTimeUsec headerBegun;
+		MonotonicTimeUsec requestBegun;
+		MonotonicTimeUsec checkoutBegun;
+		MonotonicTimeUsec sessionCheckedOut;
+		MonotonicTimeUsec sessionInitiated;
+		MonotonicTimeUsec appResponseBegun;
+	} timestamps;
+
 	ServerKit::FdSinkChannel appSink;
 	ServerKit::FdSourceChannel appSource;
 	AppResponse appResponse;
@@ -123,6 +162,8 @@ public:
 		: BaseHttpRequest()
 	{
 		memset(&stopwatchLogs, 0, sizeof(stopwatchLogs));
+		memset(&timestamps, 0, sizeof(timestamps));
+		checkoutAbandoned.store(false, boost::memory_order_relaxed);
 	}
 
 	const char *getStateString() const {
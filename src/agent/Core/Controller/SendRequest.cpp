@@ -124,6 +124,7 @@ Controller::sendHeaderToApp(Client *client, Request *req) {
 
 	UPDATE_TRACE_POINT();
 	if (!req->ended()) {
+		armAppResponseTimeout(req);
 		if (req->appSink.acceptingInput()) {
 			UPDATE_TRACE_POINT();
 			sendBodyToApp(client, req);
@@ -1005,6 +1006,7 @@ Controller::whenSendingRequest_onRequestBody(Client *client, Request *req,
 				cEscapeString(StaticString(buffer.start, buffer.size())) <<
 				"\"");
 		}
+		armAppResponseTimeout(req);
 		req->appSink.feed(buffer);
 		if (!req->appSink.acceptingInput()) {
 			if (req->appSink.mayAcceptInputLater()) {
@@ -1025,6 +1027,13 @@ Controller::whenSendingRequest_onRequestBody(Client *client, Request *req,
 				req->state = Request::WAITING_FOR_APP_OUTPUT;
 				stopBodyChannel(client, req);
 			}
+		} else if (shouldSpliceRequestBody(client, req)
+			&& beginSplicingRequestBody(client, req))
+		{
+			// Stopping bodyChannel also stops the HttpServer from
+			// reading from the client socket. We read the rest of the
+			// body from the client socket ourselves.
+			stopBodyChannel(client, req);
 		}
 		return Channel::Result(buffer.size(), false);
 	} else if (errcode == 0 || errcode == ECONNRESET) {
@@ -1094,6 +1103,165 @@ Controller::stopBodyChannel(Client *client, Request *req) {
 	}
 }
 
+/**
+ * Whether the remainder of the request body should be forwarded with
+ * splice(), directly from the client socket to the application socket,
+ * instead of being read into mbufs and written to the application from
+ * there. Must only be called from whenSendingRequest_onRequestBody(),
+ * after the data passed to it has been fully written to the application.
+ * At that point, the HttpServer has no unprocessed client data left.
+ *
+ * Only bodies with a known remaining length can be spliced, because
+ * chunked bodies have to be parsed, and an upgraded connection has no end.
+ */
+bool
+Controller::shouldSpliceRequestBody(Client *client, Request *req) const {
+	return spliceThreshold > 0
+		&& req->bodyType == Request::RBT_CONTENT_LENGTH
+		&& !req->requestBodyBuffering
+		&& req->aux.bodyInfo.contentLength - req->bodyAlreadyRead >= spliceThreshold
+		&& req->appSink.acceptingInput();
+}
+
+bool
+Controller::beginSplicingRequestBody(Client *client, Request *req) {
+	if (!splicePipePool.acquire(req->requestBodySplicePipe)) {
+		int e = errno;
+		SKC_DEBUG(client, "Cannot create a pipe for splicing the request body, "
+			"forwarding it normally instead: " << strerror(e) << " (errno=" << e << ")");
+		return false;
+	}
+
+	SKC_TRACE(client, 2, "Forwarding remaining " <<
+		(req->aux.bodyInfo.contentLength - req->bodyAlreadyRead) <<
+		" bytes of request body with splice()");
+	req->requestBodySplicePipeBytes = 0;
+	splicedRequestBodies++;
+	waitForSpliceEvent(&req->requestBodySpliceWatcher, client->getFd(), EV_READ);
+	return true;
+}
+
+void
+Controller::onRequestBodySpliceEvent(EV_P_ struct ev_io *w, int revents) {
+	Request *req = static_cast<Request *>(w->data);
+	Client *client = static_cast<Client *>(req->client);
+	Controller *self = static_cast<Controller *>(getServerFromClient(client));
+	SKC_LOG_EVENT_FROM_STATIC(self, Controller, client, "onRequestBodySpliceEvent");
+
+	self->continueSplicingRequestBody(client, req);
+}
+
+/**
+ * Alternately fills the pipe from the client socket and drains it into
+ * the application socket, until either socket would block.
+ */
+void
+Controller::continueSplicingRequestBody(Client *client, Request *req) {
+	TRACE_POINT();
+	// Limit the amount of work per event loop iteration so that
+	// other clients are not starved.
+	const unsigned int MAX_ITERATIONS = 16;
+	ssize_t ret;
+	int e;
+
+	P_ASSERT_EQ(req->state, Request::FORWARDING_BODY_TO_APP);
+
+	for (unsigned int i = 0; i < MAX_ITERATIONS; i++) {
+		if (req->requestBodySplicePipeBytes > 0) {
+			ret = SplicePipePool::transfer(req->requestBodySplicePipe.readFd,
+				req->session->fd(), req->requestBodySplicePipeBytes);
+			if (ret > 0) {
+				req->requestBodySplicePipeBytes -= ret;
+				splicedRequestBodyBytes += ret;
+				armAppResponseTimeout(req);
+				continue;
+			}
+
+			e = errno;
+			if (ret == -1 && (e == EAGAIN || e == EWOULDBLOCK)) {
+				waitForSpliceEvent(&req->requestBodySpliceWatcher, req->session->fd(), EV_WRITE);
+			} else {
+				// Handled just like an appSink write error: ForwardResponse.cpp
+				// will forward the response data and end the request.
+				stopSplicingRequestBody(req);
+				logAppSocketWriteError(client, (ret == 0) ? EPIPE : e);
+				req->state = Request::WAITING_FOR_APP_OUTPUT;
+			}
+			return;
+		}
+
+		boost::uint64_t remaining = req->aux.bodyInfo.contentLength - req->bodyAlreadyRead;
+		if (remaining == 0) {
+			finishSplicingRequestBody(client, req);
+			return;
+		}
+
+		ret = SplicePipePool::transfer(client->getFd(), req->requestBodySplicePipe.writeFd,
+			std::min<boost::uint64_t>(remaining, req->requestBodySplicePipe.capacity));
+		if (ret > 0) {
+			req->bodyAlreadyRead += ret;
+			req->requestBodySplicePipeBytes = ret;
+			req->lastDataReceiveTime = ev_now(getLoop());
+			SKC_TRACE(client, 3, "Spliced " << ret << " bytes of client request body (" <<
+				req->bodyAlreadyRead << " of " << req->aux.bodyInfo.contentLength <<
+				" bytes forwarded in total)");
+			continue;
+		}
+
+		e = errno;
+		if (ret == -1 && (e == EAGAIN || e == EWOULDBLOCK)) {
+			waitForSpliceEvent(&req->requestBodySpliceWatcher, client->getFd(), EV_READ);
+		} else {
+			// Handled just like an error reported by bodyChannel.
+			stopSplicingRequestBody(req);
+			whenSendingRequest_onRequestBody(client, req, MemoryKit::mbuf(),
+				(ret == 0) ? (int) ServerKit::UNEXPECTED_EOF : e);
+		}
+		return;
+	}
+
+	// Both sockets are probably still ready, but give other
+	// clients a chance first.
+	if (req->requestBodySplicePipeBytes > 0) {
+		waitForSpliceEvent(&req->requestBodySpliceWatcher, req->session->fd(), EV_WRITE);
+	} else {
+		waitForSpliceEvent(&req->requestBodySpliceWatcher, client->getFd(), EV_READ);
+	}
+}
+
+void
+Controller::waitForSpliceEvent(struct ev_io *watcher, int fd, int events) {
+	if (watcher->fd != fd || watcher->events != events) {
+		ev_io_stop(getLoop(), watcher);
+		ev_io_set(watcher, fd, events);
+	}
+	ev_io_start(getLoop(), watcher);
+}
+
+/**
+ * Called when the entire request body has been spliced. Hands control back
+ * to the HttpServer: restarting bodyChannel makes it pass the end of the
+ * body to whenSendingRequest_onRequestBody(), just like it does when the
+ * body was forwarded normally.
+ */
+void
+Controller::finishSplicingRequestBody(Client *client, Request *req) {
+	SKC_TRACE(client, 2, "End of request body reached");
+	stopSplicingRequestBody(req);
+	req->detectingNextRequestEarlyReadError = true;
+	client->input.start();
+	startBodyChannel(client, req);
+}
+
+void
+Controller::stopSplicingRequestBody(Request *req) {
+	if (req->requestBodySplicePipe.isOpen()) {
+		ev_io_stop(getLoop(), &req->requestBodySpliceWatcher);
+		splicePipePool.release(req->requestBodySplicePipe, req->requestBodySplicePipeBytes == 0);
+		req->requestBodySplicePipeBytes = 0;
+	}
+}
+
 void
 Controller::logAppSocketWriteError(Client *client, int errcode) {
 	if (errcode == EPIPE) {
@@ -0,0 +1,200 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONTROLLER_SPLICE_PIPE_POOL_H_
+#define _PASSENGER_CORE_CONTROLLER_SPLICE_PIPE_POOL_H_
+
+#include <boost/cstdint.hpp>
+#include <oxt/system_calls.hpp>
+#include <vector>
+#include <cerrno>
+#include <cassert>
+#include <unistd.h>
+#include <fcntl.h>
+
+#if defined(__linux__) && defined(SPLICE_F_MOVE) && defined(F_SETPIPE_SZ)
+	#define PASSENGER_SPLICE_AVAILABLE
+#endif
+
+namespace Passenger {
+namespace Core {
+
+using namespace std;
+
+
+/**
+ * A pool of pipes for moving data between two sockets with splice(),
+ * without copying it through userspace. splice() can only move data
+ * between a pipe and another file descriptor, so data is spliced from
+ * the source socket into a pipe, and from the pipe into the destination
+ * socket.
+ *
+ * A pipe is acquired for the duration of a transfer. If a pipe is released
+ * while it still contains data, then it is closed instead of being returned
+ * to the pool, because that data can't be removed.
+ *
+ * On platforms without splice(), `isAvailable()` returns false and
+ * `acquire()` always fails.
+ *
+ * This class is not thread-safe; every Controller has its own pool.
+ */
+class SplicePipePool {
+public:
+	struct Pipe {
+		int readFd;
+		int writeFd;
+		/** The number of bytes that the pipe can hold. */
+		unsigned int capacity;
+
+		Pipe()
+			: readFd(-1),
+			  writeFd(-1),
+			  capacity(0)
+			{ }
+
+		bool isOpen() const {
+			return readFd != -1;
+		}
+	};
+
+	/** The pipe capacity that we ask the kernel for. */
+	static const unsigned int PIPE_SIZE = 256 * 1024;
+
+private:
+	vector<Pipe> idle;
+	unsigned int maxIdle;
+	unsigned int inUse;
+
+	static void closePipe(Pipe &pipe) {
+		oxt::syscalls::close(pipe.readFd);
+		oxt::syscalls::close(pipe.writeFd);
+		pipe = Pipe();
+	}
+
+public:
+	SplicePipePool(unsigned int _maxIdle = 16)
+		: maxIdle(_maxIdle),
+		  inUse(0)
+		{ }
+
+	~SplicePipePool() {
+		for (unsigned int i = 0; i < idle.size(); i++) {
+			closePipe(idle[i]);
+		}
+	}
+
+	static bool isAvailable() {
+		#ifdef PASSENGER_SPLICE_AVAILABLE
+			return true;
+		#else
+			return false;
+		#endif
+	}
+
+	/**
+	 * Obtains an empty pipe, either from the pool or by creating a new one.
+	 * Both ends are non-blocking. Returns false if no pipe could be created,
+	 * in which case `errno` is set.
+	 */
+	bool acquire(Pipe &pipe) {
+		#ifdef PASSENGER_SPLICE_AVAILABLE
+			if (!idle.empty()) {
+				pipe = idle.back();
+				idle.pop_back();
+				inUse++;
+				return true;
+			}
+
+			int fds[2];
+			if (pipe2(fds, O_NONBLOCK | O_CLOEXEC) == -1) {
+				return false;
+			}
+			pipe.readFd = fds[0];
+			pipe.writeFd = fds[1];
+
+			// A larger pipe means fewer splice() calls per transfer.
+			// This may fail because of /proc/sys/fs/pipe-max-size, in which
+			// case we just use the default size.
+			fcntl(pipe.writeFd, F_SETPIPE_SZ, (int) PIPE_SIZE);
+			int size = fcntl(pipe.writeFd, F_GETPIPE_SZ);
+			pipe.capacity = (size > 0) ? size : 4096;
+
+			inUse++;
+			return true;
+		#else
+			errno = ENOSYS;
+			return false;
+		#endif
+	}
+
+	/**
+	 * Gives back a pipe obtained with `acquire()`. `empty` indicates whether
+	 * all data that was spliced into the pipe has also been spliced out of it.
+	 */
+	void release(Pipe &pipe, bool empty) {
+		assert(pipe.isOpen());
+		assert(inUse > 0);
+		inUse--;
+		if (empty && idle.size() < maxIdle) {
+			idle.push_back(pipe);
+			pipe = Pipe();
+		} else {
+			closePipe(pipe);
+		}
+	}
+
+	/**
+	 * Moves up to `size` bytes from `fromFd` to `toFd` with splice(). One of
+	 * them must be a pipe. Returns the number of bytes moved, 0 on EOF,
+	 * or -1 on error (with `errno` set). Never blocks on the pipe.
+	 */
+	static ssize_t transfer(int fromFd, int toFd, size_t size) {
+		#ifdef PASSENGER_SPLICE_AVAILABLE
+			ssize_t ret;
+			do {
+				ret = splice(fromFd, NULL, toFd, NULL, size,
+					SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+			} while (ret == -1 && errno == EINTR);
+			return ret;
+		#else
+			errno = ENOSYS;
+			return -1;
+		#endif
+	}
+
+	unsigned int getIdleCount() const {
+		return idle.size();
+	}
+
+	unsigned int getInUseCount() const {
+		return inUse;
+	}
+};
+
+
+} // namespace Core
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONTROLLER_SPLICE_PIPE_POOL_H_ */
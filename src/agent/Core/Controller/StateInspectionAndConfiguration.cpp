@@ -53,6 +53,11 @@ Controller::getConfigAsJson() const {
 	doc["stat_throttle_rate"] = statThrottleRate;
 	doc["show_version_in_header"] = showVersionInHeader;
 	doc["data_buffer_dir"] = getContext()->defaultFileBufferedChannelConfig.bufferDir;
+	doc["turbocache_max_entries"] = turboCaching.responseCache.getMaxEntries();
+	doc["turbocache_max_body_size"] = turboCaching.responseCache.getMaxBodySize();
+	doc["turbocache_memory_limit"] = (Json::UInt64) turboCaching.responseCache.getMemoryLimit();
+	doc["splice_threshold"] = spliceThreshold;
+	doc["app_response_timeout"] = appResponseTimeout;
 	return doc;
 }
 
@@ -66,11 +71,29 @@ Controller::configure(const Json::Value &doc) {
 		getContext()->defaultFileBufferedChannelConfig.bufferDir =
 			doc["data_buffer_dir"].asString();
 	}
+	if (doc.isMember("turbocache_max_entries")
+	 || doc.isMember("turbocache_max_body_size")
+	 || doc.isMember("turbocache_memory_limit"))
+	{
+		ResponseCache<Request> &cache = turboCaching.responseCache;
+		cache.configure(
+			doc.get("turbocache_max_entries", cache.getMaxEntries()).asUInt(),
+			doc.get("turbocache_max_body_size", cache.getMaxBodySize()).asUInt(),
+			doc.get("turbocache_memory_limit",
+				(Json::UInt64) cache.getMemoryLimit()).asUInt64());
+	}
+	if (doc.isMember("splice_threshold") && SplicePipePool::isAvailable()) {
+		spliceThreshold = doc["splice_threshold"].asUInt();
+	}
+	if (doc.isMember("app_response_timeout")) {
+		appResponseTimeout = doc["app_response_timeout"].asUInt();
+	}
 }
 
 Json::Value
 Controller::inspectStateAsJson() const {
 	Json::Value doc = ParentClass::inspectStateAsJson();
+	doc["timed_out_clients"]["app_response"] = (Json::UInt64) appResponseTimeouts;
 	if (turboCaching.isEnabled()) {
 		Json::Value subdoc;
 		subdoc["fetches"] = turboCaching.responseCache.getFetches();
@@ -79,8 +102,39 @@ Controller::inspectStateAsJson() const {
 		subdoc["stores"] = turboCaching.responseCache.getStores();
 		subdoc["store_successes"] = turboCaching.responseCache.getStoreSuccesses();
 		subdoc["store_success_ratio"] = turboCaching.responseCache.getStoreSuccessRatio();
+		subdoc["entries"] = turboCaching.responseCache.getCount();
+		subdoc["max_entries"] = turboCaching.responseCache.getMaxEntries();
+		subdoc["memory_usage"] = byteSizeToJson(turboCaching.responseCache.getMemoryUsage());
+		subdoc["memory_limit"] = byteSizeToJson(turboCaching.responseCache.getMemoryLimit());
+		subdoc["total_hits"] = (Json::UInt64) turboCaching.responseCache.getTotalHits();
+		subdoc["total_misses"] = (Json::UInt64) turboCaching.responseCache.getTotalMisses();
+		subdoc["total_evictions"] = (Json::UInt64) turboCaching.responseCache.getTotalEvictions();
 		doc["turbocaching"] = subdoc;
 	}
+	if (unionStationContext != NULL && !unionStationContext->isNull()) {
+		UnionStation::BatchWriter::Stats stats =
+			unionStationContext->getWriter()->getStats();
+		Json::Value subdoc;
+		subdoc["queued"] = stats.queued;
+		subdoc["peak_queued"] = stats.peakQueued;
+		subdoc["max_queued"] = unionStationContext->getWriter()->getMaxQueuedMessages();
+		subdoc["written"] = (Json::UInt64) stats.written;
+		subdoc["batches"] = (Json::UInt64) stats.batches;
+		subdoc["dropped"] = (Json::UInt64) stats.dropped;
+		subdoc["rejected"] = (Json::UInt64) stats.rejected;
+		subdoc["failed"] = (Json::UInt64) stats.failed;
+		doc["union_station"] = subdoc;
+	}
+	if (SplicePipePool::isAvailable()) {
+		Json::Value subdoc;
+		subdoc["request_bodies"] = (Json::UInt64) splicedRequestBodies;
+		subdoc["request_body_bytes"] = byteSizeToJson(splicedRequestBodyBytes);
+		subdoc["response_bodies"] = (Json::UInt64) splicedResponseBodies;
+		subdoc["response_body_bytes"] = byteSizeToJson(splicedResponseBodyBytes);
+		subdoc["pipes_in_use"] = splicePipePool.getInUseCount();
+		subdoc["pipes_idle"] = splicePipePool.getIdleCount();
+		doc["splice"] = subdoc;
+	}
 	return doc;
 }
 
@@ -110,6 +164,10 @@ Controller::inspectRequestStateAsJson(const Request *req) const {
 	flags["dechunk_response"] = req->dechunkResponse;
 	flags["request_body_buffering"] = req->requestBodyBuffering;
 	flags["https"] = req->https;
+	flags["connecting_to_app"] = ev_is_active(&req->sessionConnectWatcher)
+		|| ev_is_active(&req->sessionConnectTimer);
+	flags["splicing_request_body"] = req->requestBodySplicePipe.isOpen();
+	flags["splicing_response_body"] = req->responseBodySplicePipe.isOpen();
 	doc["flags"] = flags;
 
 	if (req->requestBodyBuffering) {
@@ -157,6 +215,11 @@ Controller::inspectRequestStateAsJson(const Request *req) const {
 	return doc;
 }
 
+const RequestLatencyStatsSet &
+Controller::getLatencyStats() const {
+	return latencyStats;
+}
+
 
 } // namespace Core
 } // namespace Passenger
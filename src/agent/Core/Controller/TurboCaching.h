@@ -28,9 +28,11 @@
 
 #include <oxt/backtrace.hpp>
 #include <ev++.h>
+#include <zlib.h>
 #include <ctime>
 #include <cstddef>
 #include <cassert>
+#include <cstring>
 #include <MemoryKit/mbuf.h>
 #include <ServerKit/Context.h>
 #include <Constants.h>
@@ -57,6 +59,8 @@ public:
 	 */
 	static const unsigned int FETCH_THRESHOLD = 20;
 	static const unsigned int STORE_THRESHOLD = 20;
+	/** Smaller response bodies are not worth compressing. */
+	static const unsigned int MIN_GZIP_BODY_SIZE = 256;
 
 	OXT_FORCE_INLINE static double MIN_HIT_RATIO() { return 0.5; }
 	OXT_FORCE_INLINE static double MIN_STORE_SUCCESS_RATIO() { return 0.5; }
@@ -85,6 +89,11 @@ public:
 private:
 	State state;
 	ev_tstamp lastTimeout, nextTimeout;
+	bool gzipEnabled;
+	/** Reused for every compression, so that we don't allocate the
+	 * deflate state for every stored response. */
+	z_stream zstream;
+	bool zstreamInitialized;
 
 	struct ResponsePreparation {
 		Request *req;
@@ -92,8 +101,11 @@ private:
 
 		time_t now;
 		time_t age;
+		const char *bodyData;
+		unsigned int bodySize;
 		unsigned int ageValueSize;
 		unsigned int contentLengthStrSize;
+		bool gzip;
 		bool showVersionInHeader;
 	};
 
@@ -111,8 +123,18 @@ private:
 			prep.age = 0;
 		}
 
+		prep.gzip = entry.body->httpGzipBodySize > 0
+			&& responseCache.requestAcceptsGzip(req);
+		if (prep.gzip) {
+			prep.bodyData = entry.body->httpGzipBodyData;
+			prep.bodySize = entry.body->httpGzipBodySize;
+		} else {
+			prep.bodyData = entry.body->httpBodyData;
+			prep.bodySize = entry.body->httpBodySize;
+		}
+
 		prep.ageValueSize = integerSizeInOtherBase<time_t, 10>(prep.age);
-		prep.contentLengthStrSize = uintSizeAsString(entry.body->httpBodySize);
+		prep.contentLengthStrSize = uintSizeAsString(prep.bodySize);
 		prep.showVersionInHeader = server->showVersionInHeader;
 	}
 
@@ -145,11 +167,20 @@ private:
 		PUSH_STATIC_STRING("Content-Length: ");
 		result += prep.contentLengthStrSize;
 		if (output != NULL) {
-			uintToString(entry->body->httpBodySize, pos, end - pos);
+			uintToString(prep.bodySize, pos, end - pos);
 			pos += prep.contentLengthStrSize;
 		}
 		PUSH_STATIC_STRING("\r\n");
 
+		if (prep.gzip) {
+			PUSH_STATIC_STRING("Content-Encoding: gzip\r\n");
+		}
+		if (entry->body->httpGzipBodySize > 0) {
+			// Responses with a Vary header are never cached, so we
+			// don't have to merge this with an existing one.
+			PUSH_STATIC_STRING("Vary: Accept-Encoding\r\n");
+		}
+
 		PUSH_STATIC_STRING("Age: ");
 		result += prep.ageValueSize;
 		if (output != NULL) {
@@ -195,7 +226,9 @@ public:
 	TurboCaching(State initialState = ENABLED)
 		: state(initialState),
 		  lastTimeout((ev_tstamp) time(NULL)),
-		  nextTimeout((ev_tstamp) time(NULL) + ENABLED_TIMEOUT)
+		  nextTimeout((ev_tstamp) time(NULL) + ENABLED_TIMEOUT),
+		  gzipEnabled(false),
+		  zstreamInitialized(false)
 	{
 		if (initialState != ENABLED && initialState != DISABLED) {
 			throw RuntimeException("The initial turbocaching state may "
@@ -203,10 +236,78 @@ public:
 		}
 	}
 
+	~TurboCaching() {
+		if (zstreamInitialized) {
+			deflateEnd(&zstream);
+		}
+	}
+
 	bool isEnabled() const {
 		return state == ENABLED;
 	}
 
+	/**
+	 * Sets whether responses are also stored as a gzip variant,
+	 * which is served to clients that accept gzip.
+	 */
+	void setGzipEnabled(bool enabled) {
+		gzipEnabled = enabled;
+	}
+
+	bool isGzipEnabled() const {
+		return gzipEnabled;
+	}
+
+	/**
+	 * Gzip-compresses a response body into memory allocated from the
+	 * request's pool. Returns the compressed size, or 0 if the body
+	 * is not worth storing in compressed form.
+	 *
+	 * @pre responseCache.responseAllowsCompression(req)
+	 */
+	unsigned int compressBody(Request *req, const LString *body, char **output) {
+		if (body->size < MIN_GZIP_BODY_SIZE) {
+			return 0;
+		}
+
+		if (!zstreamInitialized) {
+			memset(&zstream, 0, sizeof(zstream));
+			// 15 + 16: a 32 KB window and a gzip header instead of a zlib header.
+			if (deflateInit2(&zstream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+				15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			{
+				return 0;
+			}
+			zstreamInitialized = true;
+		} else {
+			deflateReset(&zstream);
+		}
+
+		unsigned int bufSize = deflateBound(&zstream, body->size);
+		char *buf = (char *) psg_pnalloc(req->pool, bufSize);
+		const LString::Part *part = body->start;
+		int ret = Z_OK;
+
+		zstream.next_out = (Bytef *) buf;
+		zstream.avail_out = bufSize;
+		while (part != NULL) {
+			zstream.next_in = (Bytef *) part->data;
+			zstream.avail_in = part->size;
+			ret = deflate(&zstream, (part->next == NULL) ? Z_FINISH : Z_NO_FLUSH);
+			if (ret != Z_OK && ret != Z_STREAM_END) {
+				return 0;
+			}
+			part = part->next;
+		}
+
+		unsigned int size = bufSize - zstream.avail_out;
+		if (ret != Z_STREAM_END || size >= body->size) {
+			return 0;
+		}
+		*output = buf;
+		return size;
+	}
+
 	// Call when the event loop multiplexer returns.
 	void updateState(ev_tstamp now) {
 		if (OXT_UNLIKELY(state == DISABLED)) {
@@ -271,22 +372,22 @@ public:
 		prepareResponseHeader(prep, server, req, entry);
 		headerSize = buildResponseHeader(prep, server, NULL, 0);
 
-		if (headerSize + entry.body->httpBodySize <= MBUF_MAX_SIZE) {
+		if (headerSize + prep.bodySize <= MBUF_MAX_SIZE) {
 			// Header and body fit inside a single mbuf
 			MemoryKit::mbuf buffer(MemoryKit::mbuf_get(&mbuf_pool));
-			buffer = MemoryKit::mbuf(buffer, 0, headerSize + entry.body->httpBodySize);
+			buffer = MemoryKit::mbuf(buffer, 0, headerSize + prep.bodySize);
 
 			buildResponseHeader(prep, server, buffer.start, buffer.size());
-			memcpy(buffer.start + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+			memcpy(buffer.start + headerSize, prep.bodyData, prep.bodySize);
 
 			server->writeResponse(client, buffer);
 		} else {
-			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + entry.body->httpBodySize);
+			char *buffer = (char *) psg_pnalloc(req->pool, headerSize + prep.bodySize);
 			buildResponseHeader(prep, server, buffer,
-				headerSize + entry.body->httpBodySize);
-			memcpy(buffer + headerSize, entry.body->httpBodyData, entry.body->httpBodySize);
+				headerSize + prep.bodySize);
+			memcpy(buffer + headerSize, prep.bodyData, prep.bodySize);
 
-			server->writeResponse(client, buffer, headerSize + entry.body->httpBodySize);
+			server->writeResponse(client, buffer, headerSize + prep.bodySize);
 		}
 	}
 };
@@ -129,6 +129,10 @@ namespace Core {
 
 	struct WorkingObjects {
 		int serverFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+		// When `reuse_port` is enabled, these are the additional SO_REUSEPORT
+		// sockets for TCP addresses: one for each thread except the first,
+		// which uses `serverFds`.
+		vector<int> reusePortServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		int apiServerFds[SERVER_KIT_MAX_SERVER_ENDPOINTS];
 		string password;
 		ApiAccountDatabase apiAccountDatabase;
@@ -380,6 +384,57 @@ makeFileWorldReadableAndWritable(const string &path) {
 	}
 #endif
 
+/**
+ * Creates one SO_REUSEPORT socket per core thread for the given TCP address.
+ * Returns false, without leaving any sockets behind, if the OS does not
+ * support SO_REUSEPORT. In that case the caller falls back to a single
+ * socket that is served through the AcceptLoadBalancer.
+ */
+static bool
+createReusePortServers(unsigned int index, const string &address) {
+	TRACE_POINT();
+	WorkingObjects *wo = workingObjects;
+	unsigned int nthreads = agentsOptions->getInt("core_threads");
+	vector<int> &fds = wo->reusePortServerFds[index];
+	string host;
+	unsigned short port;
+
+	parseTcpSocketAddress(address, host, port);
+	for (unsigned int i = 0; i < nthreads; i++) {
+		int fd;
+		try {
+			fd = createTcpServer(host.c_str(), port,
+				agentsOptions->getInt("socket_backlog"),
+				__FILE__, __LINE__, true);
+		} catch (const SystemException &e) {
+			if (i == 0) {
+				P_WARN("Cannot use SO_REUSEPORT on " << address << ": " << e.what() <<
+					". Falling back to a single socket for all threads");
+				return false;
+			} else {
+				// A later socket failing means that something else is wrong
+				// (e.g. the port got taken by another process), so let the
+				// caller report it.
+				for (unsigned int j = 0; j < fds.size(); j++) {
+					safelyClose(fds[j]);
+				}
+				safelyClose(wo->serverFds[index]);
+				fds.clear();
+				wo->serverFds[index] = -1;
+				throw;
+			}
+		}
+		if (i == 0) {
+			wo->serverFds[index] = fd;
+		} else {
+			P_LOG_FILE_DESCRIPTOR_PURPOSE(fd, "Server address: " << address <<
+				" (SO_REUSEPORT, thread " << (i + 1) << ")");
+			fds.push_back(fd);
+		}
+	}
+	return true;
+}
+
 static void
 startListening() {
 	TRACE_POINT();
@@ -394,8 +449,14 @@ startListening() {
 	#endif
 
 	for (unsigned int i = 0; i < addresses.size(); i++) {
-		wo->serverFds[i] = createServer(addresses[i], agentsOptions->getInt("socket_backlog"), true,
-			__FILE__, __LINE__);
+		if (!agentsOptions->getBool("reuse_port")
+		 || agentsOptions->getInt("core_threads") <= 1
+		 || getSocketAddressType(addresses[i]) != SAT_TCP
+		 || !createReusePortServers(i, addresses[i]))
+		{
+			wo->serverFds[i] = createServer(addresses[i], agentsOptions->getInt("socket_backlog"), true,
+				__FILE__, __LINE__);
+		}
 		#ifdef USE_SELINUX
 			resetSelinuxSocketContext();
 			if (i == 0 && getSocketAddressType(addresses[0]) == SAT_UNIX) {
@@ -653,6 +714,11 @@ initializeNonPrivilegedWorkingObjects() {
 		wo->spawningKitConfig->instanceDir = absolutizePath(
 			wo->spawningKitConfig->instanceDir);
 	}
+	wo->spawningKitConfig->deferSpawnDiagnostics = options.getBool("defer_spawn_diagnostics");
+	if (options.getUint("shell_envvars_cache_ttl") > 0) {
+		wo->spawningKitConfig->shellEnvironmentCache = boost::make_shared<SpawningKit::ShellEnvironmentCache>(
+			options.getUint("shell_envvars_cache_ttl"));
+	}
 	wo->spawningKitConfig->finalize();
 
 	UPDATE_TRACE_POINT();
@@ -661,7 +727,9 @@ initializeNonPrivilegedWorkingObjects() {
 	wo->appPool->initialize();
 	wo->appPool->setMax(options.getInt("max_pool_size"));
 	wo->appPool->setMaxIdleTime(options.getInt("pool_idle_time") * 1000000ULL);
+	wo->appPool->setMaxConcurrentSpawns(options.getUint("max_concurrent_spawns"));
 	wo->appPool->enableSelfChecking(options.getBool("selfchecks"));
+	wo->appPool->enableRestartFileWatching(options.getBool("restart_file_watching"));
 	wo->appPool->abortLongRunningConnectionsCallback = abortLongRunningConnections;
 
 	UPDATE_TRACE_POINT();
@@ -686,6 +754,12 @@ initializeNonPrivilegedWorkingObjects() {
 			options.get("data_buffer_dir");
 		two.serverKitContext->defaultFileBufferedChannelConfig.threshold =
 			options.getUint("file_buffer_threshold");
+		two.serverKitContext->mbufReclamationFloor =
+			options.getUint("memory_reclamation_mbuf_floor");
+		two.serverKitContext->memoryReclaimer.setWindowSize(
+			options.getUint("memory_reclamation_window"));
+		two.serverKitContext->memoryReclaimer.setInterval(
+			options.getUint("memory_reclamation_interval"));
 
 		UPDATE_TRACE_POINT();
 		two.controller = new Core::Controller(two.serverKitContext, agentsOptions, i + 1);
@@ -722,6 +796,12 @@ initializeNonPrivilegedWorkingObjects() {
 			options.get("data_buffer_dir");
 		awo->serverKitContext->defaultFileBufferedChannelConfig.threshold =
 			options.getUint("file_buffer_threshold");
+		awo->serverKitContext->mbufReclamationFloor =
+			options.getUint("memory_reclamation_mbuf_floor");
+		awo->serverKitContext->memoryReclaimer.setWindowSize(
+			options.getUint("memory_reclamation_window"));
+		awo->serverKitContext->memoryReclaimer.setInterval(
+			options.getUint("memory_reclamation_interval"));
 
 		UPDATE_TRACE_POINT();
 		awo->apiServer = new Core::ApiServer::ApiServer(awo->serverKitContext);
@@ -752,6 +832,13 @@ initializeNonPrivilegedWorkingObjects() {
 		if (nthreads == 1) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[0];
 			two->controller->listen(wo->serverFds[i]);
+		} else if (!wo->reusePortServerFds[i].empty()) {
+			assert(wo->reusePortServerFds[i].size() == nthreads - 1);
+			wo->threadWorkingObjects[0].controller->listen(wo->serverFds[i]);
+			for (unsigned int j = 1; j < nthreads; j++) {
+				ThreadWorkingObjects *two = &wo->threadWorkingObjects[j];
+				two->controller->listen(wo->reusePortServerFds[i][j - 1]);
+			}
 		} else {
 			wo->loadBalancer.listen(wo->serverFds[i]);
 		}
@@ -760,7 +847,7 @@ initializeNonPrivilegedWorkingObjects() {
 		ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
 		two->controller->createSpareClients();
 	}
-	if (nthreads > 1) {
+	if (nthreads > 1 && wo->loadBalancer.getEndpointCount() > 0) {
 		wo->loadBalancer.servers.reserve(nthreads);
 		for (unsigned int i = 0; i < nthreads; i++) {
 			ThreadWorkingObjects *two = &wo->threadWorkingObjects[i];
@@ -886,7 +973,7 @@ mainLoop() {
 	if (wo->apiWorkingObjects.apiServer != NULL) {
 		wo->apiWorkingObjects.bgloop->start("API event loop", 0);
 	}
-	if (wo->threadWorkingObjects.size() > 1) {
+	if (wo->threadWorkingObjects.size() > 1 && wo->loadBalancer.getEndpointCount() > 0) {
 		wo->loadBalancer.start();
 	}
 	waitForExitEvent();
@@ -1045,6 +1132,9 @@ cleanup() {
 		if (wo->serverFds[i] != -1) {
 			close(wo->serverFds[i]);
 		}
+		for (unsigned int j = 0; j < wo->reusePortServerFds[i].size(); j++) {
+			close(wo->reusePortServerFds[i][j]);
+		}
 		if (wo->apiServerFds[i] != -1) {
 			close(wo->apiServerFds[i]);
 		}
@@ -1169,10 +1259,13 @@ setAgentsOptionsDefaults() {
 	}
 	options.setDefaultStrSet("core_addresses", defaultAddress);
 	options.setDefaultInt("socket_backlog", DEFAULT_SOCKET_BACKLOG);
+	options.setDefaultBool("reuse_port", false);
 	options.setDefaultBool("multi_app", false);
 	options.setDefault("environment", DEFAULT_APP_ENV);
 	options.setDefault("spawn_method", DEFAULT_SPAWN_METHOD);
 	options.setDefaultBool("load_shell_envvars", false);
+	options.setDefaultUint("shell_envvars_cache_ttl", 0);
+	options.setDefaultBool("defer_spawn_diagnostics", false);
 	options.setDefaultBool("abort_websockets_on_process_shutdown", true);
 	options.setDefaultInt("force_max_concurrent_requests_per_process", -1);
 	options.setDefault("concurrency_model", DEFAULT_CONCURRENCY_MODEL);
@@ -1181,16 +1274,35 @@ setAgentsOptionsDefaults() {
 	options.setDefaultInt("pool_idle_time", DEFAULT_POOL_IDLE_TIME);
 	options.setDefaultInt("min_instances", 1);
 	options.setDefaultInt("max_preloader_idle_time", DEFAULT_MAX_PRELOADER_IDLE_TIME);
+	options.setDefaultUint("spawn_concurrency", DEFAULT_SPAWN_CONCURRENCY);
+	options.setDefaultUint("max_concurrent_spawns", DEFAULT_MAX_CONCURRENT_SPAWNS);
 	options.setDefaultUint("max_request_queue_size", DEFAULT_MAX_REQUEST_QUEUE_SIZE);
+	options.setDefaultUint("max_request_queue_time", 0);
+	options.setDefaultUint("request_queue_target_delay", 0);
+	options.setDefaultUint("keep_alive_timeout", 0);
+	options.setDefaultUint("request_header_timeout", 0);
+	options.setDefaultUint("request_body_timeout", 0);
+	options.setDefaultUint("app_response_timeout", 0);
+	options.setDefault("routing_policy", DEFAULT_ROUTING_POLICY);
+	options.setDefaultUint("splice_threshold", DEFAULT_SPLICE_THRESHOLD);
 	options.setDefaultUint("stat_throttle_rate", DEFAULT_STAT_THROTTLE_RATE);
+	options.setDefaultBool("restart_file_watching", true);
 	options.setDefault("server_software", SERVER_TOKEN_NAME "/" PASSENGER_VERSION);
 	options.setDefaultBool("show_version_in_header", true);
 	options.setDefaultBool("sticky_sessions", false);
 	options.setDefault("sticky_sessions_cookie_name", DEFAULT_STICKY_SESSIONS_COOKIE_NAME);
 	options.setDefaultBool("turbocaching", true);
+	options.setDefaultUint("turbocache_max_entries", DEFAULT_TURBOCACHE_MAX_ENTRIES);
+	options.setDefaultUint("turbocache_max_body_size", DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+	options.setDefaultULL("turbocache_memory_limit", DEFAULT_TURBOCACHE_MEMORY_LIMIT);
+	options.setDefaultBool("turbocache_gzip", false);
 	options.setDefault("data_buffer_dir", getSystemTempDir());
 	options.setDefaultUint("file_buffer_threshold", DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD);
+	options.setDefaultUint("memory_reclamation_interval", DEFAULT_MEMORY_RECLAMATION_INTERVAL);
+	options.setDefaultUint("memory_reclamation_window", DEFAULT_MEMORY_RECLAMATION_WINDOW);
+	options.setDefaultUint("memory_reclamation_mbuf_floor", DEFAULT_MEMORY_RECLAMATION_MBUF_FLOOR);
 	options.setDefaultInt("response_buffer_high_watermark", DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+	options.setDefaultUint("core_log_buffer_size", DEFAULT_LOG_BUFFER_SIZE);
 	options.setDefaultBool("selfchecks", false);
 	options.setDefaultBool("core_graceful_exit", true);
 	options.setDefaultInt("core_threads", boost::thread::hardware_concurrency());
@@ -1337,8 +1449,10 @@ coreMain(int argc, char *argv[]) {
 	sanityCheckOptions();
 
 	restoreOomScore(agentsOptions);
+	startAsyncLogWriter(agentsOptions->getUint("core_log_buffer_size"));
 
 	ret = runCore();
+	stopAsyncLogWriter();
 	shutdownAgent(agentsOptions);
 	return ret;
 }
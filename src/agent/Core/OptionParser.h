@@ -67,6 +67,11 @@ coreUsage() {
 	printf("                            are applicable\n");
 	printf("      --socket-backlog      Override size of the socket backlog.\n");
 	printf("                            Default: %d\n", DEFAULT_SOCKET_BACKLOG);
+	printf("      --reuse-port          Give each request handling thread its own\n");
+	printf("                            SO_REUSEPORT socket for TCP addresses, so that\n");
+	printf("                            the kernel distributes new connections over the\n");
+	printf("                            threads. Unix domain sockets are still shared\n");
+	printf("                            through a single accept thread\n");
 	printf("\n");
 	printf("Daemon options (optional):\n");
 	printf("      --pid-file PATH       Store the core's PID in the given file. The file\n");
@@ -104,6 +109,15 @@ coreUsage() {
 	printf("      --spawn-method NAME   Spawn method to use. Can either be 'smart' or\n");
 	printf("                            'direct'. Default: %s\n", DEFAULT_SPAWN_METHOD);
 	printf("      --load-shell-envvars  Load shell startup files before loading application\n");
+	printf("      --shell-envvars-cache-ttl SECONDS\n");
+	printf("                            Cache the environment set up by the shell startup\n");
+	printf("                            files for this many seconds, so that not every\n");
+	printf("                            spawn has to run a login shell. The cache is\n");
+	printf("                            invalidated when a startup file changes.\n");
+	printf("                            Default: 0 (disabled)\n");
+	printf("      --defer-spawn-diagnostics\n");
+	printf("                            Only collect spawn diagnostics information (user\n");
+	printf("                            info, ulimits, system metrics) when spawning fails\n");
 	printf("      --concurrency-model   The concurrency model to use for the app, either\n");
 	printf("                            'process' or 'thread' (Enterprise only).\n");
 	printf("                            Default: " DEFAULT_CONCURRENCY_MODEL "\n");
@@ -147,6 +161,15 @@ coreUsage() {
 	printf("                            process can handle the given number of concurrent\n");
 	printf("                            requests per process\n");
 	printf("      --min-instances N     Minimum number of application processes. Default: 1\n");
+	printf("      --spawn-concurrency N\n");
+	printf("                            Maximum number of processes that may be spawned\n");
+	printf("                            concurrently for a single application.\n");
+	printf("                            Default: %d\n", DEFAULT_SPAWN_CONCURRENCY);
+	printf("      --max-concurrent-spawns N\n");
+	printf("                            Maximum number of processes that may be spawned\n");
+	printf("                            concurrently in total. Every application may always\n");
+	printf("                            spawn at least one process at a time. A value of 0\n");
+	printf("                            means unlimited. Default: %d\n", DEFAULT_MAX_CONCURRENT_SPAWNS);
 	printf("      --memory-limit MB     Restart application processes that go over the\n");
 	printf("                            given memory limit (Enterprise only)\n");
 	printf("\n");
@@ -158,6 +181,34 @@ coreUsage() {
 	printf("      --max-request-queue-size NUMBER\n");
 	printf("                            Specify request queue size. Default: %d\n",
 		DEFAULT_MAX_REQUEST_QUEUE_SIZE);
+	printf("      --max-request-queue-time SECONDS\n");
+	printf("                            Reject requests that waited in the queue for longer\n");
+	printf("                            than this. Default: 0 (unlimited)\n");
+	printf("      --request-queue-target-delay MSEC\n");
+	printf("                            When requests keep waiting in the queue for longer\n");
+	printf("                            than this, reject those that waited longer than\n");
+	printf("                            this (CoDel). Default: 0 (disabled)\n");
+	printf("      --keep-alive-timeout SECONDS\n");
+	printf("                            Disconnect kept-alive clients that don't send a\n");
+	printf("                            new request within this time. Default: 0 (never)\n");
+	printf("      --request-header-timeout SECONDS\n");
+	printf("                            Disconnect clients that don't send a complete\n");
+	printf("                            request header within this time. Default: 0\n");
+	printf("                            (never)\n");
+	printf("      --request-body-timeout SECONDS\n");
+	printf("                            Disconnect clients that don't send any request\n");
+	printf("                            body data for this long. Default: 0 (never)\n");
+	printf("      --app-response-timeout SECONDS\n");
+	printf("                            Respond with 504 if the application doesn't begin\n");
+	printf("                            its response within this time after receiving the\n");
+	printf("                            request. Default: 0 (never)\n");
+	printf("      --routing-policy NAME How to pick a process for a request: 'least_busy'\n");
+	printf("                            or 'power_of_two' (the less busy one of two\n");
+	printf("                            random processes). Default: %s\n", DEFAULT_ROUTING_POLICY);
+	printf("      --splice-threshold BYTES\n");
+	printf("                            Forward request and response bodies with at\n");
+	printf("                            least this many bytes left with splice() (Linux\n");
+	printf("                            only). 0 means never. Default: %d\n", DEFAULT_SPLICE_THRESHOLD);
 	printf("      --sticky-sessions     Enable sticky sessions\n");
 	printf("      --sticky-sessions-cookie-name NAME\n");
 	printf("                            Cookie name to use for sticky sessions.\n");
@@ -166,6 +217,18 @@ coreUsage() {
 	printf("                            Vary the turbocache by the cookie of the given name\n");
 	printf("      --disable-turbocaching\n");
 	printf("                            Disable turbocaching\n");
+	printf("      --turbocache-max-entries NUMBER\n");
+	printf("                            Maximum number of responses in the turbocache,\n");
+	printf("                            per thread. Default: %d\n", DEFAULT_TURBOCACHE_MAX_ENTRIES);
+	printf("      --turbocache-max-body-size BYTES\n");
+	printf("                            Maximum size of a response body that may be\n");
+	printf("                            turbocached. Default: %d\n", DEFAULT_TURBOCACHE_MAX_BODY_SIZE);
+	printf("      --turbocache-memory-limit BYTES\n");
+	printf("                            Maximum amount of memory that the turbocache may\n");
+	printf("                            use, per thread. Default: %d\n", DEFAULT_TURBOCACHE_MEMORY_LIMIT);
+	printf("      --turbocache-gzip     Also store a gzip-compressed variant of textual\n");
+	printf("                            responses in the turbocache, and serve it to\n");
+	printf("                            clients that accept gzip\n");
 	printf("      --no-abort-websockets-on-process-shutdown\n");
 	printf("                            Do not abort WebSocket connections on process\n");
 	printf("                            shutdown or restart\n");
@@ -173,16 +236,37 @@ coreUsage() {
 	printf("Other options (optional):\n");
 	printf("      --log-file PATH       Log to the given file.\n");
 	printf("      --log-level LEVEL     Logging level. Default: %d\n", DEFAULT_LOG_LEVEL);
+	printf("      --log-buffer-size BYTES\n");
+	printf("                            Size of the per-thread buffers of the background\n");
+	printf("                            log writer. 0 means that every thread writes its\n");
+	printf("                            log entries itself. Default: %d\n", DEFAULT_LOG_BUFFER_SIZE);
 	printf("      --fd-log-file PATH    Log file descriptor activity to the given file.\n");
 	printf("      --stat-throttle-rate SECONDS\n");
 	printf("                            Throttle filesystem restart.txt checks to at most\n");
 	printf("                            once per given seconds. Default: %d\n", DEFAULT_STAT_THROTTLE_RATE);
+	printf("      --disable-restart-file-watching\n");
+	printf("                            Check restart.txt with stat() on requests instead\n");
+	printf("                            of monitoring it with inotify. Directories on\n");
+	printf("                            NFS, CIFS and FUSE are always checked with stat()\n");
 	printf("      --no-show-version-in-header\n");
 	printf("                            Do not show " PROGRAM_NAME " version number in\n");
 	printf("                            HTTP headers.\n");
 	printf("      --data-buffer-dir PATH\n");
 	printf("                            Directory to store data buffers in. Default:\n");
 	printf("                            %s\n", getSystemTempDir());
+	printf("      --memory-reclamation-interval SECONDS\n");
+	printf("                            How often to check for spare memory (e.g. after\n");
+	printf("                            a traffic spike) that can be returned to the OS.\n");
+	printf("                            0 means never. Default: %d\n",
+		DEFAULT_MEMORY_RECLAMATION_INTERVAL);
+	printf("      --memory-reclamation-window NUMBER\n");
+	printf("                            Keep enough spare memory to handle the peak load\n");
+	printf("                            of this many last checks. Default: %d\n",
+		DEFAULT_MEMORY_RECLAMATION_WINDOW);
+	printf("      --memory-reclamation-mbuf-floor NUMBER\n");
+	printf("                            Number of spare buffers per thread that are never\n");
+	printf("                            returned to the OS. Default: %d\n",
+		DEFAULT_MEMORY_RECLAMATION_MBUF_FLOOR);
 	printf("      --no-graceful-exit    When exiting, exit immediately instead of waiting\n");
 	printf("                            for all connections to terminate\n");
 	printf("      --benchmark MODE      Enable benchmark mode. Available modes:\n");
@@ -267,6 +351,9 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--socket-backlog")) {
 		options.setInt("socket_backlog", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--reuse-port")) {
+		options.setBool("reuse_port", true);
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-user-switching")) {
 		options.setBool("user_switching", false);
 		i++;
@@ -297,6 +384,12 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--min-instances")) {
 		options.setInt("min_instances", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--spawn-concurrency")) {
+		options.setUint("spawn_concurrency", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-concurrent-spawns")) {
+		options.setUint("max_concurrent_spawns", atoi(argv[i + 1]));
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--memory-limit")) {
 		options.setInt("memory_limit", atoi(argv[i + 1]));
 		i += 2;
@@ -315,6 +408,12 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isFlag(argv[i], '\0', "--load-shell-envvars")) {
 		options.setBool("load_shell_envvars", true);
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--shell-envvars-cache-ttl")) {
+		options.setUint("shell_envvars_cache_ttl", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--defer-spawn-diagnostics")) {
+		options.setBool("defer_spawn_diagnostics", true);
+		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--concurrency-model")) {
 		options.set("concurrency_model", argv[i + 1]);
 		i += 2;
@@ -339,6 +438,37 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-request-queue-size")) {
 		options.setInt("max_request_queue_size", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-request-queue-time")) {
+		options.setUint("max_request_queue_time", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--request-queue-target-delay")) {
+		options.setUint("request_queue_target_delay", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--keep-alive-timeout")) {
+		options.setUint("keep_alive_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--request-header-timeout")) {
+		options.setUint("request_header_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--request-body-timeout")) {
+		options.setUint("request_body_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--app-response-timeout")) {
+		options.setUint("app_response_timeout", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--routing-policy")) {
+		if (strcmp(argv[i + 1], "least_busy") != 0
+		 && strcmp(argv[i + 1], "power_of_two") != 0)
+		{
+			fprintf(stderr, "ERROR: invalid value passed to --routing-policy. "
+				"Valid values are 'least_busy' and 'power_of_two'.\n");
+			exit(1);
+		}
+		options.set("routing_policy", argv[i + 1]);
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--splice-threshold")) {
+		options.setUint("splice_threshold", atoi(argv[i + 1]));
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--sticky-sessions")) {
 		options.setBool("sticky_sessions", true);
 		i++;
@@ -351,6 +481,18 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isFlag(argv[i], '\0', "--disable-turbocaching")) {
 		options.setBool("turbocaching", false);
 		i++;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-entries")) {
+		options.setUint("turbocache_max_entries", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-max-body-size")) {
+		options.setUint("turbocache_max_body_size", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--turbocache-memory-limit")) {
+		options.setULL("turbocache_memory_limit", strtoull(argv[i + 1], NULL, 10));
+		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--turbocache-gzip")) {
+		options.setBool("turbocache_gzip", true);
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-abort-websockets-on-process-shutdown")) {
 		options.setBool("abort_websockets_on_process_shutdown", false);
 		i++;
@@ -388,6 +530,9 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 		// the Watchdog, we don't want to affect the Watchdog's own log file.
 		options.set("core_log_file", argv[i + 1]);
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--log-buffer-size")) {
+		options.setUint("core_log_buffer_size", atoi(argv[i + 1]));
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--fd-log-file")) {
 		// We do not set file_descriptor_log_file because, when this function is called from
 		// the Watchdog, we don't want to affect the Watchdog's own log file.
@@ -396,12 +541,24 @@ parseCoreOption(int argc, const char *argv[], int &i, VariantMap &options) {
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--stat-throttle-rate")) {
 		options.setInt("stat_throttle_rate", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isFlag(argv[i], '\0', "--disable-restart-file-watching")) {
+		options.setBool("restart_file_watching", false);
+		i++;
 	} else if (p.isFlag(argv[i], '\0', "--no-show-version-in-header")) {
 		options.setBool("show_version_in_header", false);
 		i++;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--data-buffer-dir")) {
 		options.setInt("data_buffer_dir", atoi(argv[i + 1]));
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--memory-reclamation-interval")) {
+		options.setUint("memory_reclamation_interval", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--memory-reclamation-window")) {
+		options.setUint("memory_reclamation_window", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--memory-reclamation-mbuf-floor")) {
+		options.setUint("memory_reclamation_mbuf_floor", atoi(argv[i + 1]));
+		i += 2;
 	} else if (p.isFlag(argv[i], '\0', "--no-graceful-exit")) {
 		options.setBool("core_graceful_exit", false);
 		i++;
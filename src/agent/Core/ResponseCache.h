@@ -27,9 +27,14 @@
 #define _PASSENGER_RESPONSE_CACHE_H_
 
 #include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
 #include <time.h>
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <Constants.h>
 #include <DataStructures/HashedStaticString.h>
 #include <ServerKit/http_parser.h>
 #include <ServerKit/CookieUtils.h>
@@ -43,25 +48,46 @@ namespace Passenger {
  * Relevant RFCs:
  * https://tools.ietf.org/html/rfc7234    HTTP 1.1 Caching
  * https://tools.ietf.org/html/rfc2109    HTTP State Management Mechanism
+ *
+ * The maximum number of entries, the maximum body size and the memory limit
+ * are configurable through configure(). Entries are found through an open
+ * addressing hash table (linear probing) on the cache key's hash. When the
+ * cache is full, entries are evicted with the CLOCK algorithm: a fetch marks
+ * an entry as referenced, and the clock hand evicts the first unreferenced
+ * entry that it encounters, clearing reference marks as it goes.
+ *
+ * A response body may be stored in two variants: as-is, and gzip-compressed
+ * (see responseAllowsCompression()). The caller produces the compressed
+ * variant once, at store time, and on fetch, requestAcceptsGzip() tells
+ * which variant the client should get.
+ *
+ * The key, the HTTP header data and the body data of an entry are stored
+ * together in a single block. Blocks are allocated in power-of-two size
+ * classes and recycled through per-class free lists. The memory limit
+ * applies to the total size of all blocks, including free ones.
  */
 template<typename Request>
-class ResponseCache {
+class ResponseCache: public boost::noncopyable {
 public:
-	static const unsigned int MAX_ENTRIES     = 8; // Fits in exactly 2 cache lines
 	static const unsigned int MAX_KEY_LENGTH  = 256;
 	static const unsigned int MAX_HEADER_SIZE = 4096;
-	static const unsigned int MAX_BODY_SIZE   = 1024 * 32;
 	static const unsigned int DEFAULT_HEURISTIC_FRESHNESS = 10;
 	static const unsigned int MIN_HEURISTIC_FRESHNESS = 1;
+	/** The smallest block size is 2^MIN_BLOCK_SIZE_SHIFT bytes. */
+	static const unsigned int MIN_BLOCK_SIZE_SHIFT = 10;
+	static const unsigned int BLOCK_SIZE_CLASSES = 22;
 
 	struct Header {
 		bool valid;
+		/** Set by fetch(), cleared by the eviction clock hand. */
+		bool referenced;
 		unsigned short keySize;
 		boost::uint32_t hash;
 		time_t date;
 
 		Header()
 			: valid(false),
+			  referenced(false),
 			  keySize(0),
 			  hash(0),
 			  date(0)
@@ -69,21 +95,31 @@ public:
 	};
 
 	struct Body {
-		unsigned short httpHeaderSize;
-		unsigned short httpBodySize;
+		unsigned int httpHeaderSize;
+		unsigned int httpBodySize;
+		/** 0 if there is no gzip variant. */
+		unsigned int httpGzipBodySize;
 		time_t expiryDate;
-		char key[MAX_KEY_LENGTH];
-		char httpHeaderData[MAX_HEADER_SIZE];
-		// This data is dechunked.
-		char httpBodyData[MAX_BODY_SIZE];
+		/* The following point into a single block that is owned by the
+		 * cache. The body data is dechunked.
+		 */
+		char *key;
+		char *httpHeaderData;
+		char *httpBodyData;
+		char *httpGzipBodyData;
+		unsigned int blockSizeClass;
 
 		Body()
 			: httpHeaderSize(0),
 			  httpBodySize(0),
-			  expiryDate(0)
-		{
-			key[0] = httpHeaderData[0] = httpBodyData[0] = '\0';
-		}
+			  httpGzipBodySize(0),
+			  expiryDate(0),
+			  key(NULL),
+			  httpHeaderData(NULL),
+			  httpBodyData(NULL),
+			  httpGzipBodyData(NULL),
+			  blockSizeClass(0)
+			{ }
 	};
 
 	struct Entry {
@@ -139,11 +175,36 @@ private:
 	HashedStaticString CONTENT_LOCATION;
 	HashedStaticString COOKIE;
 	HashedStaticString PASSENGER_VARY_TURBOCACHE_BY_COOKIE;
+	HashedStaticString ACCEPT_ENCODING;
+	HashedStaticString CONTENT_TYPE;
+	HashedStaticString CONTENT_ENCODING;
+	HashedStaticString ETAG;
+
+	static const boost::uint32_t EMPTY_INDEX_SLOT = ~((boost::uint32_t) 0);
 
 	unsigned int fetches, hits, stores, storeSuccesses;
+	boost::uint64_t totalHits, totalMisses, totalEvictions;
+
+	unsigned int maxEntries;
+	unsigned int maxBodySize;
+	size_t memoryLimit;
+
+	Header *headers;
+	Body *bodies;
+	unsigned int count;
+	unsigned int clockHand;
+	/** A stack of unused entry indices. */
+	unsigned int *freeEntries;
+	unsigned int nFreeEntries;
 
-	Header headers[MAX_ENTRIES];
-	Body bodies[MAX_ENTRIES];
+	/** Maps hash table slots to entry indices. Has at least 2 * maxEntries slots. */
+	boost::uint32_t *index;
+	unsigned int indexMask;
+
+	/** For each size class, a linked list of unused blocks. */
+	char *freeBlocks[BLOCK_SIZE_CLASSES];
+	/** Total size of all allocated blocks, used and free. */
+	size_t memoryUsage;
 
 	unsigned int calculateKeyLength(const LString * restrict host,
 		const LString * restrict varyCookie,
@@ -217,34 +278,206 @@ private:
 	}
 
 	Entry lookup(const HashedStaticString &cacheKey) {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (headers[i].valid
-			 && headers[i].hash == cacheKey.hash()
+		unsigned int pos = cacheKey.hash() & indexMask;
+
+		// The index is never more than half full, so this terminates.
+		while (true) {
+			boost::uint32_t i = index[pos];
+			if (i == EMPTY_INDEX_SLOT) {
+				return Entry();
+			} else if (headers[i].hash == cacheKey.hash()
 			 && cacheKey == StaticString(bodies[i].key, headers[i].keySize))
 			{
 				return Entry(i, &headers[i], &bodies[i]);
 			}
+			pos = (pos + 1) & indexMask;
+		}
+	}
+
+	void insertIntoIndex(unsigned int i) {
+		unsigned int pos = headers[i].hash & indexMask;
+		while (index[pos] != EMPTY_INDEX_SLOT) {
+			pos = (pos + 1) & indexMask;
 		}
-		return Entry();
+		index[pos] = i;
 	}
 
-	Entry lookupInvalidOrOldest() {
-		int oldest = -1;
+	/**
+	 * Removes entry `i` from the index. Instead of leaving a tombstone,
+	 * subsequent entries in the same probe sequence are shifted back.
+	 */
+	void removeFromIndex(unsigned int i) {
+		unsigned int hole = headers[i].hash & indexMask;
+		while (index[hole] != i) {
+			hole = (hole + 1) & indexMask;
+		}
 
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			if (!headers[i].valid) {
-				return Entry(i, &headers[i], &bodies[i]);
-			} else if (oldest == -1 || headers[i].date < headers[oldest].date) {
-				oldest = i;
+		unsigned int pos = hole;
+		while (true) {
+			pos = (pos + 1) & indexMask;
+			boost::uint32_t j = index[pos];
+			if (j == EMPTY_INDEX_SLOT) {
+				break;
+			}
+
+			// Entry j may be moved into the hole if its home slot does
+			// not lie cyclically in (hole, pos].
+			unsigned int home = headers[j].hash & indexMask;
+			bool homeInRange;
+			if (hole <= pos) {
+				homeInRange = hole < home && home <= pos;
+			} else {
+				homeInRange = hole < home || home <= pos;
+			}
+			if (!homeInRange) {
+				index[hole] = j;
+				hole = pos;
 			}
 		}
+		index[hole] = EMPTY_INDEX_SLOT;
+	}
 
-		return Entry(oldest, &headers[oldest], &bodies[oldest]);
+	static unsigned int getBlockSizeClass(size_t size) {
+		unsigned int sizeClass = 0;
+		while ((size_t(1) << (sizeClass + MIN_BLOCK_SIZE_SHIFT)) < size) {
+			sizeClass++;
+		}
+		return sizeClass;
 	}
 
-	OXT_FORCE_INLINE
-	void erase(unsigned int index) {
-		headers[index].valid = false;
+	static size_t getBlockSize(unsigned int sizeClass) {
+		return size_t(1) << (sizeClass + MIN_BLOCK_SIZE_SHIFT);
+	}
+
+	void freeBlock(char *block, unsigned int sizeClass) {
+		*((char **) block) = freeBlocks[sizeClass];
+		freeBlocks[sizeClass] = block;
+	}
+
+	/**
+	 * Returns an unused block of another size class than `sizeClass` to the
+	 * system. Returns whether there was such a block.
+	 */
+	bool releaseFreeBlock(unsigned int sizeClass) {
+		for (unsigned int i = 0; i < BLOCK_SIZE_CLASSES; i++) {
+			if (i != sizeClass && freeBlocks[i] != NULL) {
+				char *block = freeBlocks[i];
+				freeBlocks[i] = *((char **) block);
+				free(block);
+				memoryUsage -= getBlockSize(i);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void releaseAllFreeBlocks() {
+		for (unsigned int i = 0; i < BLOCK_SIZE_CLASSES; i++) {
+			while (freeBlocks[i] != NULL) {
+				char *block = freeBlocks[i];
+				freeBlocks[i] = *((char **) block);
+				free(block);
+				memoryUsage -= getBlockSize(i);
+			}
+		}
+	}
+
+	/**
+	 * Allocates a block of the given size class, evicting entries if
+	 * necessary to stay within the memory limit.
+	 *
+	 * @pre getBlockSize(sizeClass) <= memoryLimit
+	 */
+	char *allocateBlock(unsigned int sizeClass) {
+		size_t size = getBlockSize(sizeClass);
+
+		while (true) {
+			if (freeBlocks[sizeClass] != NULL) {
+				char *block = freeBlocks[sizeClass];
+				freeBlocks[sizeClass] = *((char **) block);
+				return block;
+			} else if (memoryUsage + size <= memoryLimit) {
+				break;
+			} else if (!releaseFreeBlock(sizeClass)) {
+				assert(count > 0);
+				evictOne();
+			}
+		}
+
+		char *block = (char *) malloc(size);
+		if (block != NULL) {
+			memoryUsage += size;
+		}
+		return block;
+	}
+
+	void erase(unsigned int i) {
+		assert(headers[i].valid);
+		removeFromIndex(i);
+		freeBlock(bodies[i].key, bodies[i].blockSizeClass);
+		headers[i].valid = false;
+		freeEntries[nFreeEntries] = i;
+		nFreeEntries++;
+		count--;
+	}
+
+	/** @pre count > 0 */
+	void evictOne() {
+		// Terminates within two rounds because the first round
+		// clears all reference marks.
+		while (true) {
+			unsigned int i = clockHand;
+			clockHand++;
+			if (clockHand == maxEntries) {
+				clockHand = 0;
+			}
+
+			if (headers[i].valid) {
+				if (headers[i].referenced) {
+					headers[i].referenced = false;
+				} else {
+					erase(i);
+					totalEvictions++;
+					return;
+				}
+			}
+		}
+	}
+
+	void allocateStorage() {
+		unsigned int indexSize = 1;
+		while (indexSize < maxEntries * 2) {
+			indexSize *= 2;
+		}
+
+		headers = new Header[maxEntries];
+		bodies = new Body[maxEntries];
+		freeEntries = new unsigned int[maxEntries];
+		index = new boost::uint32_t[indexSize];
+		indexMask = indexSize - 1;
+		count = 0;
+		clockHand = 0;
+		memset(freeBlocks, 0, sizeof(freeBlocks));
+		memoryUsage = 0;
+		resetIndex();
+	}
+
+	void freeStorage() {
+		clear();
+		releaseAllFreeBlocks();
+		delete[] headers;
+		delete[] bodies;
+		delete[] freeEntries;
+		delete[] index;
+	}
+
+	void resetIndex() {
+		// Pop lower indices first.
+		for (unsigned int i = 0; i < maxEntries; i++) {
+			freeEntries[i] = maxEntries - i - 1;
+		}
+		nFreeEntries = maxEntries;
+		memset(index, 0xff, sizeof(boost::uint32_t) * (indexMask + 1));
 	}
 
 	time_t parseDate(psg_pool_t *pool, const LString *date, ev_tstamp now) const {
@@ -404,12 +637,93 @@ private:
 
 		Entry entry(lookup(StaticString(key, keySize)));
 		if (entry.valid()) {
-			entry.header->valid = false;
+			erase(entry.index);
 		}
 	}
 
+	static StaticString trim(const StaticString &str) {
+		const char *begin = str.data();
+		const char *end = str.data() + str.size();
+		while (begin < end && (*begin == ' ' || *begin == '\t')) {
+			begin++;
+		}
+		while (end > begin && (end[-1] == ' ' || end[-1] == '\t')) {
+			end--;
+		}
+		return StaticString(begin, end - begin);
+	}
+
+	static bool equalsCaseInsensitive(const StaticString &str, const StaticString &lowerCase) {
+		if (str.size() != lowerCase.size()) {
+			return false;
+		}
+		for (string::size_type i = 0; i < str.size(); i++) {
+			if (tolower((unsigned char) str[i]) != lowerCase[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Given the parameters of an Accept-Encoding item (everything after
+	 * the first ';'), returns whether they contain a qvalue of zero,
+	 * which means "not acceptable".
+	 */
+	static bool hasZeroQvalue(StaticString params) {
+		while (!params.empty()) {
+			string::size_type pos = params.find(';');
+			StaticString param = trim(params.substr(0, pos));
+			if (param.size() >= 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+				StaticString value = param.substr(2);
+				if (value.empty() || value[0] != '0') {
+					return false;
+				}
+				for (string::size_type i = 1; i < value.size(); i++) {
+					if (value[i] != '0' && value[i] != '.') {
+						return false;
+					}
+				}
+				return true;
+			}
+			if (pos == string::npos) {
+				break;
+			}
+			params = params.substr(pos + 1);
+		}
+		return false;
+	}
+
+	static bool isCompressibleContentType(StaticString contentType) {
+		string::size_type pos = contentType.find(';');
+		if (pos != string::npos) {
+			contentType = contentType.substr(0, pos);
+		}
+		contentType = trim(contentType);
+
+		char buf[64];
+		if (contentType.size() > sizeof(buf)) {
+			return false;
+		}
+		convertLowerCase((const unsigned char *) contentType.data(),
+			(unsigned char *) buf, contentType.size());
+		contentType = StaticString(buf, contentType.size());
+
+		return startsWith(contentType, P_STATIC_STRING("text/"))
+			|| contentType == P_STATIC_STRING("application/json")
+			|| contentType == P_STATIC_STRING("application/javascript")
+			|| contentType == P_STATIC_STRING("application/x-javascript")
+			|| contentType == P_STATIC_STRING("application/xml")
+			|| contentType == P_STATIC_STRING("image/svg+xml")
+			|| (startsWith(contentType, P_STATIC_STRING("application/"))
+				&& (contentType.find(P_STATIC_STRING("+xml")) != string::npos
+				 || contentType.find(P_STATIC_STRING("+json")) != string::npos));
+	}
+
 public:
-	ResponseCache()
+	ResponseCache(unsigned int _maxEntries = DEFAULT_TURBOCACHE_MAX_ENTRIES,
+		unsigned int _maxBodySize = DEFAULT_TURBOCACHE_MAX_BODY_SIZE,
+		size_t _memoryLimit = DEFAULT_TURBOCACHE_MEMORY_LIMIT)
 		: CACHE_CONTROL("cache-control"),
 		  PRAGMA_CONST("pragma"),
 		  AUTHORIZATION("authorization"),
@@ -423,11 +737,60 @@ public:
 		  CONTENT_LOCATION("content-location"),
 		  COOKIE("cookie"),
 		  PASSENGER_VARY_TURBOCACHE_BY_COOKIE("!~PASSENGER_VARY_TURBOCACHE_COOKIE"),
+		  ACCEPT_ENCODING("accept-encoding"),
+		  CONTENT_TYPE("content-type"),
+		  CONTENT_ENCODING("content-encoding"),
+		  ETAG("etag"),
 		  fetches(0),
 		  hits(0),
 		  stores(0),
-		  storeSuccesses(0)
-		{ }
+		  storeSuccesses(0),
+		  totalHits(0),
+		  totalMisses(0),
+		  totalEvictions(0),
+		  maxEntries(std::max(_maxEntries, 1u)),
+		  maxBodySize(_maxBodySize),
+		  memoryLimit(_memoryLimit)
+	{
+		allocateStorage();
+	}
+
+	~ResponseCache() {
+		freeStorage();
+	}
+
+	/**
+	 * Changes the limits. This clears the cache.
+	 */
+	void configure(unsigned int maxEntries, unsigned int maxBodySize, size_t memoryLimit) {
+		freeStorage();
+		this->maxEntries = std::max(maxEntries, 1u);
+		this->maxBodySize = maxBodySize;
+		this->memoryLimit = memoryLimit;
+		allocateStorage();
+	}
+
+	unsigned int getMaxEntries() const {
+		return maxEntries;
+	}
+
+	/** The maximum size of a response body that may be cached. */
+	OXT_FORCE_INLINE
+	unsigned int getMaxBodySize() const {
+		return maxBodySize;
+	}
+
+	size_t getMemoryLimit() const {
+		return memoryLimit;
+	}
+
+	size_t getMemoryUsage() const {
+		return memoryUsage;
+	}
+
+	unsigned int getCount() const {
+		return count;
+	}
 
 	OXT_FORCE_INLINE
 	unsigned int getFetches() const {
@@ -459,6 +822,20 @@ public:
 		return storeSuccesses / (double) stores;
 	}
 
+	/* Unlike the statistics above, the following are never reset. */
+
+	boost::uint64_t getTotalHits() const {
+		return totalHits;
+	}
+
+	boost::uint64_t getTotalMisses() const {
+		return totalMisses;
+	}
+
+	boost::uint64_t getTotalEvictions() const {
+		return totalEvictions;
+	}
+
 	// For decreasing the store success ratio without calling store().
 	OXT_FORCE_INLINE
 	void incStores() {
@@ -473,9 +850,17 @@ public:
 	}
 
 	void clear() {
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
-			headers[i].valid = false;
+		if (count == 0) {
+			return;
 		}
+		for (unsigned int i = 0; i < maxEntries; i++) {
+			if (headers[i].valid) {
+				freeBlock(bodies[i].key, bodies[i].blockSizeClass);
+				headers[i].valid = false;
+			}
+		}
+		count = 0;
+		resetIndex();
 	}
 
 
@@ -550,15 +935,19 @@ public:
 		if (entry.valid()) {
 			hits++;
 			if (isFresh(entry, now)) {
+				entry.header->referenced = true;
+				totalHits++;
 				return entry;
 			} else {
 				erase(entry.index);
 				Entry result;
 				result.cacheMissReason = Entry::NOT_FRESH;
+				totalMisses++;
 				return result;
 			}
 		} else {
 			entry.cacheMissReason = Entry::NOT_FOUND;
+			totalMisses++;
 			return entry;
 		}
 	}
@@ -625,12 +1014,103 @@ public:
 			|| req->appResponse.expiresHeader != NULL;
 	}
 
-	// @pre requestAllowsStoring()
-	// @pre prepareRequestForStoring()
-	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize) {
+	/**
+	 * Returns whether the response may be stored with a gzip variant:
+	 * whether it has a textual content type and is not already encoded.
+	 * Responses with a strong ETag are not compressed, because the
+	 * compressed variant would be a different representation with
+	 * the same ETag.
+	 *
+	 * @pre prepareRequestForStoring()
+	 */
+	bool responseAllowsCompression(Request *req) const {
+		const ServerKit::HeaderTable &respHeaders = req->appResponse.headers;
+		const LString *value;
+
+		if (respHeaders.lookup(CONTENT_ENCODING) != NULL) {
+			return false;
+		}
+
+		value = respHeaders.lookup(ETAG);
+		if (value != NULL) {
+			value = psg_lstr_make_contiguous(value, req->pool);
+			if (!startsWith(StaticString(value->start->data, value->size),
+				P_STATIC_STRING("W/")))
+			{
+				return false;
+			}
+		}
+
+		value = respHeaders.lookup(CONTENT_TYPE);
+		if (value == NULL) {
+			return false;
+		}
+		value = psg_lstr_make_contiguous(value, req->pool);
+		return isCompressibleContentType(StaticString(value->start->data, value->size));
+	}
+
+	/**
+	 * Returns whether the client accepts gzip-compressed responses,
+	 * according to its Accept-Encoding header. An explicit gzip or
+	 * x-gzip entry takes precedence over `*`, regardless of the order
+	 * in which they appear (RFC 7231 section 5.3.4).
+	 */
+	bool requestAcceptsGzip(Request *req) const {
+		const LString *value = req->headers.lookup(ACCEPT_ENCODING);
+		if (value == NULL || value->size == 0) {
+			return false;
+		}
+
+		bool gzipListed = false, gzipAccepted = false;
+		bool wildcardListed = false, wildcardAccepted = false;
+
+		value = psg_lstr_make_contiguous(value, req->pool);
+		StaticString items(value->start->data, value->size);
+		while (!items.empty()) {
+			string::size_type end = items.find(',');
+			StaticString item = items.substr(0, end);
+			string::size_type paramsPos = item.find(';');
+			StaticString coding = trim(item.substr(0, paramsPos));
+			bool accepted = paramsPos == string::npos
+				|| !hasZeroQvalue(item.substr(paramsPos + 1));
+
+			if (equalsCaseInsensitive(coding, P_STATIC_STRING("gzip"))
+			 || equalsCaseInsensitive(coding, P_STATIC_STRING("x-gzip")))
+			{
+				gzipListed = true;
+				gzipAccepted = gzipAccepted || accepted;
+			} else if (coding == P_STATIC_STRING("*")) {
+				wildcardListed = true;
+				wildcardAccepted = wildcardAccepted || accepted;
+			}
+
+			if (end == string::npos) {
+				break;
+			}
+			items = items.substr(end + 1);
+		}
+
+		if (gzipListed) {
+			return gzipAccepted;
+		} else {
+			return wildcardListed && wildcardAccepted;
+		}
+	}
+
+	/**
+	 * Allocates an entry for the response. The caller must fill
+	 * `httpHeaderData`, `httpBodyData` and, if `gzipBodySize` > 0,
+	 * `httpGzipBodyData`.
+	 *
+	 * @pre requestAllowsStoring()
+	 * @pre prepareRequestForStoring()
+	 */
+	Entry store(Request *req, ev_tstamp now, unsigned int headerSize, unsigned int bodySize,
+		unsigned int gzipBodySize = 0)
+	{
 		stores++;
 
-		if (headerSize > MAX_HEADER_SIZE || bodySize > MAX_BODY_SIZE) {
+		if (headerSize > MAX_HEADER_SIZE || bodySize > maxBodySize) {
 			return Entry();
 		}
 
@@ -645,18 +1125,50 @@ public:
 		}
 
 		const HashedStaticString &cacheKey = req->cacheKey;
+		unsigned int sizeClass = getBlockSizeClass(cacheKey.size() + headerSize
+			+ bodySize + gzipBodySize);
+		if (getBlockSize(sizeClass) > memoryLimit) {
+			return Entry();
+		}
+
+		// The new response may need a block of a different size,
+		// so replace any existing entry.
 		Entry entry(lookup(cacheKey));
-		if (!entry.valid()) {
-			entry = lookupInvalidOrOldest();
-			entry.header->valid   = true;
-			entry.header->hash    = cacheKey.hash();
-			entry.header->keySize = cacheKey.size();
-			memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
-		}
-		entry.header->date     = responseDate;
-		entry.body->expiryDate = expiryDate;
+		if (entry.valid()) {
+			erase(entry.index);
+		}
+		if (count == maxEntries) {
+			evictOne();
+		}
+
+		char *block = allocateBlock(sizeClass);
+		if (OXT_UNLIKELY(block == NULL)) {
+			return Entry();
+		}
+
+		nFreeEntries--;
+		entry = Entry(freeEntries[nFreeEntries],
+			&headers[freeEntries[nFreeEntries]],
+			&bodies[freeEntries[nFreeEntries]]);
+		entry.header->valid      = true;
+		entry.header->referenced = false;
+		entry.header->hash       = cacheKey.hash();
+		entry.header->keySize    = cacheKey.size();
+		entry.header->date       = responseDate;
+		entry.body->expiryDate     = expiryDate;
 		entry.body->httpHeaderSize = headerSize;
 		entry.body->httpBodySize   = bodySize;
+		entry.body->httpGzipBodySize = gzipBodySize;
+		entry.body->blockSizeClass = sizeClass;
+		entry.body->key            = block;
+		entry.body->httpHeaderData = block + cacheKey.size();
+		entry.body->httpBodyData   = block + cacheKey.size() + headerSize;
+		entry.body->httpGzipBodyData = (gzipBodySize > 0)
+			? entry.body->httpBodyData + bodySize
+			: NULL;
+		memcpy(entry.body->key, cacheKey.data(), cacheKey.size());
+		insertIntoIndex(entry.index);
+		count++;
 		storeSuccesses++;
 		return entry;
 	}
@@ -672,7 +1184,7 @@ public:
 	void invalidate(Request *req) {
 		Entry entry(lookup(req->cacheKey));
 		if (entry.valid()) {
-			entry.header->valid = false;
+			erase(entry.index);
 		}
 
 		invalidateLocation(req, LOCATION);
@@ -682,11 +1194,15 @@ public:
 
 	string inspect() const {
 		stringstream stream;
-		for (unsigned int i = 0; i < MAX_ENTRIES; i++) {
+		for (unsigned int i = 0; i < maxEntries; i++) {
+			if (!headers[i].valid) {
+				continue;
+			}
 			time_t expiryDate = bodies[i].expiryDate;
 			stream << " #" << i << ": valid=" << headers[i].valid
 				<< ", hash=" << headers[i].hash
 				<< ", expiryDate=" << expiryDate
+				<< ", gzip=" << (bodies[i].httpGzipBodySize > 0)
 				<< ", keySize=" << headers[i].keySize << ", key=\""
 				<< cEscapeString(StaticString(bodies[i].key, headers[i].keySize)) << "\"\n";
 		}
@@ -112,7 +112,7 @@ private:
 				error.append(" for proxy address " + proxyAddress);
 				break;
 
-			case CURLE_SSL_CACERT:
+			// LOCALCOMPAT case CURLE_SSL_CACERT:
 				// Peer certificate cannot be authenticated with given / known CA certificates. This would happen
 				// for MITM but could also be a truststore issue.
 			case CURLE_PEER_FAILED_VERIFICATION:
@@ -36,6 +36,7 @@
 #include <Exceptions.h>
 #include <Utils/VariantMap.h>
 #include <Core/UnionStation/Context.h>
+#include <Core/SpawningKit/ShellEnvironmentCache.h>
 
 namespace Passenger {
 namespace ApplicationPool2 {
@@ -68,6 +69,13 @@ struct Config {
 	// Used by SmartSpawner and DirectSpawner.
 	RandomGeneratorPtr randomGenerator;
 	string instanceDir;
+	// If true, the expensive parts of the spawn diagnostics information
+	// (user info, ulimits, system metrics) are only collected when spawning
+	// fails, instead of by the SpawnPreparer before every spawn.
+	bool deferSpawnDiagnostics;
+	// If not NULL, login shell environments are cached here, so that
+	// `loadShellEnvvars` doesn't have to run the login shell on every spawn.
+	ShellEnvironmentCachePtr shellEnvironmentCache;
 
 	// Used by DummySpawner and SpawnerFactory.
 	unsigned int concurrency;
@@ -84,6 +92,7 @@ struct Config {
 		: resourceLocator(NULL),
 		  agentsOptions(NULL),
 		  errorHandler(NULL),
+		  deferSpawnDiagnostics(false),
 		  concurrency(1),
 		  spawnerCreationSleepTime(0),
 		  spawnTime(0),
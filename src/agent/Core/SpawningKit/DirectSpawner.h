@@ -124,7 +124,7 @@ private:
 			throw RuntimeException("No startCommand given");
 		}
 
-		if (shouldLoadShellEnvvars(options, preparation)) {
+		if (shouldRunLoginShell(options, preparation)) {
 			command.push_back(preparation.userSwitching.shell);
 			command.push_back(preparation.userSwitching.shell);
 			if (Passenger::getLogLevel() >= LVL_DEBUG3) {
@@ -140,7 +140,7 @@ private:
 		command.push_back(agentFilename);
 		command.push_back("spawn-preparer");
 		command.push_back(preparation.appRoot);
-		command.push_back(serializeEnvvarsFromPoolOptions(options));
+		command.push_back(serializeEnvvarsFromPoolOptions(options, preparation));
 		command.push_back(startCommandArgs[0]);
 		// Note: do not try to set a process title here.
 		// https://code.google.com/p/phusion-passenger/issues/detail?id=855
@@ -165,9 +165,12 @@ public:
 		P_DEBUG("Spawning new process: appRoot=" << options.appRoot);
 		possiblyRaiseInternalError(options);
 
+		MonotonicTimeUsec preparationStartTime = SystemTime::getMonotonicUsec();
 		shared_array<const char *> args;
 		SpawnPreparationInfo preparation = prepareSpawn(options);
 		vector<string> command = createCommand(options, preparation, args);
+		MonotonicTimeUsec preparationTime = SystemTime::getMonotonicUsec()
+			- preparationStartTime;
 		SocketPair adminSocket = createUnixSocketPair(__FILE__, __LINE__);
 		Pipe errorPipe = createPipe(__FILE__, __LINE__);
 		DebugDirPtr debugDir = boost::make_shared<DebugDir>(preparation.userSwitching.uid,
@@ -184,7 +187,7 @@ public:
 
 		pid = syscalls::fork();
 		if (pid == 0) {
-			setenv("PASSENGER_DEBUG_DIR", debugDir->getPath().c_str(), 1);
+			setSpawnPreparerEnvvars(preparation, *debugDir);
 			purgeStdio(stdout);
 			purgeStdio(stderr);
 			resetSignalHandlersAndMask();
@@ -250,6 +253,7 @@ public:
 			details.errorPipe = errorPipe.first;
 			details.options = &options;
 			details.debugDir = debugDir;
+			details.timings.preparation = preparationTime;
 
 			UPDATE_TRACE_POINT();
 			Result result;
@@ -260,6 +264,7 @@ public:
 			}
 
 			UPDATE_TRACE_POINT();
+			storeCapturedShellEnvironment(preparation, *debugDir);
 			detachProcess(result["pid"].asInt());
 			guard.clear();
 			P_DEBUG("Process spawning done: appRoot=" << options.appRoot <<
@@ -43,6 +43,33 @@ struct Result: public Json::Value {
 	FileDescriptor errorPipe;
 };
 
+/**
+ * Durations (in microseconds) of the stages of a spawn. Stages that
+ * a spawner doesn't have are 0. Reported in the pool inspection output
+ * through the "spawn_timings" field of the spawn Result.
+ */
+struct SpawnTimings {
+	/** Preparing the spawn (user switching info, command, etc). */
+	unsigned long long preparation;
+	/** SmartSpawner only: starting the preloader, if that was necessary. */
+	unsigned long long preloaderStart;
+	/** SmartSpawner only: letting the preloader fork off the process. */
+	unsigned long long fork;
+	/** Until the process sent the spawn protocol handshake. For DirectSpawner
+	 * this includes exec()ing, the login shell and the SpawnPreparer. */
+	unsigned long long handshake;
+	/** From the handshake until the application reported that it's ready. */
+	unsigned long long appStartup;
+
+	SpawnTimings()
+		: preparation(0),
+		  preloaderStart(0),
+		  fork(0),
+		  handshake(0),
+		  appStartup(0)
+		{ }
+};
+
 
 } // namespace SpawningKit
 } // namespace Passenger
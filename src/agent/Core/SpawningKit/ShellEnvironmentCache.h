@@ -0,0 +1,209 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SPAWNING_KIT_SHELL_ENVIRONMENT_CACHE_H_
+#define _PASSENGER_SPAWNING_KIT_SHELL_ENVIRONMENT_CACHE_H_
+
+#include <boost/thread.hpp>
+#include <boost/shared_ptr.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <string>
+#include <map>
+#include <cerrno>
+
+#include <StaticString.h>
+#include <Utils/StrIntUtils.h>
+#include <Utils/SystemTime.h>
+
+namespace Passenger {
+namespace SpawningKit {
+
+using namespace std;
+
+
+/**
+ * Caches the environment variables that a user's login shell sets up, so
+ * that spawning with `loadShellEnvvars` only has to run `shell -lc` once
+ * per (user, shell, app root) instead of on every spawn.
+ *
+ * An entry is invalidated when any of the well-known shell startup files
+ * (or the app root directory itself) is created, removed or modified, and
+ * in any case after `ttl` seconds, because startup files may source other
+ * files that we don't know about.
+ *
+ * The environment data is stored in the same format as the `envvars`
+ * argument of the SpawnPreparer: "key\0value\0key\0value\0...".
+ *
+ * This class is thread-safe.
+ */
+class ShellEnvironmentCache {
+private:
+	struct Entry {
+		string envvars;
+		string fingerprint;
+		unsigned long long createdAt;
+	};
+
+	mutable boost::mutex syncher;
+	map<string, Entry> entries;
+	unsigned int ttl;
+	unsigned long long hits, misses, invalidations;
+
+	static string createKey(uid_t uid, const StaticString &shell,
+		const StaticString &appRoot)
+	{
+		string key = toString(uid);
+		key.append(1, '\0');
+		key.append(shell.data(), shell.size());
+		key.append(1, '\0');
+		key.append(appRoot.data(), appRoot.size());
+		return key;
+	}
+
+	static void appendFileFingerprint(string &result, const string &path) {
+		struct stat buf;
+		result.append(path);
+		if (stat(path.c_str(), &buf) == 0) {
+			result.append(":");
+			result.append(toString((unsigned long long) buf.st_mtime));
+			result.append(":");
+			result.append(toString((unsigned long long) buf.st_size));
+			result.append(":");
+			result.append(toString((unsigned long long) buf.st_ino));
+		} else {
+			result.append(":-");
+		}
+		result.append(1, '\n');
+	}
+
+public:
+	ShellEnvironmentCache(unsigned int _ttl)
+		: ttl(_ttl),
+		  hits(0),
+		  misses(0),
+		  invalidations(0)
+		{ }
+
+	/**
+	 * Returns a string that changes whenever one of the files that a login
+	 * shell of the given user may read (for the given app root) changes.
+	 */
+	static string createFingerprint(const string &home, const string &appRoot) {
+		static const char *systemFiles[] = {
+			"/etc/profile", "/etc/profile.d", "/etc/environment",
+			"/etc/bash.bashrc", "/etc/bashrc",
+			"/etc/zshenv", "/etc/zprofile", "/etc/zshrc", "/etc/zlogin",
+			"/etc/zsh/zshenv", "/etc/zsh/zprofile", "/etc/zsh/zshrc", "/etc/zsh/zlogin",
+			"/etc/ksh.kshrc",
+			NULL
+		};
+		static const char *homeFiles[] = {
+			".profile", ".bash_profile", ".bash_login", ".bashrc",
+			".zshenv", ".zprofile", ".zshrc", ".zlogin", ".kshrc",
+			NULL
+		};
+		string result;
+		unsigned int i;
+
+		for (i = 0; systemFiles[i] != NULL; i++) {
+			appendFileFingerprint(result, systemFiles[i]);
+		}
+		for (i = 0; homeFiles[i] != NULL; i++) {
+			appendFileFingerprint(result, home + "/" + homeFiles[i]);
+		}
+		appendFileFingerprint(result, appRoot);
+		return result;
+	}
+
+	bool isEnabled() const {
+		return ttl > 0;
+	}
+
+	/**
+	 * Looks up the cached login shell environment. Returns false if there
+	 * is none, or if it is no longer valid.
+	 */
+	bool lookup(uid_t uid, const StaticString &shell, const StaticString &appRoot,
+		const string &fingerprint, string &envvars)
+	{
+		boost::lock_guard<boost::mutex> l(syncher);
+		map<string, Entry>::iterator it = entries.find(createKey(uid, shell, appRoot));
+
+		if (it == entries.end()) {
+			misses++;
+			return false;
+		} else if (it->second.fingerprint != fingerprint
+			|| SystemTime::getUsec() - it->second.createdAt >= ttl * 1000000ull)
+		{
+			entries.erase(it);
+			misses++;
+			invalidations++;
+			return false;
+		} else {
+			hits++;
+			envvars = it->second.envvars;
+			return true;
+		}
+	}
+
+	void store(uid_t uid, const StaticString &shell, const StaticString &appRoot,
+		const string &fingerprint, const string &envvars)
+	{
+		boost::lock_guard<boost::mutex> l(syncher);
+		Entry &entry = entries[createKey(uid, shell, appRoot)];
+		entry.envvars = envvars;
+		entry.fingerprint = fingerprint;
+		entry.createdAt = SystemTime::getUsec();
+	}
+
+	void clear() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		entries.clear();
+	}
+
+	unsigned long long getHits() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return hits;
+	}
+
+	unsigned long long getMisses() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return misses;
+	}
+
+	unsigned long long getInvalidations() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return invalidations;
+	}
+};
+
+typedef boost::shared_ptr<ShellEnvironmentCache> ShellEnvironmentCachePtr;
+
+
+} // namespace SpawningKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SPAWNING_KIT_SHELL_ENVIRONMENT_CACHE_H_ */
@@ -70,7 +70,7 @@ private:
 	map<string, string> preloaderAnnotations;
 	Options options;
 
-	// Protects m_lastUsed and pid.
+	// Protects m_lastUsed, pid and preloaderAnnotations.
 	mutable boost::mutex simpleFieldSyncher;
 	// Protects everything else.
 	mutable boost::mutex syncher;
@@ -103,7 +103,7 @@ private:
 		string agentFilename = config->resourceLocator->findSupportBinary(AGENT_EXE);
 		vector<string> command;
 
-		if (shouldLoadShellEnvvars(options, preparation)) {
+		if (shouldRunLoginShell(options, preparation)) {
 			command.push_back(preparation.userSwitching.shell);
 			command.push_back(preparation.userSwitching.shell);
 			if (Passenger::getLogLevel() >= LVL_DEBUG3) {
@@ -119,7 +119,7 @@ private:
 		command.push_back(agentFilename);
 		command.push_back("spawn-preparer");
 		command.push_back(preparation.appRoot);
-		command.push_back(serializeEnvvarsFromPoolOptions(options));
+		command.push_back(serializeEnvvarsFromPoolOptions(options, preparation));
 		command.push_back(preloaderCommand[0]);
 		// Note: do not try to set a process title here.
 		// https://code.google.com/p/phusion-passenger/issues/detail?id=855
@@ -199,6 +199,7 @@ private:
 		if (debugDir != NULL) {
 			e.addAnnotations(debugDir->readAll());
 		}
+		addDeferredDiagnostics(e, &preparation, options);
 	}
 
 	bool preloaderStarted() const {
@@ -230,7 +231,7 @@ private:
 		                                 options.lveMinUid);
 		pid_t pid = syscalls::fork();
 		if (pid == 0) {
-			setenv("PASSENGER_DEBUG_DIR", debugDir->getPath().c_str(), 1);
+			setSpawnPreparerEnvvars(preparation, *debugDir);
 			purgeStdio(stdout);
 			purgeStdio(stderr);
 			resetSignalHandlersAndMask();
@@ -319,7 +320,12 @@ private:
 			watcher->initialize();
 			watcher->start();
 
-			preloaderAnnotations = debugDir->readAll();
+			storeCapturedShellEnvironment(preparation, *debugDir);
+			map<string, string> annotations = debugDir->readAll();
+			{
+				boost::lock_guard<boost::mutex> l(simpleFieldSyncher);
+				preloaderAnnotations = annotations;
+			}
 			P_INFO("Preloader for " << options.appRoot <<
 				" started on PID " << pid <<
 				", listening on " << socketAddress);
@@ -632,12 +638,8 @@ private:
 		return "";
 	}
 
-	NegotiationDetails sendSpawnCommandAndGetNegotiationDetails(const Options &options) {
+	void sendSpawnCommandAndGetNegotiationDetails(NegotiationDetails &details) {
 		TRACE_POINT();
-		NegotiationDetails details;
-
-		details.preparation = &preparation;
-		details.options = &options;
 
 		try {
 			sendSpawnCommand(details);
@@ -648,8 +650,6 @@ private:
 		} catch (const SpawnException &e) {
 			sendSpawnCommandAgain(e, details);
 		}
-
-		return details;
 	}
 
 	void sendSpawnCommand(NegotiationDetails &details) {
@@ -753,7 +753,12 @@ private:
 protected:
 	virtual void annotateAppSpawnException(SpawnException &e, NegotiationDetails &details) {
 		Spawner::annotateAppSpawnException(e, details);
-		e.addAnnotations(preloaderAnnotations);
+		map<string, string> annotations;
+		{
+			boost::lock_guard<boost::mutex> l(simpleFieldSyncher);
+			annotations = preloaderAnnotations;
+		}
+		e.addAnnotations(annotations);
 	}
 
 public:
@@ -790,14 +795,37 @@ public:
 			m_lastUsed = SystemTime::getUsec();
 		}
 		UPDATE_TRACE_POINT();
-		boost::lock_guard<boost::mutex> l(syncher);
-		if (!preloaderStarted()) {
+		NegotiationDetails details;
+		SpawnPreparationInfo preparation;
+		details.options = &options;
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			MonotonicTimeUsec startTime = SystemTime::getMonotonicUsec();
+			if (!preloaderStarted()) {
+				UPDATE_TRACE_POINT();
+				startPreloader();
+				details.timings.preloaderStart = SystemTime::getMonotonicUsec()
+					- startTime;
+				startTime += details.timings.preloaderStart;
+			}
+
 			UPDATE_TRACE_POINT();
-			startPreloader();
+			details.preparation = &this->preparation;
+			sendSpawnCommandAndGetNegotiationDetails(details);
+			details.timings.fork = SystemTime::getMonotonicUsec() - startTime;
+			// The preloader may be restarted by another spawn once we
+			// release the lock, so keep a copy of the preparation info.
+			preparation = this->preparation;
+			details.preparation = &preparation;
 		}
 
+		/* The preloader has forked off the new process by now. Negotiating
+		 * with that process (which includes waiting for the application to
+		 * finish starting up) does not involve the preloader, so we do that
+		 * without holding the lock. This allows multiple processes to start
+		 * up concurrently.
+		 */
 		UPDATE_TRACE_POINT();
-		NegotiationDetails details = sendSpawnCommandAndGetNegotiationDetails(options);
 		Result result = negotiateSpawn(details);
 		P_DEBUG("Process spawning done: appRoot=" << options.appRoot <<
 			", pid=" << result["pid"].asInt());
@@ -90,6 +90,7 @@
 #include <Utils/IOUtils.h>
 #include <Utils/StrIntUtils.h>
 #include <Utils/ProcessMetricsCollector.h>
+#include <Utils/SystemMetricsCollector.h>
 #include <Core/SpawningKit/Config.h>
 #include <Core/SpawningKit/Options.h>
 #include <Core/SpawningKit/Result.h>
@@ -210,8 +211,25 @@ protected:
 
 		UserSwitchingInfo userSwitching;
 
+		// Login shell
+
+		/** Whether the environment of the login shell was found in
+		 * Config::shellEnvironmentCache. If so, the login shell is skipped and
+		 * cachedShellEnvvars is passed to the SpawnPreparer instead. */
+		bool usingCachedShellEnvvars;
+		/** Whether the SpawnPreparer should dump the environment of the login
+		 * shell, so that it can be stored in Config::shellEnvironmentCache. */
+		bool captureShellEnvvars;
+		string cachedShellEnvvars;
+		string shellEnvironmentFingerprint;
+
 		// Other information
 		string codeRevision;
+
+		SpawnPreparationInfo()
+			: usingCachedShellEnvvars(false),
+			  captureShellEnvvars(false)
+			{ }
 	};
 
 	/**
@@ -243,6 +261,7 @@ protected:
 		string gupid;
 		unsigned long long spawnStartTime;
 		unsigned long long timeout;
+		SpawnTimings timings;
 
 		NegotiationDetails() {
 			preparation = NULL;
@@ -431,6 +450,12 @@ private:
 		result["code_revision"] = details.preparation->codeRevision;
 		result["spawner_creation_time"] = (Json::UInt64) creationTime;
 		result["spawn_start_time"] = (Json::UInt64) details.spawnStartTime;
+		Json::Value &timings = result["spawn_timings"];
+		timings["preparation"] = (Json::UInt64) details.timings.preparation;
+		timings["preloader_start"] = (Json::UInt64) details.timings.preloaderStart;
+		timings["fork"] = (Json::UInt64) details.timings.fork;
+		timings["handshake"] = (Json::UInt64) details.timings.handshake;
+		timings["app_startup"] = (Json::UInt64) details.timings.appStartup;
 		result.adminSocket = details.adminSocket;
 		result.errorPipe = details.errorPipe;
 		return result;
@@ -654,6 +679,65 @@ protected:
 		if (details.debugDir != NULL) {
 			e.addAnnotations(details.debugDir->readAll());
 		}
+		addDeferredDiagnostics(e, details.preparation, *details.options);
+	}
+
+	/**
+	 * If Config::deferSpawnDiagnostics is set, the SpawnPreparer doesn't
+	 * collect the user info, ulimits and system metrics. This collects them
+	 * from the spawner's side instead, now that we know that they're needed.
+	 * They're not necessarily identical to what the process saw (for example,
+	 * ulimits are inherited from us, except for the file descriptor limit),
+	 * but close enough for troubleshooting.
+	 */
+	void addDeferredDiagnostics(SpawnException &e, const SpawnPreparationInfo *preparation,
+		const Options &options)
+	{
+		TRACE_POINT();
+		if (!config->deferSpawnDiagnostics) {
+			return;
+		}
+
+		if (e.get("user_info").empty() && preparation != NULL
+		 && !preparation->userSwitching.username.empty())
+		{
+			const char *command[] = { "id", preparation->userSwitching.username.c_str(), NULL };
+			try {
+				e.set("user_info", runCommandAndCaptureOutput(command));
+			} catch (const std::exception &e2) {
+				P_DEBUG("Cannot collect user info: " << e2.what());
+			}
+		}
+
+		if (e.get("ulimit").empty()) {
+			const char *command[] = { "/bin/sh", "-c", "ulimit -a", NULL };
+			try {
+				string ulimits = runCommandAndCaptureOutput(command);
+				if (options.fileDescriptorUlimit != 0) {
+					ulimits.append("(file descriptor limit overridden for the application: "
+						+ toString(options.fileDescriptorUlimit) + ")\n");
+				}
+				e.set("ulimit", ulimits);
+			} catch (const std::exception &e2) {
+				P_DEBUG("Cannot collect ulimits: " << e2.what());
+			}
+		}
+
+		if (e.get("system_metrics").empty()) {
+			try {
+				SystemMetricsCollector collector;
+				SystemMetrics metrics;
+				stringstream stream;
+
+				collector.collect(metrics);
+				syscalls::usleep(50000); // Correct collect CPU metrics.
+				collector.collect(metrics);
+				metrics.toDescription(stream);
+				e.set("system_metrics", stream.str());
+			} catch (const RuntimeException &e2) {
+				P_DEBUG("Cannot collect system metrics: " << e2.what());
+			}
+		}
 	}
 
 	string createErrorPageFromStderrOutput(const string &msg,
@@ -720,9 +804,73 @@ protected:
 		info.userSwitching = prepareUserSwitching(options);
 		prepareSwitchingWorkingDirectory(info, options);
 		inferApplicationInfo(info);
+		prepareShellEnvironment(info, options);
 		return info;
 	}
 
+	void prepareShellEnvironment(SpawnPreparationInfo &info, const Options &options) {
+		TRACE_POINT();
+		const ShellEnvironmentCachePtr &cache = config->shellEnvironmentCache;
+
+		// We don't know which files the shell reads inside a chroot.
+		if (cache == NULL || !cache->isEnabled() || info.chrootDir != "/"
+		 || !shouldLoadShellEnvvars(options, info))
+		{
+			return;
+		}
+
+		info.shellEnvironmentFingerprint = ShellEnvironmentCache::createFingerprint(
+			info.userSwitching.home, info.appRoot);
+		if (cache->lookup(info.userSwitching.uid, info.userSwitching.shell,
+			info.appRoot, info.shellEnvironmentFingerprint, info.cachedShellEnvvars))
+		{
+			P_DEBUG("Using cached login shell environment for " << info.appRoot);
+			info.usingCachedShellEnvvars = true;
+		} else {
+			info.captureShellEnvvars = true;
+		}
+	}
+
+	/**
+	 * Called after a successful spawn: if the SpawnPreparer dumped the login
+	 * shell's environment into the debug directory, then store it in the cache.
+	 */
+	void storeCapturedShellEnvironment(const SpawnPreparationInfo &info,
+		const DebugDir &debugDir)
+	{
+		TRACE_POINT();
+		if (!info.captureShellEnvvars) {
+			return;
+		}
+
+		string path = debugDir.getPath() + "/.shell_envvars";
+		try {
+			string envvars = Passenger::readAll(path);
+			if (!envvars.empty()) {
+				config->shellEnvironmentCache->store(info.userSwitching.uid,
+					info.userSwitching.shell, info.appRoot,
+					info.shellEnvironmentFingerprint, envvars);
+			}
+		} catch (const SystemException &e) {
+			P_DEBUG("Cannot read captured login shell environment: " << e.what());
+		}
+		syscalls::unlink(path.c_str());
+	}
+
+	/**
+	 * Sets the environment variables through which the spawned SpawnPreparer
+	 * is controlled. Called after fork(), before exec().
+	 */
+	void setSpawnPreparerEnvvars(const SpawnPreparationInfo &info, const DebugDir &debugDir) {
+		setenv("PASSENGER_DEBUG_DIR", debugDir.getPath().c_str(), 1);
+		if (info.captureShellEnvvars) {
+			setenv("PASSENGER_CAPTURE_SHELL_ENVVARS", "1", 1);
+		}
+		if (config->deferSpawnDiagnostics) {
+			setenv("PASSENGER_DEFER_SPAWN_DIAGNOSTICS", "1", 1);
+		}
+	}
+
 	void prepareChroot(SpawnPreparationInfo &info, const Options &options) {
 		TRACE_POINT();
 		info.appRoot = absolutizePath(options.appRoot);
@@ -828,9 +976,23 @@ protected:
 		}
 	}
 
-	string serializeEnvvarsFromPoolOptions(const Options &options) const {
+	/**
+	 * Whether the SpawnPreparer must be run through the user's login shell.
+	 * This is not necessary if the shell's environment has been cached.
+	 */
+	bool shouldRunLoginShell(const Options &options, const SpawnPreparationInfo &preparation) const {
+		return !preparation.usingCachedShellEnvvars
+			&& shouldLoadShellEnvvars(options, preparation);
+	}
+
+	string serializeEnvvarsFromPoolOptions(const Options &options,
+		const SpawnPreparationInfo &preparation) const
+	{
 		vector< pair<StaticString, StaticString> >::const_iterator it, end;
-		string result;
+		// The cached login shell environment comes first, so that
+		// our own environment variables take precedence, just like
+		// when the SpawnPreparer is run through the login shell.
+		string result = preparation.cachedShellEnvvars;
 
 		appendNullTerminatedKeyValue(result, "IN_PASSENGER", "1");
 		appendNullTerminatedKeyValue(result, "PYTHONUNBUFFERED", "1");
@@ -1103,6 +1265,8 @@ protected:
 			config->randomGenerator->generateAsciiString(10);
 		details.timeout = details.options->startTimeout * 1000;
 
+		MonotonicTimeUsec negotiationStartTime = SystemTime::getMonotonicUsec();
+		MonotonicTimeUsec handshakeTime;
 		string result;
 		try {
 			result = readMessageLine(details);
@@ -1119,6 +1283,9 @@ protected:
 				details);
 		}
 
+		handshakeTime = SystemTime::getMonotonicUsec();
+		details.timings.handshake = handshakeTime - negotiationStartTime;
+
 		protocol_begin:
 		if (result == "I have control 1.0\n") {
 			UPDATE_TRACE_POINT();
@@ -1138,6 +1305,7 @@ protected:
 					details);
 			}
 			if (result == "Ready\n") {
+				details.timings.appStartup = SystemTime::getMonotonicUsec() - handshakeTime;
 				return handleSpawnResponse(details);
 			} else if (result == "Error\n") {
 				handleSpawnErrorResponse(details);
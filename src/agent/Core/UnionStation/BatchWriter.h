@@ -0,0 +1,451 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_UNION_STATION_BATCH_WRITER_H_
+#define _PASSENGER_UNION_STATION_BATCH_WRITER_H_
+
+#include <boost/shared_ptr.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <oxt/thread.hpp>
+#include <oxt/backtrace.hpp>
+
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include <arpa/inet.h>
+
+#include <Logging.h>
+#include <Exceptions.h>
+#include <StaticString.h>
+#include <Utils/IOUtils.h>
+#include <Core/UnionStation/Connection.h>
+
+namespace Passenger {
+namespace UnionStation {
+
+using namespace std;
+using namespace boost;
+
+
+/**
+ * Writes messages to UstRouter connections in a background thread, so that
+ * the threads that log to a Transaction (e.g. the Controller's event loop
+ * threads) never block on UstRouter I/O.
+ *
+ * Messages are serialized directly into a buffer in their Connection (a
+ * QueuedWrite), which is reused from one write to the next. When a buffer
+ * goes from empty to non-empty, it is pushed onto a lock-free
+ * multi-producer single-consumer queue. The writer thread pops buffers
+ * from that queue and writes each one with a single write().
+ *
+ * Messages for the same connection are written in the order in which they
+ * were queued. Log messages for different connections may be reordered,
+ * but the closeTransaction message that ends a connection's checkout gets
+ * a QueuedWrite of its own at the back of the queue, so it's written after
+ * everything that was queued before it, also on other connections. This
+ * matters when a transaction is continued by another Context that shares
+ * this BatchWriter: the UstRouter must not see the transaction being
+ * closed before it sees it being reopened. The writer thread checks the
+ * connection back into its pool once that message has been written, so
+ * that nobody else can use the connection while messages for it are
+ * still queued.
+ *
+ * The number of queued messages is bounded. When the UstRouter cannot keep
+ * up, droppable messages (log lines) are dropped instead of queued and
+ * counted in `Stats::dropped`. Transaction control messages are never
+ * dropped, so that the UstRouter's view of which transactions are open
+ * stays correct.
+ */
+class BatchWriter: public boost::noncopyable {
+public:
+	static const unsigned int DEFAULT_MAX_QUEUED_MESSAGES = 8192;
+	static const unsigned long long IO_TIMEOUT = 5000000; // In microseconds.
+	/** Array messages encode their size in 16 bits, see Utils/MessageIO.h. */
+	static const unsigned int MAX_ARRAY_MESSAGE_SIZE = 0xFFFF;
+	/** A connection's write buffer is freed instead of reused if it grew
+	 * larger than this.
+	 */
+	static const unsigned int MAX_RETAINED_BUFFER_SIZE = 1024 * 64;
+
+	struct Stats {
+		/** Number of messages currently queued. */
+		unsigned int queued;
+		/** Highest number of messages that was ever queued at the same time. */
+		unsigned int peakQueued;
+		/** Number of messages successfully written. */
+		boost::uint64_t written;
+		/** Number of write() calls that `written` was written in. */
+		boost::uint64_t batches;
+		/** Number of messages dropped because the queue was full. */
+		boost::uint64_t dropped;
+		/** Number of messages rejected because they're too large for the
+		 * UstRouter protocol.
+		 */
+		boost::uint64_t rejected;
+		/** Number of messages lost because their connection was closed or
+		 * writing to it failed.
+		 */
+		boost::uint64_t failed;
+	};
+
+private:
+	/****** Queue. Intrusive MPSC queue by Dmitry Vyukov. ******/
+
+	/** Producers push here. */
+	boost::atomic<QueuedWrite *> head;
+	char padding[128];
+	/** The writer thread pops here. Only accessed by the writer thread. */
+	QueuedWrite *tail;
+	QueuedWrite stub;
+
+	boost::atomic<unsigned int> queueLength;
+	const unsigned int maxQueuedMessages;
+
+	/****** Statistics ******/
+
+	boost::atomic<unsigned int> peakQueued;
+	boost::atomic<boost::uint64_t> written;
+	boost::atomic<boost::uint64_t> batches;
+	boost::atomic<boost::uint64_t> dropped;
+	boost::atomic<boost::uint64_t> rejected;
+	boost::atomic<boost::uint64_t> failed;
+
+	/****** Writer thread synchronization ******/
+
+	boost::mutex syncher;
+	boost::condition_variable cond;
+	/** Set while the writer thread waits for messages. Producers only touch
+	 * the mutex to wake it up.
+	 */
+	boost::atomic<bool> sleeping;
+	bool quit;
+	oxt::thread *thr;
+
+	void push(QueuedWrite *node) {
+		node->next.store(NULL, boost::memory_order_relaxed);
+		QueuedWrite *prev = head.exchange(node, boost::memory_order_acq_rel);
+		prev->next.store(node, boost::memory_order_release);
+	}
+
+	/**
+	 * Returns NULL if the queue is empty, or if a producer is in the middle
+	 * of pushing the next node.
+	 */
+	QueuedWrite *pop() {
+		QueuedWrite *t = tail;
+		QueuedWrite *next = t->next.load(boost::memory_order_acquire);
+
+		if (t == &stub) {
+			if (next == NULL) {
+				return NULL;
+			}
+			tail = next;
+			t = next;
+			next = next->next.load(boost::memory_order_acquire);
+		}
+		if (next != NULL) {
+			tail = next;
+			return t;
+		}
+		if (t != head.load(boost::memory_order_acquire)) {
+			return NULL;
+		}
+		push(&stub);
+		next = t->next.load(boost::memory_order_acquire);
+		if (next != NULL) {
+			tail = next;
+			return t;
+		}
+		return NULL;
+	}
+
+	void updatePeakQueued(unsigned int length) {
+		unsigned int peak = peakQueued.load(boost::memory_order_relaxed);
+		while (length > peak
+			&& !peakQueued.compare_exchange_weak(peak, length, boost::memory_order_relaxed))
+		{
+			// Retry with the updated peak.
+		}
+	}
+
+	void threadMain() {
+		TRACE_POINT();
+
+		while (true) {
+			QueuedWrite *node;
+			bool popped = false;
+
+			while ((node = pop()) != NULL) {
+				UPDATE_TRACE_POINT();
+				writeQueued(node);
+				popped = true;
+			}
+			if (popped) {
+				continue;
+			}
+
+			boost::unique_lock<boost::mutex> l(syncher);
+			if (queueLength.load() > 0) {
+				// A producer is in the middle of pushing.
+				l.unlock();
+				boost::this_thread::yield();
+				continue;
+			} else if (quit) {
+				break;
+			}
+			sleeping.store(true);
+			if (queueLength.load() == 0 && !quit) {
+				cond.wait(l);
+			}
+			sleeping.store(false);
+		}
+	}
+
+	void writeQueued(QueuedWrite *node) {
+		Connection *c = node->connection;
+		ConnectionPtr connection;
+		ConnectionPoolPtr checkinPool;
+		unsigned int nmessages;
+
+		{
+			boost::lock_guard<boost::mutex> l(c->queueSyncher);
+			// Producers continue with the buffer that we wrote last
+			// time, which is empty but still has its capacity.
+			node->data.swap(c->writeBuffer);
+			nmessages = node->nmessages;
+			node->nmessages = 0;
+			node->queued = false;
+			connection.swap(node->self);
+			checkinPool.swap(node->checkinPool);
+		}
+		queueLength.fetch_sub(nmessages);
+
+		if (!c->writeBuffer.empty()) {
+			write(connection, nmessages);
+		}
+		if (c->writeBuffer.capacity() > MAX_RETAINED_BUFFER_SIZE) {
+			string().swap(c->writeBuffer);
+		} else {
+			c->writeBuffer.clear();
+		}
+
+		if (checkinPool != NULL) {
+			checkinPool->checkin(connection);
+		}
+	}
+
+	void write(const ConnectionPtr &connection, unsigned int nmessages) {
+		TRACE_POINT();
+		ConnectionLock l(connection);
+		if (!connection->connected()) {
+			failed.fetch_add(nmessages, boost::memory_order_relaxed);
+			return;
+		}
+
+		try {
+			unsigned long long timeout = IO_TIMEOUT;
+			writeExact(connection->fd, connection->writeBuffer.data(),
+				connection->writeBuffer.size(), &timeout);
+			written.fetch_add(nmessages, boost::memory_order_relaxed);
+			batches.fetch_add(1, boost::memory_order_relaxed);
+		} catch (const TimeoutException &) {
+			connection->disconnect();
+			failed.fetch_add(nmessages, boost::memory_order_relaxed);
+			P_WARN("Timeout trying to send data to the UstRouter; "
+				"closing the connection");
+		} catch (const SystemException &e) {
+			connection->disconnect();
+			failed.fetch_add(nmessages, boost::memory_order_relaxed);
+			P_WARN("Cannot send data to the UstRouter (" << e.what() <<
+				"); closing the connection");
+		}
+	}
+
+
+	/***** Message serialization, see Utils/MessageIO.h *****/
+
+	static void appendSize(string &output, boost::uint16_t size) {
+		boost::uint16_t header = htons(size);
+		output.append((const char *) &header, sizeof(header));
+	}
+
+	static void appendSize(string &output, boost::uint32_t size) {
+		boost::uint32_t header = htonl(size);
+		output.append((const char *) &header, sizeof(header));
+	}
+
+	static size_t arrayMessageBodySize(const StaticString args[], unsigned int nargs) {
+		size_t bodySize = 0;
+		for (unsigned int i = 0; i < nargs; i++) {
+			bodySize += args[i].size() + 1;
+		}
+		return bodySize;
+	}
+
+	/**
+	 * @pre bodySize == arrayMessageBodySize(args, nargs)
+	 * @pre bodySize <= MAX_ARRAY_MESSAGE_SIZE
+	 */
+	static void appendArrayMessage(string &output, const StaticString args[],
+		unsigned int nargs, size_t bodySize)
+	{
+		appendSize(output, (boost::uint16_t) bodySize);
+		for (unsigned int i = 0; i < nargs; i++) {
+			output.append(args[i].data(), args[i].size());
+			output.append(1, '\0');
+		}
+	}
+
+	static void appendScalarMessage(string &output, const StaticString &data) {
+		appendSize(output, (boost::uint32_t) data.size());
+		output.append(data.data(), data.size());
+	}
+
+public:
+	BatchWriter(unsigned int _maxQueuedMessages = DEFAULT_MAX_QUEUED_MESSAGES)
+		: head(&stub),
+		  tail(&stub),
+		  queueLength(0),
+		  maxQueuedMessages(_maxQueuedMessages),
+		  peakQueued(0),
+		  written(0),
+		  batches(0),
+		  dropped(0),
+		  rejected(0),
+		  failed(0),
+		  sleeping(false),
+		  quit(false)
+	{
+		thr = new oxt::thread(boost::bind(&BatchWriter::threadMain, this),
+			"Union Station writer", 1024 * 128);
+	}
+
+	/**
+	 * Writes out all queued messages and stops the writer thread.
+	 */
+	~BatchWriter() {
+		boost::this_thread::disable_interruption di;
+		boost::this_thread::disable_syscall_interruption dsi;
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			quit = true;
+			cond.notify_one();
+		}
+		thr->join();
+		delete thr;
+	}
+
+	/**
+	 * Queues an array message consisting of `args`, followed by the scalar
+	 * message `scalar` if it's not NULL, for writing to `connection`.
+	 *
+	 * @param checkinPool If given, this is the last message for `connection`:
+	 *                    the writer thread checks the connection into this
+	 *                    pool once the message has been written. The caller
+	 *                    must not use the connection anymore.
+	 * @return Whether the message was queued. Droppable messages are not
+	 *         queued if the queue is full. Array messages that are larger
+	 *         than MAX_ARRAY_MESSAGE_SIZE are never queued.
+	 */
+	bool queue(const ConnectionPtr &connection, const StaticString args[],
+		unsigned int nargs, const StaticString *scalar, bool droppable,
+		const ConnectionPoolPtr &checkinPool = ConnectionPoolPtr())
+	{
+		size_t bodySize = arrayMessageBodySize(args, nargs);
+		if (OXT_UNLIKELY(bodySize > MAX_ARRAY_MESSAGE_SIZE)) {
+			rejected.fetch_add(1, boost::memory_order_relaxed);
+			P_WARN("Cannot send a " << bodySize << " bytes large " << args[0] <<
+				" message to the UstRouter: the maximum is " <<
+				MAX_ARRAY_MESSAGE_SIZE << " bytes");
+			return false;
+		}
+
+		unsigned int length = queueLength.fetch_add(1) + 1;
+		if (length > maxQueuedMessages && droppable) {
+			queueLength.fetch_sub(1);
+			dropped.fetch_add(1, boost::memory_order_relaxed);
+			return false;
+		}
+		updatePeakQueued(length);
+
+		QueuedWrite *node = (checkinPool != NULL)
+			? &connection->queuedClose
+			: &connection->queuedMessages;
+		bool needsPush;
+		{
+			boost::lock_guard<boost::mutex> l(connection->queueSyncher);
+			appendArrayMessage(node->data, args, nargs, bodySize);
+			if (scalar != NULL) {
+				appendScalarMessage(node->data, *scalar);
+			}
+			node->nmessages++;
+			node->checkinPool = checkinPool;
+			needsPush = !node->queued;
+			if (needsPush) {
+				node->queued = true;
+				node->self = connection;
+			}
+		}
+		if (needsPush) {
+			push(node);
+		}
+
+		if (sleeping.load()) {
+			boost::lock_guard<boost::mutex> l(syncher);
+			cond.notify_one();
+		}
+		return true;
+	}
+
+	Stats getStats() const {
+		Stats stats;
+		stats.queued = queueLength.load(boost::memory_order_relaxed);
+		stats.peakQueued = peakQueued.load(boost::memory_order_relaxed);
+		stats.written = written.load(boost::memory_order_relaxed);
+		stats.batches = batches.load(boost::memory_order_relaxed);
+		stats.dropped = dropped.load(boost::memory_order_relaxed);
+		stats.rejected = rejected.load(boost::memory_order_relaxed);
+		stats.failed = failed.load(boost::memory_order_relaxed);
+		return stats;
+	}
+
+	unsigned int getMaxQueuedMessages() const {
+		return maxQueuedMessages;
+	}
+};
+
+typedef boost::shared_ptr<BatchWriter> BatchWriterPtr;
+
+
+} // namespace UnionStation
+} // namespace Passenger
+
+#endif /* _PASSENGER_UNION_STATION_BATCH_WRITER_H_ */
@@ -29,6 +29,7 @@
 #include <boost/thread.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/atomic.hpp>
 #include <oxt/system_calls.hpp>
 #include <oxt/backtrace.hpp>
 
@@ -36,6 +37,7 @@
 #include <vector>
 
 #include <errno.h>
+#include <poll.h>
 
 #include <Logging.h>
 #include <Exceptions.h>
@@ -50,7 +52,9 @@ using namespace boost;
 
 
 struct Connection;
+class ConnectionPool;
 typedef boost::shared_ptr<Connection> ConnectionPtr;
+typedef boost::shared_ptr<ConnectionPool> ConnectionPoolPtr;
 
 inline void _disconnectConnection(Connection *connection);
 
@@ -83,6 +87,35 @@ public:
 };
 
 
+/**
+ * Serialized messages that a BatchWriter has yet to write to a Connection.
+ * This is a node in the BatchWriter's queue; see BatchWriter for how it's used.
+ */
+struct QueuedWrite: public boost::noncopyable {
+	/** Next node in the BatchWriter's queue. */
+	boost::atomic<QueuedWrite *> next;
+	Connection * const connection;
+
+	/****** These fields are synchronized through the Connection's queueSyncher ******/
+
+	string data;
+	unsigned int nmessages;
+	/** Whether this node is in the BatchWriter's queue. */
+	bool queued;
+	/** Keeps the Connection alive while this node is in the queue. */
+	ConnectionPtr self;
+	/** If set, the Connection is checked into this pool once `data` has been written. */
+	ConnectionPoolPtr checkinPool;
+
+	QueuedWrite(Connection *_connection = NULL)
+		: next(NULL),
+		  connection(_connection),
+		  nmessages(0),
+		  queued(false)
+		{ }
+};
+
+
 /**
  * Represents a connection to the UstRouter.
  * All access to the file descriptor must be synchronized through the syncher.
@@ -92,8 +125,21 @@ struct Connection: public boost::noncopyable {
 	mutable boost::mutex syncher;
 	int fd;
 
+	/****** Used by BatchWriter ******/
+
+	/** Synchronizes the QueuedWrites. Never held during I/O. */
+	boost::mutex queueSyncher;
+	/** Messages logged through this connection. */
+	QueuedWrite queuedMessages;
+	/** The closeTransaction message that ends the current checkout. */
+	QueuedWrite queuedClose;
+	/** What the writer thread is writing. Only accessed by that thread. */
+	string writeBuffer;
+
 	Connection(int _fd)
-		: fd(_fd)
+		: fd(_fd),
+		  queuedMessages(this),
+		  queuedClose(this)
 		{ }
 
 	~Connection() {
@@ -104,6 +150,36 @@ struct Connection: public boost::noncopyable {
 		return fd != -1;
 	}
 
+	/**
+	 * Checks whether the UstRouter has closed this connection, without
+	 * blocking. The UstRouter never sends anything unsolicited, so a
+	 * readable socket means that it was closed (or is in a bad state).
+	 * In that case the connection is disconnected.
+	 *
+	 * @return Whether the connection is still connected.
+	 */
+	bool disconnectIfClosedByPeer() {
+		if (fd == -1) {
+			return false;
+		}
+
+		struct pollfd pfd;
+		int ret;
+
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		do {
+			ret = poll(&pfd, 1, 0);
+		} while (ret == -1 && errno == EINTR);
+		if (ret != 0) {
+			disconnect();
+			return false;
+		} else {
+			return true;
+		}
+	}
+
 	void disconnect() {
 		if (fd != -1) {
 			boost::this_thread::disable_interruption di;
@@ -161,6 +237,48 @@ struct ConnectionLock: public boost::noncopyable {
 };
 
 
+/**
+ * The idle connections of a Context. It's separate from the Context so that
+ * the BatchWriter can check a connection in once it has written everything
+ * that was queued for it, without having to keep the Context alive.
+ */
+class ConnectionPool: public boost::noncopyable {
+private:
+	boost::mutex syncher;
+	vector<ConnectionPtr> connections;
+	const unsigned int maxSize;
+
+public:
+	ConnectionPool(unsigned int _maxSize)
+		: maxSize(_maxSize)
+		{ }
+
+	/**
+	 * Returns NULL if there are no idle connections.
+	 */
+	ConnectionPtr checkout() {
+		boost::lock_guard<boost::mutex> l(syncher);
+		if (connections.empty()) {
+			return ConnectionPtr();
+		} else {
+			ConnectionPtr connection = connections.back();
+			connections.pop_back();
+			return connection;
+		}
+	}
+
+	void checkin(const ConnectionPtr &connection) {
+		boost::unique_lock<boost::mutex> l(syncher);
+		if (connections.size() < maxSize) {
+			connections.push_back(connection);
+		} else {
+			l.unlock();
+			connection->disconnect();
+		}
+	}
+};
+
+
 inline void
 _disconnectConnection(Connection *connection) {
 	connection->disconnect();
@@ -44,6 +44,7 @@
 #include <Utils/MessageIO.h>
 #include <Utils/SystemTime.h>
 #include <Core/UnionStation/Connection.h>
+#include <Core/UnionStation/BatchWriter.h>
 #include <Core/UnionStation/Transaction.h>
 
 namespace Passenger {
@@ -65,6 +66,7 @@ private:
 
 	/**** Working objects ****/
 	TransactionPtr nullTransaction;
+	BatchWriterPtr writer;
 
 	/********************** Connection handling fields **********************
 	 * These fields are synchronized through the mutex. The contents
@@ -72,7 +74,8 @@ private:
 	 * but through the Connection object's own mutex.
 	 ************************************************************************/
 	mutable boost::mutex syncher;
-	vector<ConnectionPtr> connectionPool;
+	/** Has its own lock, so it's not synchronized through the mutex. */
+	ConnectionPoolPtr connectionPool;
 	/** How long to wait before reconnecting. */
 	unsigned long long reconnectTimeout;
 	/** Earliest time at which we should attempt a reconnect. Earlier attempts
@@ -93,6 +96,7 @@ private:
 
 	void initialize() {
 		nullTransaction   = boost::make_shared<Transaction>();
+		connectionPool.reset(new ConnectionPool(CONNECTION_POOL_MAX_SIZE));
 		reconnectTimeout  = 1000000;
 		nextReconnectTime = 0;
 	}
@@ -177,14 +181,25 @@ public:
 		initialize();
 	}
 
+	/**
+	 * @param _writer The BatchWriter to write messages with. Contexts that
+	 *                continue each other's transactions should share one,
+	 *                see BatchWriter for the ordering guarantees. If not
+	 *                given, this Context creates its own BatchWriter.
+	 */
 	Context(const string &_serverAddress, const string &_username,
-	     const string &_password, const string &_nodeName = string())
+	     const string &_password, const string &_nodeName = string(),
+	     const BatchWriterPtr &_writer = BatchWriterPtr())
 		: serverAddress(_serverAddress),
 		  username(_username),
 		  password(_password),
-		  nodeName(_nodeName)
+		  nodeName(_nodeName),
+		  writer(_writer)
 	{
 		initialize();
+		if (writer == NULL && !isNull()) {
+			writer = boost::make_shared<BatchWriter>();
+		}
 	}
 
 
@@ -192,14 +207,34 @@ public:
 
 	ConnectionPtr checkoutConnection() {
 		TRACE_POINT();
-		boost::unique_lock<boost::mutex> l(syncher);
-		if (!connectionPool.empty()) {
+		ConnectionPtr connection = connectionPool->checkout();
+		boost::unique_lock<boost::mutex> l(syncher, boost::defer_lock);
+
+		if (connection != NULL) {
 			P_TRACE(3, "Checked out existing connection");
-			ConnectionPtr connection = connectionPool.back();
-			connectionPool.pop_back();
+
+			// Writes happen asynchronously in the BatchWriter, so this is
+			// where we find out that the UstRouter went away. Connections
+			// are only checked in after everything queued for them has been
+			// written, so the writer is not using this one.
+			bool alive;
+			{
+				ConnectionLock cl(connection);
+				alive = connection->disconnectIfClosedByPeer();
+			}
+			if (!alive) {
+				l.lock();
+				P_WARN("The UstRouter at " << serverAddress <<
+					" closed the connection (no error message given);" <<
+					" will reconnect in " << reconnectTimeout / 1000000 <<
+					" second(s).");
+				nextReconnectTime = SystemTime::getUsec() + reconnectTimeout;
+				return ConnectionPtr();
+			}
 			return connection;
 
 		} else {
+			l.lock();
 			if (SystemTime::getUsec() < nextReconnectTime) {
 				P_TRACE(3, "Not yet time to reconnect; returning NULL connection");
 				return ConnectionPtr();
@@ -233,14 +268,12 @@ public:
 		}
 	}
 
+	/**
+	 * Only for connections that have nothing queued in the BatchWriter.
+	 * Otherwise, pass `checkin = true` to the last queueMessage() call.
+	 */
 	void checkinConnection(const ConnectionPtr &connection) {
-		boost::unique_lock<boost::mutex> l(syncher);
-		if (connectionPool.size() < CONNECTION_POOL_MAX_SIZE) {
-			connectionPool.push_back(connection);
-		} else {
-			l.unlock();
-			connection->disconnect();
-		}
+		connectionPool->checkin(connection);
 	}
 
 
@@ -474,21 +507,43 @@ public:
 			return createNullTransaction();
 		}
 
-		// We didn't ask for a response (ack), so just send here.
-		if (sendRequest(connection, params, nparams)) {
-			ConnectionGuard guard(connection.get());
-			TransactionPtr transaction = boost::make_shared<Transaction>(
-				shared_from_this(),
-				connection,
-				txnId,
-				groupName,
-				category,
-				unionStationKey);
-			guard.clear();
-			return transaction;
-		} else {
+		// We didn't ask for a response (ack), so the message can be
+		// written in the background like any other message.
+		if (!queueMessage(connection, params, nparams, NULL, false)) {
+			checkinConnection(connection);
 			return createNullTransaction();
 		}
+
+		ConnectionGuard guard(connection.get());
+		TransactionPtr transaction = boost::make_shared<Transaction>(
+			shared_from_this(),
+			connection,
+			txnId,
+			groupName,
+			category,
+			unionStationKey);
+		guard.clear();
+		return transaction;
+	}
+
+	/**
+	 * Queues a message for writing to `connection` by the BatchWriter.
+	 * See BatchWriter::queue().
+	 *
+	 * @param checkin Whether this is the last message for `connection`.
+	 *                The connection is checked back into the pool once
+	 *                the message has been written.
+	 */
+	bool queueMessage(const ConnectionPtr &connection, const StaticString args[],
+		unsigned int nargs, const StaticString *scalar, bool droppable,
+		bool checkin = false)
+	{
+		if (checkin) {
+			return writer->queue(connection, args, nargs, scalar, droppable,
+				connectionPool);
+		} else {
+			return writer->queue(connection, args, nargs, scalar, droppable);
+		}
 	}
 
 
@@ -503,6 +558,13 @@ public:
 		return serverAddress.empty();
 	}
 
+	/**
+	 * @pre !isNull()
+	 */
+	const BatchWriterPtr &getWriter() const {
+		return writer;
+	}
+
 	const string &getAddress() const {
 		return serverAddress;
 	}
@@ -524,9 +586,12 @@ public:
 };
 
 
-inline void
-_checkinConnection(const ContextPtr &ctx, const ConnectionPtr &connection) {
-	ctx->checkinConnection(connection);
+inline bool
+_queueMessage(const ContextPtr &ctx, const ConnectionPtr &connection,
+	const StaticString args[], unsigned int nargs, const StaticString *scalar,
+	bool droppable, bool checkin)
+{
+	return ctx->queueMessage(connection, args, nargs, scalar, droppable, checkin);
 }
 
 
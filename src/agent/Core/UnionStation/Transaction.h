@@ -43,6 +43,7 @@
 #include <Utils/SystemTime.h>
 #include <Utils/StrIntUtils.h>
 #include <Core/UnionStation/Connection.h>
+#include <Core/UnionStation/BatchWriter.h>
 
 namespace Passenger {
 namespace UnionStation {
@@ -61,13 +62,14 @@ enum ExceptionHandlingMode {
 class Context;
 typedef boost::shared_ptr<Context> ContextPtr;
 
-inline void _checkinConnection(const ContextPtr &ctx, const ConnectionPtr &connection);
+inline bool _queueMessage(const ContextPtr &ctx, const ConnectionPtr &connection,
+	const StaticString args[], unsigned int nargs, const StaticString *scalar,
+	bool droppable, bool checkin);
 
 
 class Transaction: public boost::noncopyable {
 private:
 	static const int INT64_STR_BUFSIZE = 22; // Long enough for a 64-bit number.
-	static const unsigned long long IO_TIMEOUT = 5000000; // In microseconds.
 
 	const ContextPtr context;
 	const ConnectionPtr connection;
@@ -151,68 +153,48 @@ public:
 		if (connection == NULL) {
 			return;
 		}
-		ConnectionLock l(connection);
-		if (!connection->connected()) {
-			return;
-		}
 
 		char timestamp[2 * sizeof(unsigned long long) + 1];
 		integerToHexatri<unsigned long long>(SystemTime::getUsec(),
 			timestamp);
 
 		UPDATE_TRACE_POINT();
-		ConnectionGuard guard(connection.get());
-		try {
-			unsigned long long timeout = IO_TIMEOUT;
-			writeArrayMessage(connection->fd, &timeout,
-				"closeTransaction",
-				txnId.c_str(),
-				timestamp,
-				NULL);
-
-			_checkinConnection(context, connection);
-			guard.clear();
-		} catch (const SystemException &e) {
-			UPDATE_TRACE_POINT();
-			guard.clear();
-			connection->disconnect();
-			handleException(e);
-		}
+		StaticString args[] = {
+			P_STATIC_STRING("closeTransaction"),
+			txnId,
+			timestamp
+		};
+		// Closing must never be dropped, or the UstRouter would keep
+		// the transaction open until the connection is closed. The
+		// connection is checked back in once this has been written.
+		_queueMessage(context, connection, args, sizeof(args) / sizeof(StaticString),
+			NULL, false, true);
 	}
 
+	/**
+	 * Logs a message to this transaction. The message is queued on the
+	 * Context's BatchWriter, so this never blocks on UstRouter I/O.
+	 * If the UstRouter cannot keep up, the message may be dropped.
+	 */
 	void message(const StaticString &text) {
 		TRACE_POINT();
 		if (connection == NULL) {
 			P_TRACE(3, "[Union Station log to null] " << text);
 			return;
 		}
-		ConnectionLock l(connection);
-		if (!connection->connected()) {
-			P_TRACE(3, "[Union Station log to null] " << text);
-			return;
-		}
 
 		char timestamp[2 * sizeof(unsigned long long) + 1];
 		integerToHexatri<unsigned long long>(SystemTime::getUsec(), timestamp);
 
 		UPDATE_TRACE_POINT();
-		ConnectionGuard guard(connection.get());
-		try {
-			unsigned long long timeout = IO_TIMEOUT;
-			P_TRACE(3, "[Union Station log] " << txnId << " " << timestamp << " " << text);
-			writeArrayMessage(connection->fd, &timeout,
-				"log",
-				txnId.c_str(),
-				timestamp,
-				NULL);
-			writeScalarMessage(connection->fd, text, &timeout);
-			guard.clear();
-		} catch (const std::exception &e) {
-			UPDATE_TRACE_POINT();
-			guard.clear();
-			connection->disconnect();
-			handleException(e);
-		}
+		P_TRACE(3, "[Union Station log] " << txnId << " " << timestamp << " " << text);
+		StaticString args[] = {
+			P_STATIC_STRING("log"),
+			txnId,
+			timestamp
+		};
+		_queueMessage(context, connection, args, sizeof(args) / sizeof(StaticString),
+			&text, true, false);
 	}
 
 	void abort(const StaticString &text) {
@@ -884,6 +884,10 @@ abortHandler(int signo, siginfo_t *info, void *ctx) {
 	emergencyPipe1[0] = emergencyPipe1[1] = -1;
 	emergencyPipe2[0] = emergencyPipe2[1] = -1;
 
+	// Write log entries that are still buffered by the asynchronous
+	// log writer, so that they appear before the crash report.
+	flushLogBuffers();
+
 	/* We want to dump the entire crash log to both stderr and a log file.
 	 * We use 'tee' for this.
 	 */
@@ -96,9 +96,63 @@ setGivenEnvVars(const char *envvarsData) {
 	}
 }
 
+static bool
+isPerSpawnEnvvar(const char *entry) {
+	static const char *names[] = {
+		"PASSENGER_DEBUG_DIR=", "PASSENGER_DEFER_SPAWN_DIAGNOSTICS=",
+		"PWD=", "OLDPWD=", "SHLVL=", "_=", NULL
+	};
+	for (unsigned int i = 0; names[i] != NULL; i++) {
+		if (strncmp(entry, names[i], strlen(names[i])) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * If requested by the Spawner, dumps the environment that the login shell
+ * has set up to $PASSENGER_DEBUG_DIR/.shell_envvars, in the same format as
+ * the <envvars> argument (but not base64-encoded). The Spawner caches this
+ * so that subsequent spawns can skip the login shell. Must be called before
+ * setGivenEnvVars().
+ */
+static void
+dumpShellEnvironment() {
+	const char *c_dir;
+	if (getenv("PASSENGER_CAPTURE_SHELL_ENVVARS") == NULL) {
+		return;
+	}
+	unsetenv("PASSENGER_CAPTURE_SHELL_ENVVARS");
+	if ((c_dir = getenv("PASSENGER_DEBUG_DIR")) == NULL) {
+		return;
+	}
+
+	FILE *f = fopen((string(c_dir) + "/.shell_envvars").c_str(), "w");
+	if (f != NULL) {
+		int i = 0;
+		while (environ[i] != NULL) {
+			const char *entry = environ[i];
+			const char *sep = strchr(entry, '=');
+			if (sep != NULL && !isPerSpawnEnvvar(entry)) {
+				fwrite(entry, 1, sep - entry, f);
+				putc('\0', f);
+				fputs(sep + 1, f);
+				putc('\0', f);
+			}
+			i++;
+		}
+		fclose(f);
+	}
+}
+
 static void
 dumpInformation() {
 	const char *c_dir;
+	// When deferred, the Spawner collects the expensive parts of the
+	// diagnostics information itself, but only if spawning fails.
+	bool deferred = getenv("PASSENGER_DEFER_SPAWN_DIAGNOSTICS") != NULL;
+	unsetenv("PASSENGER_DEFER_SPAWN_DIAGNOSTICS");
 	if ((c_dir = getenv("PASSENGER_DEBUG_DIR")) == NULL) {
 		return;
 	}
@@ -117,6 +171,10 @@ dumpInformation() {
 		fclose(f);
 	}
 
+	if (deferred) {
+		return;
+	}
+
 	f = fopen((dir + "/user_info").c_str(), "w");
 	if (f != NULL) {
 		pid_t pid = fork();
@@ -189,6 +247,7 @@ spawnPreparerMain(int argc, char *argv[]) {
 	const char *executable = argv[ARG_OFFSET + 3];
 	char **execArgs = &argv[ARG_OFFSET + 4];
 
+	dumpShellEnvironment();
 	changeWorkingDir(workingDir);
 	setGivenEnvVars(envvars);
 	dumpInformation();
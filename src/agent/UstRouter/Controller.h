@@ -1059,6 +1059,23 @@ private:
 		return *filter;
 	}
 
+	static RemoteSender::Config createRemoteSenderConfig(const VariantMap &options) {
+		RemoteSender::Config config;
+		config.gatewayAddress = options.get("union_station_gateway_address", false,
+			DEFAULT_UNION_STATION_GATEWAY_ADDRESS);
+		config.gatewayPort = options.getInt("union_station_gateway_port", false,
+			DEFAULT_UNION_STATION_GATEWAY_PORT);
+		config.certificate = options.get("union_station_gateway_cert", false, "");
+		config.proxyAddress = options.get("union_station_proxy_address", false, "");
+		config.maxConcurrentUploads = options.getUint("union_station_max_concurrent_uploads",
+			false, DEFAULT_UNION_STATION_MAX_CONCURRENT_UPLOADS);
+		config.compressionThreads = options.getUint("union_station_compression_threads",
+			false, DEFAULT_UNION_STATION_COMPRESSION_THREADS);
+		config.memoryLimit = options.getULL("union_station_sender_memory_limit",
+			false, DEFAULT_UNION_STATION_SENDER_MEMORY_LIMIT);
+		return config;
+	}
+
 protected:
 	virtual void reinitializeClient(Client *client, int fd) {
 		ParentClass::reinitializeClient(client, fd);
@@ -1144,11 +1161,7 @@ public:
 		  dumpDir(options.get("ust_router_dump_dir", false, "/tmp")),
 		  defaultNodeName(options.get("ust_router_default_node_name", false, "")),
 		  devMode(options.getBool("ust_router_dev_mode", false, false)),
-		  remoteSender(
-		      options.get("union_station_gateway_address", false, DEFAULT_UNION_STATION_GATEWAY_ADDRESS),
-		      options.getInt("union_station_gateway_port", false, DEFAULT_UNION_STATION_GATEWAY_PORT),
-		      options.get("union_station_gateway_cert", false, ""),
-		      options.get("union_station_proxy_address", false, "")),
+		  remoteSender(createRemoteSenderConfig(options)),
 		  gcTimer(getLoop()),
 		  flushTimer(getLoop())
 	{
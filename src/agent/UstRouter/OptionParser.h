@@ -70,6 +70,21 @@ ustRouterUsage() {
 	printf("                              instead of sending them to the Union Station gateway\n");
 	printf("      --dump-dir  PATH        Directory to dump to\n");
 	printf("\n");
+	printf("Union Station gateway options (optional):\n");
+	printf("      --max-concurrent-uploads NUMBER\n");
+	printf("                              Maximum number of packets to upload to the\n");
+	printf("                              gateway at the same time. Default: %d\n",
+		DEFAULT_UNION_STATION_MAX_CONCURRENT_UPLOADS);
+	printf("      --compression-threads NUMBER\n");
+	printf("                              Number of threads that compress packets before\n");
+	printf("                              uploading. Default: %d\n",
+		DEFAULT_UNION_STATION_COMPRESSION_THREADS);
+	printf("      --sender-memory-limit BYTES\n");
+	printf("                              Maximum amount of memory taken by packets that\n");
+	printf("                              are not yet uploaded. The oldest packets are\n");
+	printf("                              dropped when exceeded. Default: %d\n",
+		DEFAULT_UNION_STATION_SENDER_MEMORY_LIMIT);
+	printf("\n");
 	printf("Other options (optional):\n");
 	printf("      --user USERNAME         Lower privilege to the given user. Only has\n");
 	printf("                              effect when started as root\n");
@@ -149,6 +164,15 @@ parseUstRouterOption(int argc, const char *argv[], int &i, VariantMap &options)
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--dump-dir")) {
 		options.set("ust_router_dump_dir", argv[i + 1]);
 		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--max-concurrent-uploads")) {
+		options.setUint("union_station_max_concurrent_uploads", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--compression-threads")) {
+		options.setUint("union_station_compression_threads", atoi(argv[i + 1]));
+		i += 2;
+	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--sender-memory-limit")) {
+		options.setULL("union_station_sender_memory_limit", strtoull(argv[i + 1], NULL, 10));
+		i += 2;
 	} else if (p.isValueFlag(argc, i, argv[i], '\0', "--user")) {
 		options.set("analytics_log_user", argv[i + 1]);
 		i += 2;
@@ -27,24 +27,35 @@
 #define _PASSENGER_REMOTE_SENDER_H_
 
 #include <sys/types.h>
+#include <sys/select.h>
 #include <ctime>
 #include <cassert>
+#include <cerrno>
+#include <unistd.h>
 #include <curl/curl.h>
 #include <zlib.h>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/bind.hpp>
 #include <boost/foreach.hpp>
+#include <boost/thread.hpp>
 #include <oxt/thread.hpp>
+#include <oxt/system_calls.hpp>
 #include <string>
 #include <list>
+#include <deque>
+#include <vector>
+#include <algorithm>
 #include <jsoncpp/json.h>
 #include <modp_b64.h>
 
+#include <Constants.h>
 #include <Logging.h>
 #include <StaticString.h>
+#include <FileDescriptor.h>
 #include <Utils.h>
-#include <Utils/BlockingQueue.h>
+#include <Utils/IOUtils.h>
 #include <Utils/SystemTime.h>
 #include <Utils/ScopeGuard.h>
 #include <Utils/JsonUtils.h>
@@ -63,19 +74,92 @@ using namespace oxt;
 #endif
 
 
+/**
+ * Sends packets to the Union Station gateway servers.
+ *
+ * `schedule()` only copies the data and returns. A small pool of compression
+ * threads compresses scheduled packets, and a single sender thread uploads
+ * compressed packets through a curl multi handle, so that up to
+ * `Config::maxConcurrentUploads` uploads are in flight at the same time.
+ * The periodic server checkups ping the gateway servers through the same
+ * multi handle, so uploads to the known servers continue while a checkup
+ * is in progress.
+ *
+ * The amount of memory taken by packets that are not yet sent is bounded by
+ * `Config::memoryLimit`. When that limit is exceeded, the oldest packets that
+ * are not yet being uploaded are dropped.
+ */
 class RemoteSender {
+public:
+	struct Config {
+		string gatewayAddress;
+		unsigned short gatewayPort;
+		string certificate;
+		string proxyAddress;
+		/** Whether to use HTTPS to talk to the gateway. Only turned off in tests. */
+		bool useHttps;
+		unsigned int maxConcurrentUploads;
+		unsigned int compressionThreads;
+		/** Maximum number of bytes taken by packets that are not yet sent. */
+		size_t memoryLimit;
+
+		Config()
+			: gatewayAddress(DEFAULT_UNION_STATION_GATEWAY_ADDRESS),
+			  gatewayPort(DEFAULT_UNION_STATION_GATEWAY_PORT),
+			  useHttps(true),
+			  maxConcurrentUploads(DEFAULT_UNION_STATION_MAX_CONCURRENT_UPLOADS),
+			  compressionThreads(DEFAULT_UNION_STATION_COMPRESSION_THREADS),
+			  memoryLimit(DEFAULT_UNION_STATION_SENDER_MEMORY_LIMIT)
+			{ }
+	};
+
 private:
 	struct Item {
-		bool exit;
 		bool compressed;
 		string unionStationKey;
 		string nodeName;
 		string category;
 		string data;
+		unsigned long long scheduledAt;
+
+		Item()
+			: compressed(false),
+			  scheduledAt(0)
+			{ }
+	};
+
+	typedef boost::shared_ptr<Item> ItemPtr;
+
+	class Server;
+	typedef boost::shared_ptr<Server> ServerPtr;
+
+	/**
+	 * An upload or a ping that has been added to the curl multi handle.
+	 * Pings have no item.
+	 */
+	struct Transfer {
+		ItemPtr item;
+		ServerPtr server;
+		CURL *curl;
+		struct curl_httppost *post;
+		string base64Data;
+		string responseBody;
+		char lastCurlErrorMessage[CURL_ERROR_SIZE];
+
+		Transfer()
+			: curl(NULL),
+			  post(NULL)
+		{
+			lastCurlErrorMessage[0] = '\0';
+		}
 
-		Item() {
-			exit = false;
-			compressed = false;
+		~Transfer() {
+			if (curl != NULL) {
+				curl_easy_cleanup(curl);
+			}
+			if (post != NULL) {
+				curl_formfree(post);
+			}
 		}
 	};
 
@@ -114,11 +198,8 @@ private:
 		string certificate;
 		const CurlProxyInfo *proxyInfo;
 
-		CURL *curl;
 		struct curl_slist *headers;
-		char lastCurlErrorMessage[CURL_ERROR_SIZE];
 		string hostHeader;
-		string responseBody;
 
 		string pingURL;
 		string sinkURL;
@@ -132,27 +213,13 @@ private:
 		unsigned int packetsRejected;
 		unsigned int packetsDropped;
 
-		void resetConnection() {
-			if (curl != NULL) {
-				#ifdef HAS_CURL_EASY_RESET
-					curl_easy_reset(curl);
-				#else
-					curl_easy_cleanup(curl);
-					curl = NULL;
-				#endif
-			}
-			if (curl == NULL) {
-				curl = curl_easy_init();
-				if (curl == NULL) {
-					throw IOException("Unable to create a CURL handle");
-				}
-			}
+		void setCommonOptions(CURL *curl, char *errorBuffer, string *responseBody) {
 			curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
 			curl_easy_setopt(curl, CURLOPT_TIMEOUT, 180);
-			curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, lastCurlErrorMessage);
+			curl_easy_setopt(curl, CURLOPT_ERRORBUFFER, errorBuffer);
 			curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
 			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, curlDataReceived);
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, this);
+			curl_easy_setopt(curl, CURLOPT_WRITEDATA, responseBody);
 			if (certificate.empty()) {
 				curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0);
 			} else {
@@ -165,12 +232,17 @@ private:
 			 */
 			curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0);
 			setCurlProxy(curl, *proxyInfo);
-			responseBody.clear();
 		}
 
-		void prepareRequest(const string &url) {
-			curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-			responseBody.clear();
+		void createHandle(Transfer *transfer, const string &url) {
+			transfer->curl = curl_easy_init();
+			if (transfer->curl == NULL) {
+				throw IOException("Unable to create a CURL handle");
+			}
+			setCommonOptions(transfer->curl, transfer->lastCurlErrorMessage,
+				&transfer->responseBody);
+			curl_easy_setopt(transfer->curl, CURLOPT_URL, url.c_str());
+			curl_easy_setopt(transfer->curl, CURLOPT_PRIVATE, transfer);
 		}
 
 		static bool validateResponse(const Json::Value &response) {
@@ -188,21 +260,22 @@ private:
 			}
 		}
 
-		SendResult handleSendResponse(const Item &item) {
+		SendResult handleSendResponse(const Transfer *transfer) {
+			const Item &item = *transfer->item;
 			Json::Reader reader;
 			Json::Value response;
 			long httpCode = -1;
 
-			curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &httpCode);
+			curl_easy_getinfo(transfer->curl, CURLINFO_RESPONSE_CODE, &httpCode);
 
-			if (!reader.parse(responseBody, response, false) || !validateResponse(response)) {
+			if (!reader.parse(transfer->responseBody, response, false) || !validateResponse(response)) {
 				setRequestError(
 					"The Union Station gateway server " + ip +
 					" encountered an error while processing sent analytics data. "
 					"It sent an invalid response. Key: " + item.unionStationKey
 					+ ". Parse error: " + reader.getFormattedErrorMessages()
 					+ "; HTTP code: " + toString(httpCode)
-					+ "; data: \"" + cEscapeString(responseBody) + "\"");
+					+ "; data: \"" + cEscapeString(transfer->responseBody) + "\"");
 				return SR_MALFUNCTION;
 			} else if (response["status"].asString() == "ok") {
 				if (httpCode == 200) {
@@ -218,7 +291,7 @@ private:
 						"analytics data. It sent an invalid response. Key: "
 						+ item.unionStationKey + ". HTTP code: "
 						+ toString(httpCode) + ". Data: \""
-						+ cEscapeString(responseBody) + "\"");
+						+ cEscapeString(transfer->responseBody) + "\"");
 					return SR_MALFUNCTION;
 				}
 			} else {
@@ -232,11 +305,11 @@ private:
 			}
 		}
 
-		void handleSendError(const Item &item) {
+		void handleSendError(const Transfer *transfer) {
 			setRequestError(
 				"Could not send data to Union Station gateway server " +
-				ip + ". It might be down. Key: " + item.unionStationKey +
-				". Error: " + lastCurlErrorMessage);
+				ip + ". It might be down. Key: " + transfer->item->unionStationKey +
+				". Error: " + transfer->lastCurlErrorMessage);
 		}
 
 		void setPingError(const string &message) {
@@ -281,14 +354,14 @@ private:
 		}
 
 		static size_t curlDataReceived(void *buffer, size_t size, size_t nmemb, void *userData) {
-			Server *self = (Server *) userData;
-			self->responseBody.append((const char *) buffer, size * nmemb);
+			string *responseBody = (string *) userData;
+			responseBody->append((const char *) buffer, size * nmemb);
 			return size * nmemb;
 		}
 
 	public:
 		Server(const string &ip, const string &hostName, unsigned short port,
-			const string &cert, const CurlProxyInfo *proxyInfo)
+			const string &cert, const CurlProxyInfo *proxyInfo, bool useHttps = true)
 		{
 			this->ip = ip;
 			this->port = port;
@@ -301,28 +374,29 @@ private:
 			if (headers == NULL) {
 				throw IOException("Unable to create a CURL linked list");
 			}
+			// Don't wait for a "100 Continue" before sending the packet.
+			headers = curl_slist_append(headers, "Expect:");
+			if (headers == NULL) {
+				throw IOException("Unable to create a CURL linked list");
+			}
 
 			// Older libcurl versions didn't strdup() any option
 			// strings so we need to keep these in memory.
-			pingURL = string("https://") + ip + ":" + toString(port) +
+			string scheme = useHttps ? "https://" : "http://";
+			pingURL = scheme + ip + ":" + toString(port) +
 				"/ping";
-			sinkURL = string("https://") + ip + ":" + toString(port) +
+			sinkURL = scheme + ip + ":" + toString(port) +
 				"/sink";
 
-			curl = NULL;
 			lastErrorTime = 0;
 			lastSuccessTime = 0;
 			pingErrors = 0;
 			packetsAccepted = 0;
 			packetsRejected = 0;
 			packetsDropped = 0;
-			resetConnection();
 		}
 
 		~Server() {
-			if (curl != NULL) {
-				curl_easy_cleanup(curl);
-			}
 			curl_slist_free_all(headers);
 		}
 
@@ -330,90 +404,100 @@ private:
 			return ip + ":" + toString(port);
 		}
 
-		bool ping() {
+		/**
+		 * Creates a curl easy handle for pinging this server.
+		 * The caller adds it to a multi handle.
+		 */
+		void preparePing(Transfer *transfer) {
 			P_INFO("Pinging Union Station gateway " << ip << ":" << port);
-			ScopeGuard guard(boost::bind(&Server::resetConnection, this));
-			prepareRequest(pingURL);
+			createHandle(transfer, pingURL);
+			curl_easy_setopt(transfer->curl, CURLOPT_HTTPGET, 1);
+		}
 
-			curl_easy_setopt(curl, CURLOPT_HTTPGET, 1);
-			if (curl_easy_perform(curl) != 0) {
+		/**
+		 * Called when the curl multi handle is done with the ping.
+		 * Returns whether the server is up.
+		 */
+		bool finishPing(const Transfer *transfer, CURLcode code) {
+			if (code != CURLE_OK) {
 				setPingError(
 					"Could not ping Union Station gateway server " +
-					ip + ": " + lastCurlErrorMessage);
+					ip + ": " + transfer->lastCurlErrorMessage);
 				return false;
-			}
-			if (responseBody == "pong") {
-				guard.clear();
+			} else if (transfer->responseBody == "pong") {
 				return true;
 			} else {
 				setPingError(
 					"Union Station gateway server " + ip +
 					" returned an unexpected ping message: " +
-					responseBody);
+					transfer->responseBody);
 				return false;
 			}
 		}
 
-		SendResult send(const Item &item) {
-			ScopeGuard guard(boost::bind(&Server::resetConnection, this));
-			prepareRequest(sinkURL);
-
-			struct curl_httppost *post = NULL;
+		/**
+		 * Creates a curl easy handle for uploading the transfer's packet
+		 * to this server. The caller adds it to a multi handle.
+		 */
+		void prepareUpload(Transfer *transfer) {
+			const Item &item = *transfer->item;
 			struct curl_httppost *last = NULL;
-			string base64_data;
 
-			curl_formadd(&post, &last,
+			createHandle(transfer, sinkURL);
+
+			curl_formadd(&transfer->post, &last,
 				CURLFORM_PTRNAME, "key",
 				CURLFORM_PTRCONTENTS, item.unionStationKey.c_str(),
 				CURLFORM_CONTENTSLENGTH, (long) item.unionStationKey.size(),
 				CURLFORM_END);
-			curl_formadd(&post, &last,
+			curl_formadd(&transfer->post, &last,
 				CURLFORM_PTRNAME, "node_name",
 				CURLFORM_PTRCONTENTS, item.nodeName.c_str(),
 				CURLFORM_CONTENTSLENGTH, (long) item.nodeName.size(),
 				CURLFORM_END);
-			curl_formadd(&post, &last,
+			curl_formadd(&transfer->post, &last,
 				CURLFORM_PTRNAME, "category",
 				CURLFORM_PTRCONTENTS, item.category.c_str(),
 				CURLFORM_CONTENTSLENGTH, (long) item.category.size(),
 				CURLFORM_END);
-			curl_formadd(&post, &last,
+			curl_formadd(&transfer->post, &last,
 				CURLFORM_PTRNAME, "client_description",
 				CURLFORM_PTRCONTENTS, UST_ROUTER_CLIENT_DESCRIPTION,
 				CURLFORM_CONTENTSLENGTH, (long) sizeof(UST_ROUTER_CLIENT_DESCRIPTION),
 				CURLFORM_END);
 			if (item.compressed) {
-				base64_data = modp::b64_encode(item.data);
-				curl_formadd(&post, &last,
+				transfer->base64Data = modp::b64_encode(item.data);
+				curl_formadd(&transfer->post, &last,
 					CURLFORM_PTRNAME, "data",
-					CURLFORM_PTRCONTENTS, base64_data.data(),
-					CURLFORM_CONTENTSLENGTH, (long) base64_data.size(),
+					CURLFORM_PTRCONTENTS, transfer->base64Data.data(),
+					CURLFORM_CONTENTSLENGTH, (long) transfer->base64Data.size(),
 					CURLFORM_END);
-				curl_formadd(&post, &last,
+				curl_formadd(&transfer->post, &last,
 					CURLFORM_PTRNAME, "compressed",
 					CURLFORM_PTRCONTENTS, "1",
 					CURLFORM_END);
 			} else {
-				curl_formadd(&post, &last,
+				curl_formadd(&transfer->post, &last,
 					CURLFORM_PTRNAME, "data",
 					CURLFORM_PTRCONTENTS, item.data.c_str(),
 					CURLFORM_CONTENTSLENGTH, (long) item.data.size(),
 					CURLFORM_END);
 			}
+			curl_easy_setopt(transfer->curl, CURLOPT_HTTPPOST, transfer->post);
 
-			curl_easy_setopt(curl, CURLOPT_HTTPGET, 0);
-			curl_easy_setopt(curl, CURLOPT_HTTPPOST, post);
 			P_DEBUG("Sending Union Station packet: key=" << item.unionStationKey <<
 				", node=" << item.nodeName << ", category=" << item.category <<
 				", compressedDataSize=" << item.data.size());
-			CURLcode code = curl_easy_perform(curl);
-			curl_formfree(post);
+		}
 
+		/**
+		 * Called when the curl multi handle is done with the transfer.
+		 */
+		SendResult finishUpload(const Transfer *transfer, CURLcode code) {
 			if (code == CURLE_OK) {
-				guard.clear();
-				return handleSendResponse(item);
+				return handleSendResponse(transfer);
 			} else {
-				handleSendError(item);
+				handleSendError(transfer);
 				return SR_DOWN;
 			}
 		}
@@ -450,75 +534,199 @@ private:
 		}
 	};
 
-	typedef boost::shared_ptr<Server> ServerPtr;
-
-	string gatewayAddress;
-	unsigned short gatewayPort;
-	string certificate;
+	const Config config;
 	CurlProxyInfo proxyInfo;
-	BlockingQueue<Item> queue;
-	oxt::thread *thr;
+	vector<oxt::thread *> compressionThreads;
+	oxt::thread *senderThread;
+	/** Wakes up the sender thread when it waits for curl. */
+	Pipe wakeupPipe;
+	/** Only accessed by the sender thread. */
+	CURLM *multi;
+
+	/******** Checkup state, only accessed by the sender thread ********/
+
+	/** Pings of the checkup in progress that haven't finished yet. */
+	vector<Transfer *> pendingPings;
+	list<ServerPtr> checkedUpServers;
+	vector<ServerPtr> checkedDownServers;
+
+	/******** Fields below are protected by the syncher ********/
 
 	mutable boost::mutex syncher;
+	boost::condition_variable compressionCond;
+	bool quit;
+
+	/** Packets waiting to be compressed. Oldest first. */
+	deque<ItemPtr> uncompressedItems;
+	/** Packets waiting to be uploaded. Oldest first. */
+	deque<ItemPtr> readyItems;
+	unsigned int compressing;
+	unsigned int uploading;
+	/** Memory taken by the data of all packets that are not yet sent. */
+	size_t memoryUsage;
+	size_t peakMemoryUsage;
+
 	list<ServerPtr> upServers;
 	vector<ServerPtr> downServers;
 	time_t lastCheckupTime, nextCheckupTime;
 	string lastDnsErrorMessage;
 	unsigned int packetsAccepted, packetsRejected, packetsDropped;
+	unsigned int packetsDroppedByMemoryLimit;
+	unsigned long long totalLatency, maxLatency, lastLatency;
 
-	void threadMain() {
-		ScopeGuard guard(boost::bind(&RemoteSender::freeThreadData, this));
+
+	/****** Compression threads ******/
+
+	void compressionThreadMain() {
+		TRACE_POINT();
+		boost::unique_lock<boost::mutex> l(syncher);
 
 		while (true) {
-			Item item;
-			bool hasItem;
+			while (uncompressedItems.empty() && !quit) {
+				compressionCond.wait(l);
+			}
+			if (uncompressedItems.empty()) {
+				return;
+			}
 
-			if (firstStarted()) {
-				item = queue.get();
-				hasItem = true;
-			} else {
-				hasItem = queue.timedGet(item, msecUntilNextCheckup());
+			UPDATE_TRACE_POINT();
+			ItemPtr item = uncompressedItems.front();
+			uncompressedItems.pop_front();
+			compressing++;
+			l.unlock();
+
+			string compressedData;
+			bool compressed = compress(item->data, compressedData);
+
+			l.lock();
+			compressing--;
+			if (compressed) {
+				memoryUsage -= item->data.size();
+				memoryUsage += compressedData.size();
+				item->data.swap(compressedData);
+				item->compressed = true;
 			}
+			readyItems.push_back(item);
+			l.unlock();
+			wakeupSender();
+			l.lock();
+		}
+	}
 
-			if (hasItem) {
-				if (item.exit) {
-					return;
-				} else {
-					if (timeForCheckup()) {
-						recheckServers();
-					}
-					sendOut(item);
-				}
-			} else if (timeForCheckup()) {
+	static bool compress(const StaticString &data, string &output) {
+		unsigned char out[128 * 1024];
+		z_stream strm;
+		int ret;
+		unsigned int have;
+
+		strm.zalloc = Z_NULL;
+		strm.zfree  = Z_NULL;
+		strm.opaque = Z_NULL;
+		ret = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
+		if (ret != Z_OK) {
+			return false;
+		}
+
+		strm.avail_in = data.size();
+		strm.next_in  = (unsigned char *) data.data();
+		do {
+			strm.avail_out = sizeof(out);
+			strm.next_out  = out;
+			ret = deflate(&strm, Z_FINISH);
+			assert(ret != Z_STREAM_ERROR);
+			have = sizeof(out) - strm.avail_out;
+			output.append((const char *) out, have);
+		} while (strm.avail_out == 0);
+		assert(strm.avail_in == 0);
+		assert(ret == Z_STREAM_END);
+
+		deflateEnd(&strm);
+		return true;
+	}
+
+
+	/****** Sender thread ******/
+
+	void senderThreadMain() {
+		TRACE_POINT();
+		ScopeGuard guard(boost::bind(&RemoteSender::freeThreadData, this));
+
+		multi = curl_multi_init();
+		if (multi == NULL) {
+			P_CRITICAL("Unable to create a CURL multi handle");
+			abort();
+		}
+
+		while (true) {
+			if (timeForCheckup()) {
+				UPDATE_TRACE_POINT();
 				recheckServers();
 			}
+
+			UPDATE_TRACE_POINT();
+			startUploads();
+
+			int running;
+			while (curl_multi_perform(multi, &running) == CURLM_CALL_MULTI_PERFORM) {
+				// Call again.
+			}
+			if (processFinishedTransfers()) {
+				// Slots have been freed, so start new uploads before waiting.
+				continue;
+			}
+
+			if (isDone()) {
+				return;
+			}
+
+			UPDATE_TRACE_POINT();
+			waitForActivity();
 		}
 	}
 
-	bool firstStarted() const {
+	/**
+	 * Returns whether it's time to recheck the servers. The first checkup
+	 * happens when the first packet is ready to be sent.
+	 */
+	bool timeForCheckup() const {
+		if (!pendingPings.empty()) {
+			return false;
+		}
 		boost::lock_guard<boost::mutex> l(syncher);
-		return nextCheckupTime == 0;
+		if (nextCheckupTime == 0) {
+			return !readyItems.empty();
+		} else {
+			return SystemTime::get() >= nextCheckupTime;
+		}
 	}
 
+	bool isDone() const {
+		boost::lock_guard<boost::mutex> l(syncher);
+		return quit && uncompressedItems.empty() && compressing == 0
+			&& readyItems.empty() && uploading == 0;
+	}
+
+	/**
+	 * Starts pinging the gateway servers. finishCheckup() is called when
+	 * all pings have finished.
+	 */
 	void recheckServers() {
-		P_INFO("Rechecking Union Station gateway servers (" << gatewayAddress << ")...");
+		P_INFO("Rechecking Union Station gateway servers (" << config.gatewayAddress << ")...");
 
 		vector<string> ips;
 		vector<string>::const_iterator it;
-		list<ServerPtr> upServers;
-		vector<ServerPtr> downServers;
 
 		try {
-			ips = resolveHostname(gatewayAddress, gatewayPort);
+			ips = resolveHostname(config.gatewayAddress, config.gatewayPort);
 		} catch (const tracable_exception &e) {
 			P_ERROR(e.what());
+			boost::lock_guard<boost::mutex> l(syncher);
 			// DNS errors tend to be temporary, so retry
 			// after a short timeout.
 			scheduleNextCheckup(1 * 60);
 			// Take note of the error, but do not change the server
 			// list so that the RemoteSender can keep working with
 			// the last known server list.
-			boost::lock_guard<boost::mutex> l(syncher);
 			this->lastCheckupTime = SystemTime::get();
 			this->lastDnsErrorMessage = e.what();
 			return;
@@ -528,19 +736,38 @@ private:
 		P_INFO(ips.size() << " Union Station gateway servers found");
 
 		for (it = ips.begin(); it != ips.end(); it++) {
-			ServerPtr server = boost::make_shared<Server>(
-				*it, gatewayAddress, gatewayPort, certificate,
-				&proxyInfo);
-			if (server->ping()) {
-				upServers.push_back(server);
-			} else {
-				downServers.push_back(server);
-			}
+			Transfer *transfer = new Transfer();
+			transfer->server = boost::make_shared<Server>(
+				*it, config.gatewayAddress, config.gatewayPort,
+				config.certificate, &proxyInfo, config.useHttps);
+			transfer->server->preparePing(transfer);
+			curl_multi_add_handle(multi, transfer->curl);
+			pendingPings.push_back(transfer);
 		}
-		P_INFO(upServers.size() << " Union Station gateway servers are up");
+		if (pendingPings.empty()) {
+			finishCheckup();
+		}
+	}
 
-		if (downServers.empty()) {
-			if (upServers.empty()) {
+	void finishPing(Transfer *transfer, bool up) {
+		pendingPings.erase(std::find(pendingPings.begin(), pendingPings.end(),
+			transfer));
+		if (up) {
+			checkedUpServers.push_back(transfer->server);
+		} else {
+			checkedDownServers.push_back(transfer->server);
+		}
+		if (pendingPings.empty()) {
+			finishCheckup();
+		}
+	}
+
+	void finishCheckup() {
+		P_INFO(checkedUpServers.size() << " Union Station gateway servers are up");
+
+		boost::lock_guard<boost::mutex> l(syncher);
+		if (checkedDownServers.empty()) {
+			if (checkedUpServers.empty()) {
 				// The DNS lookup was successful, but returned no results.
 				// This is probably some kind of DNS misconfiguration which
 				// the infrastructure team is working on, so we check back
@@ -560,14 +787,26 @@ private:
 			scheduleNextCheckup(1 * 60);
 		}
 
-		boost::lock_guard<boost::mutex> l(syncher);
-		this->lastCheckupTime = SystemTime::get();
-		this->upServers = upServers;
-		this->downServers = downServers;
-		this->lastDnsErrorMessage.clear();
+		lastCheckupTime = SystemTime::get();
+		upServers.swap(checkedUpServers);
+		downServers.swap(checkedDownServers);
+		checkedUpServers.clear();
+		checkedDownServers.clear();
+		lastDnsErrorMessage.clear();
 	}
 
 	void freeThreadData() {
+		foreach (Transfer *transfer, pendingPings) {
+			curl_multi_remove_handle(multi, transfer->curl);
+			delete transfer;
+		}
+		pendingPings.clear();
+		checkedUpServers.clear();
+		checkedDownServers.clear();
+		if (multi != NULL) {
+			curl_multi_cleanup(multi);
+			multi = NULL;
+		}
 		boost::lock_guard<boost::mutex> l(syncher);
 		// Invoke destructors inside this thread.
 		upServers.clear();
@@ -578,6 +817,8 @@ private:
 	 * Schedules the next checkup to be run after the given number
 	 * of seconds, unless there's already a checkup scheduled for
 	 * earlier.
+	 *
+	 * @pre The syncher is locked.
 	 */
 	void scheduleNextCheckup(unsigned int seconds) {
 		time_t now = SystemTime::get();
@@ -587,130 +828,210 @@ private:
 		}
 	}
 
+	/**
+	 * @pre The syncher is locked.
+	 */
 	unsigned int msecUntilNextCheckup() const {
-		boost::lock_guard<boost::mutex> l(syncher);
 		time_t now = SystemTime::get();
-		if (now >= nextCheckupTime) {
+		if (nextCheckupTime == 0) {
+			return 60 * 1000;
+		} else if (now >= nextCheckupTime) {
 			return 0;
 		} else {
-			return (nextCheckupTime - now) * 1000;
+			return std::min<time_t>(nextCheckupTime - now, 60) * 1000;
 		}
 	}
 
-	bool timeForCheckup() const {
-		boost::lock_guard<boost::mutex> l(syncher);
-		return SystemTime::get() >= nextCheckupTime;
-	}
-
-	void sendOut(const Item &item) {
+	/**
+	 * Hands ready packets to the curl multi handle, round-robin over the
+	 * servers that are up, until `maxConcurrentUploads` are in flight.
+	 */
+	void startUploads() {
 		boost::unique_lock<boost::mutex> l(syncher);
-		bool done = false;
-		bool accepted = false;
-		bool rejected = false;
-		bool upServersEmpty;
 
-		while (!done && !upServers.empty()) {
+		unsigned int maxUploads = std::max(config.maxConcurrentUploads, 1u);
+
+		while (uploading < maxUploads && !readyItems.empty()) {
+			if (upServers.empty()) {
+				if (lastCheckupTime == 0 && !pendingPings.empty()) {
+					// Wait for the first checkup to find servers.
+					return;
+				}
+				/* If all servers are down then all items in the queue will be
+				 * effectively dropped until after the next checkup has detected
+				 * servers that are up.
+				 */
+				dropReadyItems(l);
+				return;
+			}
+
+			ItemPtr item = readyItems.front();
+			readyItems.pop_front();
 			// Pick first available server and put it on the back of the list
 			// for round-robin load balancing.
 			ServerPtr server = upServers.front();
-
+			upServers.pop_front();
+			upServers.push_back(server);
+			uploading++;
 			l.unlock();
-			Server::SendResult result = server->send(item);
+
+			Transfer *transfer = new Transfer();
+			transfer->item = item;
+			transfer->server = server;
+			server->prepareUpload(transfer);
+			curl_multi_add_handle(multi, transfer->curl);
+
 			l.lock();
+		}
+	}
+
+	/**
+	 * Returns whether any uploads or pings were finished.
+	 */
+	bool processFinishedTransfers() {
+		CURLMsg *msg;
+		int msgsLeft;
+		bool finished = false;
+
+		while ((msg = curl_multi_info_read(multi, &msgsLeft)) != NULL) {
+			if (msg->msg != CURLMSG_DONE) {
+				continue;
+			}
 
-			if (result == Server::SR_OK) {
-				upServers.pop_front();
-				upServers.push_back(server);
-				accepted = true;
-				done = true;
-			} else if (result == Server::SR_REJECTED) {
-				upServers.pop_front();
-				upServers.push_back(server);
-				rejected = true;
-				done = true;
+			Transfer *transfer;
+			CURLcode code = msg->data.result;
+			curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char **) &transfer);
+			curl_multi_remove_handle(multi, transfer->curl);
+
+			if (transfer->item == NULL) {
+				finishPing(transfer, transfer->server->finishPing(transfer, code));
 			} else {
-				upServers.pop_front();
-				downServers.push_back(server);
+				Server::SendResult result = transfer->server->finishUpload(transfer, code);
+				finishUpload(transfer, result);
 			}
+			delete transfer;
+			finished = true;
 		}
+		return finished;
+	}
 
-		if (!downServers.empty()) {
+	void finishUpload(const Transfer *transfer, Server::SendResult result) {
+		boost::unique_lock<boost::mutex> l(syncher);
+		const ItemPtr &item = transfer->item;
+
+		uploading--;
+		if (result == Server::SR_OK) {
+			unsigned long long latency = SystemTime::getMonotonicUsec() - item->scheduledAt;
+			totalLatency += latency;
+			maxLatency = std::max(maxLatency, latency);
+			lastLatency = latency;
+			memoryUsage -= item->data.size();
+			packetsAccepted++;
+		} else if (result == Server::SR_REJECTED) {
+			memoryUsage -= item->data.size();
+			packetsRejected++;
+		} else {
+			list<ServerPtr>::iterator it = std::find(upServers.begin(),
+				upServers.end(), transfer->server);
+			if (it != upServers.end()) {
+				upServers.erase(it);
+				downServers.push_back(transfer->server);
+			}
 			// If some gateways are down then the infrastructure team
 			// is likely already working on the problem, so we check
 			// back in 1 minute.
 			scheduleNextCheckup(1 * 60);
+
+			// Try again with the next server. Every failure takes a server
+			// out of the up list, so this ends.
+			if (!upServers.empty()) {
+				readyItems.push_front(item);
+			} else {
+				memoryUsage -= item->data.size();
+				packetsDropped++;
+				l.unlock();
+				logDroppedItem(item, "no servers are available");
+			}
 		}
+	}
 
-		if (accepted) {
-			packetsAccepted++;
-		} else if (rejected) {
-			packetsRejected++;
-		} else {
+	/**
+	 * @pre The syncher is locked through `l`.
+	 */
+	void dropReadyItems(boost::unique_lock<boost::mutex> &l) {
+		deque<ItemPtr> items;
+		items.swap(readyItems);
+		foreach (const ItemPtr &item, items) {
+			memoryUsage -= item->data.size();
 			packetsDropped++;
 		}
-
-		upServersEmpty = upServers.empty();
-
 		l.unlock();
-
-		if (!accepted && !rejected) {
-			assert(upServersEmpty);
-			(void) upServersEmpty; // Avoid compiler warning
-
-			/* If all servers went down then all items in the queue will be
-			 * effectively dropped until after the next checkup has detected
-			 * servers that are up.
-			 */
-			P_WARN("Dropping Union Station packet because no servers are"
-				" available. Run `passenger-status --show=union_station` to"
-				" view server status. Details of dropped packet:"
-				" key=" << item.unionStationKey <<
-				", node=" << item.nodeName <<
-				", category=" << item.category <<
-				", compressedDataSize=" << item.data.size());
+		foreach (const ItemPtr &item, items) {
+			logDroppedItem(item, "no servers are available");
 		}
+		l.lock();
 	}
 
-	bool compress(const StaticString data[], unsigned int count, string &output) {
-		if (count == 0) {
-			StaticString newdata;
-			return compress(&newdata, 1, output);
-		}
+	void logDroppedItem(const ItemPtr &item, const char *reason) {
+		P_WARN("Dropping Union Station packet because " << reason << "."
+			" Run `passenger-status --show=union_station` to"
+			" view server status. Details of dropped packet:"
+			" key=" << item->unionStationKey <<
+			", node=" << item->nodeName <<
+			", category=" << item->category <<
+			", dataSize=" << item->data.size());
+	}
 
-		unsigned char out[128 * 1024];
-		z_stream strm;
-		int ret, flush;
-		unsigned int i, have;
+	void wakeupSender() {
+		char c = 0;
+		ssize_t ret;
+		do {
+			ret = write(wakeupPipe.second, &c, 1);
+		} while (ret == -1 && errno == EINTR);
+		// EAGAIN means that the sender already has a wakeup pending.
+	}
 
-		strm.zalloc = Z_NULL;
-		strm.zfree  = Z_NULL;
-		strm.opaque = Z_NULL;
-		ret = deflateInit(&strm, Z_DEFAULT_COMPRESSION);
-		if (ret != Z_OK) {
-			return false;
+	void waitForActivity() {
+		unsigned int timeout;
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			timeout = msecUntilNextCheckup();
 		}
 
-		for (i = 0; i < count; i++) {
-			strm.avail_in = data[i].size();
-			strm.next_in  = (unsigned char *) data[i].c_str();
-			flush = (i == count - 1) ? Z_FINISH : Z_NO_FLUSH;
-
-			do {
-				strm.avail_out = sizeof(out);
-				strm.next_out  = out;
-				ret = deflate(&strm, flush);
-				assert(ret != Z_STREAM_ERROR);
-				have = sizeof(out) - strm.avail_out;
-				output.append((const char *) out, have);
-			} while (strm.avail_out == 0);
-			assert(strm.avail_in == 0);
+		#if LIBCURL_VERSION_NUM >= 0x071C00
+			struct curl_waitfd extraFd;
+			extraFd.fd = wakeupPipe.first;
+			extraFd.events = CURL_WAIT_POLLIN;
+			extraFd.revents = 0;
+			curl_multi_wait(multi, &extraFd, 1, timeout, NULL);
+		#else
+			fd_set readFds, writeFds, exceptFds;
+			int maxFd = -1;
+			long curlTimeout = -1;
+			struct timeval tv;
+
+			FD_ZERO(&readFds);
+			FD_ZERO(&writeFds);
+			FD_ZERO(&exceptFds);
+			curl_multi_fdset(multi, &readFds, &writeFds, &exceptFds, &maxFd);
+			curl_multi_timeout(multi, &curlTimeout);
+			if (curlTimeout >= 0 && (unsigned long) curlTimeout < timeout) {
+				timeout = curlTimeout;
+			}
+			FD_SET(wakeupPipe.first, &readFds);
+			maxFd = std::max<int>(maxFd, wakeupPipe.first);
+			tv.tv_sec = timeout / 1000;
+			tv.tv_usec = (timeout % 1000) * 1000;
+			select(maxFd + 1, &readFds, &writeFds, &exceptFds, &tv);
+		#endif
+
+		char buf[256];
+		while (read(wakeupPipe.first, buf, sizeof(buf)) > 0) {
+			// Drain wakeup notifications.
 		}
-		assert(ret == Z_STREAM_END);
-
-		deflateEnd(&strm);
-		return true;
 	}
 
+
 	Json::Value inspectUpServersStateAsJson() const {
 		Json::Value doc(Json::arrayValue);
 		foreach (const ServerPtr server, upServers) {
@@ -727,99 +1048,191 @@ private:
 		return doc;
 	}
 
-public:
-	RemoteSender(const string &gatewayAddress, unsigned short gatewayPort,
-		const string &certificate, const string &proxyAddress)
-		: queue(1024)
-	{
+	void initialize() {
 		TRACE_POINT();
-		this->gatewayAddress = gatewayAddress;
-		this->gatewayPort = gatewayPort;
-		this->certificate = certificate;
 		try {
-			this->proxyInfo = prepareCurlProxy(proxyAddress);
+			this->proxyInfo = prepareCurlProxy(config.proxyAddress);
 		} catch (const ArgumentException &e) {
 			throw RuntimeException("Invalid Union Station proxy address \"" +
-				proxyAddress + "\": " + e.what());
+				config.proxyAddress + "\": " + e.what());
 		}
+		multi = NULL;
+		quit = false;
+		compressing = 0;
+		uploading = 0;
+		memoryUsage = 0;
+		peakMemoryUsage = 0;
 		lastCheckupTime = 0;
 		nextCheckupTime = 0;
 		packetsAccepted = 0;
 		packetsRejected = 0;
 		packetsDropped = 0;
-		thr = new oxt::thread(
-			boost::bind(&RemoteSender::threadMain, this),
+		packetsDroppedByMemoryLimit = 0;
+		totalLatency = 0;
+		maxLatency = 0;
+		lastLatency = 0;
+
+		wakeupPipe = createPipe(__FILE__, __LINE__);
+		setNonBlocking(wakeupPipe.first);
+		setNonBlocking(wakeupPipe.second);
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(wakeupPipe.first, "RemoteSender wakeup pipe (read end)");
+		P_LOG_FILE_DESCRIPTOR_PURPOSE(wakeupPipe.second, "RemoteSender wakeup pipe (write end)");
+
+		for (unsigned int i = 0; i < std::max(config.compressionThreads, 1u); i++) {
+			compressionThreads.push_back(new oxt::thread(
+				boost::bind(&RemoteSender::compressionThreadMain, this),
+				"RemoteSender compression thread " + toString(i + 1),
+				1024 * 256
+			));
+		}
+		senderThread = new oxt::thread(
+			boost::bind(&RemoteSender::senderThreadMain, this),
 			"RemoteSender thread",
 			1024 * 512
 		);
 	}
 
+	static Config makeConfig(const string &gatewayAddress, unsigned short gatewayPort,
+		const string &certificate, const string &proxyAddress)
+	{
+		Config config;
+		config.gatewayAddress = gatewayAddress;
+		config.gatewayPort = gatewayPort;
+		config.certificate = certificate;
+		config.proxyAddress = proxyAddress;
+		return config;
+	}
+
+public:
+	RemoteSender(const string &gatewayAddress, unsigned short gatewayPort,
+		const string &certificate, const string &proxyAddress)
+		: config(makeConfig(gatewayAddress, gatewayPort, certificate, proxyAddress))
+	{
+		initialize();
+	}
+
+	RemoteSender(const Config &_config)
+		: config(_config)
+	{
+		initialize();
+	}
+
 	~RemoteSender() {
-		Item item;
-		item.exit = true;
-		queue.add(item);
-		/* Wait until the thread sends out all queued items.
+		{
+			boost::lock_guard<boost::mutex> l(syncher);
+			quit = true;
+			compressionCond.notify_all();
+		}
+		/* Wait until the threads send out all queued items.
 		 * If this cannot be done within a short amount of time,
 		 * e.g. because all servers are down, then we'll get killed
 		 * by the watchdog anyway.
 		 */
-		thr->join();
-		delete thr;
+		foreach (oxt::thread *thr, compressionThreads) {
+			thr->join();
+			delete thr;
+		}
+		wakeupSender();
+		senderThread->join();
+		delete senderThread;
 	}
 
 	void schedule(const string &unionStationKey, const StaticString &nodeName,
 		const StaticString &category, const StaticString data[],
 		unsigned int count)
 	{
-		Item item;
-
-		item.unionStationKey = unionStationKey;
-		item.nodeName = nodeName;
-		item.category = category;
-
-		if (compress(data, count, item.data)) {
-			item.compressed = true;
-		} else {
-			size_t size = 0;
-			unsigned int i;
-
-			for (i = 0; i < count; i++) {
-				size += data[i].size();
-			}
-			item.data.reserve(size);
-			for (i = 0; i < count; i++) {
-				item.data.append(data[i].c_str(), data[i].size());
-			}
+		ItemPtr item = boost::make_shared<Item>();
+		size_t size = 0;
+		unsigned int i, dropped = 0;
+
+		item->unionStationKey = unionStationKey;
+		item->nodeName = nodeName;
+		item->category = category;
+		item->scheduledAt = SystemTime::getMonotonicUsec();
+		for (i = 0; i < count; i++) {
+			size += data[i].size();
+		}
+		item->data.reserve(size);
+		for (i = 0; i < count; i++) {
+			item->data.append(data[i].data(), data[i].size());
 		}
 
 		P_DEBUG("Scheduling Union Station packet: key=" << unionStationKey <<
 			", node=" << nodeName << ", category=" << category <<
-			", compressedDataSize=" << item.data.size());
+			", dataSize=" << item->data.size());
 
-		if (!queue.tryAdd(item)) {
-			P_WARN("The Union Station gateway isn't responding quickly enough; dropping packet.");
-			boost::lock_guard<boost::mutex> l(syncher);
+		boost::unique_lock<boost::mutex> l(syncher);
+		uncompressedItems.push_back(item);
+		memoryUsage += item->data.size();
+
+		// Drop the oldest packets that are not being worked on.
+		while (memoryUsage > config.memoryLimit
+			&& (!readyItems.empty() || !uncompressedItems.empty()))
+		{
+			ItemPtr victim;
+			if (!readyItems.empty()) {
+				victim = readyItems.front();
+				readyItems.pop_front();
+			} else {
+				victim = uncompressedItems.front();
+				uncompressedItems.pop_front();
+			}
+			memoryUsage -= victim->data.size();
 			packetsDropped++;
+			packetsDroppedByMemoryLimit++;
+			dropped++;
+		}
+		peakMemoryUsage = std::max(peakMemoryUsage, memoryUsage);
+		compressionCond.notify_one();
+		l.unlock();
+
+		if (dropped > 0) {
+			P_WARN("The Union Station gateway isn't responding quickly enough; dropped " <<
+				dropped << " packet(s) to stay within the memory limit of " <<
+				config.memoryLimit << " bytes.");
 		}
 	}
 
+	/**
+	 * Returns the number of packets that are scheduled but not yet sent.
+	 */
 	unsigned int queued() const {
-		return queue.size();
+		boost::lock_guard<boost::mutex> l(syncher);
+		return uncompressedItems.size() + compressing + readyItems.size() + uploading;
 	}
 
 	Json::Value inspectStateAsJson() const {
-		Json::Value doc;
+		Json::Value doc, queueDoc, latencyDoc;
 		boost::lock_guard<boost::mutex> l(syncher);
 		doc["up_servers"] = inspectUpServersStateAsJson();
 		doc["down_servers"] = inspectDownServersStateAsJson();
-		doc["queue_size"] = queue.size();
+		doc["queue_size"] = Json::UInt(uncompressedItems.size() + compressing
+			+ readyItems.size() + uploading);
+		queueDoc["waiting_for_compression"] = Json::UInt(uncompressedItems.size());
+		queueDoc["compressing"] = compressing;
+		queueDoc["waiting_for_upload"] = Json::UInt(readyItems.size());
+		queueDoc["uploading"] = uploading;
+		queueDoc["max_concurrent_uploads"] = config.maxConcurrentUploads;
+		queueDoc["memory_usage"] = byteSizeToJson(memoryUsage);
+		queueDoc["peak_memory_usage"] = byteSizeToJson(peakMemoryUsage);
+		queueDoc["memory_limit"] = byteSizeToJson(config.memoryLimit);
+		doc["queue"] = queueDoc;
 		doc["packets_accepted"] = packetsAccepted;
 		doc["packets_rejected"] = packetsRejected;
 		doc["packets_dropped"] = packetsDropped;
-		if (certificate.empty()) {
+		doc["packets_dropped_by_memory_limit"] = packetsDroppedByMemoryLimit;
+		if (packetsAccepted > 0) {
+			latencyDoc["average"] = durationToJson(totalLatency / packetsAccepted);
+			latencyDoc["max"] = durationToJson(maxLatency);
+			latencyDoc["last"] = durationToJson(lastLatency);
+			doc["latency"] = latencyDoc;
+		} else {
+			doc["latency"] = Json::Value(Json::nullValue);
+		}
+		if (config.certificate.empty()) {
 			doc["certificate"] = Json::nullValue;
 		} else {
-			doc["certificate"] = certificate;
+			doc["certificate"] = config.certificate;
 		}
 		if (lastCheckupTime == 0) {
 			doc["last_server_checkup_time"] = Json::Value(Json::nullValue);
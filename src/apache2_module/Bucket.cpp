@@ -60,6 +60,7 @@ bucket_destroy(void *data) {
 static apr_status_t
 bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type_e block) {
 	char *buf;
+	apr_size_t toRead;
 	ssize_t ret;
 	BucketData *data;
 
@@ -87,19 +88,41 @@ bucket_read(apr_bucket *bucket, const char **str, apr_size_t *len, apr_read_type
 		return APR_EAGAIN;
 	}
 
+	if (data->state->bodyLengthKnown && data->state->bodyRemaining == 0) {
+		/* End of the response body. Do not touch the connection anymore:
+		 * it may already have been handed to another request.
+		 */
+		data->state->completed = true;
+		delete data;
+		bucket->data = NULL;
+
+		bucket = apr_bucket_immortal_make(bucket, "", 0);
+		*str = (const char *) bucket->data;
+		*len = 0;
+		return APR_SUCCESS;
+	}
+
 	buf = (char *) apr_bucket_alloc(APR_BUCKET_BUFF_SIZE, bucket->list);
 	if (buf == NULL) {
 		return APR_ENOMEM;
 	}
 
+	toRead = APR_BUCKET_BUFF_SIZE;
+	if (data->state->bodyLengthKnown && data->state->bodyRemaining < (apr_off_t) toRead) {
+		toRead = (apr_size_t) data->state->bodyRemaining;
+	}
+
 	do {
-		ret = read(data->state->connection, buf, APR_BUCKET_BUFF_SIZE);
+		ret = read(data->state->connection, buf, toRead);
 	} while (ret == -1 && errno == EINTR);
 
 	if (ret > 0) {
 		apr_bucket_heap *h;
 
 		data->state->bytesRead += ret;
+		if (data->state->bodyLengthKnown) {
+			data->state->bodyRemaining -= ret;
+		}
 
 		*str = buf;
 		*len = ret;
@@ -52,6 +52,18 @@ struct PassengerBucketState {
 	 */
 	int errorCode;
 
+	/** Whether the end of the response is marked by `bodyRemaining`
+	 * reaching 0, instead of by the Passenger core closing the connection.
+	 * This is the case for responses on keep-alive connections.
+	 */
+	bool bodyLengthKnown;
+
+	/** When bodyLengthKnown is true, the number of response body bytes that
+	 * have not been read from the connection yet. The PassengerBucket never
+	 * reads beyond this, so that the connection can be reused afterwards.
+	 */
+	apr_off_t bodyRemaining;
+
 	/** Connection to the Passenger core. */
 	FileDescriptor connection;
 
@@ -59,6 +71,8 @@ struct PassengerBucketState {
 		bytesRead  = 0;
 		completed  = false;
 		errorCode  = 0;
+		bodyLengthKnown = false;
+		bodyRemaining   = 0;
 		connection = conn;
 	}
 };
@@ -78,7 +92,10 @@ typedef boost::shared_ptr<PassengerBucketState> PassengerBucketStatePtr;
  * PassengerBucket is like apr_bucket_pipe, but:
  * - It also holds a reference to the connection with the Passenger core.
  *   When a read error has occured or when end-of-stream has been reached
- *   this connection will be closed.
+ *   this connection will be closed, unless the caller kept a reference to
+ *   it for reuse.
+ * - If the response body length is known, it stops reading at the end of
+ *   the body instead of at end-of-stream.
  * - It ignores the APR_NONBLOCK_READ flag because that's known to cause
  *   strange I/O problems.
  * - It can store its current state in a PassengerBucketState data structure.
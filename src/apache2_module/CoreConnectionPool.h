@@ -0,0 +1,115 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_CORE_CONNECTION_POOL_H_
+#define _PASSENGER_CORE_CONNECTION_POOL_H_
+
+#include <boost/thread.hpp>
+#include <boost/noncopyable.hpp>
+#include <vector>
+#include <cerrno>
+#include <poll.h>
+#include <FileDescriptor.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * A small, per-process pool of idle keep-alive connections to the Passenger
+ * core, so that not every request has to pay for a connect()/accept() pair.
+ *
+ * A connection may only be checked in after a response has been read
+ * completely and the core indicated that it wants to keep the connection
+ * alive. The core may still close an idle connection at any time, e.g.
+ * because it is restarting, so checkout() discards connections on which the
+ * core has already sent EOF. Callers must be prepared to retry on a fresh
+ * connection if a checked out connection turns out to be closed anyway.
+ *
+ * This class is thread-safe.
+ */
+class CoreConnectionPool: public boost::noncopyable {
+private:
+	boost::mutex syncher;
+	vector<FileDescriptor> idleConnections;
+	unsigned int maxIdleConnections;
+
+	/**
+	 * The core never sends anything on an idle keep-alive connection, so if
+	 * it is readable then the core has closed it or an error has occurred.
+	 */
+	static bool isClosedByPeer(int fd) {
+		struct pollfd pfd;
+		int ret;
+
+		pfd.fd = fd;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+		do {
+			ret = poll(&pfd, 1, 0);
+		} while (ret == -1 && errno == EINTR);
+		return ret != 0;
+	}
+
+public:
+	CoreConnectionPool(unsigned int _maxIdleConnections)
+		: maxIdleConnections(_maxIdleConnections)
+		{ }
+
+	/**
+	 * Returns an idle connection, or a FileDescriptor with value -1
+	 * if there are none.
+	 */
+	FileDescriptor checkout() {
+		FileDescriptor result;
+		while (true) {
+			{
+				boost::lock_guard<boost::mutex> l(syncher);
+				if (idleConnections.empty()) {
+					return FileDescriptor();
+				}
+				// Most recently used first; those are least likely to be stale.
+				result = idleConnections.back();
+				idleConnections.pop_back();
+			}
+			if (!isClosedByPeer(result)) {
+				return result;
+			}
+		}
+	}
+
+	void checkin(const FileDescriptor &fd) {
+		boost::lock_guard<boost::mutex> l(syncher);
+		if (idleConnections.size() < maxIdleConnections) {
+			idleConnections.push_back(fd);
+		}
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_CORE_CONNECTION_POOL_H_ */
@@ -52,6 +52,7 @@
 #include <oxt/detail/context.hpp>
 #include "Hooks.h"
 #include "Bucket.h"
+#include "CoreConnectionPool.h"
 #include "Configuration.hpp"
 #include "DirectoryMapper.h"
 #include <modp_b64.h>
@@ -76,6 +77,7 @@
 #include <http_request.h>
 #include <http_protocol.h>
 #include <http_log.h>
+#include <ap_mpm.h>
 #include <util_script.h>
 #include <apr_pools.h>
 #include <apr_strings.h>
@@ -225,6 +227,7 @@ private:
 	Threeway m_hasModRewrite, m_hasModDir, m_hasModAutoIndex, m_hasModXsendfile;
 	CachedFileStat cstat;
 	WatchdogLauncher watchdogLauncher;
+	CoreConnectionPool coreConnectionPool;
 	boost::mutex cstatMutex;
 
 	inline DirConfig *getDirConfig(request_rec *r) {
@@ -314,6 +317,146 @@ private:
 		return conn;
 	}
 
+	/**
+	 * Sends the request headers to the Passenger core. Uses an idle keep-alive
+	 * connection if one is available and a new connection otherwise. If
+	 * writing to the idle connection fails because the core has closed it in
+	 * the mean time, then the core hasn't seen any part of this request, so
+	 * the headers are sent over a new connection instead.
+	 *
+	 * @param reusedConnection Set to whether the returned connection
+	 *                         is a previously used keep-alive connection.
+	 */
+	FileDescriptor sendRequestHeaders(const string &headers, bool &reusedConnection) {
+		TRACE_POINT();
+		FileDescriptor conn = coreConnectionPool.checkout();
+
+		if (conn != -1) {
+			try {
+				writeExact(conn, headers);
+				reusedConnection = true;
+				return conn;
+			} catch (const SystemException &e) {
+				if (e.code() != EPIPE && e.code() != ECONNRESET) {
+					throw;
+				}
+				P_TRACE(3, "Keep-alive connection to the Passenger core was "
+					"closed; retrying on a new connection");
+			}
+		}
+
+		UPDATE_TRACE_POINT();
+		reusedConnection = false;
+		conn = connectToCore();
+		writeExact(conn, headers);
+		return conn;
+	}
+
+	/**
+	 * Whether a request may be sent to the Passenger core again after a
+	 * keep-alive connection was closed without a response. The core may have
+	 * processed the request before it closed the connection, so this is only
+	 * the case for requests without a body and with an idempotent method.
+	 */
+	static bool requestIsReplayable(request_rec *r, bool expectingBody) {
+		return !expectingBody
+			&& (r->method_number == M_GET || r->method_number == M_OPTIONS);
+	}
+
+	apr_bucket_brigade *createResponseBrigade(request_rec *r, DirConfig *config,
+		const PassengerBucketStatePtr &bucketState)
+	{
+		apr_bucket_brigade *bb;
+		apr_bucket *b;
+
+		bb = apr_brigade_create(r->connection->pool, r->connection->bucket_alloc);
+
+		b = passenger_bucket_create(bucketState, r->connection->bucket_alloc,
+			config->getBufferResponse());
+		APR_BRIGADE_INSERT_TAIL(bb, b);
+
+		b = apr_bucket_eos_create(r->connection->bucket_alloc);
+		APR_BRIGADE_INSERT_TAIL(bb, b);
+
+		return bb;
+	}
+
+	/**
+	 * Called after the response headers from the Passenger core have been
+	 * parsed. If the core wants to keep the connection alive, and the end of
+	 * the response body can be determined without waiting for EOF, then
+	 * configures `bucketState` to stop reading at the end of the body.
+	 */
+	void prepareForKeepAlive(request_rec *r, apr_bucket_brigade *bb,
+		const PassengerBucketStatePtr &bucketState)
+	{
+		const char *connection = apr_table_get(r->err_headers_out, "Connection");
+		if (connection == NULL) {
+			connection = apr_table_get(r->headers_out, "Connection");
+		}
+		if (connection != NULL && strcasecmp(connection, "keep-alive") != 0) {
+			return;
+		}
+
+		apr_off_t bodyLength;
+		if (r->header_only || r->status == HTTP_NO_CONTENT || r->status == HTTP_NOT_MODIFIED) {
+			bodyLength = 0;
+		} else {
+			const char *contentLength = apr_table_get(r->headers_out, "Content-Length");
+			if (contentLength == NULL) {
+				contentLength = apr_table_get(r->err_headers_out, "Content-Length");
+			}
+			char *end;
+			if (contentLength == NULL
+			 || apr_strtoff(&bodyLength, contentLength, &end, 10) != APR_SUCCESS
+			 || *end != '\0'
+			 || bodyLength < 0)
+			{
+				return;
+			}
+		}
+
+		/* While parsing the response headers, part of the body may already
+		 * have been read into heap buckets that precede the PassengerBucket,
+		 * which is the only bucket with an unknown length.
+		 */
+		apr_bucket *b;
+		for (b = APR_BRIGADE_FIRST(bb);
+		     b != APR_BRIGADE_SENTINEL(bb) && b->length != (apr_size_t) -1;
+		     b = APR_BUCKET_NEXT(b))
+		{
+			bodyLength -= b->length;
+		}
+		if (bodyLength >= 0) {
+			bucketState->bodyLengthKnown = true;
+			bucketState->bodyRemaining = bodyLength;
+		}
+	}
+
+	/**
+	 * Returns the connection to the pool of idle keep-alive connections
+	 * if both the request and the response have been transferred completely.
+	 */
+	void maybeReuseConnection(const PassengerBucketStatePtr &bucketState,
+		bool requestFullySent)
+	{
+		if (requestFullySent
+		 && bucketState->bodyLengthKnown
+		 && bucketState->bodyRemaining == 0
+		 && bucketState->errorCode == 0)
+		{
+			coreConnectionPool.checkin(bucketState->connection);
+		}
+	}
+
+	static unsigned int getMaxThreadsPerChild() {
+		int threads = 1;
+		if (ap_mpm_query(AP_MPMQ_MAX_THREADS, &threads) != APR_SUCCESS || threads < 1) {
+			threads = 1;
+		}
+		return threads;
+	}
+
 	bool hasModRewrite() {
 		if (m_hasModRewrite == UNKNOWN) {
 			if (ap_find_linked_module("mod_rewrite.c")) {
@@ -579,13 +722,13 @@ private:
 
 			int ret;
 			bool bodyIsChunked = false;
+			bool reusedConnection;
+			bool requestFullySent = true;
 
 			string headers = constructRequestHeaders(r, mapper, bodyIsChunked);
-			FileDescriptor conn = connectToCore();
-			writeExact(conn, headers);
-			headers.clear();
+			FileDescriptor conn = sendRequestHeaders(headers, reusedConnection);
 			if (expectingBody) {
-				sendRequestBody(conn, r, bodyIsChunked);
+				requestFullySent = sendRequestBody(conn, r, bodyIsChunked);
 			}
 
 
@@ -594,19 +737,11 @@ private:
 
 			UPDATE_TRACE_POINT();
 			apr_bucket_brigade *bb;
-			apr_bucket *b;
 			PassengerBucketStatePtr bucketState;
 
 			/* Setup the bucket brigade. */
-			bb = apr_brigade_create(r->connection->pool, r->connection->bucket_alloc);
-
 			bucketState = boost::make_shared<PassengerBucketState>(conn);
-			b = passenger_bucket_create(bucketState, r->connection->bucket_alloc,
-				config->getBufferResponse());
-			APR_BRIGADE_INSERT_TAIL(bb, b);
-
-			b = apr_bucket_eos_create(r->connection->bucket_alloc);
-			APR_BRIGADE_INSERT_TAIL(bb, b);
+			bb = createResponseBrigade(r, config, bucketState);
 
 			/* Now read the HTTP response header, parse it and fill relevant
 			 * information in our request_rec structure. We skip the status line
@@ -619,15 +754,35 @@ private:
 			char backendData[MAX_STRING_LEN];
 			getsfunc_BRIGADE(backendData, MAX_STRING_LEN, bb);
 
+			if (reusedConnection && bucketState->bytesRead == 0
+			 && requestIsReplayable(r, expectingBody))
+			{
+				/* The core closed the keep-alive connection without responding,
+				 * e.g. because it crashed or is shutting down. This request is
+				 * safe to send again, so we do that over a new connection.
+				 */
+				UPDATE_TRACE_POINT();
+				apr_brigade_cleanup(bb);
+				conn = connectToCore();
+				writeExact(conn, headers);
+				bucketState = boost::make_shared<PassengerBucketState>(conn);
+				bb = createResponseBrigade(r, config, bucketState);
+				getsfunc_BRIGADE(backendData, MAX_STRING_LEN, bb);
+			}
+			headers.clear();
+
 			// The bucket brigade is an interface to the HTTP response sent by the
 			// PassengerAgent. The scanner parses (line by line) response headers
 			// into error_headers_out (mostly) as well as headers_out.
 			ret = ap_scan_script_header_err_brigade(r, bb, backendData);
 
-			// The PassengerAgent sets the Connection: close header because it wants
-			// the bb connection closed, but because we fed everything to the
+			// The PassengerAgent may set the Connection header to tell us whether
+			// it keeps our connection alive. Because we fed everything to the
 			// ap_scan_script it will also be set in the response to the client and
-			// that breaks HTTP 1.1 keep-alive, so unset it.
+			// that breaks HTTP 1.1 keep-alive, so unset it after looking at it.
+			if (ret == OK) {
+				prepareForKeepAlive(r, bb, bucketState);
+			}
 			apr_table_unset(r->err_headers_out, "Connection");
 			// It's undefined in which of the tables it ends up in, so unset on both.
 			apr_table_unset(r->headers_out, "Connection");
@@ -671,6 +826,7 @@ private:
 				} else if (ap_pass_brigade(r->output_filters, bb) == APR_SUCCESS) {
 					apr_brigade_cleanup(bb);
 				}
+				maybeReuseConnection(bucketState, requestFullySent);
 				return OK;
 			} else {
 				// Passenger core sent an empty response, or an invalid response.
@@ -911,10 +1067,9 @@ private:
 			}
 		}
 
+		// Without a Connection header, HTTP 1.1 defaults to keep-alive.
 		if (connectionHeader != NULL && connectionUpgradeFlagSet(connectionHeader->val)) {
 			result.append("Connection: upgrade\r\n", sizeof("Connection: upgrade\r\n") - 1);
-		} else {
-			result.append("Connection: close\r\n", sizeof("Connection: close\r\n") - 1);
 		}
 
 		if (transferEncodingHeader != NULL) {
@@ -1196,7 +1351,11 @@ private:
 		return bufsiz;
 	}
 
-	void sendRequestBody(const FileDescriptor &fd, request_rec *r, bool chunk) {
+	/**
+	 * @return Whether the entire body was sent. If not, then the
+	 *         connection must not be reused for another request.
+	 */
+	bool sendRequestBody(const FileDescriptor &fd, request_rec *r, bool chunk) {
 		TRACE_POINT();
 		char buf[1024 * 32];
 		apr_off_t len;
@@ -1221,11 +1380,12 @@ private:
 			if (chunk) {
 				writeExact(fd, "0\r\n\r\n");
 			}
+			return true;
 		} catch (const SystemException &e) {
 			if (e.code() == EPIPE || e.code() == ECONNRESET) {
 				// The Passenger core stopped reading the body, probably
 				// because the application already sent EOF.
-				return;
+				return false;
 			} else {
 				throw e;
 			}
@@ -1235,7 +1395,8 @@ private:
 public:
 	Hooks(apr_pool_t *pconf, apr_pool_t *plog, apr_pool_t *ptemp, server_rec *s)
 	    : cstat(1024),
-	      watchdogLauncher(IM_APACHE)
+	      watchdogLauncher(IM_APACHE),
+	      coreConnectionPool(getMaxThreadsPerChild())
 	{
 		passenger_postprocess_config(s);
 
@@ -0,0 +1,135 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_ALGORITHMS_CODEL_H_
+#define _PASSENGER_ALGORITHMS_CODEL_H_
+
+#include <boost/cstdint.hpp>
+
+namespace Passenger {
+
+
+/**
+ * Detects a standing queue using the CoDel ("controlled delay") criterion,
+ * for the purpose of shedding load from a request queue.
+ *
+ * CoDel looks at the *minimum* time that items spent in the queue
+ * (their "sojourn time") during an interval. A queue that absorbs a
+ * burst drains within an interval, so its minimum sojourn time drops to
+ * near zero. If even the minimum stays above `target` for a whole interval,
+ * then the queue is not absorbing a burst but is permanently too long: the
+ * system is overloaded and waiting longer only makes every request slower.
+ *
+ * Unlike CoDel for network packets, which controls a drop rate, this
+ * variant (as described for server request queues in "Fail at Scale",
+ * Maurer 2015) switches between two modes: while overloaded, requests
+ * that waited longer than `target` should be rejected immediately, so that
+ * the requests behind them can still be served in time. Otherwise, no
+ * requests are rejected and bursts are queued normally.
+ *
+ * The interval is 20 times the target, the ratio recommended by RFC 8289.
+ *
+ * All times are in microseconds. This class is not thread-safe.
+ */
+class CoDel {
+public:
+	static const unsigned int INTERVAL_TARGET_RATIO = 20;
+
+private:
+	boost::uint64_t target;
+	boost::uint64_t interval;
+	boost::uint64_t intervalEnd;
+	boost::uint64_t minSojournTime;
+	bool overloaded;
+
+	static boost::uint64_t noSojournTime() {
+		return ~((boost::uint64_t) 0);
+	}
+
+public:
+	CoDel(boost::uint64_t _target = 0) {
+		setTarget(_target);
+	}
+
+	/**
+	 * Sets the target queueing delay. A value of 0 disables this algorithm.
+	 */
+	void setTarget(boost::uint64_t _target) {
+		target = _target;
+		interval = _target * INTERVAL_TARGET_RATIO;
+		intervalEnd = 0;
+		minSojournTime = noSojournTime();
+		overloaded = false;
+	}
+
+	boost::uint64_t getTarget() const {
+		return target;
+	}
+
+	bool isEnabled() const {
+		return target != 0;
+	}
+
+	/**
+	 * Must be called whenever an item leaves the queue, whether it was
+	 * served or rejected, with the time it spent in the queue. Must also be
+	 * called with a sojourn time of 0 when an item is added to an empty
+	 * queue: it would have been served immediately if capacity had been
+	 * available, and it proves that the queue drained.
+	 */
+	void update(boost::uint64_t now, boost::uint64_t sojournTime) {
+		if (target == 0) {
+			return;
+		}
+
+		if (sojournTime < minSojournTime) {
+			minSojournTime = sojournTime;
+		}
+		if (intervalEnd == 0) {
+			intervalEnd = now + interval;
+		} else if (now >= intervalEnd) {
+			overloaded = minSojournTime > target;
+			minSojournTime = noSojournTime();
+			intervalEnd = now + interval;
+		}
+	}
+
+	bool isOverloaded() const {
+		return overloaded;
+	}
+
+	/**
+	 * Whether an item that has been in the queue for `sojournTime`
+	 * should be rejected instead of served.
+	 */
+	bool shouldShed(boost::uint64_t sojournTime) const {
+		return overloaded && sojournTime > target;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_ALGORITHMS_CODEL_H_ */
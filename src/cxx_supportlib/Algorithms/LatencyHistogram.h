@@ -0,0 +1,213 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_
+#define _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <cstring>
+#include <jsoncpp/json.h>
+#include <Utils/JsonUtils.h>
+
+namespace Passenger {
+
+using namespace std;
+
+
+/**
+ * A fixed-size histogram of latencies (in microseconds) with logarithmic
+ * buckets, in the style of HdrHistogram. Every power of two is split into
+ * `SUB_BUCKETS` linear sub-buckets, so any recorded value can be reported
+ * back with a relative error of at most 1/16th (6.25%), regardless of
+ * its magnitude. Values below `SUB_BUCKETS` are recorded exactly. Values
+ * larger than `MAX_VALUE` (about 19 hours) are clamped.
+ *
+ * Recording is O(1) and does not allocate, so a histogram can be updated
+ * for every request. The memory footprint is constant (about 4 KB).
+ *
+ * This class is not thread-safe. The intended usage is to keep one
+ * histogram per thread, and to `merge()` copies of them when a report
+ * is needed.
+ */
+class LatencyHistogram {
+public:
+	static const unsigned int SUB_BUCKET_BITS = 4;
+	static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+	static const unsigned int MAX_VALUE_BITS = 36;
+	static const boost::uint64_t MAX_VALUE = (((boost::uint64_t) 1) << MAX_VALUE_BITS) - 1;
+	static const unsigned int BUCKET_COUNT =
+		SUB_BUCKETS + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+private:
+	boost::uint64_t buckets[BUCKET_COUNT];
+	boost::uint64_t count;
+	boost::uint64_t sum;
+	boost::uint64_t min;
+	boost::uint64_t max;
+
+	static unsigned int mostSignificantBit(boost::uint64_t value) {
+		#if defined(__GNUC__) || defined(__clang__)
+			return 63 - __builtin_clzll(value);
+		#else
+			unsigned int result = 0;
+			while (value >>= 1) {
+				result++;
+			}
+			return result;
+		#endif
+	}
+
+	static unsigned int getBucketIndex(boost::uint64_t value) {
+		if (value < SUB_BUCKETS) {
+			return (unsigned int) value;
+		} else {
+			unsigned int shift = mostSignificantBit(value) - SUB_BUCKET_BITS;
+			return SUB_BUCKETS + shift * SUB_BUCKETS
+				+ (unsigned int) ((value >> shift) - SUB_BUCKETS);
+		}
+	}
+
+	/**
+	 * Returns the largest value that maps to the given bucket.
+	 */
+	static boost::uint64_t getBucketUpperBound(unsigned int index) {
+		if (index < SUB_BUCKETS) {
+			return index;
+		} else {
+			unsigned int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+			boost::uint64_t subBucket = SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS;
+			return ((subBucket + 1) << shift) - 1;
+		}
+	}
+
+public:
+	LatencyHistogram() {
+		reset();
+	}
+
+	void reset() {
+		memset(buckets, 0, sizeof(buckets));
+		count = 0;
+		sum = 0;
+		min = 0;
+		max = 0;
+	}
+
+	void record(boost::uint64_t value) {
+		value = std::min(value, (boost::uint64_t) MAX_VALUE);
+		buckets[getBucketIndex(value)]++;
+		if (count == 0 || value < min) {
+			min = value;
+		}
+		if (value > max) {
+			max = value;
+		}
+		count++;
+		sum += value;
+	}
+
+	void merge(const LatencyHistogram &other) {
+		if (other.count == 0) {
+			return;
+		}
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			buckets[i] += other.buckets[i];
+		}
+		if (count == 0 || other.min < min) {
+			min = other.min;
+		}
+		max = std::max(max, other.max);
+		count += other.count;
+		sum += other.sum;
+	}
+
+	boost::uint64_t getCount() const {
+		return count;
+	}
+
+	boost::uint64_t getMin() const {
+		return min;
+	}
+
+	boost::uint64_t getMax() const {
+		return max;
+	}
+
+	double getMean() const {
+		if (count == 0) {
+			return 0;
+		} else {
+			return (double) sum / count;
+		}
+	}
+
+	/**
+	 * Returns the value below which `percentile` percent of the recorded
+	 * values fall. The result is the upper bound of the bucket that contains
+	 * the percentile, capped by the largest recorded value, so it never
+	 * underestimates. Returns 0 if nothing has been recorded.
+	 *
+	 * @param percentile A number in the range [0, 100].
+	 */
+	boost::uint64_t getValueAtPercentile(double percentile) const {
+		if (count == 0) {
+			return 0;
+		}
+
+		boost::uint64_t target = (boost::uint64_t) ((percentile / 100.0) * count + 0.5);
+		boost::uint64_t seen = 0;
+		target = std::max<boost::uint64_t>(target, 1);
+		target = std::min(target, count);
+
+		for (unsigned int i = 0; i < BUCKET_COUNT; i++) {
+			seen += buckets[i];
+			if (seen >= target) {
+				return std::max(min, std::min(getBucketUpperBound(i), max));
+			}
+		}
+		return max;
+	}
+
+	Json::Value inspectAsJson() const {
+		Json::Value doc;
+		doc["count"] = (Json::UInt64) count;
+		if (count > 0) {
+			doc["min"] = durationToJson(min);
+			doc["mean"] = durationToJson((unsigned long long) getMean());
+			doc["p50"] = durationToJson(getValueAtPercentile(50));
+			doc["p90"] = durationToJson(getValueAtPercentile(90));
+			doc["p99"] = durationToJson(getValueAtPercentile(99));
+			doc["p999"] = durationToJson(getValueAtPercentile(99.9));
+			doc["max"] = durationToJson(max);
+		}
+		return doc;
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_ALGORITHMS_LATENCY_HISTOGRAM_H_ */
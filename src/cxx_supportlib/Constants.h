@@ -50,24 +50,40 @@
 #define DEFAULT_FILE_BUFFERED_CHANNEL_THRESHOLD 131072
 #define DEFAULT_HTTP_SERVER_LISTEN_ADDRESS "tcp://127.0.0.1:3000"
 #define DEFAULT_INTEGRATION_MODE "standalone"
+#define DEFAULT_LARGE_MBUF_CHUNK_SIZE 65536
+#define DEFAULT_LOG_BUFFER_SIZE 65536
 #define DEFAULT_LOG_LEVEL 3
 #define DEFAULT_LVE_MIN_UID 500
+#define DEFAULT_MAX_CONCURRENT_SPAWNS 0
 #define DEFAULT_MAX_POOL_SIZE 6
 #define DEFAULT_MAX_PRELOADER_IDLE_TIME 300
 #define DEFAULT_MAX_REQUEST_QUEUE_SIZE 100
 #define DEFAULT_MBUF_CHUNK_SIZE 4096
+#define DEFAULT_MEMORY_RECLAMATION_INTERVAL 10
+#define DEFAULT_MEMORY_RECLAMATION_MBUF_FLOOR 256
+#define DEFAULT_MEMORY_RECLAMATION_WINDOW 30
 #define DEFAULT_NODEJS "node"
 #define DEFAULT_POOL_IDLE_TIME 300
 #define DEFAULT_PYTHON "python"
 #define DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK 134217728
+#define DEFAULT_ROUTING_POLICY "least_busy"
 #define DEFAULT_RUBY "ruby"
+#define DEFAULT_SMALL_MBUF_CHUNK_SIZE 1024
 #define DEFAULT_SOCKET_BACKLOG 2048
+#define DEFAULT_SPAWN_CONCURRENCY 1
 #define DEFAULT_SPAWN_METHOD "smart"
+#define DEFAULT_SPLICE_THRESHOLD 1048576
 #define DEFAULT_START_TIMEOUT 90000
 #define DEFAULT_STAT_THROTTLE_RATE 10
 #define DEFAULT_STICKY_SESSIONS_COOKIE_NAME "_passenger_route"
+#define DEFAULT_TURBOCACHE_MAX_BODY_SIZE 32768
+#define DEFAULT_TURBOCACHE_MAX_ENTRIES 1024
+#define DEFAULT_TURBOCACHE_MEMORY_LIMIT 8388608
+#define DEFAULT_UNION_STATION_COMPRESSION_THREADS 2
 #define DEFAULT_UNION_STATION_GATEWAY_ADDRESS "gateway.unionstationapp.com"
 #define DEFAULT_UNION_STATION_GATEWAY_PORT 443
+#define DEFAULT_UNION_STATION_MAX_CONCURRENT_UPLOADS 4
+#define DEFAULT_UNION_STATION_SENDER_MEMORY_LIMIT 67108864
 #define DEFAULT_UST_ROUTER_LISTEN_ADDRESS "tcp://127.0.0.1:9344"
 #define DEFAULT_WEB_APP_USER "nobody"
 #define ENTERPRISE_URL "https://www.phusionpassenger.com/enterprise"
@@ -0,0 +1,185 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_
+#define _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_
+
+#include <boost/container/vector.hpp>
+#include <cstddef>
+#include <cassert>
+
+namespace Passenger {
+
+
+/**
+ * An array of integer keys, addressed by slot number like a vector, that
+ * can also tell which slot has the smallest key in O(1) time. Changing a
+ * key or appending a slot takes O(log n) time. Erasing a slot shifts all
+ * subsequent slots down by one, just like vector::erase(), and takes O(n)
+ * time.
+ *
+ * If multiple slots have the smallest key, then `top()` returns the lowest
+ * numbered one, so that the result is the same as that of a linear scan
+ * for the first minimum.
+ *
+ * The keys are also available as a contiguous array through `data()`.
+ */
+class IndexedMinHeap {
+private:
+	typedef boost::container::vector<int> KeyVector;
+	typedef boost::container::vector<unsigned int> IndexVector;
+
+	/** Keys, by slot number. */
+	KeyVector keys;
+	/** Slot numbers, in heap order. */
+	IndexVector heap;
+	/** Position in `heap`, by slot number. */
+	IndexVector positions;
+
+	bool less(unsigned int slot1, unsigned int slot2) const {
+		return keys[slot1] < keys[slot2]
+			|| (keys[slot1] == keys[slot2] && slot1 < slot2);
+	}
+
+	void swapPositions(unsigned int pos1, unsigned int pos2) {
+		unsigned int slot1 = heap[pos1];
+		unsigned int slot2 = heap[pos2];
+		heap[pos1] = slot2;
+		heap[pos2] = slot1;
+		positions[slot2] = pos1;
+		positions[slot1] = pos2;
+	}
+
+	void siftUp(unsigned int pos) {
+		while (pos > 0) {
+			unsigned int parent = (pos - 1) / 2;
+			if (less(heap[pos], heap[parent])) {
+				swapPositions(pos, parent);
+				pos = parent;
+			} else {
+				break;
+			}
+		}
+	}
+
+	void siftDown(unsigned int pos) {
+		unsigned int size = heap.size();
+		while (true) {
+			unsigned int left = 2 * pos + 1;
+			unsigned int right = left + 1;
+			unsigned int smallest = pos;
+
+			if (left < size && less(heap[left], heap[smallest])) {
+				smallest = left;
+			}
+			if (right < size && less(heap[right], heap[smallest])) {
+				smallest = right;
+			}
+			if (smallest == pos) {
+				break;
+			}
+			swapPositions(pos, smallest);
+			pos = smallest;
+		}
+	}
+
+	void rebuild() {
+		unsigned int size = keys.size();
+		heap.resize(size);
+		positions.resize(size);
+		for (unsigned int i = 0; i < size; i++) {
+			heap[i] = i;
+			positions[i] = i;
+		}
+		for (unsigned int i = size / 2; i > 0; i--) {
+			siftDown(i - 1);
+		}
+	}
+
+public:
+	unsigned int size() const {
+		return keys.size();
+	}
+
+	bool empty() const {
+		return keys.empty();
+	}
+
+	int operator[](unsigned int slot) const {
+		return keys[slot];
+	}
+
+	const int *data() const {
+		return keys.data();
+	}
+
+	/**
+	 * Returns the slot with the smallest key. The heap must not be empty.
+	 */
+	unsigned int top() const {
+		assert(!empty());
+		return heap[0];
+	}
+
+	void push_back(int key) {
+		unsigned int slot = keys.size();
+		keys.push_back(key);
+		heap.push_back(slot);
+		positions.push_back(slot);
+		siftUp(slot);
+	}
+
+	void set(unsigned int slot, int key) {
+		int oldKey = keys[slot];
+		keys[slot] = key;
+		if (key < oldKey) {
+			siftUp(positions[slot]);
+		} else if (key > oldKey) {
+			siftDown(positions[slot]);
+		}
+	}
+
+	void erase(unsigned int slot) {
+		keys.erase(keys.begin() + slot);
+		rebuild();
+	}
+
+	void clear() {
+		keys.clear();
+		heap.clear();
+		positions.clear();
+	}
+
+	void shrink_to_fit() {
+		keys.shrink_to_fit();
+		heap.shrink_to_fit();
+		positions.shrink_to_fit();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_DATA_STRUCTURES_INDEXED_MIN_HEAP_H_ */
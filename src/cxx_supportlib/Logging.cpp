@@ -26,11 +26,18 @@
 #include <iomanip>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <fcntl.h>
 #include <unistd.h>
+#include <sched.h>
+#include <pthread.h>
+#include <sys/uio.h>
 
 #include <boost/thread.hpp>
 #include <boost/atomic.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <oxt/thread.hpp>
 #include <Logging.h>
 #include <Constants.h>
 #include <StaticString.h>
@@ -52,6 +59,61 @@ static string fileDescriptorLogFile;
 
 #define TRUNCATE_LOGPATHS_TO_MAXCHARS 3 // set to 0 to disable truncation
 
+namespace {
+	/**
+	 * A single-producer, single-consumer ring buffer of log entry bytes.
+	 * The producer is the thread that owns the buffer, the consumer is
+	 * whoever holds `logBuffersDraining`. `head` and `tail` only increase;
+	 * the positions in `data` are obtained by taking them modulo `capacity`.
+	 */
+	struct LogBuffer {
+		char *data;
+		unsigned int capacity;
+		boost::atomic<boost::uint64_t> head;
+		boost::atomic<boost::uint64_t> tail;
+		boost::atomic<unsigned int> dropped;
+		// Protected by logBufferRegistrationMutex.
+		bool owned;
+
+		LogBuffer(char *_data, unsigned int _capacity)
+			: data(_data),
+			  capacity(_capacity),
+			  head(0),
+			  tail(0),
+			  dropped(0),
+			  owned(true)
+			{ }
+	};
+}
+
+// The maximum number of threads that can log asynchronously at the same time.
+// Any other threads log synchronously.
+static const unsigned int MAX_LOG_BUFFERS = 256;
+static const unsigned int LOG_WRITER_INTERVAL_MSEC = 50;
+static const unsigned int LOG_WRITER_MAX_IOVECS = 64;
+static const unsigned int LOG_FLUSH_MAX_SPINS = 10000;
+
+static void releaseLogBuffer(LogBuffer *buf);
+
+// Buffers are never freed: when a thread exits, its buffer is
+// released so that a new thread can take it over.
+static LogBuffer *logBuffers[MAX_LOG_BUFFERS];
+static boost::atomic<unsigned int> logBufferCount(0);
+static boost::mutex logBufferRegistrationMutex;
+static boost::thread_specific_ptr<LogBuffer> threadLogBuffer(releaseLogBuffer);
+static unsigned int logBufferSize = 0;
+static boost::atomic<bool> asyncLogWriterRunning(false);
+static boost::atomic<bool> logBuffersDraining(false);
+
+static oxt::thread *logWriterThread = NULL;
+static boost::mutex logWriterMutex;
+static boost::condition_variable logWriterCond;
+static bool logWriterQuit = false;
+// Set by logging threads that want the writer to flush before its next
+// periodic wakeup. The writer clears it before flushing.
+static boost::atomic<bool> logWriterWakeupRequested(false);
+static unsigned long long reportedDroppedLogEntries = 0;
+
 
 void
 setLogLevel(int value) {
@@ -215,8 +277,293 @@ writeExactWithoutOXT(int fd, const char *str, unsigned int size) {
 	}
 }
 
+static void
+writevExactWithoutOXT(int fd, struct iovec *iov, unsigned int count) {
+	// See writeExactWithoutOXT() for why we don't use oxt::syscalls
+	// and why we ignore errors.
+	ssize_t ret;
+	while (count > 0) {
+		do {
+			ret = writev(fd, iov, count);
+		} while (ret == -1 && errno == EINTR);
+		if (ret == -1) {
+			break;
+		}
+		while (count > 0 && (size_t) ret >= iov->iov_len) {
+			ret -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0) {
+			iov->iov_base = (char *) iov->iov_base + ret;
+			iov->iov_len -= ret;
+		}
+	}
+}
+
+static void
+releaseLogBuffer(LogBuffer *buf) {
+	boost::lock_guard<boost::mutex> l(logBufferRegistrationMutex);
+	buf->owned = false;
+}
+
+static LogBuffer *
+getThreadLogBuffer() {
+	LogBuffer *buf = threadLogBuffer.get();
+	if (OXT_LIKELY(buf != NULL && buf->capacity == logBufferSize)) {
+		return buf;
+	} else if (buf != NULL) {
+		// The writer was restarted with a different buffer size.
+		threadLogBuffer.reset();
+	}
+
+	boost::lock_guard<boost::mutex> l(logBufferRegistrationMutex);
+	unsigned int count = logBufferCount.load(boost::memory_order_relaxed);
+	for (unsigned int i = 0; i < count; i++) {
+		buf = logBuffers[i];
+		if (!buf->owned && buf->capacity == logBufferSize) {
+			buf->owned = true;
+			threadLogBuffer.reset(buf);
+			return buf;
+		}
+	}
+	if (count == MAX_LOG_BUFFERS) {
+		return NULL;
+	}
+
+	// If we're out of memory, the caller logs synchronously.
+	char *data = (char *) malloc(logBufferSize);
+	if (data == NULL) {
+		return NULL;
+	}
+	buf = new (std::nothrow) LogBuffer(data, logBufferSize);
+	if (buf == NULL) {
+		free(data);
+		return NULL;
+	}
+	logBuffers[count] = buf;
+	logBufferCount.store(count + 1, boost::memory_order_release);
+	threadLogBuffer.reset(buf);
+	return buf;
+}
+
+static void
+wakeUpLogWriter() {
+	// Only the first thread to request a wakeup takes the mutex. Notifying
+	// under the mutex ensures that the wakeup is not lost, and the writer
+	// checks the flag before it waits.
+	if (!logWriterWakeupRequested.exchange(true, boost::memory_order_acq_rel)) {
+		boost::lock_guard<boost::mutex> l(logWriterMutex);
+		logWriterCond.notify_one();
+	}
+}
+
+static bool
+logWriterShouldWakeUp() {
+	return logWriterQuit || logWriterWakeupRequested.load(boost::memory_order_acquire);
+}
+
+static void
+appendToLogBuffer(LogBuffer *buf, const char *str, unsigned int size) {
+	boost::uint64_t head = buf->head.load(boost::memory_order_relaxed);
+	boost::uint64_t used = head - buf->tail.load(boost::memory_order_acquire);
+
+	if (used + size > buf->capacity) {
+		buf->dropped.fetch_add(1, boost::memory_order_relaxed);
+		wakeUpLogWriter();
+		return;
+	}
+
+	unsigned int start = head % buf->capacity;
+	unsigned int firstPart = std::min(size, buf->capacity - start);
+	memcpy(buf->data + start, str, firstPart);
+	memcpy(buf->data, str + firstPart, size - firstPart);
+	buf->head.store(head + size, boost::memory_order_release);
+
+	if (used + size > buf->capacity / 2) {
+		wakeUpLogWriter();
+	}
+}
+
+static void
+commitLogBuffers(struct iovec *iov, unsigned int iovCount, LogBuffer **bufs,
+	const boost::uint64_t *newTails, unsigned int bufCount)
+{
+	writevExactWithoutOXT(logFd, iov, iovCount);
+	for (unsigned int i = 0; i < bufCount; i++) {
+		bufs[i]->tail.store(newTails[i], boost::memory_order_release);
+	}
+}
+
+void
+flushLogBuffers() {
+	unsigned int spins = 0;
+	bool expected = false;
+
+	// We can't use a mutex here because this function must be
+	// async-signal-safe. If the thread that is draining the buffers
+	// was interrupted by a signal handler that calls us, then we must
+	// not wait forever, hence the spin limit.
+	while (!logBuffersDraining.compare_exchange_weak(expected, true,
+		boost::memory_order_acquire))
+	{
+		expected = false;
+		if (++spins > LOG_FLUSH_MAX_SPINS) {
+			return;
+		}
+		sched_yield();
+	}
+
+	struct iovec iov[LOG_WRITER_MAX_IOVECS];
+	LogBuffer *bufs[LOG_WRITER_MAX_IOVECS];
+	boost::uint64_t newTails[LOG_WRITER_MAX_IOVECS];
+	unsigned int iovCount = 0, bufCount = 0;
+	unsigned int count = logBufferCount.load(boost::memory_order_acquire);
+
+	for (unsigned int i = 0; i < count; i++) {
+		LogBuffer *buf = logBuffers[i];
+		boost::uint64_t tail = buf->tail.load(boost::memory_order_relaxed);
+		boost::uint64_t head = buf->head.load(boost::memory_order_acquire);
+		if (head == tail) {
+			continue;
+		}
+
+		unsigned int start = tail % buf->capacity;
+		unsigned int size = head - tail;
+		unsigned int firstPart = std::min(size, buf->capacity - start);
+		iov[iovCount].iov_base = buf->data + start;
+		iov[iovCount].iov_len = firstPart;
+		iovCount++;
+		if (firstPart < size) {
+			iov[iovCount].iov_base = buf->data;
+			iov[iovCount].iov_len = size - firstPart;
+			iovCount++;
+		}
+		bufs[bufCount] = buf;
+		newTails[bufCount] = head;
+		bufCount++;
+
+		if (iovCount + 2 > LOG_WRITER_MAX_IOVECS) {
+			commitLogBuffers(iov, iovCount, bufs, newTails, bufCount);
+			iovCount = 0;
+			bufCount = 0;
+		}
+	}
+	if (iovCount > 0) {
+		commitLogBuffers(iov, iovCount, bufs, newTails, bufCount);
+	}
+
+	logBuffersDraining.store(false, boost::memory_order_release);
+}
+
+unsigned long long
+getDroppedLogEntryCount() {
+	unsigned long long result = 0;
+	unsigned int count = logBufferCount.load(boost::memory_order_acquire);
+	for (unsigned int i = 0; i < count; i++) {
+		result += logBuffers[i]->dropped.load(boost::memory_order_relaxed);
+	}
+	return result;
+}
+
+static void
+reportDroppedLogEntries() {
+	unsigned long long dropped = getDroppedLogEntryCount();
+	if (dropped > reportedDroppedLogEntries) {
+		FastStringStream<> stream;
+		_prepareLogEntry(stream, __FILE__, __LINE__);
+		stream << (dropped - reportedDroppedLogEntries) <<
+			" log entries were dropped because the log buffer was full\n";
+		writeExactWithoutOXT(logFd, stream.data(), stream.size());
+		reportedDroppedLogEntries = dropped;
+	}
+}
+
+static void
+logWriterMain() {
+	boost::unique_lock<boost::mutex> l(logWriterMutex);
+	while (!logWriterQuit) {
+		logWriterCond.timed_wait(l,
+			boost::posix_time::milliseconds(LOG_WRITER_INTERVAL_MSEC),
+			logWriterShouldWakeUp);
+		logWriterWakeupRequested.store(false, boost::memory_order_release);
+		l.unlock();
+		flushLogBuffers();
+		reportDroppedLogEntries();
+		l.lock();
+	}
+}
+
+static void
+disableAsyncLogWriterAfterFork() {
+	// The writer thread does not exist in the child. Log synchronously,
+	// and forget about the buffers so that the parent's pending entries
+	// are not written twice.
+	asyncLogWriterRunning.store(false, boost::memory_order_relaxed);
+	logBufferCount.store(0, boost::memory_order_relaxed);
+	logBuffersDraining.store(false, boost::memory_order_relaxed);
+	logWriterThread = NULL;
+}
+
+void
+startAsyncLogWriter(unsigned int bufferSize) {
+	static bool atforkInstalled = false;
+
+	if (bufferSize == 0 || logWriterThread != NULL) {
+		return;
+	}
+	if (!atforkInstalled) {
+		pthread_atfork(NULL, NULL, disableAsyncLogWriterAfterFork);
+		atforkInstalled = true;
+	}
+
+	logBufferSize = bufferSize;
+	logWriterQuit = false;
+	logWriterThread = new oxt::thread(logWriterMain, "Log writer", 1024 * 128);
+	asyncLogWriterRunning.store(true, boost::memory_order_seq_cst);
+}
+
 void
-_writeLogEntry(const char *str, unsigned int size) {
+stopAsyncLogWriter() {
+	if (logWriterThread == NULL) {
+		return;
+	}
+
+	asyncLogWriterRunning.store(false, boost::memory_order_seq_cst);
+	{
+		boost::lock_guard<boost::mutex> l(logWriterMutex);
+		logWriterQuit = true;
+		logWriterCond.notify_one();
+	}
+	logWriterThread->join();
+	delete logWriterThread;
+	logWriterThread = NULL;
+
+	flushLogBuffers();
+	reportDroppedLogEntries();
+}
+
+void
+_writeLogEntry(const char *str, unsigned int size, int level) {
+	if (level > LVL_CRIT && asyncLogWriterRunning.load(boost::memory_order_acquire)) {
+		LogBuffer *buf = getThreadLogBuffer();
+		if (buf != NULL && size <= buf->capacity / 4) {
+			appendToLogBuffer(buf, str, size);
+			// If the writer was stopped in the mean time, then its final
+			// flush may have missed this entry.
+			boost::atomic_thread_fence(boost::memory_order_seq_cst);
+			if (OXT_UNLIKELY(!asyncLogWriterRunning.load(boost::memory_order_relaxed))) {
+				flushLogBuffers();
+			}
+			return;
+		}
+	}
+
+	// Write any buffered entries first so that this entry
+	// is not written before entries that were logged earlier.
+	if (logBufferCount.load(boost::memory_order_relaxed) > 0) {
+		flushLogBuffers();
+	}
 	writeExactWithoutOXT(logFd, str, size);
 }
 
@@ -249,7 +596,7 @@ realPrintAppOutput(char *buf, unsigned int bufSize,
 	pos = appendData(pos, end, ": ");
 	pos = appendData(pos, end, message, messageLen);
 	pos = appendData(pos, end, "\n");
-	_writeLogEntry(buf, pos - buf);
+	_writeLogEntry(buf, pos - buf, LVL_NOTICE);
 }
 
 void
@@ -164,10 +164,6 @@ int getFileDescriptorLogFileFd();
  */
 bool setFileDescriptorLogFile(const string &path, int *errcode = NULL);
 
-void _prepareLogEntry(FastStringStream<> &sstream, const char *file, unsigned int line);
-void _writeLogEntry(const char *str, unsigned int size);
-void _writeFileDescriptorLogEntry(const char *str, unsigned int size);
-const char *_strdupFastStringStream(const FastStringStream<> &stream);
 
 
 enum PassengerLogLevel {
@@ -181,6 +177,57 @@ enum PassengerLogLevel {
 	LVL_DEBUG3 = 7
 };
 
+/**
+ * Starts a background thread that writes log entries to the log file, so
+ * that threads that log don't have to wait for a write() system call per
+ * log entry. Each thread appends its entries to its own lock-free ring
+ * buffer of `bufferSize` bytes. The background thread periodically drains
+ * all buffers using batched writev() calls.
+ *
+ * Memory usage is bounded: when a thread's buffer is full, its new entries
+ * are dropped and counted, and the background thread logs how many entries
+ * were dropped. Entries that are larger than a quarter of the buffer, and
+ * entries of level LVL_CRIT, are written synchronously after flushing the
+ * buffers, so that critical messages are never lost. Entries that different
+ * threads log at about the same time may appear slightly out of order.
+ *
+ * Does nothing if `bufferSize` is 0 or if the writer has already been
+ * started. In child processes created with fork(), logging automatically
+ * falls back to synchronous writes.
+ *
+ * This method is not thread-safe: it must be called before any other
+ * threads log.
+ */
+void startAsyncLogWriter(unsigned int bufferSize);
+
+/**
+ * Stops the background thread that was started with `startAsyncLogWriter()`,
+ * and writes all remaining buffered log entries. Logging becomes
+ * synchronous again. This method is not thread-safe.
+ */
+void stopAsyncLogWriter();
+
+/**
+ * Writes all log entries that are buffered by the asynchronous log writer.
+ * This is a best-effort operation: if another thread is writing the buffers
+ * and doesn't finish soon, then this method gives up.
+ *
+ * This method is thread-safe and async-signal-safe, so that it can be
+ * called from crash handlers.
+ */
+void flushLogBuffers();
+
+/**
+ * Returns the number of log entries that the asynchronous log writer
+ * dropped because a thread's log buffer was full. This method is thread-safe.
+ */
+unsigned long long getDroppedLogEntryCount();
+
+void _prepareLogEntry(FastStringStream<> &sstream, const char *file, unsigned int line);
+void _writeLogEntry(const char *str, unsigned int size, int level = LVL_CRIT);
+void _writeFileDescriptorLogEntry(const char *str, unsigned int size);
+const char *_strdupFastStringStream(const FastStringStream<> &stream);
+
 /**
  * Write the given expression to the log stream.
  */
@@ -190,7 +237,7 @@ enum PassengerLogLevel {
 			Passenger::FastStringStream<> _ostream; \
 			Passenger::_prepareLogEntry(_ostream, file, line); \
 			_ostream << expr << "\n"; \
-			Passenger::_writeLogEntry(_ostream.data(), _ostream.size()); \
+			Passenger::_writeLogEntry(_ostream.data(), _ostream.size(), (level)); \
 		} \
 	} while (false)
 
@@ -200,7 +247,7 @@ enum PassengerLogLevel {
 			Passenger::FastStringStream<> _ostream; \
 			Passenger::_prepareLogEntry(_ostream, file, line); \
 			_ostream << expr << "\n"; \
-			Passenger::_writeLogEntry(_ostream.data(), _ostream.size()); \
+			Passenger::_writeLogEntry(_ostream.data(), _ostream.size(), (level)); \
 		} \
 	} while (false)
 
@@ -271,7 +318,7 @@ enum PassengerLogLevel {
 			if (hasFileDescriptorLogFile()) { \
 				Passenger::_writeFileDescriptorLogEntry(_ostream.data(), _ostream.size()); \
 			} else { \
-				Passenger::_writeLogEntry(_ostream.data(), _ostream.size()); \
+				Passenger::_writeLogEntry(_ostream.data(), _ostream.size(), Passenger::LVL_DEBUG); \
 			} \
 		} \
 	} while (false)
@@ -295,7 +342,7 @@ enum PassengerLogLevel {
 			if (hasFileDescriptorLogFile()) { \
 				Passenger::_writeFileDescriptorLogEntry(_ostream.data(), _ostream.size()); \
 			} else { \
-				Passenger::_writeLogEntry(_ostream.data(), _ostream.size()); \
+				Passenger::_writeLogEntry(_ostream.data(), _ostream.size(), Passenger::LVL_DEBUG); \
 			} \
 		} \
 	} while (false)
@@ -312,7 +359,7 @@ enum PassengerLogLevel {
 			if (hasFileDescriptorLogFile()) { \
 				Passenger::_writeFileDescriptorLogEntry(_ostream.data(), _ostream.size()); \
 			} else { \
-				Passenger::_writeLogEntry(_ostream.data(), _ostream.size()); \
+				Passenger::_writeLogEntry(_ostream.data(), _ostream.size(), Passenger::LVL_DEBUG); \
 			} \
 		} \
 	} while (false)
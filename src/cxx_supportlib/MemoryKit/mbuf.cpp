@@ -58,6 +58,9 @@ _mbuf_block_mark_as_active(struct mbuf_pool *pool, struct mbuf_block *mbuf_block
 	#endif
 	mbuf_block->refcount = 1;
 	pool->nactive_mbuf_blockq++;
+	if (pool->nactive_mbuf_blockq > pool->peak_nactive_mbuf_blockq) {
+		pool->peak_nactive_mbuf_blockq = pool->nactive_mbuf_blockq;
+	}
 }
 
 static struct mbuf_block *
@@ -273,6 +276,7 @@ mbuf_pool_init(struct mbuf_pool *pool)
 {
 	pool->nfree_mbuf_blockq = 0;
 	pool->nactive_mbuf_blockq = 0;
+	pool->peak_nactive_mbuf_blockq = 0;
 	STAILQ_INIT(&pool->free_mbuf_blockq);
 
 	#ifdef MBUF_ENABLE_DEBUGGING
@@ -301,19 +305,74 @@ mbuf_pool_data_size(struct mbuf_pool *pool)
 unsigned int
 mbuf_pool_compact(struct mbuf_pool *pool)
 {
-	unsigned int count = pool->nfree_mbuf_blockq;
+	unsigned int count = mbuf_pool_release(pool, pool->nfree_mbuf_blockq);
+	assert(pool->nfree_mbuf_blockq == 0);
+	return count;
+}
 
-	while (!STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
+/*
+ * Free at most `max` mbuf_blocks from the free mbuf_block q. Returns the
+ * number of mbuf_blocks that were freed.
+ */
+unsigned int
+mbuf_pool_release(struct mbuf_pool *pool, unsigned int max)
+{
+	unsigned int count = 0;
+
+	while (count < max && !STAILQ_EMPTY(&pool->free_mbuf_blockq)) {
 		struct mbuf_block *mbuf_block = STAILQ_FIRST(&pool->free_mbuf_blockq);
 		mbuf_block_remove(&pool->free_mbuf_blockq, mbuf_block);
 		mbuf_block_free(mbuf_block);
 		pool->nfree_mbuf_blockq--;
+		count++;
 	}
-	assert(pool->nfree_mbuf_blockq == 0);
 
 	return count;
 }
 
+void
+mbuf_size_class_tracker_init(struct mbuf_size_class_tracker *tracker,
+	enum mbuf_size_class size_class)
+{
+	tracker->size_class = size_class;
+	tracker->small_reads = 0;
+}
+
+/*
+ * Record a read of `read_size` bytes into a buffer of `buffer_size` bytes.
+ *
+ * A read that filled (most of) a block means that more data is probably
+ * pending, so the next read uses the next larger size class right away.
+ * Only after several consecutive reads that would have fit in the next
+ * smaller size class does the tracker move down, so that a single short
+ * read in the middle of a bulk transfer doesn't cause flapping.
+ */
+void
+mbuf_size_class_tracker_update(struct mbuf_size_class_tracker *tracker,
+	struct mbuf_pool_set *set, size_t read_size, size_t buffer_size)
+{
+	unsigned int size_class = tracker->size_class;
+
+	if (read_size == buffer_size
+	 && buffer_size * 2 >= mbuf_pool_data_size(set->pools[size_class]))
+	{
+		if (size_class + 1 < MBUF_SIZE_CLASS_COUNT) {
+			tracker->size_class++;
+		}
+		tracker->small_reads = 0;
+	} else if (size_class > 0
+	 && read_size <= mbuf_pool_data_size(set->pools[size_class - 1]))
+	{
+		tracker->small_reads++;
+		if (tracker->small_reads >= MBUF_SIZE_CLASS_DOWNGRADE_READS) {
+			tracker->size_class--;
+			tracker->small_reads = 0;
+		}
+	} else {
+		tracker->small_reads = 0;
+	}
+}
+
 
 void
 mbuf_block_ref(struct mbuf_block *mbuf_block)
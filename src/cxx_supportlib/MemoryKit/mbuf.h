@@ -54,6 +54,14 @@
  * This approach is similar to how Node.js manages buffer slices.
  * We also got rid of the global variables, and put them in an mbuf_pool
  * struct, which acts like a context structure.
+ *
+ * To get around the chunk size trade-off, readers may use several pools with
+ * different chunk sizes ("size classes"), grouped in an mbuf_pool_set: small
+ * blocks for small reads such as keep-alive request headers, large blocks for
+ * bulk transfers. An mbuf_block always returns to the pool it came from, so
+ * mbufs from different size classes can be mixed freely. An
+ * mbuf_size_class_tracker picks the size class for a reader based on its
+ * recent read sizes.
  */
 
 //#define MBUF_ENABLE_DEBUGGING
@@ -96,6 +104,7 @@ STAILQ_HEAD(mhdr, struct mbuf_block);
 struct mbuf_pool {
 	boost::uint32_t nfree_mbuf_blockq;   /* # free mbuf_block */
 	boost::uint32_t nactive_mbuf_blockq; /* # active (non-free) mbuf_block */
+	boost::uint32_t peak_nactive_mbuf_blockq; /* highest # active mbuf_block since last reset */
 	struct mhdr free_mbuf_blockq; /* free mbuf_block q */
 	#ifdef MBUF_ENABLE_DEBUGGING
 		struct active_mbuf_block_list active_mbuf_blockq; /* active mbuf_block q */
@@ -105,6 +114,27 @@ struct mbuf_pool {
 	size_t mbuf_block_offset;     /* mbuf_block offset in chunk (const) */
 };
 
+enum mbuf_size_class {
+	MBUF_SIZE_CLASS_SMALL,
+	MBUF_SIZE_CLASS_MEDIUM,
+	MBUF_SIZE_CLASS_LARGE
+};
+
+#define MBUF_SIZE_CLASS_COUNT 3
+
+/* Pools in increasing chunk size order, indexed by mbuf_size_class. */
+struct mbuf_pool_set {
+	struct mbuf_pool *pools[MBUF_SIZE_CLASS_COUNT];
+};
+
+struct mbuf_size_class_tracker {
+	boost::uint8_t size_class;  /* size class for the next read */
+	boost::uint8_t small_reads; /* # consecutive reads that fit in a smaller class */
+};
+
+/* # consecutive small reads after which the tracker moves down a size class */
+#define MBUF_SIZE_CLASS_DOWNGRADE_READS 4
+
 #define MBUF_BLOCK_MAGIC      0xdeadbeef
 #define MBUF_BLOCK_MIN_SIZE   512
 #define MBUF_BLOCK_MAX_SIZE   16777216
@@ -118,6 +148,12 @@ void mbuf_pool_init(struct mbuf_pool *pool);
 void mbuf_pool_deinit(struct mbuf_pool *pool);
 size_t mbuf_pool_data_size(struct mbuf_pool *pool);
 unsigned int mbuf_pool_compact(struct mbuf_pool *pool);
+unsigned int mbuf_pool_release(struct mbuf_pool *pool, unsigned int max);
+
+void mbuf_size_class_tracker_init(struct mbuf_size_class_tracker *tracker,
+	enum mbuf_size_class size_class);
+void mbuf_size_class_tracker_update(struct mbuf_size_class_tracker *tracker,
+	struct mbuf_pool_set *set, size_t read_size, size_t buffer_size);
 
 struct mbuf_block *mbuf_block_get(struct mbuf_pool *pool);
 void mbuf_block_put(struct mbuf_block *mbuf_block);
@@ -78,6 +78,11 @@ using namespace boost;
  * Inside the "PassengerAgent core", we activate AcceptLoadBalancer
  * only if `core_threads > 1`, which is often the case because
  * `core_threads` defaults to the number of CPU cores.
+ *
+ * When `reuse_port` is enabled, every Server gets its own SO_REUSEPORT
+ * socket for each TCP address instead, and the kernel distributes the
+ * connections. The AcceptLoadBalancer is then only used for Unix domain
+ * socket addresses, which do not support SO_REUSEPORT.
  */
 template<typename Server>
 class AcceptLoadBalancer {
@@ -300,6 +305,10 @@ public:
 		#undef EXTENSION_EOPNOTSUPP
 	}
 
+	unsigned int getEndpointCount() const {
+		return nEndpoints;
+	}
+
 	void start() {
 		boost::function<void ()> func = boost::bind(&AcceptLoadBalancer<Server>::mainLoop, this);
 		thread = new oxt::thread(boost::bind(runAndPrintExceptions, func, true),
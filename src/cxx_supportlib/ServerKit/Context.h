@@ -33,6 +33,8 @@
 #include <MemoryKit/mbuf.h>
 #include <SafeLibev.h>
 #include <Constants.h>
+#include <ServerKit/TimerWheel.h>
+#include <ServerKit/MemoryReclaimer.h>
 #include <Utils/StrIntUtils.h>
 #include <Utils/JsonUtils.h>
 
@@ -64,51 +66,89 @@ struct FileBufferedChannelConfig {
 
 class Context {
 private:
+	struct SpareMbufBlocks {
+		ReclaimableResource resource;
+		Context *context;
+		struct MemoryKit::mbuf_pool *pool;
+	};
+
+	SpareMbufBlocks spareMbufBlocks[MBUF_SIZE_CLASS_COUNT];
+
 	void initialize() {
+		static const char *resourceNames[MBUF_SIZE_CLASS_COUNT] = {
+			"small_mbuf_blocks", "mbuf_blocks", "large_mbuf_blocks"
+		};
+
+		small_mbuf_pool.mbuf_block_chunk_size = DEFAULT_SMALL_MBUF_CHUNK_SIZE;
 		mbuf_pool.mbuf_block_chunk_size = DEFAULT_MBUF_CHUNK_SIZE;
-		MemoryKit::mbuf_pool_init(&mbuf_pool);
+		large_mbuf_pool.mbuf_block_chunk_size = DEFAULT_LARGE_MBUF_CHUNK_SIZE;
+		mbuf_pools.pools[MemoryKit::MBUF_SIZE_CLASS_SMALL] = &small_mbuf_pool;
+		mbuf_pools.pools[MemoryKit::MBUF_SIZE_CLASS_MEDIUM] = &mbuf_pool;
+		mbuf_pools.pools[MemoryKit::MBUF_SIZE_CLASS_LARGE] = &large_mbuf_pool;
+		mbufReclamationFloor = DEFAULT_MEMORY_RECLAMATION_MBUF_FLOOR;
+
+		for (unsigned int i = 0; i < MBUF_SIZE_CLASS_COUNT; i++) {
+			SpareMbufBlocks *spare = &spareMbufBlocks[i];
+
+			MemoryKit::mbuf_pool_init(mbuf_pools.pools[i]);
+			spare->context = this;
+			spare->pool = mbuf_pools.pools[i];
+			spare->resource.name = resourceNames[i];
+			spare->resource.userData = spare;
+			spare->resource.getActiveCount = getActiveMbufBlockCount;
+			spare->resource.takePeakActiveCount = takePeakActiveMbufBlockCount;
+			spare->resource.getSpareCount = getSpareMbufBlockCount;
+			spare->resource.release = releaseSpareMbufBlocks;
+			memoryReclaimer.add(&spare->resource);
+		}
 	}
 
-public:
-	SafeLibevPtr libev;
-	struct uv_loop_s *libuv;
-	struct MemoryKit::mbuf_pool mbuf_pool;
-	string secureModePassword;
-	FileBufferedChannelConfig defaultFileBufferedChannelConfig;
+	static unsigned int getActiveMbufBlockCount(ReclaimableResource *resource) {
+		SpareMbufBlocks *spare = static_cast<SpareMbufBlocks *>(resource->userData);
+		return spare->pool->nactive_mbuf_blockq;
+	}
 
-	Context(const SafeLibevPtr &_libev, struct uv_loop_s *_libuv)
-		: libev(_libev),
-		  libuv(_libuv)
-	{
-		initialize();
+	static unsigned int takePeakActiveMbufBlockCount(ReclaimableResource *resource) {
+		SpareMbufBlocks *spare = static_cast<SpareMbufBlocks *>(resource->userData);
+		unsigned int result = spare->pool->peak_nactive_mbuf_blockq;
+		spare->pool->peak_nactive_mbuf_blockq = spare->pool->nactive_mbuf_blockq;
+		return result;
 	}
 
-	Context(struct ev_loop *loop)
-		: libev(boost::make_shared<SafeLibev>(loop))
-	{
-		initialize();
+	static unsigned int getSpareMbufBlockCount(ReclaimableResource *resource) {
+		SpareMbufBlocks *spare = static_cast<SpareMbufBlocks *>(resource->userData);
+		// The floor is expressed in default-sized blocks, so that every
+		// size class keeps the same amount of memory.
+		unsigned int floor = (size_t) spare->context->mbufReclamationFloor
+			* DEFAULT_MBUF_CHUNK_SIZE / spare->pool->mbuf_block_chunk_size;
+		if (spare->pool->nfree_mbuf_blockq > floor) {
+			return spare->pool->nfree_mbuf_blockq - floor;
+		} else {
+			return 0;
+		}
 	}
 
-	~Context() {
-		MemoryKit::mbuf_pool_deinit(&mbuf_pool);
+	static size_t releaseSpareMbufBlocks(ReclaimableResource *resource, unsigned int count) {
+		SpareMbufBlocks *spare = static_cast<SpareMbufBlocks *>(resource->userData);
+		return MemoryKit::mbuf_pool_release(spare->pool, count)
+			* spare->pool->mbuf_block_chunk_size;
 	}
 
-	Json::Value inspectStateAsJson() const {
+	static Json::Value inspectMbufPoolAsJson(const struct MemoryKit::mbuf_pool &pool) {
 		Json::Value doc;
-		Json::Value mbufDoc;
-
-		mbufDoc["free_blocks"] = (Json::UInt) mbuf_pool.nfree_mbuf_blockq;
-		mbufDoc["active_blocks"] = (Json::UInt) mbuf_pool.nactive_mbuf_blockq;
-		mbufDoc["chunk_size"] = (Json::UInt) mbuf_pool.mbuf_block_chunk_size;
-		mbufDoc["offset"] = (Json::UInt) mbuf_pool.mbuf_block_offset;
-		mbufDoc["spare_memory"] = byteSizeToJson(mbuf_pool.nfree_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
-		mbufDoc["active_memory"] = byteSizeToJson(mbuf_pool.nactive_mbuf_blockq
-			* mbuf_pool.mbuf_block_chunk_size);
+
+		doc["free_blocks"] = (Json::UInt) pool.nfree_mbuf_blockq;
+		doc["active_blocks"] = (Json::UInt) pool.nactive_mbuf_blockq;
+		doc["chunk_size"] = (Json::UInt) pool.mbuf_block_chunk_size;
+		doc["offset"] = (Json::UInt) pool.mbuf_block_offset;
+		doc["spare_memory"] = byteSizeToJson(pool.nfree_mbuf_blockq
+			* pool.mbuf_block_chunk_size);
+		doc["active_memory"] = byteSizeToJson(pool.nactive_mbuf_blockq
+			* pool.mbuf_block_chunk_size);
 		#ifdef MBUF_ENABLE_DEBUGGING
 			struct MemoryKit::active_mbuf_block_list *list =
 				const_cast<struct MemoryKit::active_mbuf_block_list *>(
-					&mbuf_pool.active_mbuf_blockq);
+					&pool.active_mbuf_blockq);
 			struct MemoryKit::mbuf_block *block;
 			Json::Value listJson(Json::arrayValue);
 
@@ -123,10 +163,62 @@ public:
 				#endif
 				listJson.append(blockJson);
 			}
-			mbufDoc["active_blocks_list"] = listJson;
+			doc["active_blocks_list"] = listJson;
 		#endif
 
-		doc["mbuf_pool"] = mbufDoc;
+		return doc;
+	}
+
+public:
+	SafeLibevPtr libev;
+	struct uv_loop_s *libuv;
+	/** The default (medium) size class. Use this one unless you read data of unknown size. */
+	struct MemoryKit::mbuf_pool mbuf_pool;
+	struct MemoryKit::mbuf_pool small_mbuf_pool;
+	struct MemoryKit::mbuf_pool large_mbuf_pool;
+	/** All of the above, indexed by MemoryKit::mbuf_size_class. */
+	struct MemoryKit::mbuf_pool_set mbuf_pools;
+	string secureModePassword;
+	FileBufferedChannelConfig defaultFileBufferedChannelConfig;
+	TimerWheel timerWheel;
+	MemoryReclaimer memoryReclaimer;
+	/**
+	 * The number of free mbuf blocks that memoryReclaimer always keeps, in
+	 * blocks of the default size class.
+	 */
+	unsigned int mbufReclamationFloor;
+
+	Context(const SafeLibevPtr &_libev, struct uv_loop_s *_libuv)
+		: libev(_libev),
+		  libuv(_libuv),
+		  timerWheel(_libev->getLoop()),
+		  memoryReclaimer(_libev->getLoop())
+	{
+		initialize();
+	}
+
+	Context(struct ev_loop *loop)
+		: libev(boost::make_shared<SafeLibev>(loop)),
+		  timerWheel(loop),
+		  memoryReclaimer(loop)
+	{
+		initialize();
+	}
+
+	~Context() {
+		for (unsigned int i = 0; i < MBUF_SIZE_CLASS_COUNT; i++) {
+			MemoryKit::mbuf_pool_deinit(mbuf_pools.pools[i]);
+		}
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+
+		doc["mbuf_pool"] = inspectMbufPoolAsJson(mbuf_pool);
+		doc["small_mbuf_pool"] = inspectMbufPoolAsJson(small_mbuf_pool);
+		doc["large_mbuf_pool"] = inspectMbufPoolAsJson(large_mbuf_pool);
+		doc["timer_wheel"] = timerWheel.inspectStateAsJson();
+		doc["memory_reclamation"] = memoryReclaimer.inspectStateAsJson();
 
 		return doc;
 	}
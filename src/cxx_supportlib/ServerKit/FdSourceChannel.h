@@ -46,6 +46,7 @@ class FdSourceChannel: protected Channel {
 private:
 	ev_io watcher;
 	MemoryKit::mbuf buffer;
+	MemoryKit::mbuf_size_class_tracker sizeClassTracker;
 
 	static void _onReadable(EV_P_ ev_io *io, int revents) {
 		static_cast<FdSourceChannel *>(io->data)->onReadable(io, revents);
@@ -72,8 +73,20 @@ private:
 		}
 
 		for (i = 0; i < burstReadCount && !done; i++) {
+			if (!buffer.empty()) {
+				struct MemoryKit::mbuf_pool *pool =
+					ctx->mbuf_pools.pools[sizeClassTracker.size_class];
+				// Don't keep reading into the remainder of a smaller block
+				// when the recent reads call for a larger one.
+				if (buffer.mbuf_block->pool != pool
+				 && buffer.size() < MemoryKit::mbuf_pool_data_size(pool))
+				{
+					buffer = MemoryKit::mbuf();
+				}
+			}
 			if (buffer.empty()) {
-				buffer = MemoryKit::mbuf_get(&ctx->mbuf_pool);
+				buffer = MemoryKit::mbuf_get(
+					ctx->mbuf_pools.pools[sizeClassTracker.size_class]);
 			}
 
 			origBufferSize = buffer.size();
@@ -81,6 +94,8 @@ private:
 				ret = ::read(watcher.fd, buffer.start, buffer.size());
 			} while (OXT_UNLIKELY(ret == -1 && errno == EINTR));
 			if (ret > 0) {
+				MemoryKit::mbuf_size_class_tracker_update(&sizeClassTracker,
+					&ctx->mbuf_pools, ret, origBufferSize);
 				MemoryKit::mbuf buffer2(buffer, 0, ret);
 				if (size_t(ret) == size_t(buffer.size())) {
 					// Unref mbuf_block
@@ -138,6 +153,8 @@ private:
 		watcher.active = false;
 		watcher.fd = -1;
 		watcher.data = this;
+		MemoryKit::mbuf_size_class_tracker_init(&sizeClassTracker,
+			MemoryKit::MBUF_SIZE_CLASS_SMALL);
 	}
 
 public:
@@ -168,6 +185,8 @@ public:
 	void reinitialize(int fd) {
 		Channel::reinitialize();
 		ev_io_init(&watcher, _onReadable, fd, EV_READ);
+		MemoryKit::mbuf_size_class_tracker_init(&sizeClassTracker,
+			MemoryKit::MBUF_SIZE_CLASS_SMALL);
 	}
 
 	void deinitialize() {
@@ -241,6 +260,7 @@ public:
 		Json::Value doc = Channel::inspectAsJson();
 		doc["initialized"] = watcher.fd != -1;
 		doc["io_watcher_active"] = (bool) watcher.active;
+		doc["mbuf_size_class"] = sizeClassTracker.size_class;
 		return doc;
 	}
 };
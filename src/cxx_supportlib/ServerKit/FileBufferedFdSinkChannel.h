@@ -219,6 +219,16 @@ public:
 		return FileBufferedChannel::ended();
 	}
 
+	/**
+	 * Whether all data fed so far has been written to the file descriptor,
+	 * so that data may be written to it directly without reordering.
+	 */
+	OXT_FORCE_INLINE
+	bool flushed() const {
+		return FileBufferedChannel::getReaderState() == FileBufferedChannel::RS_INACTIVE
+			&& FileBufferedChannel::getTotalBytesBuffered() == 0;
+	}
+
 	OXT_FORCE_INLINE
 	bool endAcked() const {
 		return FileBufferedChannel::endAcked();
@@ -68,7 +68,7 @@ struct Header {
  *
  * The hash table automatically doubles in size when it becomes 75% full.
  * The hash table never shrinks in size, even after clear(), unless you explicitly call
- * compact(). This allows you to reuse hash table memory over multiple requests.
+ * compact() or shrink(). This allows you to reuse hash table memory over multiple requests.
  *
  * This implementation is based on https://github.com/preshing/CompareIntegerMaps.
  * See also http://preshing.com/20130107/this-hash-table-is-faster-than-a-judy-array
@@ -309,8 +309,8 @@ public:
 		Header *header = (Header *) psg_palloc(pool, sizeof(Header));
 
 		char *downcasedName = (char *) psg_pnalloc(pool, name.size());
-		convertLowerCase((const unsigned char *) name.data(),
-			(unsigned char *) downcasedName, name.size());
+		Hasher hasher;
+		hasher.updateWithLowerCase(name.data(), downcasedName, name.size());
 		psg_lstr_init(&header->key);
 		psg_lstr_append(&header->key, pool, downcasedName, name.size());
 
@@ -320,7 +320,7 @@ public:
 		psg_lstr_init(&header->val);
 		psg_lstr_append(&header->val, pool, value.data(), value.size());
 
-		header->hash = HashedStaticString(downcasedName, name.size()).hash();
+		header->hash = hasher.finalize();
 		insert(&header, pool);
 		return header;
 	}
@@ -391,6 +391,22 @@ public:
 		repopulate(upper_power_of_two((m_population * 4 + 3) / 3));
 	}
 
+	/**
+	 * Shrinks the array back to `size` cells if it has grown beyond that,
+	 * and if the current elements fit. `size` must be a power of 2.
+	 * Returns the number of bytes freed.
+	 */
+	size_t shrink(unsigned int size) {
+		size_t result;
+
+		if (m_arraySize <= size || m_population * 4 > size * 3) {
+			return 0;
+		}
+		result = (m_arraySize - size) * sizeof(Cell);
+		repopulate(size);
+		return result;
+	}
+
 	unsigned int size() const {
 		return m_population;
 	}
@@ -29,6 +29,7 @@
 #include <psg_sysqueue.h>
 #include <ServerKit/Client.h>
 #include <ServerKit/HttpRequest.h>
+#include <ServerKit/TimerWheel.h>
 
 namespace Passenger {
 namespace ServerKit {
@@ -40,6 +41,16 @@ public:
 	typedef Request RequestType;
 	LIST_HEAD(RequestList, Request);
 
+	enum TimeoutType {
+		NO_TIMEOUT,
+		/** Waiting for the next request on a kept-alive connection. */
+		KEEP_ALIVE_TIMEOUT,
+		/** Waiting for the rest of the request header. */
+		REQUEST_HEADER_TIMEOUT,
+		/** Waiting for more request body data. */
+		REQUEST_BODY_TIMEOUT
+	};
+
 	/**
 	 * @invariant
 	 *     if currentRequest != NULL:
@@ -48,11 +59,15 @@ public:
 	 */
 	Request *currentRequest;
 	unsigned int requestsBegun;
+	/** Armed in the context's TimerWheel while `timeoutType != NO_TIMEOUT`. */
+	Timer timeoutTimer;
+	TimeoutType timeoutType;
 
 	BaseHttpClient(void *server)
 		: BaseClient(server),
 		  currentRequest(NULL),
-		  requestsBegun(0)
+		  requestsBegun(0),
+		  timeoutType(NO_TIMEOUT)
 		{ }
 };
 
@@ -169,13 +169,16 @@ public:
 	 */
 	int nextRequestEarlyReadError;
 
+	static const unsigned int HEADER_TABLE_SIZE = 16;
+	static const unsigned int SECURE_HEADER_TABLE_SIZE = 32;
+
 
 	BaseHttpRequest()
 		: refcount(1),
 		  client(NULL),
 		  pool(NULL),
-		  headers(16),
-		  secureHeaders(32),
+		  headers(HEADER_TABLE_SIZE),
+		  secureHeaders(SECURE_HEADER_TABLE_SIZE),
 		  bodyAlreadyRead(0)
 	{
 		psg_lstr_init(&path);
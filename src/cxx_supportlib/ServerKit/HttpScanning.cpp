@@ -0,0 +1,299 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+// Implementation is in its own file so that we can enable compiler optimizations for these functions only.
+
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <ServerKit/HttpScanning.h>
+
+#if defined(__x86_64__) && (defined(__clang__) || __GNUC__ >= 5)
+	// Older compilers can't compile intrinsics for instruction sets
+	// that haven't been enabled for the entire file.
+	#define PASSENGER_HTTP_SCANNING_X86_64
+	#include <immintrin.h>
+#endif
+
+namespace Passenger {
+namespace ServerKit {
+
+using namespace std;
+
+
+namespace {
+
+typedef const char *(*ScanFunction)(const char *begin, const char *end);
+
+struct Implementation {
+	const char *name;
+	bool (*isSupported)();
+	ScanFunction findCrOrLf;
+	ScanFunction findNonTokenChar;
+};
+
+/*
+ * `tokenChars` must match the `tokens` table in http_parser.cpp (in strict
+ * mode). For the vectorized implementations, the same set is encoded as two
+ * 16-byte tables that are indexed by the low and the high nibble of a byte
+ * respectively, so that they can be looked up with a byte shuffle. A byte
+ * is a token character if
+ * `(lowNibbleTable[byte & 0xf] & highNibbleTable[byte >> 4]) != 0`.
+ */
+struct CharClasses {
+	bool tokenChars[256];
+	boost::uint8_t lowNibbleTable[16];
+	boost::uint8_t highNibbleTable[16];
+
+	CharClasses() {
+		static const char SYMBOLS[] = "!#$%&'*+-.^_`|~";
+		unsigned int i;
+
+		memset(tokenChars, 0, sizeof(tokenChars));
+		for (i = '0'; i <= '9'; i++) {
+			tokenChars[i] = true;
+		}
+		for (i = 'a'; i <= 'z'; i++) {
+			tokenChars[i] = true;
+			tokenChars[i - 'a' + 'A'] = true;
+		}
+		for (i = 0; i < sizeof(SYMBOLS) - 1; i++) {
+			tokenChars[(unsigned char) SYMBOLS[i]] = true;
+		}
+
+		// Only ASCII characters can be token characters, so the high
+		// nibble can be mapped to a single bit.
+		for (i = 0; i < 16; i++) {
+			lowNibbleTable[i] = 0;
+			highNibbleTable[i] = (i < 8) ? (1 << i) : 0;
+		}
+		for (i = 0; i < 128; i++) {
+			if (tokenChars[i]) {
+				lowNibbleTable[i & 0xf] |= 1 << (i >> 4);
+			}
+		}
+	}
+};
+
+const CharClasses charClasses;
+
+
+/***** Generic implementation *****/
+
+bool
+genericIsSupported() {
+	return true;
+}
+
+const char *
+findCrOrLfGeneric(const char *begin, const char *end) {
+	while (begin < end && *begin != '\r' && *begin != '\n') {
+		begin++;
+	}
+	return begin;
+}
+
+const char *
+findNonTokenCharGeneric(const char *begin, const char *end) {
+	while (begin < end && charClasses.tokenChars[(unsigned char) *begin]) {
+		begin++;
+	}
+	return begin;
+}
+
+
+#ifdef PASSENGER_HTTP_SCANNING_X86_64
+
+/***** SSSE3 implementation: 16 bytes at a time *****/
+
+bool
+ssse3IsSupported() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3");
+}
+
+__attribute__((target("ssse3")))
+const char *
+findCrOrLfSsse3(const char *begin, const char *end) {
+	const __m128i cr = _mm_set1_epi8('\r');
+	const __m128i lf = _mm_set1_epi8('\n');
+
+	while (end - begin >= 16) {
+		__m128i data = _mm_loadu_si128((const __m128i *) begin);
+		int mask = _mm_movemask_epi8(_mm_or_si128(
+			_mm_cmpeq_epi8(data, cr),
+			_mm_cmpeq_epi8(data, lf)));
+		if (mask != 0) {
+			return begin + __builtin_ctz(mask);
+		}
+		begin += 16;
+	}
+	return findCrOrLfGeneric(begin, end);
+}
+
+__attribute__((target("ssse3")))
+const char *
+findNonTokenCharSsse3(const char *begin, const char *end) {
+	const __m128i lowNibbleTable = _mm_loadu_si128(
+		(const __m128i *) charClasses.lowNibbleTable);
+	const __m128i highNibbleTable = _mm_loadu_si128(
+		(const __m128i *) charClasses.highNibbleTable);
+	const __m128i nibbleMask = _mm_set1_epi8(0x0f);
+	const __m128i zero = _mm_setzero_si128();
+
+	while (end - begin >= 16) {
+		__m128i data = _mm_loadu_si128((const __m128i *) begin);
+		__m128i lowBits = _mm_shuffle_epi8(lowNibbleTable,
+			_mm_and_si128(data, nibbleMask));
+		__m128i highBits = _mm_shuffle_epi8(highNibbleTable,
+			_mm_and_si128(_mm_srli_epi16(data, 4), nibbleMask));
+		int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+			_mm_and_si128(lowBits, highBits), zero));
+		if (mask != 0) {
+			return begin + __builtin_ctz(mask);
+		}
+		begin += 16;
+	}
+	return findNonTokenCharGeneric(begin, end);
+}
+
+
+/***** AVX2 implementation: 32 bytes at a time *****/
+
+bool
+avx2IsSupported() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("avx2")))
+const char *
+findCrOrLfAvx2(const char *begin, const char *end) {
+	const __m256i cr = _mm256_set1_epi8('\r');
+	const __m256i lf = _mm256_set1_epi8('\n');
+
+	while (end - begin >= 32) {
+		__m256i data = _mm256_loadu_si256((const __m256i *) begin);
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_or_si256(
+			_mm256_cmpeq_epi8(data, cr),
+			_mm256_cmpeq_epi8(data, lf)));
+		if (mask != 0) {
+			return begin + __builtin_ctz(mask);
+		}
+		begin += 32;
+	}
+	return findCrOrLfSsse3(begin, end);
+}
+
+__attribute__((target("avx2")))
+const char *
+findNonTokenCharAvx2(const char *begin, const char *end) {
+	// _mm256_shuffle_epi8 shuffles within each 128-bit lane,
+	// so both lanes need a copy of the tables.
+	const __m256i lowNibbleTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+		(const __m128i *) charClasses.lowNibbleTable));
+	const __m256i highNibbleTable = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+		(const __m128i *) charClasses.highNibbleTable));
+	const __m256i nibbleMask = _mm256_set1_epi8(0x0f);
+	const __m256i zero = _mm256_setzero_si256();
+
+	while (end - begin >= 32) {
+		__m256i data = _mm256_loadu_si256((const __m256i *) begin);
+		__m256i lowBits = _mm256_shuffle_epi8(lowNibbleTable,
+			_mm256_and_si256(data, nibbleMask));
+		__m256i highBits = _mm256_shuffle_epi8(highNibbleTable,
+			_mm256_and_si256(_mm256_srli_epi16(data, 4), nibbleMask));
+		unsigned int mask = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+			_mm256_and_si256(lowBits, highBits), zero));
+		if (mask != 0) {
+			return begin + __builtin_ctz(mask);
+		}
+		begin += 32;
+	}
+	return findNonTokenCharSsse3(begin, end);
+}
+
+#endif /* PASSENGER_HTTP_SCANNING_X86_64 */
+
+
+// In order of preference.
+const Implementation implementations[] = {
+	#ifdef PASSENGER_HTTP_SCANNING_X86_64
+		{ "avx2", avx2IsSupported, findCrOrLfAvx2, findNonTokenCharAvx2 },
+		{ "ssse3", ssse3IsSupported, findCrOrLfSsse3, findNonTokenCharSsse3 },
+	#endif
+	{ "generic", genericIsSupported, findCrOrLfGeneric, findNonTokenCharGeneric }
+};
+
+const unsigned int NUM_IMPLEMENTATIONS = sizeof(implementations) / sizeof(Implementation);
+
+const Implementation *
+selectBestImplementation() {
+	for (unsigned int i = 0; i < NUM_IMPLEMENTATIONS; i++) {
+		if (implementations[i].isSupported()) {
+			return &implementations[i];
+		}
+	}
+	return &implementations[NUM_IMPLEMENTATIONS - 1];
+}
+
+const Implementation *implementation = selectBestImplementation();
+
+} // anonymous namespace
+
+
+const char *
+httpFindCrOrLf(const char *begin, const char *end) {
+	return implementation->findCrOrLf(begin, end);
+}
+
+const char *
+httpFindNonTokenChar(const char *begin, const char *end) {
+	return implementation->findNonTokenChar(begin, end);
+}
+
+const char *
+getHttpScanningImplementation() {
+	return implementation->name;
+}
+
+bool
+setHttpScanningImplementation(const StaticString &name) {
+	for (unsigned int i = 0; i < NUM_IMPLEMENTATIONS; i++) {
+		if (name == implementations[i].name) {
+			if (implementations[i].isSupported()) {
+				implementation = &implementations[i];
+				return true;
+			} else {
+				return false;
+			}
+		}
+	}
+	return false;
+}
+
+
+} // namespace ServerKit
+} // namespace Passenger
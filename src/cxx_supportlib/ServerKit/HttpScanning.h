@@ -0,0 +1,76 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_HTTP_SCANNING_H_
+#define _PASSENGER_SERVER_KIT_HTTP_SCANNING_H_
+
+#include <StaticString.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+/*
+ * Functions for skipping over runs of uninteresting bytes in HTTP headers,
+ * used by http_parser's header field and header value states so that they
+ * don't have to go through their state machine for every byte.
+ *
+ * There are several implementations: a generic one, and vectorized ones
+ * for x86_64 CPUs that support SSSE3 or AVX2. The best implementation that
+ * the CPU supports is selected at startup. All implementations produce
+ * identical results.
+ */
+
+/**
+ * Returns a pointer to the first CR or LF byte in [begin, end), or `end`
+ * if there is none.
+ */
+const char *httpFindCrOrLf(const char *begin, const char *end);
+
+/**
+ * Returns a pointer to the first byte in [begin, end) that is not an HTTP
+ * token character (as defined by RFC 2616 section 2.2, and as accepted by
+ * http_parser in header names), or `end` if there is none.
+ */
+const char *httpFindNonTokenChar(const char *begin, const char *end);
+
+/**
+ * Returns the name of the selected implementation:
+ * "generic", "ssse3" or "avx2".
+ */
+const char *getHttpScanningImplementation();
+
+/**
+ * Selects an implementation by name. Returns false if the CPU doesn't
+ * support it. Only meant for tests and benchmarks: this function is not
+ * thread-safe with respect to the scanning functions.
+ */
+bool setHttpScanningImplementation(const StaticString &name);
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_HTTP_SCANNING_H_ */
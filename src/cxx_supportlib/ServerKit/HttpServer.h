@@ -58,6 +58,9 @@ using namespace boost;
 
 extern const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[];
 extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
+extern const HashedStaticString HTTP_CONTENT_TYPE;
+extern const HashedStaticString HTTP_DATE;
+extern const HashedStaticString HTTP_CONNECTION;
 
 
 template< typename DerivedServer, typename Client = HttpClient<HttpRequest> >
@@ -69,7 +72,11 @@ public:
 
 	FreeRequestList freeRequests;
 	unsigned int freeRequestCount, requestFreelistLimit;
+	// Client timeouts in seconds. 0 means no timeout.
+	unsigned int keepAliveTimeout, requestHeaderTimeout, requestBodyTimeout;
 	unsigned long totalRequestsBegun, lastTotalRequestsBegun;
+	unsigned long totalKeepAliveTimeouts, totalRequestHeaderTimeouts,
+		totalRequestBodyTimeouts;
 	double requestBeginSpeed1m, requestBeginSpeed1h;
 
 private:
@@ -106,6 +113,8 @@ private:
 
 	RequestHooksImpl requestHooksImpl;
 	object_pool<HttpHeaderParserState> headerParserStatePool;
+	ReclaimableResource spareRequests, requestHeaderTables;
+	unsigned int activeRequestCount, reclamationPeakActiveRequestCount;
 
 
 	/***** Request object creation and destruction *****/
@@ -154,6 +163,8 @@ private:
 		assert(client->lingeringRequestCount > 0);
 		client->lingeringRequestCount--;
 		request->client = NULL;
+		assert(activeRequestCount > 0);
+		activeRequestCount--;
 
 		if (addRequestToFreelist(request)) {
 			SKC_TRACE(client, 3, "Request object added to freelist (" <<
@@ -254,7 +265,85 @@ private:
 
 		client->currentRequest = req = checkoutRequestObject(client);
 		req->client = client;
+		activeRequestCount++;
+		reclamationPeakActiveRequestCount = std::max(reclamationPeakActiveRequestCount,
+			activeRequestCount);
 		reinitializeRequest(client, req);
+
+		if (client->requestsBegun == 0) {
+			armClientTimeout(client, Client::REQUEST_HEADER_TIMEOUT, requestHeaderTimeout);
+		} else {
+			armClientTimeout(client, Client::KEEP_ALIVE_TIMEOUT, keepAliveTimeout);
+		}
+	}
+
+
+	/***** Client timeouts *****/
+
+	void armClientTimeout(Client *client, typename Client::TimeoutType type,
+		unsigned int timeout)
+	{
+		if (timeout == 0) {
+			cancelClientTimeout(client);
+		} else {
+			client->timeoutType = type;
+			this->getContext()->timerWheel.arm(&client->timeoutTimer, timeout);
+		}
+	}
+
+	void cancelClientTimeout(Client *client) {
+		if (client->timeoutType != Client::NO_TIMEOUT) {
+			client->timeoutType = Client::NO_TIMEOUT;
+			this->getContext()->timerWheel.cancel(&client->timeoutTimer);
+		}
+	}
+
+	void rearmRequestBodyTimeout(Client *client, Request *req) {
+		// Upgraded connections may legitimately be idle for a long time.
+		if (req->bodyType != Request::RBT_UPGRADE) {
+			armClientTimeout(client, Client::REQUEST_BODY_TIMEOUT, requestBodyTimeout);
+		}
+	}
+
+	static void _onClientTimeout(Timer *timer) {
+		Client *client = static_cast<Client *>(static_cast<BaseClient *>(
+			timer->userData));
+		HttpServer *self = static_cast<HttpServer *>(HttpServer::getServerFromClient(client));
+		self->onClientTimeout(client);
+	}
+
+	void onClientTimeout(Client *client) {
+		SKC_LOG_EVENT(HttpServer, client, "onClientTimeout");
+		typename Client::TimeoutType type = client->timeoutType;
+
+		client->timeoutType = Client::NO_TIMEOUT;
+		switch (type) {
+		case Client::KEEP_ALIVE_TIMEOUT:
+			SKC_DEBUG(client, "Keep-alive timeout reached; disconnecting client");
+			totalKeepAliveTimeouts++;
+			this->disconnect(&client);
+			break;
+		case Client::REQUEST_HEADER_TIMEOUT:
+			totalRequestHeaderTimeouts++;
+			this->disconnectWithError(&client, "timed out while receiving request header",
+				LVL_INFO);
+			break;
+		case Client::REQUEST_BODY_TIMEOUT:
+			if (!client->currentRequest->bodyChannel.isStarted()) {
+				// We aren't reading the body right now (e.g. because we're
+				// still waiting for an application process), so it's not
+				// the client that is slow.
+				armClientTimeout(client, Client::REQUEST_BODY_TIMEOUT, requestBodyTimeout);
+				break;
+			}
+			totalRequestBodyTimeouts++;
+			this->disconnectWithError(&client, "timed out while receiving request body",
+				LVL_INFO);
+			break;
+		default:
+			P_BUG("Invalid client timeout type " << (int) type);
+			break;
+		}
 	}
 
 
@@ -281,6 +370,7 @@ private:
 			SKC_TRACE(client, 2, "New request received: #" << (totalRequestsBegun + 1));
 			headerParserStatePool.destroy(req->parserState.headerParser);
 			req->parserState.headerParser = NULL;
+			cancelClientTimeout(client);
 
 			if (HttpServer::serverState == HttpServer::SHUTTING_DOWN
 			 && shouldDisconnectClientOnShutdown(client))
@@ -296,11 +386,13 @@ private:
 				return Channel::Result(ret, false);
 			case Request::PARSING_BODY:
 				SKC_TRACE(client, 2, "Expecting a request body");
+				rearmRequestBodyTimeout(client, req);
 				onRequestBegin(client, req);
 				return Channel::Result(ret, false);
 			case Request::PARSING_CHUNKED_BODY:
 				SKC_TRACE(client, 2, "Expecting a chunked request body");
 				prepareChunkedBodyParsing(client, req);
+				rearmRequestBodyTimeout(client, req);
 				onRequestBegin(client, req);
 				return Channel::Result(ret, false);
 			case Request::UPGRADED:
@@ -341,6 +433,7 @@ private:
 			if (!req->bodyChannel.acceptingInput()) {
 				if (req->bodyChannel.mayAcceptInputLater()) {
 					client->input.stop();
+					cancelClientTimeout(client);
 					req->bodyChannel.consumedCallback =
 						onRequestBodyChannelConsumed;
 					return Channel::Result(0, false);
@@ -368,12 +461,16 @@ private:
 			if (req->bodyChannel.acceptingInput()) {
 				if (req->bodyFullyRead()) {
 					SKC_TRACE(client, 2, "End of request body reached");
+					cancelClientTimeout(client);
 					req->detectingNextRequestEarlyReadError = true;
 					req->bodyChannel.feed(MemoryKit::mbuf());
+				} else {
+					rearmRequestBodyTimeout(client, req);
 				}
 				return Channel::Result(remaining, false);
 			} else if (req->bodyChannel.mayAcceptInputLater()) {
 				client->input.stop();
+				cancelClientTimeout(client);
 				req->bodyChannel.consumedCallback =
 					onRequestBodyChannelConsumed;
 				return Channel::Result(remaining, false);
@@ -405,6 +502,7 @@ private:
 			if (!req->bodyChannel.acceptingInput()) {
 				if (req->bodyChannel.mayAcceptInputLater()) {
 					client->input.stop();
+					cancelClientTimeout(client);
 					req->bodyChannel.consumedCallback =
 						onRequestBodyChannelConsumed;
 					return Channel::Result(0, false);
@@ -419,15 +517,18 @@ private:
 			switch (event.type) {
 			case HttpChunkedEvent::NONE:
 				assert(!event.end);
+				rearmRequestBodyTimeout(client, req);
 				return Channel::Result(event.consumed, false);
 			case HttpChunkedEvent::DATA:
 				assert(!event.end);
 				req->bodyChannel.feed(event.data);
 				if (!req->ended()) {
 					if (req->bodyChannel.acceptingInput()) {
+						rearmRequestBodyTimeout(client, req);
 						return Channel::Result(event.consumed, false);
 					} else if (req->bodyChannel.mayAcceptInputLater()) {
 						client->input.stop();
+						cancelClientTimeout(client);
 						req->bodyChannel.consumedCallback = onRequestBodyChannelConsumed;
 						return Channel::Result(event.consumed, false);
 					} else {
@@ -438,6 +539,7 @@ private:
 				}
 			case HttpChunkedEvent::END:
 				assert(event.end);
+				cancelClientTimeout(client);
 				req->detectingNextRequestEarlyReadError = true;
 				req->aux.bodyInfo.endChunkReached = true;
 				req->bodyChannel.feed(MemoryKit::mbuf());
@@ -445,6 +547,7 @@ private:
 			case HttpChunkedEvent::ERROR:
 				assert(event.end);
 				client->input.stop();
+				cancelClientTimeout(client);
 				req->wantKeepAlive = false;
 				req->bodyChannel.feedError(event.errcode);
 				return Channel::Result(event.consumed, true);
@@ -476,6 +579,7 @@ private:
 			if (!req->bodyChannel.acceptingInput()) {
 				if (req->bodyChannel.mayAcceptInputLater()) {
 					client->input.stop();
+					cancelClientTimeout(client);
 					req->bodyChannel.consumedCallback =
 						onRequestBodyChannelConsumed;
 					return Channel::Result(0, false);
@@ -656,6 +760,7 @@ private:
 				req->bodyChannel.feed(MemoryKit::mbuf());
 			} else {
 				client->input.start();
+				self->rearmRequestBodyTimeout(client, req);
 			}
 		}
 	}
@@ -694,6 +799,8 @@ protected:
 	virtual void onClientObjectCreated(Client *client) {
 		ParentClass::onClientObjectCreated(client);
 		client->output.setDataFlushedCallback(_onClientOutputDataFlushed);
+		client->timeoutTimer.callback = _onClientTimeout;
+		client->timeoutTimer.userData = static_cast<BaseClient *>(client);
 	}
 
 	virtual void onClientAccepted(Client *client) {
@@ -714,6 +821,11 @@ protected:
 		if (!ended) {
 			req->lastDataReceiveTime = ev_now(this->getLoop());
 		}
+		if (client->timeoutType == Client::KEEP_ALIVE_TIMEOUT && !buffer.empty()) {
+			// The next request has begun, so the client has to send the
+			// rest of its header within the header timeout.
+			armClientTimeout(client, Client::REQUEST_HEADER_TIMEOUT, requestHeaderTimeout);
+		}
 		if (detectNextRequestEarlyReadError(client, req, buffer, errcode)) {
 			return Channel::Result(0, false);
 		}
@@ -755,6 +867,7 @@ protected:
 
 	virtual void onClientDisconnecting(Client *client) {
 		ParentClass::onClientDisconnecting(client);
+		cancelClientTimeout(client);
 
 		// Handle client being disconnect()'ed without endRequest().
 
@@ -918,6 +1031,75 @@ protected:
 	}
 
 
+	/***** Memory reclamation *****/
+
+	static unsigned int getActiveRequestCount(ReclaimableResource *resource) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		return self->activeRequestCount;
+	}
+
+	static unsigned int takePeakActiveRequestCount(ReclaimableResource *resource) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		unsigned int result = self->reclamationPeakActiveRequestCount;
+		self->reclamationPeakActiveRequestCount = self->activeRequestCount;
+		return result;
+	}
+
+	// Every spare client object will need a request object, so
+	// minSpareClients is the floor for spare request objects too.
+	static unsigned int getSpareRequestCount(ReclaimableResource *resource) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		if (self->freeRequestCount > self->minSpareClients) {
+			return self->freeRequestCount - self->minSpareClients;
+		} else {
+			return 0;
+		}
+	}
+
+	static size_t releaseSpareRequests(ReclaimableResource *resource, unsigned int count) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		// Spare request objects usually hold on to a memory pool.
+		return self->freeRequestObjects(count) * (sizeof(Request) + PSG_DEFAULT_POOL_SIZE);
+	}
+
+	static bool headerTablesHaveGrown(const Request *req) {
+		return req->headers.arraySize() > Request::HEADER_TABLE_SIZE
+			|| req->secureHeaders.arraySize() > Request::SECURE_HEADER_TABLE_SIZE;
+	}
+
+	// Header tables of requests on the freelist stay as large as the
+	// largest request they have ever parsed.
+	static unsigned int countGrownHeaderTables(ReclaimableResource *resource) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		Request *req;
+		unsigned int result = 0;
+
+		STAILQ_FOREACH (req, &self->freeRequests, nextRequest.freeRequest) {
+			if (headerTablesHaveGrown(req)) {
+				result++;
+			}
+		}
+		return result;
+	}
+
+	static size_t shrinkGrownHeaderTables(ReclaimableResource *resource, unsigned int count) {
+		HttpServer *self = static_cast<HttpServer *>(resource->userData);
+		Request *req;
+		size_t result = 0;
+
+		STAILQ_FOREACH (req, &self->freeRequests, nextRequest.freeRequest) {
+			if (count == 0) {
+				break;
+			} else if (headerTablesHaveGrown(req)) {
+				result += req->headers.shrink(Request::HEADER_TABLE_SIZE);
+				result += req->secureHeaders.shrink(Request::SECURE_HEADER_TABLE_SIZE);
+				count--;
+			}
+		}
+		return result;
+	}
+
+
 	/***** Misc *****/
 
 	OXT_FORCE_INLINE
@@ -930,13 +1112,40 @@ public:
 		: ParentClass(context),
 		  freeRequestCount(0),
 		  requestFreelistLimit(1024),
+		  keepAliveTimeout(0),
+		  requestHeaderTimeout(0),
+		  requestBodyTimeout(0),
 		  totalRequestsBegun(0),
 		  lastTotalRequestsBegun(0),
+		  totalKeepAliveTimeouts(0),
+		  totalRequestHeaderTimeouts(0),
+		  totalRequestBodyTimeouts(0),
 		  requestBeginSpeed1m(-1),
 		  requestBeginSpeed1h(-1),
-		  headerParserStatePool(16, 256)
+		  headerParserStatePool(16, 256),
+		  activeRequestCount(0),
+		  reclamationPeakActiveRequestCount(0)
 	{
 		STAILQ_INIT(&freeRequests);
+
+		spareRequests.name = "spare_requests";
+		spareRequests.userData = this;
+		spareRequests.getActiveCount = getActiveRequestCount;
+		spareRequests.takePeakActiveCount = takePeakActiveRequestCount;
+		spareRequests.getSpareCount = getSpareRequestCount;
+		spareRequests.release = releaseSpareRequests;
+		context->memoryReclaimer.add(&spareRequests);
+
+		requestHeaderTables.name = "request_header_tables";
+		requestHeaderTables.userData = this;
+		requestHeaderTables.getSpareCount = countGrownHeaderTables;
+		requestHeaderTables.release = shrinkGrownHeaderTables;
+		context->memoryReclaimer.add(&requestHeaderTables);
+	}
+
+	~HttpServer() {
+		this->getContext()->memoryReclaimer.remove(&spareRequests);
+		this->getContext()->memoryReclaimer.remove(&requestHeaderTables);
 	}
 
 
@@ -944,9 +1153,21 @@ public:
 
 	virtual void compact(int logLevel = LVL_NOTICE) {
 		ParentClass::compact();
-		unsigned int count = freeRequestCount;
+		unsigned int count = freeRequestObjects(freeRequestCount);
+		assert(freeRequestCount == 0);
 
-		while (!STAILQ_EMPTY(&freeRequests)) {
+		SKS_LOG(logLevel, __FILE__, __LINE__,
+			"Freed " << count << " spare request objects");
+	}
+
+	/**
+	 * Destroys at most `max` request objects on the freelist. Returns the
+	 * number of objects that were destroyed.
+	 */
+	unsigned int freeRequestObjects(unsigned int max) {
+		unsigned int count = 0;
+
+		while (count < max && !STAILQ_EMPTY(&freeRequests)) {
 			Request *request = STAILQ_FIRST(&freeRequests);
 			if (request->pool != NULL) {
 				psg_destroy_pool(request->pool);
@@ -956,11 +1177,10 @@ public:
 			freeRequestCount--;
 			STAILQ_REMOVE_HEAD(&freeRequests, nextRequest.freeRequest);
 			delete request;
+			count++;
 		}
-		assert(freeRequestCount == 0);
 
-		SKS_LOG(logLevel, __FILE__, __LINE__,
-			"Freed " << count << " spare request objects");
+		return count;
 	}
 
 
@@ -1048,7 +1268,7 @@ public:
 			"Status: %s\r\n",
 			(int) req->httpMajor, (int) req->httpMinor, status, status);
 
-		value = (headers != NULL) ? headers->lookup(P_STATIC_STRING("content-type")) : NULL;
+		value = (headers != NULL) ? headers->lookup(HTTP_CONTENT_TYPE) : NULL;
 		if (value == NULL) {
 			pos = appendData(pos, end, P_STATIC_STRING("Content-Type: text/html; charset=UTF-8\r\n"));
 		} else {
@@ -1057,7 +1277,7 @@ public:
 			pos = appendData(pos, end, P_STATIC_STRING("\r\n"));
 		}
 
-		value = (headers != NULL) ? headers->lookup(P_STATIC_STRING("date")) : NULL;
+		value = (headers != NULL) ? headers->lookup(HTTP_DATE) : NULL;
 		pos = appendData(pos, end, P_STATIC_STRING("Date: "));
 		if (value == NULL) {
 			time_t the_time = time(NULL);
@@ -1069,7 +1289,7 @@ public:
 		}
 		pos = appendData(pos, end, P_STATIC_STRING("\r\n"));
 
-		value = (headers != NULL) ? headers->lookup(P_STATIC_STRING("connection")) : NULL;
+		value = (headers != NULL) ? headers->lookup(HTTP_CONNECTION) : NULL;
 		if (value == NULL) {
 			if (canKeepAlive(req)) {
 				pos = appendData(pos, end, P_STATIC_STRING("Connection: keep-alive\r\n"));
@@ -1087,7 +1307,7 @@ public:
 			}
 		}
 
-		value = (headers != NULL) ? headers->lookup(P_STATIC_STRING("content-length")) : NULL;
+		value = (headers != NULL) ? headers->lookup(HTTP_CONTENT_LENGTH) : NULL;
 		pos = appendData(pos, end, P_STATIC_STRING("Content-Length: "));
 		if (value == NULL) {
 			pos += snprintf(pos, end - pos, "%u", (unsigned int) body.size());
@@ -1135,6 +1355,7 @@ public:
 
 		SKC_TRACE(c, 2, "Ending request");
 		assert(c->currentRequest == req);
+		cancelClientTimeout(c);
 
 		if (OXT_UNLIKELY(!req->responseBegun)) {
 			writeDefault500Response(c, req);
@@ -1183,11 +1404,23 @@ public:
 		if (doc.isMember("request_freelist_limit")) {
 			requestFreelistLimit = doc["request_freelist_limit"].asUInt();
 		}
+		if (doc.isMember("keep_alive_timeout")) {
+			keepAliveTimeout = doc["keep_alive_timeout"].asUInt();
+		}
+		if (doc.isMember("request_header_timeout")) {
+			requestHeaderTimeout = doc["request_header_timeout"].asUInt();
+		}
+		if (doc.isMember("request_body_timeout")) {
+			requestBodyTimeout = doc["request_body_timeout"].asUInt();
+		}
 	}
 
 	virtual Json::Value getConfigAsJson() const {
 		Json::Value doc = ParentClass::getConfigAsJson();
 		doc["request_freelist_limit"] = requestFreelistLimit;
+		doc["keep_alive_timeout"] = keepAliveTimeout;
+		doc["request_header_timeout"] = requestHeaderTimeout;
+		doc["request_body_timeout"] = requestBodyTimeout;
 		return doc;
 	}
 
@@ -1195,6 +1428,9 @@ public:
 		Json::Value doc = ParentClass::inspectStateAsJson();
 		doc["free_request_count"] = freeRequestCount;
 		doc["total_requests_begun"] = (Json::UInt64) totalRequestsBegun;
+		doc["timed_out_clients"]["keep_alive"] = (Json::UInt64) totalKeepAliveTimeouts;
+		doc["timed_out_clients"]["request_header"] = (Json::UInt64) totalRequestHeaderTimeouts;
+		doc["timed_out_clients"]["request_body"] = (Json::UInt64) totalRequestBodyTimeouts;
 		doc["request_begin_speed"]["1m"] = averageSpeedToJson(
 			capFloatPrecision(requestBeginSpeed1m * 60),
 			"minute", "1 minute", -1);
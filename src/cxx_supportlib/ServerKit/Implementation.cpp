@@ -36,6 +36,9 @@ extern const HashedStaticString HTTP_CONTENT_LENGTH;
 extern const HashedStaticString HTTP_TRANSFER_ENCODING;
 extern const HashedStaticString HTTP_X_SENDFILE;
 extern const HashedStaticString HTTP_X_ACCEL_REDIRECT;
+extern const HashedStaticString HTTP_CONTENT_TYPE;
+extern const HashedStaticString HTTP_DATE;
+extern const HashedStaticString HTTP_CONNECTION;
 extern const char DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE[];
 extern const unsigned int DEFAULT_INTERNAL_SERVER_ERROR_RESPONSE_SIZE;
 
@@ -54,6 +57,9 @@ const HashedStaticString HTTP_CONTENT_LENGTH("content-length");
 const HashedStaticString HTTP_TRANSFER_ENCODING("transfer-encoding");
 const HashedStaticString HTTP_X_SENDFILE("x-sendfile");
 const HashedStaticString HTTP_X_ACCEL_REDIRECT("x-accel-redirect");
+const HashedStaticString HTTP_CONTENT_TYPE("content-type");
+const HashedStaticString HTTP_DATE("date");
+const HashedStaticString HTTP_CONNECTION("connection");
 
 
 } // namespace ServerKit
@@ -0,0 +1,433 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_MEMORY_RECLAIMER_H_
+#define _PASSENGER_SERVER_KIT_MEMORY_RECLAIMER_H_
+
+#include <psg_sysqueue.h>
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <ev++.h>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#ifdef __GLIBC__
+	#include <malloc.h>
+#endif
+#include <jsoncpp/json.h>
+#include <Utils/JsonUtils.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+struct ReclaimableResource;
+TAILQ_HEAD(ReclaimableResourceList, ReclaimableResource);
+
+/**
+ * Something that retains spare memory for reuse, such as a freelist, and
+ * that a MemoryReclaimer may shrink. The owner fills in the callbacks and
+ * registers the resource with MemoryReclaimer::add(). Resources are meant
+ * to be embedded in their owners, like Timers.
+ */
+struct ReclaimableResource {
+	typedef unsigned int (*CountFunction)(ReclaimableResource *resource);
+	typedef size_t (*ReleaseFunction)(ReclaimableResource *resource, unsigned int count);
+
+	static const unsigned int MAX_WINDOW_SIZE = 64;
+
+	TAILQ_ENTRY(ReclaimableResource) next;
+	const char *name;
+	void *userData;
+	/**
+	 * Returns the number of items that are currently in use. May be NULL
+	 * if usage isn't tracked, in which case all spare items are surplus.
+	 */
+	CountFunction getActiveCount;
+	/**
+	 * Returns the highest number of items that was in use since the
+	 * previous call, and restarts the measurement from the current usage.
+	 * Must be NULL if and only if getActiveCount is NULL.
+	 */
+	CountFunction takePeakActiveCount;
+	/**
+	 * Returns the number of spare items that may be released. Items that
+	 * the owner always wants to keep around (its floor) are not included.
+	 */
+	CountFunction getSpareCount;
+	/** Releases `count` spare items and returns the number of bytes freed. */
+	ReleaseFunction release;
+
+	/***** Working state and statistics of MemoryReclaimer (do not modify) *****/
+	unsigned int peaks[MAX_WINDOW_SIZE];
+	unsigned int highWaterMark;
+	unsigned int surplus;
+	boost::uint64_t totalReleased;
+	boost::uint64_t totalBytesReclaimed;
+
+	ReclaimableResource()
+		: name(NULL),
+		  userData(NULL),
+		  getActiveCount(NULL),
+		  takePeakActiveCount(NULL),
+		  getSpareCount(NULL),
+		  release(NULL),
+		  highWaterMark(0),
+		  surplus(0),
+		  totalReleased(0),
+		  totalBytesReclaimed(0)
+	{
+		memset(peaks, 0, sizeof(peaks));
+	}
+};
+
+/**
+ * Gradually returns memory that was retained after a load spike, such as
+ * spare mbuf blocks and spare client and request objects on freelists.
+ * Without it, those are only freed when an administrator asks for it
+ * (through the /gc.json API), so a single spike permanently inflates the
+ * RSS.
+ *
+ * Every `interval` seconds, the reclaimer records the peak usage of every
+ * resource since the previous sample. The highest of the last `windowSize`
+ * samples is the resource's high-water mark: enough spare items are kept
+ * to serve that many items again without allocating, and the rest is
+ * surplus. The surplus is released in increments of `releaseIncrement`
+ * items per resource from an idle watcher, so that reclamation only
+ * happens while the event loop has nothing else to do, and never blocks
+ * it for long. When all surplus is released, glibc is asked to return
+ * free heap pages to the kernel with malloc_trim(), which madvise()s
+ * away free pages in the middle of the heap too. malloc_trim() holds
+ * every arena's lock while it walks that arena, so on a large heap it
+ * can stall both the event loop and other threads' malloc() calls. It
+ * therefore runs at most once per `minTrimInterval` seconds; a trim that
+ * comes due sooner is deferred with a timer.
+ *
+ * Not thread-safe: a MemoryReclaimer must only be used from its event
+ * loop's thread. ServerKit::Context owns one per event loop. It is
+ * disabled until an interval is set.
+ */
+class MemoryReclaimer {
+public:
+	static const unsigned int DEFAULT_RELEASE_INCREMENT = 16;
+	static const unsigned int DEFAULT_MIN_TRIM_INTERVAL = 60;
+
+private:
+	struct ev_loop *loop;
+	ev::timer sampleWatcher;
+	ev::idle idleWatcher;
+	ev::timer trimWatcher;
+	ReclaimableResourceList resources;
+	ev_tstamp interval;
+	ev_tstamp minTrimInterval;
+	ev_tstamp lastTrimTime;
+	unsigned int windowSize;
+	unsigned int windowPos;
+	unsigned int releaseIncrement;
+	size_t roundBytesReclaimed;
+	boost::uint64_t totalBytesReclaimed;
+	unsigned long totalRounds;
+	unsigned long totalTrims;
+	size_t steadyStateRss;
+
+	void onSampleTimeout(ev::timer &watcher, int revents) {
+		sample();
+	}
+
+	void onIdle(ev::idle &watcher, int revents) {
+		releaseNextIncrement();
+	}
+
+	void onTrimTimeout(ev::timer &watcher, int revents) {
+		trim();
+	}
+
+	unsigned int calculateHighWaterMark(const ReclaimableResource *resource) const {
+		return *std::max_element(resource->peaks, resource->peaks + windowSize);
+	}
+
+	void finishRound() {
+		idleWatcher.stop();
+		totalRounds++;
+		if (roundBytesReclaimed > 0) {
+			scheduleTrim();
+			roundBytesReclaimed = 0;
+		}
+		steadyStateRss = getCurrentRss();
+	}
+
+	void scheduleTrim() {
+		ev_tstamp now = ev_now(loop);
+
+		if (trimWatcher.is_active()) {
+			// The deferred trim will take care of this round too.
+			return;
+		} else if (totalTrims == 0
+		 || now - lastTrimTime >= minTrimInterval
+		 || now < lastTrimTime)
+		{
+			trim();
+		} else {
+			trimWatcher.set(lastTrimTime + minTrimInterval - now, 0);
+			trimWatcher.start();
+		}
+	}
+
+	void trim() {
+		#ifdef __GLIBC__
+			malloc_trim(0);
+		#endif
+		lastTrimTime = ev_now(loop);
+		totalTrims++;
+		steadyStateRss = getCurrentRss();
+	}
+
+public:
+	MemoryReclaimer(struct ev_loop *_loop)
+		: loop(_loop),
+		  interval(0),
+		  minTrimInterval(DEFAULT_MIN_TRIM_INTERVAL),
+		  lastTrimTime(0),
+		  windowSize(1),
+		  windowPos(0),
+		  releaseIncrement(DEFAULT_RELEASE_INCREMENT),
+		  roundBytesReclaimed(0),
+		  totalBytesReclaimed(0),
+		  totalRounds(0),
+		  totalTrims(0),
+		  steadyStateRss(0)
+	{
+		TAILQ_INIT(&resources);
+		sampleWatcher.set(loop);
+		sampleWatcher.set<MemoryReclaimer, &MemoryReclaimer::onSampleTimeout>(this);
+		idleWatcher.set(loop);
+		idleWatcher.set<MemoryReclaimer, &MemoryReclaimer::onIdle>(this);
+		trimWatcher.set(loop);
+		trimWatcher.set<MemoryReclaimer, &MemoryReclaimer::onTrimTimeout>(this);
+	}
+
+	void add(ReclaimableResource *resource) {
+		assert((resource->getActiveCount == NULL) == (resource->takePeakActiveCount == NULL));
+		assert(resource->getSpareCount != NULL);
+		assert(resource->release != NULL);
+		memset(resource->peaks, 0, sizeof(resource->peaks));
+		resource->highWaterMark = 0;
+		resource->surplus = 0;
+		TAILQ_INSERT_TAIL(&resources, resource, next);
+	}
+
+	void remove(ReclaimableResource *resource) {
+		TAILQ_REMOVE(&resources, resource, next);
+	}
+
+	/**
+	 * Sets the number of seconds between samples. 0 disables reclamation.
+	 */
+	void setInterval(ev_tstamp value) {
+		interval = value;
+		if (value > 0) {
+			sampleWatcher.set(value, value);
+			sampleWatcher.start();
+		} else {
+			sampleWatcher.stop();
+			idleWatcher.stop();
+		}
+	}
+
+	/**
+	 * Sets the number of samples that the high-water marks are taken
+	 * over, so the window is `interval * windowSize` seconds long.
+	 */
+	void setWindowSize(unsigned int value) {
+		if (value > ReclaimableResource::MAX_WINDOW_SIZE) {
+			windowSize = ReclaimableResource::MAX_WINDOW_SIZE;
+		} else {
+			windowSize = std::max(1u, value);
+		}
+		windowPos = windowPos % windowSize;
+	}
+
+	void setReleaseIncrement(unsigned int value) {
+		releaseIncrement = std::max(1u, value);
+	}
+
+	/**
+	 * Sets the minimum number of seconds between two malloc_trim() calls.
+	 * Only affects trims that are scheduled afterwards.
+	 */
+	void setMinTrimInterval(ev_tstamp value) {
+		minTrimInterval = value;
+	}
+
+	/**
+	 * Records the peak usage of all resources, recalculates their surplus
+	 * and starts releasing it when the event loop is idle. Normally called
+	 * by the sample timer, but unit tests may call it directly.
+	 */
+	void sample() {
+		ReclaimableResource *resource;
+		bool hasSurplus = false;
+
+		TAILQ_FOREACH (resource, &resources, next) {
+			unsigned int active = 0, spare, reserve;
+
+			if (resource->takePeakActiveCount != NULL) {
+				resource->peaks[windowPos] = resource->takePeakActiveCount(resource);
+				resource->highWaterMark = calculateHighWaterMark(resource);
+				active = resource->getActiveCount(resource);
+			}
+			spare = resource->getSpareCount(resource);
+			reserve = (resource->highWaterMark > active)
+				? resource->highWaterMark - active
+				: 0;
+			resource->surplus = (spare > reserve) ? spare - reserve : 0;
+			hasSurplus = hasSurplus || resource->surplus > 0;
+		}
+
+		windowPos = (windowPos + 1) % windowSize;
+		if (hasSurplus) {
+			idleWatcher.start();
+		}
+	}
+
+	/**
+	 * Releases the next increment of every resource's surplus. Returns
+	 * whether there is surplus left. Normally called by the idle watcher,
+	 * but unit tests may call it directly.
+	 */
+	bool releaseNextIncrement() {
+		ReclaimableResource *resource;
+		bool hasSurplus = false;
+
+		TAILQ_FOREACH (resource, &resources, next) {
+			unsigned int count;
+			size_t bytes;
+
+			if (resource->surplus == 0) {
+				continue;
+			}
+
+			// Some spare items may have been put to use since the sample.
+			count = std::min(std::min(resource->surplus, releaseIncrement),
+				resource->getSpareCount(resource));
+			if (count == 0) {
+				resource->surplus = 0;
+				continue;
+			}
+
+			bytes = resource->release(resource, count);
+			resource->surplus -= count;
+			resource->totalReleased += count;
+			resource->totalBytesReclaimed += bytes;
+			roundBytesReclaimed += bytes;
+			totalBytesReclaimed += bytes;
+			hasSurplus = hasSurplus || resource->surplus > 0;
+		}
+
+		if (!hasSurplus) {
+			finishRound();
+		}
+		return hasSurplus;
+	}
+
+	bool isReleasing() const {
+		return idleWatcher.is_active();
+	}
+
+	boost::uint64_t getTotalBytesReclaimed() const {
+		return totalBytesReclaimed;
+	}
+
+	unsigned long getTotalTrims() const {
+		return totalTrims;
+	}
+
+	bool isTrimPending() const {
+		return trimWatcher.is_active();
+	}
+
+	/** Returns the resident set size of this process, or 0 if unknown. */
+	static size_t getCurrentRss() {
+		#ifdef __linux__
+			FILE *f = fopen("/proc/self/statm", "r");
+			unsigned long size, resident;
+			size_t result = 0;
+
+			if (f != NULL) {
+				if (fscanf(f, "%lu %lu", &size, &resident) == 2) {
+					result = (size_t) resident * sysconf(_SC_PAGESIZE);
+				}
+				fclose(f);
+			}
+			return result;
+		#else
+			return 0;
+		#endif
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		Json::Value resourcesDoc(Json::arrayValue);
+		const ReclaimableResource *resource;
+		size_t rss = getCurrentRss();
+
+		doc["interval"] = interval;
+		doc["window_size"] = windowSize;
+		doc["release_increment"] = releaseIncrement;
+		doc["releasing"] = isReleasing();
+		doc["total_rounds"] = (Json::UInt64) totalRounds;
+		doc["total_trims"] = (Json::UInt64) totalTrims;
+		doc["trim_pending"] = isTrimPending();
+		doc["total_reclaimed_memory"] = byteSizeToJson(totalBytesReclaimed);
+		if (rss > 0) {
+			doc["rss"] = byteSizeToJson(rss);
+		}
+		if (steadyStateRss > 0) {
+			doc["steady_state_rss"] = byteSizeToJson(steadyStateRss);
+		}
+
+		TAILQ_FOREACH (resource, &resources, next) {
+			Json::Value subdoc;
+			subdoc["name"] = resource->name;
+			subdoc["high_water_mark"] = resource->highWaterMark;
+			subdoc["surplus"] = resource->surplus;
+			subdoc["total_released"] = (Json::UInt64) resource->totalReleased;
+			subdoc["reclaimed_memory"] = byteSizeToJson(resource->totalBytesReclaimed);
+			resourcesDoc.append(subdoc);
+		}
+		doc["resources"] = resourcesDoc;
+
+		return doc;
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_MEMORY_RECLAIMER_H_ */
@@ -228,6 +228,8 @@ private:
 	ev::timer acceptResumptionWatcher;
 	ev::timer statisticsUpdateWatcher;
 	ev::io endpoints[SERVER_KIT_MAX_SERVER_ENDPOINTS];
+	ReclaimableResource spareClients;
+	unsigned int reclamationPeakActiveClientCount;
 
 
 	/***** Private methods *****/
@@ -341,6 +343,32 @@ private:
 		}
 	}
 
+	static unsigned int getActiveClientCount(ReclaimableResource *resource) {
+		BaseServer *self = static_cast<BaseServer *>(resource->userData);
+		return self->activeClientCount;
+	}
+
+	static unsigned int takePeakActiveClientCount(ReclaimableResource *resource) {
+		BaseServer *self = static_cast<BaseServer *>(resource->userData);
+		unsigned int result = self->reclamationPeakActiveClientCount;
+		self->reclamationPeakActiveClientCount = self->activeClientCount;
+		return result;
+	}
+
+	static unsigned int getSpareClientCount(ReclaimableResource *resource) {
+		BaseServer *self = static_cast<BaseServer *>(resource->userData);
+		if (self->freeClientCount > self->minSpareClients) {
+			return self->freeClientCount - self->minSpareClients;
+		} else {
+			return 0;
+		}
+	}
+
+	static size_t releaseSpareClients(ReclaimableResource *resource, unsigned int count) {
+		BaseServer *self = static_cast<BaseServer *>(resource->userData);
+		return self->freeClientObjects(count) * sizeof(Client);
+	}
+
 	void onStatisticsUpdateTimeout(ev::timer &timer, int revents) {
 		TRACE_POINT();
 
@@ -533,6 +561,8 @@ protected:
 		unsigned int i;
 
 		peakActiveClientCount = std::max(peakActiveClientCount, activeClientCount);
+		reclamationPeakActiveClientCount = std::max(reclamationPeakActiveClientCount,
+			activeClientCount);
 
 		for (i = 0; i < size; i++) {
 			Client *client = clients[i];
@@ -655,7 +685,8 @@ public:
 		  ctx(context),
 		  nextClientNumber(1),
 		  nEndpoints(0),
-		  accept4Available(true)
+		  accept4Available(true),
+		  reclamationPeakActiveClientCount(0)
 	{
 		STAILQ_INIT(&freeClients);
 		TAILQ_INIT(&activeClients);
@@ -672,10 +703,19 @@ public:
 			&BaseServer<DerivedServer, Client>::onStatisticsUpdateTimeout>(this);
 		statisticsUpdateWatcher.set(5, 5);
 		statisticsUpdateWatcher.start();
+
+		spareClients.name = "spare_clients";
+		spareClients.userData = this;
+		spareClients.getActiveCount = getActiveClientCount;
+		spareClients.takePeakActiveCount = takePeakActiveClientCount;
+		spareClients.getSpareCount = getSpareClientCount;
+		spareClients.release = releaseSpareClients;
+		context->memoryReclaimer.add(&spareClients);
 	}
 
 	virtual ~BaseServer() {
 		P_ASSERT_EQ(serverState, FINISHED_SHUTDOWN);
+		ctx->memoryReclaimer.remove(&spareClients);
 	}
 
 
@@ -801,20 +841,31 @@ public:
 	/***** Server management *****/
 
 	virtual void compact(int logLevel = LVL_NOTICE) {
-		unsigned int count = freeClientCount;
+		unsigned int count = freeClientObjects(freeClientCount);
+		assert(freeClientCount == 0);
+
+		SKS_LOG(logLevel, __FILE__, __LINE__,
+			"Freed " << count << " spare client objects");
+	}
 
-		while (!STAILQ_EMPTY(&freeClients)) {
+	/**
+	 * Destroys at most `max` client objects on the freelist. Returns the
+	 * number of objects that were destroyed.
+	 */
+	unsigned int freeClientObjects(unsigned int max) {
+		unsigned int count = 0;
+
+		while (count < max && !STAILQ_EMPTY(&freeClients)) {
 			Client *client = STAILQ_FIRST(&freeClients);
 			P_ASSERT_EQ(client->getConnState(), Client::IN_FREELIST);
 			client->refcount.store(2, boost::memory_order_relaxed);
 			freeClientCount--;
 			STAILQ_REMOVE_HEAD(&freeClients, nextClient.freeClient);
 			delete client;
+			count++;
 		}
-		assert(freeClientCount == 0);
 
-		SKS_LOG(logLevel, __FILE__, __LINE__,
-			"Freed " << count << " spare client objects");
+		return count;
 	}
 
 
@@ -0,0 +1,288 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_
+#define _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_
+
+#include <psg_sysqueue.h>
+#include <boost/cstdint.hpp>
+#include <oxt/macros.hpp>
+#include <ev++.h>
+#include <cassert>
+#include <cmath>
+#include <jsoncpp/json.h>
+
+namespace Passenger {
+namespace ServerKit {
+
+
+struct Timer;
+TAILQ_HEAD(TimerList, Timer);
+
+/**
+ * A timer managed by a TimerWheel. Timers are meant to be embedded in
+ * other objects (e.g. client objects), so that arming them does not
+ * allocate memory.
+ */
+struct Timer {
+	typedef void (*Callback)(Timer *timer);
+
+	TAILQ_ENTRY(Timer) next;
+	/** The slot that this timer is in, or NULL if it's not armed. */
+	TimerList *list;
+	/** The tick at which this timer expires. */
+	boost::uint64_t expiry;
+	Callback callback;
+	void *userData;
+
+	Timer()
+		: list(NULL),
+		  expiry(0),
+		  callback(NULL),
+		  userData(NULL)
+		{ }
+
+	bool isArmed() const {
+		return list != NULL;
+	}
+};
+
+/**
+ * A hierarchical timer wheel (Varghese & Lauck) for large numbers of
+ * coarse-grained timeouts, such as per-client idle timeouts. Arming,
+ * re-arming and cancelling a timer are O(1) and don't allocate memory,
+ * unlike a libev timer which is kept in a heap. The wheel is driven by
+ * a single libev timer that only runs while there are armed timers.
+ *
+ * Time is divided in ticks of `resolution` seconds. The wheel has
+ * LEVELS levels of SLOTS slots each; a timer that expires within SLOTS
+ * ticks is put in a level 0 slot, a timer that expires within SLOTS^2
+ * ticks in a level 1 slot, etc. Whenever the level 0 index wraps around,
+ * the timers in the next level 1 slot are redistributed ("cascaded") over
+ * level 0, and so on. Timeouts longer than the wheel's range are capped.
+ *
+ * A timer fires between `timeout` and `timeout + resolution` seconds
+ * after it was armed: never early.
+ *
+ * Not thread-safe: a TimerWheel must only be used from its event loop's
+ * thread. ServerKit::Context owns one per event loop.
+ */
+class TimerWheel {
+public:
+	static const unsigned int SLOT_BITS = 6;
+	static const unsigned int SLOTS = 1 << SLOT_BITS;
+	static const unsigned int SLOT_MASK = SLOTS - 1;
+	static const unsigned int LEVELS = 4;
+	static const boost::uint64_t MAX_TICKS = (boost::uint64_t) 1 << (SLOT_BITS * LEVELS);
+
+private:
+	struct ev_loop *loop;
+	ev::timer tickWatcher;
+	ev_tstamp resolution;
+	ev_tstamp lastTickTime;
+	boost::uint64_t currentTick;
+	unsigned int armedCount;
+	boost::uint64_t totalFired;
+	TimerList slots[LEVELS][SLOTS];
+
+	void insert(Timer *timer) {
+		boost::uint64_t delta = timer->expiry - currentTick;
+		unsigned int level = 0;
+
+		while (level < LEVELS - 1
+		 && delta >= ((boost::uint64_t) 1 << (SLOT_BITS * (level + 1))))
+		{
+			level++;
+		}
+
+		timer->list = &slots[level][(timer->expiry >> (SLOT_BITS * level)) & SLOT_MASK];
+		TAILQ_INSERT_TAIL(timer->list, timer, next);
+	}
+
+	/**
+	 * Redistributes the timers in the given slot over the lower levels.
+	 * Returns the slot index, which is 0 when the next level has to be
+	 * cascaded too.
+	 */
+	unsigned int cascade(unsigned int level) {
+		unsigned int index = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+		TimerList list;
+		Timer *timer;
+
+		TAILQ_INIT(&list);
+		TAILQ_CONCAT(&list, &slots[level][index], next);
+		while ((timer = TAILQ_FIRST(&list)) != NULL) {
+			TAILQ_REMOVE(&list, timer, next);
+			insert(timer);
+		}
+
+		return index;
+	}
+
+	void tick() {
+		TimerList *list;
+		Timer *timer;
+
+		currentTick++;
+		if ((currentTick & SLOT_MASK) == 0) {
+			unsigned int level = 1;
+			while (level < LEVELS && cascade(level) == 0) {
+				level++;
+			}
+		}
+
+		// Fire timers one by one, because a callback may cancel or
+		// re-arm other timers in the same slot.
+		list = &slots[0][currentTick & SLOT_MASK];
+		while ((timer = TAILQ_FIRST(list)) != NULL) {
+			TAILQ_REMOVE(list, timer, next);
+			timer->list = NULL;
+			armedCount--;
+			totalFired++;
+			timer->callback(timer);
+		}
+	}
+
+	void onTick(ev::timer &watcher, int revents) {
+		ev_tstamp now = ev_now(loop);
+		boost::uint64_t ticks = (boost::uint64_t) ((now - lastTickTime) / resolution);
+
+		// The event loop may have been blocked for a while, so catch up.
+		if (ticks == 0) {
+			ticks = 1;
+		}
+		lastTickTime += ticks * resolution;
+		advance(ticks);
+	}
+
+	void startTicking() {
+		lastTickTime = ev_now(loop);
+		tickWatcher.set(resolution, resolution);
+		tickWatcher.start();
+	}
+
+public:
+	TimerWheel(struct ev_loop *_loop, ev_tstamp _resolution = 1)
+		: loop(_loop),
+		  resolution(_resolution),
+		  lastTickTime(0),
+		  currentTick(0),
+		  armedCount(0),
+		  totalFired(0)
+	{
+		for (unsigned int level = 0; level < LEVELS; level++) {
+			for (unsigned int i = 0; i < SLOTS; i++) {
+				TAILQ_INIT(&slots[level][i]);
+			}
+		}
+		tickWatcher.set(loop);
+		tickWatcher.set<TimerWheel, &TimerWheel::onTick>(this);
+	}
+
+	/**
+	 * Arms the timer so that its callback is called after `timeout`
+	 * seconds. If the timer is already armed, then it's re-armed.
+	 */
+	void arm(Timer *timer, ev_tstamp timeout) {
+		boost::uint64_t ticks;
+
+		assert(timer->callback != NULL);
+		if (timer->isArmed()) {
+			TAILQ_REMOVE(timer->list, timer, next);
+		} else {
+			if (armedCount == 0) {
+				startTicking();
+			}
+			armedCount++;
+		}
+
+		// Add one tick because we don't know how far we are into the current one.
+		ticks = (boost::uint64_t) ceil(timeout / resolution) + 1;
+		if (ticks >= MAX_TICKS) {
+			ticks = MAX_TICKS - 1;
+		}
+		timer->expiry = currentTick + ticks;
+		insert(timer);
+	}
+
+	void cancel(Timer *timer) {
+		if (timer->isArmed()) {
+			TAILQ_REMOVE(timer->list, timer, next);
+			timer->list = NULL;
+			armedCount--;
+			if (armedCount == 0) {
+				tickWatcher.stop();
+			}
+		}
+	}
+
+	/**
+	 * Advances the wheel by the given number of ticks, firing all timers
+	 * that expire in the mean time. Normally called by the libev timer,
+	 * but unit tests may call it directly.
+	 */
+	void advance(boost::uint64_t ticks) {
+		while (ticks > 0 && armedCount > 0) {
+			tick();
+			ticks--;
+		}
+		// Nothing can expire until a timer is armed, so the
+		// remaining ticks don't have to be processed.
+		currentTick += ticks;
+		if (armedCount == 0) {
+			tickWatcher.stop();
+		}
+	}
+
+	/**
+	 * Changes the tick length. May only be called when no timers are armed.
+	 */
+	void setResolution(ev_tstamp value) {
+		assert(armedCount == 0);
+		resolution = value;
+	}
+
+	ev_tstamp getResolution() const {
+		return resolution;
+	}
+
+	unsigned int getArmedCount() const {
+		return armedCount;
+	}
+
+	Json::Value inspectStateAsJson() const {
+		Json::Value doc;
+		doc["resolution"] = resolution;
+		doc["armed_timers"] = armedCount;
+		doc["total_timers_fired"] = (Json::UInt64) totalFired;
+		return doc;
+	}
+};
+
+
+} // namespace ServerKit
+} // namespace Passenger
+
+#endif /* _PASSENGER_SERVER_KIT_TIMER_WHEEL_H_ */
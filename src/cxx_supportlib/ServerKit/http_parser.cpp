@@ -22,6 +22,7 @@
  * IN THE SOFTWARE.
  */
 #include <ServerKit/http_parser.h>
+#include <ServerKit/HttpScanning.h>
 #include <assert.h>
 #include <stddef.h>
 #include <ctype.h>
@@ -387,6 +388,30 @@ enum http_host_state
 #define start_state (parser->type == HTTP_REQUEST ? s_start_req : s_start_res)
 
 
+/* Returns how far the parser may skip ahead from `p` (which has not been
+ * counted in parser->nread yet) without reading more than
+ * HTTP_MAX_HEADER_SIZE bytes of headers. If the limit is reached, the
+ * byte-by-byte loop takes over and reports the overflow at the same byte
+ * as it would have without skipping.
+ */
+static const char *
+header_skip_limit(const http_parser *parser, const char *p, const char *end)
+{
+  size_t max = (HTTP_MAX_HEADER_SIZE) - parser->nread;
+  return ((size_t) (end - p) > max) ? p + max : end;
+}
+
+/* Skips the parser ahead to `q`, the first byte that isn't part of the run
+ * of bytes that starts after `p`. Must be followed by `break` so that the
+ * main loop continues with `q`.
+ */
+#define SKIP_TO(q)                                                   \
+do {                                                                 \
+  parser->nread += (q) - (p + 1);                                    \
+  p = (q) - 1;                                                       \
+} while (0)
+
+
 #if HTTP_PARSER_STRICT
 # define STRICT_CHECK(cond)                                          \
 do {                                                                 \
@@ -1283,6 +1308,9 @@ size_t http_parser_execute (http_parser *parser,
         if (c) {
           switch (parser->header_state) {
             case h_general:
+              /* Skip over the rest of the header name in bulk. */
+              SKIP_TO(Passenger::ServerKit::httpFindNonTokenChar(p + 1,
+                header_skip_limit(parser, p + 1, data + len)));
               break;
 
             case h_C:
@@ -1492,6 +1520,9 @@ size_t http_parser_execute (http_parser *parser,
 
         switch (parser->header_state) {
           case h_general:
+            /* Skip over the rest of the header value in bulk. */
+            SKIP_TO(Passenger::ServerKit::httpFindCrOrLf(p + 1,
+              header_skip_limit(parser, p + 1, data + len)));
             break;
 
           case h_connection:
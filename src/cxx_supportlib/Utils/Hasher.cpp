@@ -26,28 +26,140 @@
 
 // Implementation is in its own file so that we can enable compiler optimizations for these functions only.
 
+#include <cstring>
 #include <Utils/Hasher.h>
 
 namespace Passenger {
 
+using namespace std;
+
+
+const boost::uint32_t MurmurHash::EMPTY_STRING_HASH;
+
+static const boost::uint64_t M = 0xc6a4a7935bd1e995ULL;
+static const int R = 47;
+static const boost::uint64_t ONES = 0x0101010101010101ULL;
+
+static inline boost::uint64_t
+loadWord(const char *data) {
+	boost::uint64_t word;
+	memcpy(&word, data, sizeof(word));
+	return word;
+}
+
+static inline void
+mixWord(boost::uint64_t &hash, boost::uint64_t word) {
+	word *= M;
+	word ^= word >> R;
+	word *= M;
+	hash ^= word;
+	hash *= M;
+}
+
+static inline char
+toLowerCase(char ch) {
+	if (ch >= 'A' && ch <= 'Z') {
+		return ch | 0x20;
+	} else {
+		return ch;
+	}
+}
+
+/**
+ * Converts the ASCII letters A-Z in all 8 bytes of `word` to lower case,
+ * leaving all other bytes (including non-ASCII ones) untouched. For every
+ * byte, bit 7 of `geA` is set if its lower 7 bits are >= 'A', and bit 7 of
+ * `gtZ` is set if they're > 'Z'. The additions can't carry into the next
+ * byte because the operands' bytes are at most 0x7f + 0x3f.
+ */
+static inline boost::uint64_t
+toLowerCaseWord(boost::uint64_t word) {
+	boost::uint64_t lower7 = word & (ONES * 0x7f);
+	boost::uint64_t geA = lower7 + ONES * (0x80 - 'A');
+	boost::uint64_t gtZ = lower7 + ONES * (0x80 - 'Z' - 1);
+	boost::uint64_t isUpper = geA & ~gtZ & ~word & (ONES * 0x80);
+	return word | (isUpper >> 2);
+}
+
+void
+MurmurHash::update(const char *data, unsigned int size) {
+	const char *end = data + size;
+
+	length += size;
+	if (tailSize > 0) {
+		while (tailSize < 8 && data < end) {
+			tail[tailSize] = *data;
+			tailSize++;
+			data++;
+		}
+		if (tailSize < 8) {
+			return;
+		}
+		mixWord(hash, loadWord(tail));
+		tailSize = 0;
+	}
+
+	while (end - data >= 8) {
+		mixWord(hash, loadWord(data));
+		data += 8;
+	}
+
+	while (data < end) {
+		tail[tailSize] = *data;
+		tailSize++;
+		data++;
+	}
+}
+
 void
-JenkinsHash::update(const char *data, unsigned int size) {
+MurmurHash::updateWithLowerCase(const char *data, char *output, unsigned int size) {
 	const char *end = data + size;
+	boost::uint64_t word;
+
+	length += size;
+	if (tailSize > 0) {
+		while (tailSize < 8 && data < end) {
+			*output = tail[tailSize] = toLowerCase(*data);
+			tailSize++;
+			data++;
+			output++;
+		}
+		if (tailSize < 8) {
+			return;
+		}
+		mixWord(hash, loadWord(tail));
+		tailSize = 0;
+	}
+
+	while (end - data >= 8) {
+		word = toLowerCaseWord(loadWord(data));
+		memcpy(output, &word, sizeof(word));
+		mixWord(hash, word);
+		data += 8;
+		output += 8;
+	}
 
 	while (data < end) {
-		hash += *data;
-		hash += (hash << 10);
-		hash ^= (hash >> 6);
+		*output = tail[tailSize] = toLowerCase(*data);
+		tailSize++;
 		data++;
+		output++;
 	}
 }
 
 boost::uint32_t
-JenkinsHash::finalize() {
-	hash += (hash << 3);
-	hash ^= (hash >> 11);
-	hash += (hash << 15);
-	return hash;
+MurmurHash::finalize() {
+	if (tailSize > 0) {
+		memset(tail + tailSize, 0, 8 - tailSize);
+		hash ^= loadWord(tail);
+		hash *= M;
+	}
+	hash ^= length * M;
+	hash ^= hash >> R;
+	hash *= M;
+	hash ^= hash >> R;
+	return (boost::uint32_t) (hash ^ (hash >> 32));
 }
 
+
 } // namespace Passenger
@@ -31,27 +31,47 @@
 namespace Passenger {
 
 
-// TODO: use SpookyHash on x86_64
-// TODO: use streaming murmurhash implementation: https://github.com/c9/murmur3
-
-struct JenkinsHash {
-	static const boost::uint32_t EMPTY_STRING_HASH = 0;
+/**
+ * A streaming variant of MurmurHash64A (by Austin Appleby), which processes
+ * 8 bytes at a time. Data may be passed to `update()` in arbitrary pieces,
+ * e.g. one call per LString part: the result only depends on the
+ * concatenation of all pieces. `finalize()` folds the 64-bit state into a
+ * 32-bit hash.
+ *
+ * Words are loaded in native byte order, so hashes are only meaningful
+ * within a single process and must not be persisted.
+ */
+struct MurmurHash {
+	static const boost::uint32_t EMPTY_STRING_HASH = 0x551e323e;
 
-	boost::uint32_t hash;
+	boost::uint64_t hash;
+	boost::uint32_t length;
+	unsigned int tailSize;
+	char tail[8];
 
-	JenkinsHash()
-		: hash(0)
-		{ }
+	MurmurHash() {
+		reset();
+	}
 
 	void update(const char *data, unsigned int size);
 	boost::uint32_t finalize();
 
+	/**
+	 * Converts `data` to lower case, stores the result in `output` and
+	 * updates the hash with it, all in a single pass over 8 bytes at a
+	 * time. Produces the same results as `convertLowerCase()` followed
+	 * by `update(output, size)`.
+	 */
+	void updateWithLowerCase(const char *data, char *output, unsigned int size);
+
 	void reset() {
-		hash = 0;
+		hash = 0x9747b28c;
+		length = 0;
+		tailSize = 0;
 	}
 };
 
-typedef JenkinsHash Hasher;
+typedef MurmurHash Hasher;
 
 
 } // namespace Passenger
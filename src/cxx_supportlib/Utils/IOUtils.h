@@ -188,6 +188,10 @@ int createUnixServer(const StaticString &filename,
  * Create a new TCP server socket which is bounded to the given address and port.
  * SO_REUSEADDR will be set on the socket.
  *
+ * If <tt>reusePort</tt> is true, then SO_REUSEPORT is set as well, so that
+ * multiple sockets can be bound to the same address and port. The kernel
+ * then distributes incoming connections over those sockets.
+ *
  * @param address The IP address to bind the socket to.
  * @param port The port to bind the socket to, or 0 to have the OS automatically
  *             select a free port.
@@ -196,8 +200,10 @@ int createUnixServer(const StaticString &filename,
  * @param file The name of the source file that called this function,
  *             for file descriptor logging purposes.
  * @param line The line in the source file that called this function.
+ * @param reusePort Whether to set SO_REUSEPORT on the socket.
  * @return The file descriptor of the newly created server socket.
- * @throws SystemException Something went wrong while creating the server socket.
+ * @throws SystemException Something went wrong while creating the server socket,
+ *                         or SO_REUSEPORT was requested but could not be set.
  * @throws ArgumentException The given address cannot be parsed.
  * @throws boost::thread_interrupted A system call has been interrupted.
  * @ingroup Support
@@ -206,7 +212,8 @@ int createTcpServer(const char *address = "0.0.0.0",
 	unsigned short port = 0,
 	unsigned int backlogSize = 0,
 	const char *file = __FILE__,
-	unsigned int line = __LINE__);
+	unsigned int line = __LINE__,
+	bool reusePort = false);
 
 /**
  * Connect to a server at the given address in a blocking manner.
@@ -52,8 +52,11 @@
 #include <sys/wait.h>
 #include <sys/time.h>
 #include <sys/resource.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <signal.h>
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <cerrno>
 #include <cstring>
@@ -189,10 +192,25 @@ public:
 /**
  * Utility class for collection metrics on processes, such as CPU usage, memory usage,
  * command name, etc.
+ *
+ * On Linux, metrics are read directly from /proc. This avoids forking (a
+ * potentially large) process and running `ps`, which matters when metrics
+ * are collected periodically for hundreds of processes. On other platforms,
+ * `ps` is used.
  */
 class ProcessMetricsCollector {
+public:
+	enum Backend {
+		/** Run `ps` and parse its output. Works on all supported platforms. */
+		PS_BACKEND,
+		/** Read /proc/<PID>/{stat,statm,status,cmdline} directly. Linux only. */
+		PROCFS_BACKEND
+	};
+
 private:
+	Backend backend;
 	bool canMeasureRealMemory;
+	bool hasSmapsRollup;
 	string psOutput;
 
 	template<typename Collection, typename ConstIterator>
@@ -249,16 +267,294 @@ private:
 		return result;
 	}
 
+	/**
+	 * Reads the entire contents of a (/proc) file into `buffer`, followed by a
+	 * NUL terminator. The buffer is grown as necessary but never shrunk, so
+	 * that it can be reused for reading many files. Returns the size of the
+	 * data, or -1 if the file cannot be read, e.g. because the process
+	 * that it describes has exited.
+	 */
+	static ssize_t readProcFile(const char *path, string &buffer) {
+		int fd = syscalls::open(path, O_RDONLY);
+		if (fd == -1) {
+			return -1;
+		}
+		FdGuard guard(fd, NULL, 0, true);
+		size_t size = 0;
+		ssize_t ret;
+
+		if (buffer.size() < 1024 * 4) {
+			buffer.resize(1024 * 4);
+		}
+		do {
+			if (size + 1 >= buffer.size()) {
+				buffer.resize(buffer.size() * 2);
+			}
+			ret = syscalls::read(fd, &buffer[size], buffer.size() - size - 1);
+			if (ret > 0) {
+				size += ret;
+			}
+		} while (ret > 0);
+
+		if (ret == -1) {
+			return -1;
+		} else {
+			buffer[size] = '\0';
+			return size;
+		}
+	}
+
+	/**
+	 * Sums the Pss, Private_Dirty and Swap fields in the contents of
+	 * /proc/<PID>/smaps or /proc/<PID>/smaps_rollup. Fields that do
+	 * not appear in the data are set to -1.
+	 *
+	 * @throws ParseException
+	 */
+	static void parseSmaps(const char *data, ssize_t &pss, ssize_t &privateDirty,
+		ssize_t &swap)
+	{
+		bool hasPss = false;
+		bool hasPrivateDirty = false;
+		bool hasSwap = false;
+
+		// In KB.
+		pss = 0;
+		privateDirty = 0;
+		swap = 0;
+
+		do {
+			const char *buf = data;
+			ssize_t *field;
+
+			if (strncmp(data, "Pss:", 4) == 0) {
+				/* Linux supports Proportional Set Size since kernel 2.6.25.
+				 * See kernel commit ec4dd3eb35759f9fbeb5c1abb01403b2fde64cc9.
+				 */
+				hasPss = true;
+				field = &pss;
+			} else if (strncmp(data, "Private_Dirty:", 14) == 0) {
+				hasPrivateDirty = true;
+				field = &privateDirty;
+			} else if (strncmp(data, "Swap:", 5) == 0) {
+				hasSwap = true;
+				field = &swap;
+			} else {
+				continue;
+			}
+
+			readNextWord(&buf);
+			*field += readNextWordAsLongLong(&buf);
+			if (readNextWord(&buf) != "kB") {
+				throw ParseException();
+			}
+		} while (skipToNextLine(&data));
+
+		if (!hasPss) {
+			pss = -1;
+		}
+		if (!hasPrivateDirty) {
+			privateDirty = -1;
+		}
+		if (!hasSwap) {
+			swap = -1;
+		}
+	}
+
+	#ifdef __linux__
+		/**
+		 * Parses the contents of /proc/<PID>/stat. Sets `ppid`, `processGroupId` and
+		 * `cpu`, and returns the command name (without arguments).
+		 *
+		 * Like `ps`, the CPU usage is the average over the process's entire lifetime.
+		 *
+		 * @throws ParseException
+		 */
+		static StaticString parseProcPidStat(const char *data, double uptime,
+			long clockTicks, ProcessMetrics &metrics)
+		{
+			// The command name is enclosed in parentheses, but may itself
+			// contain spaces and parentheses.
+			const char *commStart = strchr(data, '(');
+			const char *commEnd = strrchr(data, ')');
+			if (commStart == NULL || commEnd == NULL || commEnd < commStart) {
+				throw ParseException();
+			}
+
+			const char *pos = commEnd + 1;
+			long long utime, stime, starttime;
+			unsigned int i;
+
+			readNextWord(&pos); // state
+			metrics.ppid = (pid_t) readNextWordAsLongLong(&pos);
+			metrics.processGroupId = (pid_t) readNextWordAsLongLong(&pos);
+			// Skip session, tty_nr, tpgid, flags, minflt, cminflt, majflt, cmajflt.
+			for (i = 0; i < 8; i++) {
+				readNextWord(&pos);
+			}
+			utime = readNextWordAsLongLong(&pos);
+			stime = readNextWordAsLongLong(&pos);
+			// Skip cutime, cstime, priority, nice, num_threads, itrealvalue.
+			for (i = 0; i < 6; i++) {
+				readNextWord(&pos);
+			}
+			starttime = readNextWordAsLongLong(&pos);
+
+			double lifetime = uptime - starttime / (double) clockTicks;
+			if (lifetime > 0) {
+				double cpu = (utime + stime) / (double) clockTicks / lifetime * 100;
+				metrics.cpu = (boost::uint8_t) std::min(cpu, 255.0);
+			} else {
+				metrics.cpu = 0;
+			}
+
+			return StaticString(commStart + 1, commEnd - commStart - 1);
+		}
+
+		/**
+		 * Parses the effective UID from the contents of /proc/<PID>/status.
+		 *
+		 * @throws ParseException
+		 */
+		static uid_t parseProcPidStatusUid(const char *data) {
+			// Format: "Uid:\t<real>\t<effective>\t<saved>\t<filesystem>"
+			const char *pos = strstr(data, "\nUid:");
+			char *end;
+
+			if (pos == NULL) {
+				throw ParseException();
+			}
+			pos += sizeof("\nUid:") - 1;
+			strtoul(pos, &end, 10);
+			if (end == pos) {
+				throw ParseException();
+			}
+			pos = end;
+			unsigned long uid = strtoul(pos, &end, 10);
+			if (end == pos) {
+				throw ParseException();
+			}
+			return (uid_t) uid;
+		}
+
+		/**
+		 * Collects the metrics for a single process from /proc. Returns false if
+		 * the process does not exist (anymore).
+		 *
+		 * @throws ParseException
+		 */
+		bool collectFromProcfs(pid_t pid, double uptime, long clockTicks, long pageSize,
+			string &buffer, ProcessMetrics &metrics) const
+		{
+			char path[64];
+			int prefixSize = snprintf(path, sizeof(path), "/proc/%d/", (int) pid);
+			char *name = path + prefixSize;
+			ssize_t size;
+
+			strcpy(name, "stat");
+			if (readProcFile(path, buffer) == -1) {
+				return false;
+			}
+			string comm = parseProcPidStat(buffer.c_str(), uptime, clockTicks, metrics);
+
+			// Sizes are in pages.
+			strcpy(name, "statm");
+			if (readProcFile(path, buffer) == -1) {
+				return false;
+			}
+			const char *pos = buffer.c_str();
+			metrics.vmsize = readNextWordAsLongLong(&pos) * (pageSize / 1024);
+			metrics.rss = readNextWordAsLongLong(&pos) * (pageSize / 1024);
+
+			strcpy(name, "status");
+			if (readProcFile(path, buffer) == -1) {
+				return false;
+			}
+			metrics.uid = parseProcPidStatusUid(buffer.c_str());
+
+			// Arguments are separated by NUL bytes. Kernel threads and
+			// zombies have no arguments, in which case `ps` shows the
+			// command name in brackets.
+			strcpy(name, "cmdline");
+			size = readProcFile(path, buffer);
+			if (size == -1) {
+				return false;
+			}
+			while (size > 0 && buffer[size - 1] == '\0') {
+				size--;
+			}
+			if (size == 0) {
+				metrics.command = "[" + comm + "]";
+			} else {
+				metrics.command.assign(buffer.data(), size);
+				std::replace(metrics.command.begin(), metrics.command.end(), '\0', ' ');
+			}
+
+			if (canMeasureRealMemory) {
+				measureRealMemory(pid, hasSmapsRollup, buffer, metrics.pss,
+					metrics.privateDirty, metrics.swap);
+			}
+
+			metrics.pid = pid;
+			return true;
+		}
+
+		template<typename Collection, typename ConstIterator>
+		ProcessMetricMap collectFromProcfs(const Collection &pids) const {
+			ProcessMetricMap result;
+			ConstIterator it;
+			string buffer;
+			long clockTicks = sysconf(_SC_CLK_TCK);
+			long pageSize = sysconf(_SC_PAGESIZE);
+			double uptime = 0;
+
+			if (readProcFile("/proc/uptime", buffer) != -1) {
+				uptime = atof(buffer.c_str());
+			}
+
+			for (it = pids.begin(); it != pids.end(); it++) {
+				ProcessMetrics metrics;
+				if (collectFromProcfs(*it, uptime, clockTicks, pageSize, buffer, metrics)) {
+					result[metrics.pid] = metrics;
+				}
+			}
+			return result;
+		}
+	#endif
+
 public:
 	ProcessMetricsCollector() {
+		#ifdef __linux__
+			if (fileExists("/proc/self/stat")) {
+				backend = PROCFS_BACKEND;
+			} else {
+				backend = PS_BACKEND;
+			}
+		#else
+			backend = PS_BACKEND;
+		#endif
 		#ifdef __APPLE__
 			canMeasureRealMemory = true;
+			hasSmapsRollup = false;
 		#else
 			canMeasureRealMemory = fileExists("/proc/self/smaps");
+			hasSmapsRollup = fileExists("/proc/self/smaps_rollup");
 		#endif
 	}
 
-	/** Mock 'ps' output, used by unit tests. */
+	Backend getBackend() const {
+		return backend;
+	}
+
+	/**
+	 * Overrides the automatically selected backend. Only PS_BACKEND is
+	 * supported on non-Linux platforms.
+	 */
+	void setBackend(Backend backend) {
+		this->backend = backend;
+	}
+
+	/** Mock 'ps' output, used by unit tests. Implies PS_BACKEND. */
 	void setPsOutput(const string &data) {
 		this->psOutput = data;
 	}
@@ -277,6 +573,11 @@ public:
 		if (pids.empty()) {
 			return ProcessMetricMap();
 		}
+		#ifdef __linux__
+			if (backend == PROCFS_BACKEND && psOutput.empty()) {
+				return collectFromProcfs<Collection, ConstIterator>(pids);
+			}
+		#endif
 
 		ConstIterator it;
 		// The list of PIDs must follow -p without a space.
@@ -319,10 +620,18 @@ public:
 		psOutput.resize(0);
 		if (canMeasureRealMemory) {
 			ProcessMetricMap::iterator it;
+			#ifndef __APPLE__
+				string buffer;
+			#endif
 			for (it = result.begin(); it != result.end(); it++) {
 				ProcessMetrics &metric = it->second;
-				measureRealMemory(metric.pid, metric.pss,
-					metric.privateDirty, metric.swap);
+				#ifdef __APPLE__
+					measureRealMemory(metric.pid, metric.pss,
+						metric.privateDirty, metric.swap);
+				#else
+					measureRealMemory(metric.pid, hasSmapsRollup, buffer,
+						metric.pss, metric.privateDirty, metric.swap);
+				#endif
 			}
 		}
 		return result;
@@ -405,83 +714,48 @@ public:
 			pss /= 1024;
 			privateDirty /= 1024;
 		#else
-			string smapsFilename = "/proc/";
-			smapsFilename.append(toString(pid));
-			smapsFilename.append("/smaps");
+			string buffer;
+			measureRealMemory(pid, true, buffer, pss, privateDirty, swap);
+		#endif
+	}
 
-			FILE *f = syscalls::fopen(smapsFilename.c_str(), "r");
-			if (f == NULL) {
-				error:
+	#ifndef __APPLE__
+		/**
+		 * Like measureRealMemory(pid, pss, privateDirty, swap), but reads
+		 * /proc/<PID>/smaps_rollup if `useSmapsRollup` is true (Linux >= 4.14),
+		 * which is much smaller than /proc/<PID>/smaps, and reuses `buffer`
+		 * for reading.
+		 */
+		static void measureRealMemory(pid_t pid, bool useSmapsRollup, string &buffer,
+			ssize_t &pss, ssize_t &privateDirty, ssize_t &swap)
+		{
+			char path[64];
+			ssize_t size = -1;
+
+			if (useSmapsRollup) {
+				snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int) pid);
+				size = readProcFile(path, buffer);
+			}
+			if (size == -1) {
+				snprintf(path, sizeof(path), "/proc/%d/smaps", (int) pid);
+				size = readProcFile(path, buffer);
+			}
+			if (size == -1) {
 				pss = -1;
 				privateDirty = -1;
 				swap = -1;
 				return;
 			}
 
-			StdioGuard guard(f, NULL, 0);
-			bool hasPss = false;
-			bool hasPrivateDirty = false;
-			bool hasSwap = false;
-
-			// In KB.
-			pss = 0;
-			privateDirty = 0;
-			swap = 0;
-
-			while (!feof(f)) {
-				char line[1024 * 4];
-				const char *buf;
-
-				buf = fgets(line, sizeof(line), f);
-				if (buf == NULL) {
-					if (ferror(f)) {
-						goto error;
-					} else {
-						break;
-					}
-				}
-				try {
-					if (startsWith(line, "Pss:")) {
-						/* Linux supports Proportional Set Size since kernel 2.6.25.
-						 * See kernel commit ec4dd3eb35759f9fbeb5c1abb01403b2fde64cc9.
-						 */
-						hasPss = true;
-						readNextWord(&buf);
-						pss += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					} else if (startsWith(line, "Private_Dirty:")) {
-						hasPrivateDirty = true;
-						readNextWord(&buf);
-						privateDirty += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					} else if (startsWith(line, "Swap:")) {
-						hasSwap = true;
-						readNextWord(&buf);
-						swap += readNextWordAsLongLong(&buf);
-						if (readNextWord(&buf) != "kB") {
-							goto error;
-						}
-					}
-				} catch (const ParseException &) {
-					goto error;
-				}
-			}
-
-			if (!hasPss) {
+			try {
+				parseSmaps(buffer.c_str(), pss, privateDirty, swap);
+			} catch (const ParseException &) {
 				pss = -1;
-			}
-			if (!hasPrivateDirty) {
 				privateDirty = -1;
-			}
-			if (!hasSwap) {
 				swap = -1;
 			}
-		#endif
-	}
+		}
+	#endif
 };
 
 } // namespace Passenger
@@ -0,0 +1,124 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+#ifndef _PASSENGER_SHARDED_SHARED_MUTEX_H_
+#define _PASSENGER_SHARDED_SHARED_MUTEX_H_
+
+#include <boost/thread.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <pthread.h>
+#include <stdint.h>
+
+namespace Passenger {
+
+using namespace boost;
+
+
+/**
+ * A reader-writer mutex that is optimized for the case where shared (reader)
+ * locks are taken very frequently from many threads, while exclusive (writer)
+ * locks are comparatively rare.
+ *
+ * A shared lock only grabs one of SHARD_COUNT internal mutexes, selected by
+ * the calling thread's identity, so threads on different shards never touch
+ * the same cache line. An exclusive lock grabs all shards in order. This is
+ * the classic "big reader lock" design.
+ *
+ * Satisfies the Lockable and SharedLockable concepts, so it can be used with
+ * `boost::lock_guard`, `boost::unique_lock`, `boost::shared_lock` and
+ * `boost::condition_variable_any`. A shared lock must be released by the same
+ * thread that acquired it. Neither mode is recursive.
+ */
+class ShardedSharedMutex: public boost::noncopyable {
+public:
+	static const unsigned int SHARD_COUNT = 16;
+
+private:
+	/* Padded so that the mutexes of two adjacent shards never share a
+	 * cache line, regardless of the alignment of the array.
+	 */
+	struct Shard {
+		boost::mutex mutex;
+		char padding[128];
+	};
+
+	Shard shards[SHARD_COUNT];
+
+	static unsigned int currentShard() {
+		// pthread_t is usually the address of a thread control block,
+		// whose lower bits carry little entropy. Mix it (MurmurHash3 finalizer).
+		boost::uint64_t h = (boost::uint64_t) (uintptr_t) pthread_self();
+		h ^= h >> 33;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+		return (unsigned int) (h % SHARD_COUNT);
+	}
+
+public:
+	void lock() {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			shards[i].mutex.lock();
+		}
+	}
+
+	bool try_lock() {
+		for (unsigned int i = 0; i < SHARD_COUNT; i++) {
+			if (!shards[i].mutex.try_lock()) {
+				while (i > 0) {
+					i--;
+					shards[i].mutex.unlock();
+				}
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void unlock() {
+		unsigned int i = SHARD_COUNT;
+		while (i > 0) {
+			i--;
+			shards[i].mutex.unlock();
+		}
+	}
+
+	void lock_shared() {
+		shards[currentShard()].mutex.lock();
+	}
+
+	bool try_lock_shared() {
+		return shards[currentShard()].mutex.try_lock();
+	}
+
+	void unlock_shared() {
+		shards[currentShard()].mutex.unlock();
+	}
+};
+
+
+} // namespace Passenger
+
+#endif /* _PASSENGER_SHARDED_SHARED_MUTEX_H_ */
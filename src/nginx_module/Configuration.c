@@ -386,6 +386,9 @@ passenger_create_loc_conf(ngx_conf_t *cf)
     conf->options_cache.len   = 0;
     conf->env_vars_cache.data = NULL;
     conf->env_vars_cache.len  = 0;
+    conf->config_fingerprint.data = NULL;
+    conf->config_fingerprint.len  = 0;
+    conf->config_options_cached   = 0;
 
     return conf;
 }
@@ -399,6 +402,7 @@ cache_loc_conf_options(ngx_conf_t *cf, passenger_loc_conf_t *conf)
     ngx_keyval_t  *env_vars;
     size_t         unencoded_len;
     u_char        *unencoded_buf;
+    uint32_t       crc;
 
     if (generated_cache_location_part(cf, conf) == 0) {
         return NGX_ERROR;
@@ -464,6 +468,27 @@ cache_loc_conf_options(ngx_conf_t *cf, passenger_loc_conf_t *conf)
         free(unencoded_buf);
     }
 
+    /* Fingerprint the cached data. Two different 32-bit hashes are combined
+     * so that accidental collisions between location configs are negligible.
+     */
+
+    ngx_crc32_init(crc);
+    ngx_crc32_update(&crc, conf->options_cache.data, conf->options_cache.len);
+    ngx_crc32_update(&crc, conf->env_vars_cache.data, conf->env_vars_cache.len);
+    ngx_crc32_final(crc);
+
+    conf->config_fingerprint.data = ngx_palloc(cf->pool, 2 * 8);
+    if (conf->config_fingerprint.data == NULL) {
+        ngx_conf_log_error(NGX_LOG_EMERG, cf, 0,
+                           "cannot allocate buffer for configuration fingerprint");
+        return NGX_ERROR;
+    }
+    conf->config_fingerprint.len = ngx_sprintf(conf->config_fingerprint.data,
+        "%08xD%08xD", crc,
+        ngx_murmur_hash2(conf->options_cache.data, conf->options_cache.len)
+        ^ ngx_murmur_hash2(conf->env_vars_cache.data, conf->env_vars_cache.len))
+        - conf->config_fingerprint.data;
+
     return NGX_OK;
 }
 
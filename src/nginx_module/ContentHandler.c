@@ -720,18 +720,39 @@ construct_request_buffer(ngx_http_request_t *r, passenger_loc_conf_t *slcf,
         }
     }
 
-    if (b != NULL) {
-        b->last = ngx_copy(b->last, slcf->options_cache.data, slcf->options_cache.len);
-    }
-    total_size += slcf->options_cache.len;
-
-    if (slcf->env_vars_cache.data != NULL) {
-        PUSH_STATIC_STR("!~PASSENGER_ENV_VARS: ");
+    if (context->config_options_omitted) {
+        /* The core has the options cached, so we only send the fingerprint. */
+        PUSH_STATIC_STR("!~PASSENGER_CACHED_CONFIG_FINGERPRINT: ");
         if (b != NULL) {
-            b->last = ngx_copy(b->last, slcf->env_vars_cache.data, slcf->env_vars_cache.len);
+            b->last = ngx_copy(b->last, slcf->config_fingerprint.data,
+                slcf->config_fingerprint.len);
         }
-        total_size += slcf->env_vars_cache.len;
+        total_size += slcf->config_fingerprint.len;
         PUSH_STATIC_STR("\r\n");
+    } else {
+        if (b != NULL) {
+            b->last = ngx_copy(b->last, slcf->options_cache.data, slcf->options_cache.len);
+        }
+        total_size += slcf->options_cache.len;
+
+        if (slcf->config_fingerprint.data != NULL) {
+            PUSH_STATIC_STR("!~PASSENGER_CONFIG_FINGERPRINT: ");
+            if (b != NULL) {
+                b->last = ngx_copy(b->last, slcf->config_fingerprint.data,
+                    slcf->config_fingerprint.len);
+            }
+            total_size += slcf->config_fingerprint.len;
+            PUSH_STATIC_STR("\r\n");
+        }
+
+        if (slcf->env_vars_cache.data != NULL) {
+            PUSH_STATIC_STR("!~PASSENGER_ENV_VARS: ");
+            if (b != NULL) {
+                b->last = ngx_copy(b->last, slcf->env_vars_cache.data, slcf->env_vars_cache.len);
+            }
+            total_size += slcf->env_vars_cache.len;
+            PUSH_STATIC_STR("\r\n");
+        }
     }
 
     /* D = Dechunk response
@@ -772,6 +793,10 @@ create_request(ngx_http_request_t *r)
 
     /* Construct and pass request headers */
 
+    context->config_options_omitted = slcf->config_fingerprint.data != NULL
+        && slcf->config_options_cached;
+    context->config_miss = 0;
+
     if (prepare_request_buffer_construction(r, context, &state) != NGX_OK) {
         return NGX_ERROR;
     }
@@ -1109,6 +1134,45 @@ done:
 }
 
 
+/**
+ * Called when the core responded that it does not have the options cached
+ * that we left out of the request, e.g. because it was restarted. Aborts the
+ * upstream request and internally redirects the request to itself, so that
+ * it is sent to the core again, this time along with the options. The
+ * request body (if any) was completely read into r->request_body before the
+ * first attempt, so it can be sent again.
+ *
+ * Returns NGX_OK if the core's response must be passed to the client instead.
+ */
+static ngx_int_t
+resend_request_with_options(ngx_http_request_t *r)
+{
+    ngx_http_upstream_t  *u = r->upstream;
+
+    if (r->uri_changes <= 1 || u->cleanup == NULL) {
+        return NGX_OK;
+    }
+
+    ngx_log_debug0(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
+                   "Passenger core does not have the location's options "
+                   "cached; resending request");
+
+    /* Finalizing the upstream request drops a reference to the request,
+     * just like ngx_http_upstream_create() does when reinitializing an
+     * upstream request. The internal redirect takes over that reference.
+     */
+    r->main->count++;
+    (*u->cleanup)(r);
+
+    ngx_http_internal_redirect(r, &r->uri, &r->args);
+
+    /* Our caller finalizes the (already finalized) upstream request, which
+     * drops the reference that we took above.
+     */
+    return NGX_ERROR;
+}
+
+
 static ngx_int_t
 process_header(ngx_http_request_t *r)
 {
@@ -1119,9 +1183,16 @@ process_header(ngx_http_request_t *r)
     ngx_http_upstream_header_t     *hh;
     ngx_http_upstream_main_conf_t  *umcf;
     ngx_http_core_loc_conf_t       *clcf;
+    passenger_loc_conf_t           *slcf;
+    passenger_context_t            *context;
 
     umcf = ngx_http_get_module_main_conf(r, ngx_http_upstream_module);
     clcf = ngx_http_get_module_loc_conf(r, ngx_http_core_module);
+    slcf = ngx_http_get_module_loc_conf(r, ngx_http_passenger_module);
+    context = ngx_http_get_module_ctx(r, ngx_http_passenger_module);
+    if (context == NULL) {
+        return NGX_ERROR;
+    }
 
     for ( ;; ) {
 
@@ -1170,6 +1241,13 @@ process_header(ngx_http_request_t *r)
                 return NGX_ERROR;
             }
 
+            if (h->key.len == sizeof("x-passenger-config-miss") - 1
+                && ngx_strncmp(h->lowcase_key, "x-passenger-config-miss",
+                               h->key.len) == 0)
+            {
+                context->config_miss = 1;
+            }
+
             ngx_log_debug2(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
                            "http scgi header: \"%V: %V\"", &h->key, &h->value);
 
@@ -1183,6 +1261,22 @@ process_header(ngx_http_request_t *r)
             ngx_log_debug0(NGX_LOG_DEBUG_HTTP, r->connection->log, 0,
                            "http scgi header done");
 
+            if (context->config_miss) {
+                slcf->config_options_cached = 0;
+                if (context->config_options_omitted
+                    && resend_request_with_options(r) != NGX_OK)
+                {
+                    return NGX_ERROR;
+                }
+            } else if (!context->config_options_omitted
+                       && slcf->config_fingerprint.data != NULL)
+            {
+                /* The core caches the options of every request that
+                 * it responds to, so leave them out from now on.
+                 */
+                slcf->config_options_cached = 1;
+            }
+
             /*
              * if no "Server" and "Date" in header line,
              * then add the default headers
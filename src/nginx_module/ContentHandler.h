@@ -48,6 +48,14 @@ typedef struct {
 
     /** The application's type. */
     PassengerAppType app_type;
+
+    /** Whether the location's options were left out of the request
+     * because the core has them cached. */
+    ngx_flag_t  config_options_omitted;
+
+    /** Whether the core responded that it does not have the options
+     * cached after all. */
+    ngx_flag_t  config_miss;
 } passenger_context_t;
 
 
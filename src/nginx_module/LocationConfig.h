@@ -47,6 +47,13 @@ typedef struct {
     /** Raw HTTP header data for this location are cached here. */
     ngx_str_t    options_cache;
     ngx_str_t    env_vars_cache;
+    /** Fingerprint of the above data, so that the core can cache the
+     * options that it parsed from them. */
+    ngx_str_t    config_fingerprint;
+    /** Whether the core has the options cached under the above fingerprint,
+     * as far as this worker process knows. If so, then the options are left
+     * out of requests. */
+    ngx_flag_t   config_options_cached;
 
     ngx_int_t abort_websockets_on_process_shutdown;
     ngx_uint_t app_file_descriptor_ulimit;
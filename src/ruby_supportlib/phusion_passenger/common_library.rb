@@ -319,6 +319,10 @@ def locate_source_file(path)
     :source   => 'ServerKit/http_parser.cpp',
     :category => :other,
     :optimize => :very_heavy
+  define_component 'ServerKit/HttpScanning.o',
+    :source   => 'ServerKit/HttpScanning.cpp',
+    :category => :other,
+    :optimize => :very_heavy
   define_component 'ServerKit/Implementation.o',
     :source   => 'ServerKit/Implementation.cpp',
     :category => :other,
@@ -43,8 +43,10 @@ module PhusionPassenger
   module SharedConstants
     # Default config values
     DEFAULT_LOG_LEVEL = 3
+    DEFAULT_LOG_BUFFER_SIZE = 1024 * 64
     DEFAULT_INTEGRATION_MODE = "standalone"
     DEFAULT_SOCKET_BACKLOG = 2048
+    DEFAULT_SPLICE_THRESHOLD = 1024 * 1024
     DEFAULT_RUBY = "ruby"
     DEFAULT_PYTHON = "python"
     DEFAULT_NODEJS = "node"
@@ -55,6 +57,9 @@ module SharedConstants
     DEFAULT_WEB_APP_USER = "nobody"
     DEFAULT_APP_ENV = "production"
     DEFAULT_SPAWN_METHOD = "smart"
+    DEFAULT_SPAWN_CONCURRENCY = 1
+    DEFAULT_MAX_CONCURRENT_SPAWNS = 0
+    DEFAULT_ROUTING_POLICY = "least_busy"
     # Apache's unixd.h also defines DEFAULT_USER, so we avoid naming clash here.
     PASSENGER_DEFAULT_USER = "nobody"
     DEFAULT_CONCURRENCY_MODEL = "process"
@@ -63,11 +68,20 @@ module SharedConstants
     DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK = 1024 * 1024 * 128
     DEFAULT_MAX_REQUEST_QUEUE_SIZE = 100
     DEFAULT_STAT_THROTTLE_RATE = 10
+    DEFAULT_TURBOCACHE_MAX_ENTRIES = 1024
+    DEFAULT_TURBOCACHE_MAX_BODY_SIZE = 1024 * 32
+    DEFAULT_TURBOCACHE_MEMORY_LIMIT = 1024 * 1024 * 8
+    DEFAULT_MEMORY_RECLAMATION_INTERVAL = 10
+    DEFAULT_MEMORY_RECLAMATION_WINDOW = 30
+    DEFAULT_MEMORY_RECLAMATION_MBUF_FLOOR = 256
     DEFAULT_ANALYTICS_LOG_USER = DEFAULT_WEB_APP_USER
     DEFAULT_ANALYTICS_LOG_GROUP = ""
     DEFAULT_ANALYTICS_LOG_PERMISSIONS = "u=rwx,g=rx,o=rx"
     DEFAULT_UNION_STATION_GATEWAY_ADDRESS = "gateway.unionstationapp.com"
     DEFAULT_UNION_STATION_GATEWAY_PORT = 443
+    DEFAULT_UNION_STATION_MAX_CONCURRENT_UPLOADS = 4
+    DEFAULT_UNION_STATION_COMPRESSION_THREADS = 2
+    DEFAULT_UNION_STATION_SENDER_MEMORY_LIMIT = 1024 * 1024 * 64
     DEFAULT_HTTP_SERVER_LISTEN_ADDRESS = "tcp://127.0.0.1:3000"
     DEFAULT_UST_ROUTER_LISTEN_ADDRESS = "tcp://127.0.0.1:9344"
     DEFAULT_LVE_MIN_UID = 500
@@ -80,6 +94,10 @@ module SharedConstants
     # also introduce context switching and smaller transfer writes. The size is picked 
     # to balance this out.
     DEFAULT_MBUF_CHUNK_SIZE = 1024 * 4
+    # Size classes next to the default one, for sockets whose recent reads were
+    # small (idle keep-alive connections) or filled whole blocks (large bodies).
+    DEFAULT_SMALL_MBUF_CHUNK_SIZE = 1024
+    DEFAULT_LARGE_MBUF_CHUNK_SIZE = 1024 * 64
     # Affects input and output buffering (between app and client). Threshold is picked
     # such that it fits most output (i.e. html page size, not assets), and allows for
     # high concurrency with low mem overhead. On the upload side there is a penalty 
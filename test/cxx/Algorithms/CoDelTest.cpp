@@ -0,0 +1,60 @@
+#include <TestSupport.h>
+#include <Algorithms/CoDel.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Algorithms_CoDelTest {
+		// Target 10 ms, so the interval is 200 ms.
+		CoDel codel;
+
+		Algorithms_CoDelTest()
+			: codel(10000)
+			{ }
+	};
+
+	DEFINE_TEST_GROUP(Algorithms_CoDelTest);
+
+	TEST_METHOD(1) {
+		set_test_name("A disabled instance never sheds");
+		CoDel disabled;
+		ensure(!disabled.isEnabled());
+		disabled.update(1000000, 5000000);
+		disabled.update(9000000, 5000000);
+		ensure(!disabled.isOverloaded());
+		ensure(!disabled.shouldShed(5000000));
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("A short burst above the target does not cause overload");
+		codel.update(1000000, 50000);
+		codel.update(1100000, 80000);
+		// The queue drained before the interval ended.
+		codel.update(1150000, 0);
+		codel.update(1250000, 50000);
+		ensure(!codel.isOverloaded());
+		ensure(!codel.shouldShed(50000));
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("A sojourn time that stays above the target for a "
+			"whole interval causes overload");
+		codel.update(1000000, 50000);
+		codel.update(1100000, 60000);
+		codel.update(1200000, 40000);
+		ensure("(1)", codel.isOverloaded());
+		ensure("(2)", codel.shouldShed(10001));
+		ensure("(3)", !codel.shouldShed(10000));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Overload ends after an interval in which the queue drained");
+		codel.update(1000000, 50000);
+		codel.update(1200000, 50000);
+		ensure("(1)", codel.isOverloaded());
+		codel.update(1300000, 0);
+		codel.update(1400000, 50000);
+		ensure("(2)", !codel.isOverloaded());
+	}
+}
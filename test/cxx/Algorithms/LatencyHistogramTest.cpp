@@ -0,0 +1,93 @@
+#include <TestSupport.h>
+#include <Algorithms/LatencyHistogram.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Algorithms_LatencyHistogramTest {
+		LatencyHistogram histogram;
+	};
+
+	DEFINE_TEST_GROUP(Algorithms_LatencyHistogramTest);
+
+	TEST_METHOD(1) {
+		set_test_name("An empty histogram reports zeroes");
+		ensure_equals(histogram.getCount(), 0u);
+		ensure_equals(histogram.getMin(), 0u);
+		ensure_equals(histogram.getMax(), 0u);
+		ensure_equals(histogram.getValueAtPercentile(99), 0u);
+		ensure_equals(histogram.inspectAsJson()["count"].asUInt(), 0u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Small values are recorded exactly");
+		for (unsigned int i = 1; i <= 10; i++) {
+			histogram.record(i);
+		}
+		ensure_equals(histogram.getCount(), 10u);
+		ensure_equals(histogram.getMin(), 1u);
+		ensure_equals(histogram.getMax(), 10u);
+		ensure_equals(histogram.getMean(), 5.5);
+		ensure_equals(histogram.getValueAtPercentile(50), 5u);
+		ensure_equals(histogram.getValueAtPercentile(90), 9u);
+		ensure_equals(histogram.getValueAtPercentile(100), 10u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Large values are reported with a bounded relative error");
+		for (unsigned int i = 1; i <= 1000; i++) {
+			histogram.record(i * 1000);
+		}
+
+		boost::uint64_t p50 = histogram.getValueAtPercentile(50);
+		boost::uint64_t p99 = histogram.getValueAtPercentile(99);
+		ensure("p50 is not underestimated", p50 >= 500000);
+		ensure("p50 is within 6.25%", p50 <= 500000 + 500000 / 16);
+		ensure("p99 is not underestimated", p99 >= 990000);
+		ensure("p99 is within 6.25%", p99 <= 990000 + 990000 / 16);
+		ensure_equals("Percentiles are capped by the maximum",
+			histogram.getValueAtPercentile(100), 1000000u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Values larger than MAX_VALUE are clamped");
+		histogram.record(LatencyHistogram::MAX_VALUE * 4);
+		ensure_equals(histogram.getMax(), (boost::uint64_t) LatencyHistogram::MAX_VALUE);
+		ensure_equals(histogram.getValueAtPercentile(50),
+			(boost::uint64_t) LatencyHistogram::MAX_VALUE);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("merge() combines counts, minimums and maximums");
+		LatencyHistogram other;
+
+		histogram.record(100);
+		histogram.record(200);
+		other.record(50);
+		other.record(5000);
+		histogram.merge(other);
+
+		ensure_equals(histogram.getCount(), 4u);
+		ensure_equals(histogram.getMin(), 50u);
+		ensure_equals(histogram.getMax(), 5000u);
+		ensure_equals(histogram.getMean(), (100 + 200 + 50 + 5000) / 4.0);
+		// 50 falls in the bucket [50, 51]; its upper bound is reported.
+		ensure_equals(histogram.getValueAtPercentile(25), 51u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("merge() into an empty histogram copies the other one");
+		LatencyHistogram other;
+
+		other.record(300);
+		histogram.merge(other);
+		ensure_equals(histogram.getCount(), 1u);
+		ensure_equals(histogram.getMin(), 300u);
+		ensure_equals(histogram.getMax(), 300u);
+
+		histogram.merge(LatencyHistogram());
+		ensure_equals(histogram.getCount(), 1u);
+		ensure_equals(histogram.getMin(), 300u);
+	}
+}
@@ -0,0 +1,212 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how many sessions per second the ApplicationPool can check out
+ * and close while N threads call asyncGet() concurrently. Two scenarios are
+ * measured: all threads checking out from the same group, and each thread
+ * checking out from its own group. The processes are dummy processes, so
+ * only the pool's own bookkeeping and locking is measured.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/ApplicationPool/CheckoutContentionBenchmark [MAX_THREADS] [MSEC_PER_RUN]
+ */
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/initialize.hpp>
+#include <oxt/thread.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <signal.h>
+#include <unistd.h>
+
+#include <ResourceLocator.h>
+#include <Logging.h>
+#include <Utils.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+#include <Core/ApplicationPool/Pool.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+const unsigned int PROCESSES_PER_GROUP = 4;
+
+struct Worker {
+	Options options;
+	unsigned long long checkouts;
+	unsigned long long errors;
+};
+
+boost::atomic<bool> started;
+boost::atomic<bool> stopped;
+
+
+Options
+createOptions(const string &appGroupName) {
+	Options options;
+	options.spawnMethod = "dummy";
+	options.appRoot = "stub/rack";
+	options.appGroupName = appGroupName;
+	options.startCommand = "ruby\t" "start.rb";
+	options.startupFile  = "start.rb";
+	options.loadShellEnvvars = false;
+	options.minProcesses = PROCESSES_PER_GROUP;
+	return options.copyAndPersist();
+}
+
+void
+checkoutLoop(PoolPtr pool, Worker *worker) {
+	while (!started.load(boost::memory_order_acquire)) {
+		// Spin until all threads are ready.
+	}
+	while (!stopped.load(boost::memory_order_relaxed)) {
+		Ticket ticket;
+		try {
+			SessionPtr session = pool->get(worker->options, &ticket);
+			session->close(true);
+			worker->checkouts++;
+		} catch (const std::exception &) {
+			worker->errors++;
+		}
+	}
+}
+
+double
+measure(const PoolPtr &pool, const vector<string> &groupNames,
+	unsigned int nthreads, unsigned int msec)
+{
+	vector<Worker> workers(nthreads);
+	vector<oxt::thread *> threads;
+	unsigned long long total = 0, errors = 0;
+	unsigned long long startTime, endTime;
+
+	for (unsigned int i = 0; i < nthreads; i++) {
+		workers[i].options = createOptions(groupNames[i % groupNames.size()]);
+		workers[i].checkouts = 0;
+		workers[i].errors = 0;
+	}
+
+	started.store(false);
+	stopped.store(false);
+	for (unsigned int i = 0; i < nthreads; i++) {
+		threads.push_back(new oxt::thread(
+			boost::bind(checkoutLoop, pool, &workers[i]),
+			"Checkout thread " + toString(i + 1),
+			1024 * 256));
+	}
+
+	startTime = SystemTime::getMonotonicUsec();
+	started.store(true, boost::memory_order_release);
+	usleep(msec * 1000);
+	stopped.store(true);
+	for (unsigned int i = 0; i < nthreads; i++) {
+		threads[i]->join();
+		delete threads[i];
+	}
+	endTime = SystemTime::getMonotonicUsec();
+
+	for (unsigned int i = 0; i < nthreads; i++) {
+		total += workers[i].checkouts;
+		errors += workers[i].errors;
+	}
+	if (errors > 0) {
+		fprintf(stderr, "*** WARNING: %llu checkouts failed\n", errors);
+	}
+	return total / ((endTime - startTime) / 1000000.0);
+}
+
+void
+spawnGroups(const PoolPtr &pool, const vector<string> &groupNames) {
+	for (unsigned int i = 0; i < groupNames.size(); i++) {
+		Ticket ticket;
+		pool->get(createOptions(groupNames[i]), &ticket)->close(true);
+	}
+	while (pool->getProcessCount() < groupNames.size() * PROCESSES_PER_GROUP) {
+		usleep(10000);
+	}
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int maxThreads = (argc > 1) ? atoi(argv[1]) : 16;
+	unsigned int msec = (argc > 2) ? atoi(argv[2]) : 2000;
+	vector<string> sharedGroup, ownGroups;
+	char path[PATH_MAX + 1];
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	getcwd(path, PATH_MAX);
+	ResourceLocator resourceLocator(extractDirName(path));
+	SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+	spawningKitConfig->resourceLocator = &resourceLocator;
+	// Let every process accept an unlimited number of concurrent sessions,
+	// so that checkouts never have to wait for a process to become free.
+	spawningKitConfig->concurrency = 0;
+	spawningKitConfig->finalize();
+	SpawningKit::FactoryPtr spawningKitFactory =
+		boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
+
+	PoolPtr pool = boost::make_shared<Pool>(spawningKitFactory);
+	pool->initialize();
+	pool->setMax((maxThreads + 1) * PROCESSES_PER_GROUP);
+
+	sharedGroup.push_back("shared");
+	for (unsigned int i = 0; i < maxThreads; i++) {
+		ownGroups.push_back("group" + toString(i + 1));
+	}
+	spawnGroups(pool, sharedGroup);
+	spawnGroups(pool, ownGroups);
+
+	printf("%-8s  %26s  %26s\n", "Threads",
+		"Same group (checkouts/sec)", "Own group (checkouts/sec)");
+	for (unsigned int nthreads = 1; nthreads <= maxThreads; nthreads *= 2) {
+		double sameGroupRate = measure(pool, sharedGroup, nthreads, msec);
+		double ownGroupRate = measure(pool, ownGroups, nthreads, msec);
+		printf("%-8u  %26.0f  %26.0f\n", nthreads, sameGroupRate, ownGroupRate);
+		fflush(stdout);
+	}
+
+	pool->destroy();
+	pool.reset();
+	oxt::shutdown();
+	return 0;
+}
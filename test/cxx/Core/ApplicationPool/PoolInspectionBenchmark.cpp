@@ -0,0 +1,240 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures the latency of checking out and closing sessions while another
+ * thread scrapes the pool status XML (as served on /pool.xml) in a tight
+ * loop, compared to when nobody is scraping. The processes are dummy
+ * processes, so only the pool's own bookkeeping and locking is measured.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/ApplicationPool/PoolInspectionBenchmark [GROUPS] [THREADS] [MSEC_PER_RUN]
+ */
+#include <boost/make_shared.hpp>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/initialize.hpp>
+#include <oxt/thread.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <signal.h>
+#include <unistd.h>
+
+#include <ResourceLocator.h>
+#include <Logging.h>
+#include <Utils.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+#include <Algorithms/LatencyHistogram.h>
+#include <Core/ApplicationPool/Pool.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+const unsigned int PROCESSES_PER_GROUP = 4;
+
+enum ScrapeMode {
+	NO_SCRAPING,
+	SCRAPE_FRESH,
+	SCRAPE_SNAPSHOT
+};
+
+struct Worker {
+	Options options;
+	LatencyHistogram latencies;
+};
+
+boost::atomic<bool> started;
+boost::atomic<bool> stopped;
+
+
+Options
+createOptions(const string &appGroupName) {
+	Options options;
+	options.spawnMethod = "dummy";
+	options.appRoot = "stub/rack";
+	options.appGroupName = appGroupName;
+	options.startCommand = "ruby\t" "start.rb";
+	options.startupFile  = "start.rb";
+	options.loadShellEnvvars = false;
+	options.minProcesses = PROCESSES_PER_GROUP;
+	return options.copyAndPersist();
+}
+
+void
+checkoutLoop(PoolPtr pool, Worker *worker) {
+	while (!started.load(boost::memory_order_acquire)) {
+		// Spin until all threads are ready.
+	}
+	while (!stopped.load(boost::memory_order_relaxed)) {
+		unsigned long long startTime = SystemTime::getMonotonicUsec();
+		Ticket ticket;
+		SessionPtr session = pool->get(worker->options, &ticket);
+		session->close(true);
+		worker->latencies.record(SystemTime::getMonotonicUsec() - startTime);
+	}
+}
+
+void
+scrapeLoop(PoolPtr pool, ScrapeMode mode, unsigned long long *scrapes) {
+	Pool::ToXmlOptions options(Pool::ToXmlOptions::makeAuthorized());
+
+	while (!started.load(boost::memory_order_acquire)) {
+		// Spin until all threads are ready.
+	}
+	while (!stopped.load(boost::memory_order_relaxed)) {
+		if (mode == SCRAPE_FRESH) {
+			pool->toXml(options);
+		} else {
+			// This is what the ApiServer does for /pool.xml.
+			pool->getSnapshot()->toXml(options);
+		}
+		(*scrapes)++;
+	}
+}
+
+void
+measure(const PoolPtr &pool, const vector<string> &groupNames,
+	unsigned int nthreads, unsigned int msec, ScrapeMode mode,
+	LatencyHistogram &latencies, unsigned long long &scrapes)
+{
+	vector<Worker> workers(nthreads);
+	vector<oxt::thread *> threads;
+
+	for (unsigned int i = 0; i < nthreads; i++) {
+		workers[i].options = createOptions(groupNames[i % groupNames.size()]);
+	}
+
+	started.store(false);
+	stopped.store(false);
+	scrapes = 0;
+	for (unsigned int i = 0; i < nthreads; i++) {
+		threads.push_back(new oxt::thread(
+			boost::bind(checkoutLoop, pool, &workers[i]),
+			"Checkout thread " + toString(i + 1),
+			1024 * 256));
+	}
+	if (mode != NO_SCRAPING) {
+		threads.push_back(new oxt::thread(
+			boost::bind(scrapeLoop, pool, mode, &scrapes),
+			"Scrape thread",
+			1024 * 256));
+	}
+
+	started.store(true, boost::memory_order_release);
+	usleep(msec * 1000);
+	stopped.store(true);
+	for (unsigned int i = 0; i < threads.size(); i++) {
+		threads[i]->join();
+		delete threads[i];
+	}
+
+	latencies.reset();
+	for (unsigned int i = 0; i < nthreads; i++) {
+		latencies.merge(workers[i].latencies);
+	}
+}
+
+void
+spawnGroups(const PoolPtr &pool, const vector<string> &groupNames) {
+	for (unsigned int i = 0; i < groupNames.size(); i++) {
+		Ticket ticket;
+		pool->get(createOptions(groupNames[i]), &ticket)->close(true);
+	}
+	while (pool->getProcessCount() < groupNames.size() * PROCESSES_PER_GROUP) {
+		usleep(10000);
+	}
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int ngroups = (argc > 1) ? atoi(argv[1]) : 16;
+	unsigned int nthreads = (argc > 2) ? atoi(argv[2]) : 4;
+	unsigned int msec = (argc > 3) ? atoi(argv[3]) : 2000;
+	const char *modeNames[] = { "none", "Pool::toXml()", "getSnapshot()->toXml()" };
+	vector<string> groupNames;
+	char path[PATH_MAX + 1];
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	getcwd(path, PATH_MAX);
+	ResourceLocator resourceLocator(extractDirName(path));
+	SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+	spawningKitConfig->resourceLocator = &resourceLocator;
+	// Let every process accept an unlimited number of concurrent sessions,
+	// so that checkouts never have to wait for a process to become free.
+	spawningKitConfig->concurrency = 0;
+	spawningKitConfig->finalize();
+	SpawningKit::FactoryPtr spawningKitFactory =
+		boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
+
+	PoolPtr pool = boost::make_shared<Pool>(spawningKitFactory);
+	pool->initialize();
+	pool->setMax(ngroups * PROCESSES_PER_GROUP);
+
+	for (unsigned int i = 0; i < ngroups; i++) {
+		groupNames.push_back("group" + toString(i + 1));
+	}
+	spawnGroups(pool, groupNames);
+
+	printf("%u groups, %u processes, %u checkout threads\n",
+		ngroups, ngroups * PROCESSES_PER_GROUP, nthreads);
+	printf("%-24s  %12s  %10s  %10s  %10s  %10s\n", "Scraping", "Scrapes/sec",
+		"p50 (us)", "p99 (us)", "p99.9 (us)", "max (us)");
+	for (unsigned int i = 0; i < sizeof(modeNames) / sizeof(const char *); i++) {
+		LatencyHistogram latencies;
+		unsigned long long scrapes;
+
+		measure(pool, groupNames, nthreads, msec, (ScrapeMode) i, latencies, scrapes);
+		printf("%-24s  %12.0f  %10llu  %10llu  %10llu  %10llu\n",
+			modeNames[i],
+			scrapes / (msec / 1000.0),
+			(unsigned long long) latencies.getValueAtPercentile(50),
+			(unsigned long long) latencies.getValueAtPercentile(99),
+			(unsigned long long) latencies.getValueAtPercentile(99.9),
+			(unsigned long long) latencies.getMax());
+		fflush(stdout);
+	}
+
+	pool->destroy();
+	pool.reset();
+	oxt::shutdown();
+	return 0;
+}
@@ -6,6 +6,7 @@
 #include <MessageReadersWriters.h>
 #include <map>
 #include <vector>
+#include <set>
 #include <cerrno>
 #include <signal.h>
 
@@ -14,6 +15,16 @@ using namespace Passenger;
 using namespace Passenger::ApplicationPool2;
 
 namespace tut {
+	static boost::atomic<unsigned int> restartFileStatCount;
+
+	static int
+	countingStat(const char *path, struct stat *buf) {
+		if (strstr(path, "restart.txt") != NULL) {
+			restartFileStatCount++;
+		}
+		return stat(path, buf);
+	}
+
 	struct Core_ApplicationPool_PoolTest {
 		SpawningKit::ConfigPtr spawningKitConfig;
 		SpawningKit::FactoryPtr spawningKitFactory;
@@ -36,6 +47,9 @@ namespace tut {
 			spawningKitFactory = boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
 			pool = boost::make_shared<Pool>(spawningKitFactory);
 			pool->initialize();
+			// Most tests touch restart.txt and expect the very next get() to
+			// notice it, which only the stat()-based check guarantees.
+			pool->enableRestartFileWatching(false);
 			callback.func = _callback;
 			callback.userData = this;
 			setLogLevel(LVL_WARN);
@@ -55,6 +69,7 @@ namespace tut {
 			setLogLevel(DEFAULT_LOG_LEVEL);
 			setPrintAppOutputAsDebuggingMessages(false);
 			SystemTime::releaseAll();
+			RestartFileWatcher::setStatFunction(NULL);
 		}
 
 		void initPoolDebugging() {
@@ -205,7 +220,7 @@ namespace tut {
 		// as the new process is done spawning.
 		Options options = createOptions();
 
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("(1)", number, 0);
 		ensure("(2)", pool->getWaitlist.empty());
@@ -240,7 +255,7 @@ namespace tut {
 		ensure(!process->isTotallyBusy());
 
 		// Verify test assertion.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("callback is immediately called", number, 2);
 	}
@@ -361,7 +376,7 @@ namespace tut {
 
 		// Now open another session. It should complete immediately
 		// and should not use the first process.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		pool->asyncGet(options, callback, false);
 		ensure_equals("asyncGet() completed immediately", number, 2);
 		SessionPtr session2 = currentSession;
@@ -394,7 +409,7 @@ namespace tut {
 		GroupPtr group = pool->findOrCreateGroup(options);
 		spawningKitConfig->concurrency = 2;
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			group->spawn();
 		}
 		EVENTUALLY(5,
@@ -513,7 +528,7 @@ namespace tut {
 		);
 
 		// The next asyncGet() should spawn a new process and the action should be queued.
-		ScopedLock l(pool->syncher);
+		PoolScopedLock l(pool->syncher);
 		spawningKitConfig->spawnTime = 5000000;
 		pool->asyncGet(options, callback, false);
 		ensure(group->spawning());
@@ -814,7 +829,7 @@ namespace tut {
 		SystemTime::force(2);
 		GroupPtr barGroup = pool->get(options2, &ticket)->getGroup()->shared_from_this();
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals("(1)", barGroup->spawn(), SR_OK);
 		}
 		debug->debugger->recv("Begin spawn loop iteration 1");
@@ -837,7 +852,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -899,7 +914,7 @@ namespace tut {
 		debug->messages->send("Proceed with spawn loop iteration 2");
 		debug->debugger->recv("Spawn loop done");
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			vector<ProcessPtr> processes = pool->getProcesses(false);
 			if (processes.size() == 1) {
 				GroupPtr group = processes[0]->getGroup()->shared_from_this();
@@ -934,7 +949,7 @@ namespace tut {
 		ProcessPtr process = currentSession->getProcess()->shared_from_this();
 		pool->detachProcess(process);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 		EVENTUALLY(5,
@@ -965,13 +980,13 @@ namespace tut {
 		pool->asyncGet(options, callback);
 
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
 		}
 
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test")->spawning());
 			ensure_equals(pool->groups.lookupCopy("test")->enabledCount, 0);
 			ensure_equals(pool->groups.lookupCopy("test")->getWaitlist.size(), 1u);
@@ -1003,7 +1018,7 @@ namespace tut {
 		spawningKitConfig->spawnTime = 90000;
 		pool->asyncGet(options2, callback);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(pool->getWaitlist.size(), 1u);
 		}
 
@@ -1016,7 +1031,7 @@ namespace tut {
 		currentSession.reset();
 		pool->detachProcess(session1->getProcess()->shared_from_this());
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(pool->groups.lookupCopy("test2") != NULL);
 			ensure_equals(pool->getWaitlist.size(), 0u);
 		}
@@ -1037,7 +1052,7 @@ namespace tut {
 		currentSession.reset();
 		GroupPtr group = process->getGroup()->shared_from_this();
 		pool->detachProcess(process);
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure_equals(pool->groups.size(), 1u);
 		ensure(group->isAlive());
 		ensure(!group->garbageCollectable());
@@ -1054,18 +1069,18 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = !process->isAlive()
 				|| !process->osProcessExists();
 		);
 
 		session.reset();
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1085,7 +1100,7 @@ namespace tut {
 
 		ensure(pool->detachProcess(process));
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(process->enabled, Process::DETACHED);
 		}
 		EVENTUALLY(1,
@@ -1093,7 +1108,7 @@ namespace tut {
 		);
 
 		SHOULD_NEVER_HAPPEN(100,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->isDead()
 				|| !process->osProcessExists();
 		);
@@ -1102,7 +1117,7 @@ namespace tut {
 		g.clear();
 
 		EVENTUALLY(1,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = process->enabled == Process::DETACHED
 				&& !process->osProcessExists()
 				&& process->isDead();
@@ -1132,7 +1147,7 @@ namespace tut {
 		pool->detachProcess(process);
 		debug->debugger->recv("About to start detached processes checker");
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure(process->enabled == Process::DETACHED);
 		}
 
@@ -1164,7 +1179,7 @@ namespace tut {
 		ensure_equals("Disabling succeeds",
 			pool->disableProcess(processes[0]->getGupid()), DR_SUCCESS);
 
-		LockGuard l(pool->syncher);
+		PoolLockGuard l(pool->syncher);
 		ensure(processes[0]->isAlive());
 		ensure_equals("Process is disabled",
 			processes[0]->enabled,
@@ -1238,7 +1253,7 @@ namespace tut {
 		TempThread thr2(boost::bind(&Core_ApplicationPool_PoolTest::disableProcess,
 			this, process2, &code2));
 		EVENTUALLY(5,
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1257,7 +1272,7 @@ namespace tut {
 			result = code2 == DR_SUCCESS;
 		);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 2);
@@ -1285,7 +1300,7 @@ namespace tut {
 			this, session2->getProcess()->shared_from_this(), &code2));
 		EVENTUALLY(2,
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			result = group->enabledCount == 0
 				&& group->disablingCount == 2
 				&& group->disabledCount == 0;
@@ -1304,7 +1319,7 @@ namespace tut {
 		);
 		{
 			GroupPtr group = session1->getGroup()->shared_from_this();
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->enabledCount, 2);
 			ensure_equals(group->disablingCount, 0);
 			ensure_equals(group->disabledCount, 0);
@@ -1363,7 +1378,7 @@ namespace tut {
 		ensure_equals(result, DR_SUCCESS);
 
 		{
-			ScopedLock l(pool->syncher);
+			PoolScopedLock l(pool->syncher);
 			GroupPtr group = processes[0]->getGroup()->shared_from_this();
 			ensure_equals(group->enabledCount, 1);
 			ensure_equals(group->disablingCount, 0);
@@ -1911,7 +1926,7 @@ namespace tut {
 		}
 		ensure_equals(number, 0);
 		{
-			LockGuard l(pool->syncher);
+			PoolLockGuard l(pool->syncher);
 			ensure_equals(group->getWaitlist.size(),
 				3u);
 		}
@@ -2007,9 +2022,225 @@ namespace tut {
 	//       when the session's connection has been released by the app.
 
 
-	/*********** Test previously discovered bugs ***********/
+	/*********** Test concurrent spawning ***********/
+
+	TEST_METHOD(80) {
+		// By default, a group spawns one process at a time.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 3;
+		spawningKitConfig->spawnTime = 100000;
+
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			ensure_equals(group->processesBeingSpawned, 1);
+			ensure_equals(group->spawnThreadCount, 1u);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3;
+		);
+	}
+
+	TEST_METHOD(81) {
+		// If spawnConcurrency > 1, then the group spawns multiple processes
+		// concurrently in order to satisfy minProcesses, and it keeps track
+		// of how long it took to reach capacity.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 3;
+		options.spawnConcurrency = 4;
+		spawningKitConfig->spawnTime = 100000;
+
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			ensure_equals(group->processesBeingSpawned, 3);
+			ensure_equals(group->spawnThreadCount, 3u);
+		}
+		EVENTUALLY(5,
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			result = !group->spawning();
+		);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			ensure_equals(group->getProcessCount(), 3u);
+			ensure_equals(group->lastSpawnBurstProcessCount, 3u);
+			ensure(group->lastSpawnBurstDuration >= 100000);
+		}
+	}
+
+	TEST_METHOD(82) {
+		// Concurrent spawning respects maxProcesses and the pool size.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 10;
+		options.maxProcesses = 3;
+		options.spawnConcurrency = 10;
+		spawningKitConfig->spawnTime = 100000;
+
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			ensure_equals(group->processesBeingSpawned, 3);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3;
+		);
+
+		Options options2 = createOptions();
+		options2.appGroupName = "test2";
+		options2.minProcesses = 10;
+		options2.spawnConcurrency = 10;
+		pool->setMax(5);
+		pool->asyncGet(options2, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test2");
+			ensure_equals(group->processesBeingSpawned, 2);
+		}
+	}
+
+	TEST_METHOD(83) {
+		// Concurrent spawning respects the pool-wide limit on concurrent
+		// spawns, but every group may spawn at least one process at a time.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 4;
+		options.spawnConcurrency = 4;
+		pool->setMax(10);
+		pool->setMaxConcurrentSpawns(2);
+		spawningKitConfig->spawnTime = 100000;
+
+		pool->asyncGet(options, callback);
+		Options options2 = createOptions();
+		options2.appGroupName = "test2";
+		options2.minProcesses = 4;
+		options2.spawnConcurrency = 4;
+		pool->asyncGet(options2, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals(pool->groups.lookupCopy("test")->spawnThreadCount, 2u);
+			ensure_equals(pool->groups.lookupCopy("test2")->spawnThreadCount, 1u);
+		}
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 8;
+		);
+	}
+
+	TEST_METHOD(84) {
+		// When requests are queued because all processes are busy, the group
+		// spawns one process for every queued request, up to spawnConcurrency
+		// processes at a time.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.spawnConcurrency = 3;
+		pool->setMax(10);
+		spawningKitConfig->spawnTime = 100000;
+		retainSessions = true;
+
+		SessionPtr session = pool->get(options, &ticket);
+		for (unsigned int i = 0; i < 4; i++) {
+			pool->asyncGet(options, callback);
+		}
+		{
+			PoolLockGuard l(pool->syncher);
+			GroupPtr group = pool->groups.lookupCopy("test");
+			ensure_equals(group->getWaitlist.size(), 4u);
+			ensure_equals(group->spawnThreadCount, 3u);
+		}
+		EVENTUALLY(5,
+			result = number == 4;
+		);
+		ensure_equals(pool->getProcessCount(), 5u);
+	}
 
 	TEST_METHOD(85) {
+		// Requests that have waited in the getWaitlist for longer than
+		// maxRequestQueueTime are rejected with a RequestQueueFullException.
+		Options options = createOptions();
+		options.appGroupName = "test1";
+		options.maxRequestQueueTime = 1;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		initPoolDebugging();
+		pool->setMax(1);
+
+		unsigned long long now = SystemTime::getUsec();
+		SystemTime::forceAll(now);
+		pool->asyncGet(options, callback);
+		pool->asyncGet(options, callback);
+		ensure_equals(number, 0);
+
+		SystemTime::forceAll(now + 2000000);
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		{
+			LockGuard l(syncher);
+			ensure("(1)", dynamic_pointer_cast<RequestQueueFullException>(currentException) != NULL);
+		}
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(2)", group->getWaitlist.size(), 1u);
+			ensure_equals("(3)", group->requestsTimedOutInQueue, 2ull);
+		}
+
+		SystemTime::releaseAll();
+		debug->messages->send("Proceed with spawn loop iteration 1");
+		debug->messages->send("Spawn loop done");
+		EVENTUALLY(5,
+			result = number == 3;
+		);
+	}
+
+	TEST_METHOD(86) {
+		// With the power-of-two-choices routing policy, requests are
+		// never routed to a totally busy process while another process
+		// can still accept requests.
+		Options options = createOptions();
+		options.appGroupName = "test";
+		options.minProcesses = 3;
+		options.routingPolicy = "power_of_two";
+		spawningKitConfig->concurrency = 1;
+		pool->setMax(3);
+		retainSessions = true;
+
+		pool->asyncGet(options, callback);
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		clearAllSessions();
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 3 && !pool->isSpawning();
+		);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(1)", pool->groups.lookupCopy("test")->routingPolicy,
+				RP_POWER_OF_TWO);
+		}
+
+		for (unsigned int round = 0; round < 10; round++) {
+			vector<SessionPtr> busySessions;
+			set<pid_t> pids;
+			for (unsigned int i = 0; i < 3; i++) {
+				SessionPtr session = pool->get(options, &ticket);
+				pids.insert(session->getPid());
+				busySessions.push_back(session);
+			}
+			ensure_equals("(2)", pids.size(), 3u);
+		}
+	}
+
+
+	/*********** Test previously discovered bugs ***********/
+
+	TEST_METHOD(87) {
 		// Test detaching, then restarting. This should not violate any invariants.
 		TempDirCopy dir("stub/wsgi", "tmp.wsgi");
 		Options options = createOptions();
@@ -2028,5 +2259,315 @@ namespace tut {
 	}
 
 
+	/*********** Test restart file watching ***********/
+
+	TEST_METHOD(88) {
+		// When restart file watching is enabled, get() does not stat() the
+		// restart files, but touching restart.txt still restarts the app.
+		TempDirCopy dir("stub/rack", "tmp.rack");
+		Options options = createOptions();
+		options.appRoot = "tmp.rack";
+		options.statThrottleRate = 0;
+		pool->enableRestartFileWatching(true);
+
+		pool->get(options, &ticket).reset();
+		GroupPtr group = pool->findOrCreateGroup(options);
+		ensure("(1)", group->restartFileWatch->active.load());
+
+		RestartFileWatcher::setStatFunction(countingStat);
+		restartFileStatCount = 0;
+		pool->get(options, &ticket).reset();
+		pool->get(options, &ticket).reset();
+		ensure_equals("(2)", restartFileStatCount.load(), 0u);
+
+		unsigned int restartsInitiated = group->restartsInitiated;
+		touchFile("tmp.rack/tmp/restart.txt", 1);
+		EVENTUALLY(5,
+			result = group->restartFileWatch->restartPending.load();
+		);
+		pool->get(options, &ticket).reset();
+		ensure_equals("(3)", group->restartsInitiated, restartsInitiated + 1);
+		ensure("(4)", !group->restartFileWatch->restartPending.load());
+	}
+
+	TEST_METHOD(89) {
+		// When the restart directory does not exist, get() falls back to
+		// stat(). The directory is watched as soon as it appears, and
+		// when it's deleted, get() falls back to stat() again.
+		TempDirCopy dir("stub/rack", "tmp.rack");
+		removeDirTree("tmp.rack/tmp");
+		Options options = createOptions();
+		options.appRoot = "tmp.rack";
+		options.statThrottleRate = 0;
+		pool->enableRestartFileWatching(true);
+
+		pool->get(options, &ticket).reset();
+		GroupPtr group = pool->findOrCreateGroup(options);
+		ensure("(1)", !group->restartFileWatch->active.load());
+
+		makeDirTree("tmp.rack/tmp");
+		EVENTUALLY(5,
+			result = group->restartFileWatch->active.load();
+		);
+		unsigned int restartsInitiated = group->restartsInitiated;
+		touchFile("tmp.rack/tmp/restart.txt", 1);
+		EVENTUALLY(5,
+			result = group->restartFileWatch->restartPending.load();
+		);
+		pool->get(options, &ticket).reset();
+		ensure_equals("(2)", group->restartsInitiated, restartsInitiated + 1);
+
+		removeDirTree("tmp.rack/tmp");
+		EVENTUALLY(5,
+			result = !group->restartFileWatch->active.load();
+		);
+		makeDirTree("tmp.rack/tmp");
+		touchFile("tmp.rack/tmp/restart.txt", 2);
+		pool->get(options, &ticket).reset();
+		ensure_equals("(3)", group->restartsInitiated, restartsInitiated + 2);
+	}
+
+	TEST_METHOD(97) {
+		// When the restart directory is created and restart.txt is touched
+		// without any get() in between, the app is still restarted once the
+		// directory is watched.
+		TempDirCopy dir("stub/rack", "tmp.rack");
+		removeDirTree("tmp.rack/tmp");
+		Options options = createOptions();
+		options.appRoot = "tmp.rack";
+		options.statThrottleRate = 0;
+		pool->enableRestartFileWatching(true);
+
+		pool->get(options, &ticket).reset();
+		GroupPtr group = pool->findOrCreateGroup(options);
+		ensure("(1)", !group->restartFileWatch->active.load());
+		unsigned int restartsInitiated = group->restartsInitiated;
+
+		makeDirTree("tmp.rack/tmp");
+		touchFile("tmp.rack/tmp/restart.txt", 1);
+		EVENTUALLY(5,
+			result = group->restartFileWatch->active.load();
+		);
+		pool->get(options, &ticket).reset();
+		ensure_equals("(2)", group->restartsInitiated, restartsInitiated + 1);
+		pool->get(options, &ticket).reset();
+		ensure_equals("(3)", group->restartsInitiated, restartsInitiated + 1);
+	}
+
+
+	/*********** Test state inspection snapshots ***********/
+
+	TEST_METHOD(90) {
+		// getSnapshot() reuses a snapshot until it's older than the maximum age.
+		ensureMinProcesses(1);
+		PoolSnapshotPtr snapshot = pool->getSnapshot();
+		ensure("(1)", pool->getSnapshot() == snapshot);
+
+		pool->setSnapshotMaxAge(0);
+		PoolSnapshotPtr snapshot2 = pool->getSnapshot();
+		ensure("(2)", snapshot2 != snapshot);
+		ensure("(3)", snapshot2->version > snapshot->version);
+		ensure("(4)", pool->getSnapshot()->version > snapshot2->version);
+	}
+
+	TEST_METHOD(91) {
+		// A snapshot doesn't change along with the pool.
+		Options options = ensureMinProcesses(1);
+		PoolSnapshotPtr snapshot = pool->getSnapshot();
+		ensure_equals("(1)", snapshot->processCount, 1u);
+		ensure_equals("(2)", snapshot->groups.size(), 1u);
+		ensure_equals("(3)", snapshot->groups[0].enabledProcesses.size(), 1u);
+
+		options.minProcesses = 2;
+		pool->get(options, &ticket).reset();
+		EVENTUALLY(5,
+			result = pool->getProcessCount() == 2;
+		);
+		ensure_equals("(4)", snapshot->processCount, 1u);
+		ensure_equals("(5)", snapshot->groups[0].enabledProcesses.size(), 1u);
+	}
+
+	TEST_METHOD(92) {
+		// Snapshots can be formatted as XML and as text, and enforce
+		// the same authorization rules as the pool itself.
+		ensureMinProcesses(1);
+		vector<ProcessPtr> processes = pool->getProcesses();
+		PoolSnapshotPtr snapshot = pool->getSnapshot();
+		string xml = snapshot->toXml();
+		string text = snapshot->inspect();
+
+		string groupName = snapshot->groups[0].name;
+		string pid = toString(processes[0]->getPid());
+
+		ensure("(1)", xml.find("<name>" + groupName + "</name>") != string::npos);
+		ensure("(2)", xml.find("<pid>" + pid + "</pid>") != string::npos);
+		ensure("(3)", text.find(groupName + ":") != string::npos);
+		ensure("(4)", text.find("PID: " + pid) != string::npos);
+
+		Pool::ToXmlOptions options;
+		options.uid = (uid_t) -2;
+		try {
+			snapshot->toXml(options);
+			fail("SecurityException expected");
+		} catch (const SecurityException &) {
+			// Pass.
+		}
+	}
+
+
+	/*********** Test the shared lock fast paths ***********/
+
+	TEST_METHOD(93) {
+		// If the Group exists and one of its processes has spare capacity,
+		// then tryGetQuickly() checks out a session from it, and closing
+		// that session only updates the statistics.
+		Options options = ensureMinProcesses(1);
+		ProcessPtr process = pool->getProcesses()[0];
+		unsigned int processed;
+		{
+			PoolLockGuard l(pool->syncher);
+			processed = process->processed;
+		}
+
+		SessionPtr session = pool->tryGetQuickly(options, NULL);
+		ensure("(1)", session != NULL);
+		ensure("(2)", session->getProcess() == process.get());
+		{
+			PoolLockGuard l(pool->syncher);
+			Group *group = process->getGroup();
+			ensure_equals("(3)", process->sessions, 1);
+			ensure("(4)", process->isTotallyBusy());
+			ensure_equals("(5)", group->nEnabledProcessesTotallyBusy, 1);
+			ensure("(6)", group->sessionCloseIsTrivial(process.get()));
+		}
+
+		session->close(true);
+		session.reset();
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(7)", process->sessions, 0);
+			ensure_equals("(8)", process->processed, processed + 1);
+			ensure_equals("(9)", process->getGroup()->nEnabledProcessesTotallyBusy, 0);
+			ensure_equals("(10)", process->enabled, Process::ENABLED);
+			ensure_equals("(11)", pool->getProcessCount(false), 1u);
+		}
+	}
+
+	TEST_METHOD(94) {
+		// tryGetQuickly() returns NULL, without side effects, if the request
+		// needs more than routing to an existing process. asyncGet() then
+		// falls back to the exclusively locked slow path.
+		Options options = createOptions();
+		ensure("(1)", pool->tryGetQuickly(options, NULL) == NULL);
+		ensure_equals("(2)", pool->getGroupCount(), 0u);
+
+		options = ensureMinProcesses(1);
+		pool->setMax(1);
+
+		Options noopOptions = options;
+		noopOptions.noop = true;
+		ensure("(3)", pool->tryGetQuickly(noopOptions, NULL) == NULL);
+
+		SessionPtr session = pool->tryGetQuickly(options, NULL);
+		ensure("(4)", session != NULL);
+
+		// The only process is totally busy and the pool is full,
+		// so the request has to be queued.
+		ensure("(5)", pool->tryGetQuickly(options, NULL) == NULL);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(6)", pool->findMatchingGroup(options)->getWaitlist.empty());
+		}
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(7)", pool->findMatchingGroup(options)->getWaitlist.size(), 1u);
+		}
+		ensure_equals("(8)", number, 1);
+
+		session->close(true);
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+	}
+
+	TEST_METHOD(95) {
+		// Closing a session falls back to the exclusively locked slow path
+		// if there's more to do than updating statistics.
+		Options options = ensureMinProcesses(1);
+		pool->setMax(1);
+		ProcessPtr process = pool->getProcesses()[0];
+
+		// A client is waiting for the process.
+		SessionPtr session = pool->tryGetQuickly(options, NULL);
+		pool->asyncGet(options, callback);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(1)", !process->getGroup()->sessionCloseIsTrivial(process.get()));
+		}
+		session->close(true);
+		session.reset();
+		EVENTUALLY(5,
+			result = number == 2;
+		);
+		ensure("(2)", currentSession->getProcess() == process.get());
+		currentSession->close(true);
+		currentSession.reset();
+
+		// The process reaches its maximum number of requests.
+		{
+			PoolLockGuard l(pool->syncher);
+			options.maxRequests = process->processed + 1;
+		}
+		session = pool->tryGetQuickly(options, NULL);
+		ensure("(3)", session != NULL);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure("(4)", !process->getGroup()->sessionCloseIsTrivial(process.get()));
+		}
+		session->close(true);
+		session.reset();
+		EVENTUALLY(5,
+			result = process->getLifeStatus() != Process::ALIVE;
+		);
+	}
+
+
+	/*********** Test request queue time limits ***********/
+
+	TEST_METHOD(96) {
+		// Requests that have waited in the getWaitlist for longer than
+		// maxRequestQueueTime are rejected by the garbage collector,
+		// even if nothing else happens in the pool.
+		Options options = createOptions();
+		options.appGroupName = "test1";
+		options.maxRequestQueueTime = 1;
+		GroupPtr group = pool->findOrCreateGroup(options);
+		initPoolDebugging();
+		pool->setMax(1);
+
+		unsigned long long startTime = SystemTime::getMonotonicUsec();
+		pool->asyncGet(options, callback);
+		ensure_equals(number, 0);
+		EVENTUALLY(5,
+			result = number == 1;
+		);
+		{
+			LockGuard l(syncher);
+			ensure("(1)", dynamic_pointer_cast<RequestQueueFullException>(currentException) != NULL);
+		}
+		// Not just when the garbage collector happens to run next.
+		ensure("(4)", SystemTime::getMonotonicUsec() - startTime < 3000000);
+		{
+			PoolLockGuard l(pool->syncher);
+			ensure_equals("(2)", group->getWaitlist.size(), 0u);
+			ensure_equals("(3)", group->requestsTimedOutInQueue, 1ull);
+		}
+
+		debug->messages->send("Proceed with spawn loop iteration 1");
+		debug->messages->send("Spawn loop done");
+	}
+
+
 	/*****************************/
 }
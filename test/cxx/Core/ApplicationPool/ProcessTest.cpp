@@ -1,6 +1,10 @@
 #include <TestSupport.h>
 #include <Core/ApplicationPool/Process.h>
 #include <Utils/IOUtils.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cstring>
 
 using namespace Passenger;
 using namespace Passenger::ApplicationPool2;
@@ -8,6 +12,8 @@ using namespace std;
 
 namespace tut {
 	struct Core_ApplicationPool_ProcessTest {
+		static const unsigned long long CONNECT_TIMEOUT = 5000000;
+
 		Context context;
 		BasicGroupInfo groupInfo;
 		Json::Value sockets;
@@ -39,7 +45,7 @@ namespace tut {
 			server1.assign(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__), NULL, 0);
 			getsockname(server1, (struct sockaddr *) &addr, &len);
 			socket["name"] = "main1";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -48,7 +54,7 @@ namespace tut {
 			getsockname(server2, (struct sockaddr *) &addr, &len);
 			socket = Json::Value();
 			socket["name"] = "main2";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -57,7 +63,7 @@ namespace tut {
 			getsockname(server3, (struct sockaddr *) &addr, &len);
 			socket = Json::Value();
 			socket["name"] = "main3";
-			socket["address"] = "tcp://127.0.0.1:" + toString(addr.sin_port);
+			socket["address"] = "tcp://127.0.0.1:" + toString(ntohs(addr.sin_port));
 			socket["protocol"] = "session";
 			socket["concurrency"] = 3;
 			sockets.append(socket);
@@ -95,6 +101,20 @@ namespace tut {
 			process->shutdownNotRequired();
 			return process;
 		}
+
+		void waitUntilInitiated(const SessionPtr &session, AbstractSession::InitiateResult result) {
+			while (result != AbstractSession::INITIATED) {
+				if (result == AbstractSession::INITIATE_WAIT_WRITABLE) {
+					struct pollfd pfd;
+					pfd.fd = session->fd();
+					pfd.events = POLLOUT;
+					ensure("Connect completes in time", poll(&pfd, 1, 5000) == 1);
+				} else {
+					usleep(1000);
+				}
+				result = session->continueInitiate();
+			}
+		}
 	};
 
 	DEFINE_TEST_GROUP(Core_ApplicationPool_ProcessTest);
@@ -204,4 +224,104 @@ namespace tut {
 				&& gatheredOutput.find("errorPipe 2\n") != string::npos;
 		);
 	}
+
+	TEST_METHOD(6) {
+		set_test_name("initiateNonBlocking() connects without blocking, and later sessions "
+			"reuse the pooled connection");
+		ProcessPtr process = createProcess();
+		SessionPtr session = process->newSession();
+		Socket *socket = session->getSocket();
+
+		waitUntilInitiated(session, session->initiateNonBlocking(CONNECT_TIMEOUT));
+		ensure(session->initiated());
+		ensure_equals(socket->getPoolMisses(), 1u);
+		ensure_equals(socket->getConnectCount(), 1u);
+		ensure_equals(socket->totalConnections.load(), 1);
+		process->sessionClosed(session.get());
+		session->close(true, true);
+		ensure_equals(socket->totalIdleConnections.load(), 1);
+
+		session = process->newSession();
+		ensure_equals(session->getSocket(), socket);
+		ensure_equals(session->initiateNonBlocking(CONNECT_TIMEOUT), AbstractSession::INITIATED);
+		ensure_equals(socket->getPoolHits(), 1u);
+		ensure_equals(socket->getConnectCount(), 1u);
+		ensure_equals(socket->totalIdleConnections.load(), 0);
+		process->sessionClosed(session.get());
+		session->close(false);
+		ensure_equals(socket->totalConnections.load(), 0);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("initiateNonBlocking() reports connect failures");
+		ProcessPtr process = createProcess();
+		SessionPtr session = process->newSession();
+		server1.close();
+		server2.close();
+		server3.close();
+
+		try {
+			waitUntilInitiated(session, session->initiateNonBlocking(CONNECT_TIMEOUT));
+			fail("SystemException expected");
+		} catch (const SystemException &) {
+			// Pass.
+		}
+		ensure(!session->initiated());
+		ensure_equals(session->getSocket()->totalConnections.load(), 0);
+		process->sessionClosed(session.get());
+		session->close(false);
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("continueInitiate() throws a TimeoutException once the timeout"
+			" given to initiateNonBlocking() has passed");
+		TempDir tmpdir("tmp.process_test");
+		string filename = tmpdir.getPath() + "/socket";
+		FileDescriptor server(createUnixServer(filename, 1, true, __FILE__, __LINE__),
+			NULL, 0);
+		vector<FileDescriptor> clients;
+		struct sockaddr_un addr;
+
+		// Fill the listen backlog, so that connecting keeps failing with EAGAIN.
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strncpy(addr.sun_path, filename.c_str(), sizeof(addr.sun_path) - 1);
+		while (true) {
+			FileDescriptor fd(socket(PF_UNIX, SOCK_STREAM, 0), NULL, 0);
+			setNonBlocking(fd);
+			if (connect(fd, (const struct sockaddr *) &addr, sizeof(addr)) == -1) {
+				ensure_equals(errno, EAGAIN);
+				break;
+			}
+			clients.push_back(fd);
+		}
+
+		Json::Value socket;
+		socket["name"] = "main1";
+		socket["address"] = "unix:" + filename;
+		socket["protocol"] = "session";
+		socket["concurrency"] = 3;
+		sockets = Json::Value(Json::arrayValue);
+		sockets.append(socket);
+
+		ProcessPtr process = createProcess();
+		SessionPtr session = process->newSession();
+		ensure_equals(session->initiateNonBlocking(100000), AbstractSession::INITIATE_RETRY_LATER);
+		ensure(session->getConnectTimeRemaining() > 0);
+		ensure(session->getConnectTimeRemaining() <= 100000);
+		ensure_equals(session->continueInitiate(), AbstractSession::INITIATE_RETRY_LATER);
+
+		usleep(150000);
+		ensure_equals(session->getConnectTimeRemaining(), 0ull);
+		try {
+			session->continueInitiate();
+			fail("TimeoutException expected");
+		} catch (const TimeoutException &) {
+			// Pass.
+		}
+		ensure(!session->initiated());
+		ensure_equals(session->getSocket()->totalConnections.load(), 0);
+		process->sessionClosed(session.get());
+		session->close(false);
+	}
 }
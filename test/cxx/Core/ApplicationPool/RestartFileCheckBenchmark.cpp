@@ -0,0 +1,190 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures the latency of Pool::get() with many groups whose restart
+ * directories are on a tmpfs, while stat() is artificially slowed down to
+ * simulate a slow filesystem such as NFS. The groups are checked out from in
+ * round-robin order with a stat throttle rate of 0, once with restart file
+ * watching (inotify) and once with the stat()-based fallback.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/ApplicationPool/RestartFileCheckBenchmark [GROUPS] [STAT_DELAY_USEC] [ROUNDS]
+ */
+#include <boost/make_shared.hpp>
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+
+#include <ResourceLocator.h>
+#include <Logging.h>
+#include <Utils.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+#include <Core/ApplicationPool/Pool.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+unsigned int statDelay;
+
+
+int
+slowStat(const char *path, struct stat *buf) {
+	usleep(statDelay);
+	return stat(path, buf);
+}
+
+string
+getBaseDir() {
+	struct stat buf;
+	if (stat("/dev/shm", &buf) == 0 && S_ISDIR(buf.st_mode)) {
+		return "/dev/shm/passenger-restart-file-check-benchmark."
+			+ toString(getpid());
+	} else {
+		return "/tmp/passenger-restart-file-check-benchmark."
+			+ toString(getpid());
+	}
+}
+
+Options
+createOptions(const string &appRoot) {
+	Options options;
+	options.spawnMethod = "dummy";
+	options.appRoot = appRoot;
+	options.appGroupName = appRoot;
+	options.startCommand = "ruby\t" "start.rb";
+	options.startupFile  = "start.rb";
+	options.loadShellEnvvars = false;
+	options.statThrottleRate = 0;
+	return options.copyAndPersist();
+}
+
+void
+measure(const char *name, const SpawningKit::FactoryPtr &spawningKitFactory,
+	const string &baseDir, unsigned int ngroups, unsigned int rounds,
+	bool restartFileWatching)
+{
+	vector<Options> options;
+	vector<unsigned long long> latencies;
+	unsigned int i, j;
+
+	PoolPtr pool = boost::make_shared<Pool>(spawningKitFactory);
+	pool->initialize();
+	pool->setMax(ngroups);
+	pool->enableRestartFileWatching(restartFileWatching);
+
+	RestartFileWatcher::setStatFunction(NULL);
+	for (i = 0; i < ngroups; i++) {
+		Ticket ticket;
+		options.push_back(createOptions(baseDir + "/app" + toString(i)));
+		pool->get(options[i], &ticket)->close(true);
+	}
+	RestartFileWatcher::setStatFunction(slowStat);
+
+	latencies.reserve(ngroups * rounds);
+	for (j = 0; j < rounds; j++) {
+		for (i = 0; i < ngroups; i++) {
+			Ticket ticket;
+			unsigned long long startTime = SystemTime::getMonotonicUsec();
+			SessionPtr session = pool->get(options[i], &ticket);
+			latencies.push_back(SystemTime::getMonotonicUsec() - startTime);
+			session->close(true);
+		}
+	}
+	RestartFileWatcher::setStatFunction(NULL);
+
+	std::sort(latencies.begin(), latencies.end());
+	printf("%-10s  %14u  %10llu  %10llu  %10llu\n", name,
+		pool->getContext()->getRestartFileWatcher().getActiveWatchCount(),
+		latencies[latencies.size() / 2],
+		latencies[latencies.size() * 99 / 100],
+		latencies.back());
+	fflush(stdout);
+
+	pool->destroy();
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int ngroups = (argc > 1) ? atoi(argv[1]) : 1000;
+	statDelay = (argc > 2) ? atoi(argv[2]) : 100;
+	unsigned int rounds = (argc > 3) ? atoi(argv[3]) : 20;
+	char path[PATH_MAX + 1];
+	struct rlimit rl;
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	// Every dummy process holds a few file descriptors.
+	if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur < rl.rlim_max) {
+		rl.rlim_cur = rl.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &rl);
+	}
+
+	string baseDir = getBaseDir();
+	for (unsigned int i = 0; i < ngroups; i++) {
+		makeDirTree(baseDir + "/app" + toString(i) + "/tmp");
+	}
+
+	getcwd(path, PATH_MAX);
+	ResourceLocator resourceLocator(extractDirName(path));
+	SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+	spawningKitConfig->resourceLocator = &resourceLocator;
+	spawningKitConfig->finalize();
+	SpawningKit::FactoryPtr spawningKitFactory =
+		boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
+
+	printf("%u groups in %s, stat() delayed by %u usec\n",
+		ngroups, baseDir.c_str(), statDelay);
+	printf("%-10s  %14s  %10s  %10s  %10s\n", "Method", "Active watches",
+		"p50 (usec)", "p99 (usec)", "Max (usec)");
+	measure("inotify", spawningKitFactory, baseDir, ngroups, rounds, true);
+	measure("stat()", spawningKitFactory, baseDir, ngroups, rounds, false);
+
+	removeDirTree(baseDir);
+	oxt::shutdown();
+	return 0;
+}
@@ -0,0 +1,159 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long it takes to check out and close a session in a group
+ * with many processes, for each routing policy. While measuring, a fixed
+ * number of sessions is kept open, so that the processes' busyness levels
+ * keep changing like they do under real traffic. The processes are dummy
+ * processes with unlimited concurrency, so only the pool's routing and
+ * bookkeeping is measured.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/ApplicationPool/RoutingBenchmark [ITERATIONS]
+ */
+#include <boost/make_shared.hpp>
+#include <oxt/initialize.hpp>
+#include <string>
+#include <deque>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <signal.h>
+#include <unistd.h>
+
+#include <ResourceLocator.h>
+#include <Logging.h>
+#include <Utils.h>
+#include <Utils/SystemTime.h>
+#include <Core/ApplicationPool/Pool.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+Options
+createOptions(unsigned int nprocesses, const char *routingPolicy) {
+	Options options;
+	options.spawnMethod = "dummy";
+	options.appRoot = "stub/rack";
+	options.appGroupName = "benchmark";
+	options.startCommand = "ruby\t" "start.rb";
+	options.startupFile  = "start.rb";
+	options.loadShellEnvvars = false;
+	options.minProcesses = nprocesses;
+	options.maxProcesses = nprocesses;
+	options.spawnConcurrency = nprocesses;
+	options.routingPolicy = routingPolicy;
+	return options.copyAndPersist();
+}
+
+/**
+ * Returns the average time, in nanoseconds, of checking out a session.
+ */
+double
+measure(const SpawningKit::FactoryPtr &spawningKitFactory, unsigned int nprocesses,
+	const char *routingPolicy, unsigned int iterations)
+{
+	PoolPtr pool = boost::make_shared<Pool>(spawningKitFactory);
+	pool->initialize();
+	pool->setMax(nprocesses);
+
+	Options options = createOptions(nprocesses, routingPolicy);
+	Ticket ticket;
+
+	pool->get(options, &ticket)->close(true);
+	while (pool->getProcessCount() < nprocesses || pool->isSpawning()) {
+		usleep(1000);
+	}
+
+	// Keep a number of sessions open, closing the oldest one whenever
+	// a new one is checked out.
+	deque<SessionPtr> openSessions;
+	for (unsigned int i = 0; i < nprocesses * 2; i++) {
+		openSessions.push_back(pool->get(options, &ticket));
+	}
+
+	unsigned long long startTime = SystemTime::getMonotonicUsec();
+	for (unsigned int i = 0; i < iterations; i++) {
+		openSessions.push_back(pool->get(options, &ticket));
+		openSessions.front()->close(true);
+		openSessions.pop_front();
+	}
+	unsigned long long duration = SystemTime::getMonotonicUsec() - startTime;
+
+	while (!openSessions.empty()) {
+		openSessions.front()->close(true);
+		openSessions.pop_front();
+	}
+	pool->destroy();
+	return duration * 1000.0 / iterations;
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+	const unsigned int processCounts[] = { 10, 30, 100, 300, 1000 };
+	char path[PATH_MAX + 1];
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	getcwd(path, PATH_MAX);
+	ResourceLocator resourceLocator(extractDirName(path));
+	SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+	spawningKitConfig->resourceLocator = &resourceLocator;
+	spawningKitConfig->spawnTime = 0;
+	spawningKitConfig->concurrency = 0;
+	spawningKitConfig->finalize();
+	SpawningKit::FactoryPtr spawningKitFactory =
+		boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
+
+	printf("Checking out %u sessions per measurement\n\n", iterations);
+	printf("%-10s  %22s  %22s\n", "Processes",
+		"least_busy (ns/get)", "power_of_two (ns/get)");
+	for (unsigned int i = 0; i < sizeof(processCounts) / sizeof(unsigned int); i++) {
+		unsigned int nprocesses = processCounts[i];
+		double leastBusy = measure(spawningKitFactory, nprocesses,
+			"least_busy", iterations);
+		double powerOfTwo = measure(spawningKitFactory, nprocesses,
+			"power_of_two", iterations);
+		printf("%-10u  %22.0f  %22.0f\n", nprocesses, leastBusy, powerOfTwo);
+		fflush(stdout);
+	}
+
+	oxt::shutdown();
+	return 0;
+}
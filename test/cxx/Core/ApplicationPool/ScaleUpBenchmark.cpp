@@ -0,0 +1,218 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long a group takes to scale up from 2 processes to
+ * MAX_PROCESSES processes when a burst of requests arrives while all
+ * existing processes are busy, for different values of the group's spawn
+ * concurrency. The processes are dummy processes that take SPAWN_MSEC
+ * milliseconds to spawn, so only the pool's spawning behavior is measured.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/ApplicationPool/ScaleUpBenchmark [MAX_PROCESSES] [SPAWN_MSEC] [REQUESTS]
+ */
+#include <boost/make_shared.hpp>
+#include <boost/thread.hpp>
+#include <oxt/initialize.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <signal.h>
+#include <unistd.h>
+
+#include <ResourceLocator.h>
+#include <Logging.h>
+#include <Utils.h>
+#include <Utils/SystemTime.h>
+#include <Core/ApplicationPool/Pool.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+const unsigned int INITIAL_PROCESSES = 2;
+
+struct SessionCollector {
+	boost::mutex syncher;
+	vector<SessionPtr> sessions;
+	unsigned int finished;
+	unsigned int errors;
+};
+
+struct Result {
+	unsigned long long timeToCapacity;
+	unsigned long long burstDuration;
+	unsigned int burstProcesses;
+};
+
+
+void
+collectSession(const AbstractSessionPtr &session, const ExceptionPtr &e, void *userData) {
+	SessionCollector *collector = (SessionCollector *) userData;
+	boost::lock_guard<boost::mutex> l(collector->syncher);
+	if (session != NULL) {
+		collector->sessions.push_back(static_pointer_cast<Session>(session));
+	} else {
+		collector->errors++;
+	}
+	collector->finished++;
+}
+
+Options
+createOptions(unsigned int maxProcesses, unsigned int spawnConcurrency) {
+	Options options;
+	options.spawnMethod = "dummy";
+	options.appRoot = "stub/rack";
+	options.appGroupName = "benchmark";
+	options.startCommand = "ruby\t" "start.rb";
+	options.startupFile  = "start.rb";
+	options.loadShellEnvvars = false;
+	options.minProcesses = INITIAL_PROCESSES;
+	options.maxProcesses = maxProcesses;
+	options.maxRequestQueueSize = 0;
+	options.spawnConcurrency = spawnConcurrency;
+	return options.copyAndPersist();
+}
+
+Result
+measure(const SpawningKit::FactoryPtr &spawningKitFactory, unsigned int maxProcesses,
+	unsigned int spawnConcurrency, unsigned int nrequests)
+{
+	PoolPtr pool = boost::make_shared<Pool>(spawningKitFactory);
+	pool->initialize();
+	pool->setMax(maxProcesses);
+
+	Options options = createOptions(maxProcesses, spawnConcurrency);
+	SessionCollector collector;
+	GetCallback callback;
+	Result result;
+	Ticket ticket;
+
+	collector.finished = 0;
+	collector.errors = 0;
+	callback.func = collectSession;
+	callback.userData = &collector;
+
+	// Start with INITIAL_PROCESSES processes that are all busy.
+	vector<SessionPtr> busySessions;
+	pool->get(options, &ticket)->close(true);
+	while (pool->isSpawning()) {
+		usleep(1000);
+	}
+	for (unsigned int i = 0; i < INITIAL_PROCESSES; i++) {
+		busySessions.push_back(pool->get(options, &ticket));
+	}
+
+	unsigned long long startTime = SystemTime::getMonotonicUsec();
+	for (unsigned int i = 0; i < nrequests; i++) {
+		pool->asyncGet(options, callback);
+	}
+	while (pool->getProcessCount() < maxProcesses) {
+		usleep(1000);
+	}
+	result.timeToCapacity = SystemTime::getMonotonicUsec() - startTime;
+
+	while (pool->isSpawning()) {
+		usleep(1000);
+	}
+	{
+		PoolLockGuard l(pool->syncher);
+		GroupPtr group = pool->groups.lookupCopy(options.getAppGroupName());
+		result.burstDuration = group->lastSpawnBurstDuration;
+		result.burstProcesses = group->lastSpawnBurstProcessCount;
+	}
+
+	// The remaining requests are still queued. Keep releasing sessions
+	// until all requests are done, so that we can destroy the pool.
+	busySessions.clear();
+	while (true) {
+		vector<SessionPtr> sessions;
+		bool done;
+		{
+			boost::lock_guard<boost::mutex> l(collector.syncher);
+			sessions.swap(collector.sessions);
+			done = collector.finished == nrequests;
+		}
+		sessions.clear();
+		if (done) {
+			break;
+		}
+		usleep(1000);
+	}
+
+	if (collector.errors > 0) {
+		fprintf(stderr, "*** WARNING: %u requests failed\n", collector.errors);
+	}
+	pool->destroy();
+	return result;
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int maxProcesses = (argc > 1) ? atoi(argv[1]) : 20;
+	unsigned int spawnMsec = (argc > 2) ? atoi(argv[2]) : 200;
+	unsigned int nrequests = (argc > 3) ? atoi(argv[3]) : 200;
+	char path[PATH_MAX + 1];
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	getcwd(path, PATH_MAX);
+	ResourceLocator resourceLocator(extractDirName(path));
+	SpawningKit::ConfigPtr spawningKitConfig = boost::make_shared<SpawningKit::Config>();
+	spawningKitConfig->resourceLocator = &resourceLocator;
+	spawningKitConfig->spawnTime = spawnMsec * 1000;
+	spawningKitConfig->finalize();
+	SpawningKit::FactoryPtr spawningKitFactory =
+		boost::make_shared<SpawningKit::Factory>(spawningKitConfig);
+
+	printf("Scaling up from %u to %u processes, %u queued requests, %u msec per spawn\n\n",
+		INITIAL_PROCESSES, maxProcesses, nrequests, spawnMsec);
+	printf("%-18s  %22s  %22s\n", "Spawn concurrency",
+		"Time to capacity (ms)", "Spawn burst");
+	for (unsigned int concurrency = 1; concurrency <= maxProcesses; concurrency *= 2) {
+		Result result = measure(spawningKitFactory, maxProcesses, concurrency, nrequests);
+		printf("%-18u  %22.0f  %8u procs %6.0f ms\n", concurrency,
+			result.timeToCapacity / 1000.0,
+			result.burstProcesses,
+			result.burstDuration / 1000.0);
+		fflush(stdout);
+	}
+
+	oxt::shutdown();
+	return 0;
+}
@@ -0,0 +1,315 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how fast the core forwards large request bodies (uploads) and
+ * response bodies (downloads), and how much CPU time that costs, with and
+ * without splice(). The client and the application are threads in this
+ * process that connect to a real Controller over TCP and a Unix socket pair
+ * respectively, just like in production. Both only count the body bytes
+ * that they receive.
+ *
+ * The CPU time covers the whole process, so it includes the client and
+ * application threads. Those do the same amount of work in every mode,
+ * so differences between the modes are caused by the core.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Core/BodyForwardingBenchmark [BODY_MB] [REQUESTS]
+ */
+#include <boost/bind.hpp>
+#include <oxt/initialize.hpp>
+#include <oxt/thread.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <Constants.h>
+#include <Logging.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Context.h>
+#include <Utils/IOUtils.h>
+#include <Utils/BufferedIO.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+#include <Core/ApplicationPool/TestSession.h>
+#include <Core/Controller.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::Core;
+using namespace Passenger::ApplicationPool2;
+
+namespace {
+
+class BenchmarkController: public Controller {
+protected:
+	virtual void asyncGetFromApplicationPool(Request *req, GetCallback callback) {
+		callback(sessionToReturn, ExceptionPtr());
+		sessionToReturn.reset();
+	}
+
+public:
+	AbstractSessionPtr sessionToReturn;
+
+	BenchmarkController(ServerKit::Context *context, const VariantMap *agentsOptions)
+		: Controller(context, agentsOptions)
+		{ }
+};
+
+struct Result {
+	double seconds;
+	double cpuSeconds;
+};
+
+
+void
+initOptions(VariantMap &options, unsigned int spliceThreshold) {
+	options.setInt("stat_throttle_rate", DEFAULT_STAT_THROTTLE_RATE);
+	options.setInt("response_buffer_high_watermark", DEFAULT_RESPONSE_BUFFER_HIGH_WATERMARK);
+	options.setBool("show_version_in_header", true);
+	options.setBool("sticky_sessions", false);
+	options.setBool("core_graceful_exit", true);
+	options.setBool("multi_app", false);
+	options.set("environment", DEFAULT_APP_ENV);
+	options.set("app_root", "stub/rack");
+	options.set("app_type", "dummy");
+	options.set("startup_file", "none");
+	options.set("default_ruby", DEFAULT_RUBY);
+	options.set("default_server_name", "localhost");
+	options.setInt("default_server_port", 80);
+	options.set("server_software", PROGRAM_NAME);
+	options.set("sticky_sessions_cookie_name", DEFAULT_STICKY_SESSIONS_COOKIE_NAME);
+	options.setBool("user_switching", false);
+	options.setInt("min_instances", 1);
+	options.setInt("max_preloader_idle_time", DEFAULT_MAX_PRELOADER_IDLE_TIME);
+	options.setInt("max_request_queue_size", DEFAULT_MAX_REQUEST_QUEUE_SIZE);
+	options.setBool("abort_websockets_on_process_shutdown", true);
+	options.setInt("force_max_concurrent_requests_per_process", -1);
+	options.set("spawn_method", DEFAULT_SPAWN_METHOD);
+	options.setBool("load_shell_envvars", false);
+	options.setUint("splice_threshold", spliceThreshold);
+}
+
+double
+getCpuSeconds() {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1000000.0
+		+ usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1000000.0;
+}
+
+void
+setSession(BenchmarkController *controller, TestSession *session) {
+	controller->sessionToReturn.reset(session, false);
+}
+
+void
+shutdownController(BenchmarkController *controller) {
+	controller->shutdown(true);
+}
+
+void
+getControllerState(BenchmarkController *controller, BenchmarkController::State *state) {
+	*state = controller->serverState;
+}
+
+void
+destroyController(BenchmarkController *controller) {
+	delete controller;
+}
+
+void
+writeBody(int fd, unsigned long long bodySize) {
+	string buf(64 * 1024, 'x');
+	while (bodySize > 0) {
+		unsigned int size = (unsigned int) std::min<unsigned long long>(bodySize, buf.size());
+		writeExact(fd, buf.data(), size);
+		bodySize -= size;
+	}
+}
+
+void
+readBody(BufferedIO &io, unsigned long long bodySize) {
+	char buf[64 * 1024];
+	while (bodySize > 0) {
+		unsigned int size = io.read(buf,
+			(unsigned int) std::min<unsigned long long>(bodySize, sizeof(buf)));
+		if (size == 0) {
+			fprintf(stderr, "*** ERROR: body truncated\n");
+			abort();
+		}
+		bodySize -= size;
+	}
+}
+
+void
+readHeader(BufferedIO &io) {
+	string line;
+	do {
+		line = io.readLine();
+	} while (!line.empty() && line != "\r\n");
+}
+
+void
+sendRequest(int fd, unsigned long long bodySize) {
+	writeExact(fd,
+		"POST /upload HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"Connection: close\r\n"
+		"Content-Length: " + toString(bodySize) + "\r\n"
+		"\r\n");
+	writeBody(fd, bodySize);
+}
+
+/**
+ * Plays the application: reads the request, then sends a response.
+ */
+void
+handleRequest(TestSession *session, unsigned long long requestBodySize,
+	unsigned long long responseBodySize)
+{
+	BufferedIO &io = session->getPeerBufferedIO();
+	readHeader(io);
+	readBody(io, requestBodySize);
+	writeExact(session->peerFd(),
+		"HTTP/1.1 200 OK\r\n"
+		"Content-Length: " + toString(responseBodySize) + "\r\n"
+		"Connection: close\r\n\r\n");
+	writeBody(session->peerFd(), responseBodySize);
+}
+
+Result
+measure(unsigned long long requestBodySize, unsigned long long responseBodySize,
+	unsigned int nrequests, unsigned int spliceThreshold)
+{
+	BackgroundEventLoop bg(false, true);
+	ServerKit::Context context(bg.safe, bg.libuv_loop);
+	VariantMap options;
+	vector<TestSession *> sessions;
+	unsigned short port = 0;
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	Result result;
+
+	initOptions(options, spliceThreshold);
+	int serverFd = createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__);
+	getsockname(serverFd, (struct sockaddr *) &addr, &len);
+	port = ntohs(addr.sin_port);
+
+	BenchmarkController *controller = new BenchmarkController(&context, &options);
+	controller->listen(serverFd);
+	bg.start("Core", 0);
+
+	unsigned long long startTime = SystemTime::getMonotonicUsec();
+	double startCpuTime = getCpuSeconds();
+	for (unsigned int i = 0; i < nrequests; i++) {
+		TestSession *session = new TestSession();
+		session->setProtocol("http_session");
+		sessions.push_back(session);
+		bg.safe->runSync(boost::bind(setSession, controller, session));
+
+		FileDescriptor client(connectToTcpServer("127.0.0.1", port, __FILE__, __LINE__),
+			NULL, 0);
+		oxt::thread sender(boost::bind(sendRequest, (int) client, requestBodySize),
+			"Client", 1024 * 256);
+		while (session->fd() == -1) {
+			usleep(100);
+		}
+		oxt::thread app(boost::bind(handleRequest, session, requestBodySize,
+			responseBodySize), "Application", 1024 * 256);
+
+		BufferedIO clientIO(client);
+		readHeader(clientIO);
+		readBody(clientIO, responseBodySize);
+		sender.join();
+		app.join();
+	}
+	result.seconds = (SystemTime::getMonotonicUsec() - startTime) / 1000000.0;
+	result.cpuSeconds = getCpuSeconds() - startCpuTime;
+
+	BenchmarkController::State state;
+	bg.safe->runSync(boost::bind(shutdownController, controller));
+	do {
+		usleep(1000);
+		bg.safe->runSync(boost::bind(getControllerState, controller, &state));
+	} while (state != BenchmarkController::FINISHED_SHUTDOWN);
+	bg.safe->runSync(boost::bind(destroyController, controller));
+	bg.stop();
+	safelyClose(serverFd);
+	for (unsigned int i = 0; i < sessions.size(); i++) {
+		delete sessions[i];
+	}
+	return result;
+}
+
+void
+report(const char *name, unsigned long long bodySize, unsigned int nrequests,
+	const Result &result)
+{
+	double mbytes = bodySize * nrequests / 1024.0 / 1024.0;
+	printf("%-26s  %12.0f  %20.3f\n", name, mbytes / result.seconds,
+		result.cpuSeconds / (mbytes / 1024.0));
+	fflush(stdout);
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned long long bodySize = ((argc > 1) ? atoi(argv[1]) : 256) * 1024ull * 1024;
+	unsigned int nrequests = (argc > 2) ? atoi(argv[2]) : 8;
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	printf("%-26s  %12s  %20s\n", "Uploads", "MB/sec", "CPU seconds per GB");
+	report("Read and write (mbufs)", bodySize, nrequests,
+		measure(bodySize, 0, nrequests, 0));
+	report("splice()", bodySize, nrequests,
+		measure(bodySize, 0, nrequests, DEFAULT_SPLICE_THRESHOLD));
+
+	printf("\n%-26s  %12s  %20s\n", "Downloads", "MB/sec", "CPU seconds per GB");
+	report("Read and write (mbufs)", bodySize, nrequests,
+		measure(0, bodySize, nrequests, 0));
+	report("splice()", bodySize, nrequests,
+		measure(0, bodySize, nrequests, DEFAULT_SPLICE_THRESHOLD));
+
+	oxt::shutdown();
+	return 0;
+}
@@ -5,6 +5,7 @@
 #include <Utils/MessageIO.h>
 #include <Core/ApplicationPool/TestSession.h>
 #include <Core/Controller.h>
+#include <zlib.h>
 
 using namespace std;
 using namespace boost;
@@ -18,6 +19,7 @@ namespace tut {
 			virtual void asyncGetFromApplicationPool(Request *req,
 				ApplicationPool2::GetCallback callback)
 			{
+				lastEnvironment = req->options.environment;
 				callback(sessionToReturn, exceptionToReturn);
 				sessionToReturn.reset();
 			}
@@ -25,6 +27,7 @@ namespace tut {
 		public:
 			ApplicationPool2::AbstractSessionPtr sessionToReturn;
 			ApplicationPool2::ExceptionPtr exceptionToReturn;
+			string lastEnvironment;
 
 			MyController(ServerKit::Context *context, const VariantMap *agentsOptions)
 				: Core::Controller(context, agentsOptions)
@@ -158,6 +161,130 @@ namespace tut {
 			*result = controller->totalBytesConsumed;
 		}
 
+		Json::Value getLatencyStats() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getLatencyStats,
+				this, &result));
+			return result;
+		}
+
+		void _getLatencyStats(Json::Value *result) {
+			*result = controller->getLatencyStats().inspectAsJson();
+		}
+
+		void _returnCheckoutErrors() {
+			controller->exceptionToReturn = boost::make_shared<tracable_exception>();
+		}
+
+		string getLastEnvironment() {
+			string result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_getLastEnvironment,
+				this, &result));
+			return result;
+		}
+
+		void _getLastEnvironment(string *result) {
+			*result = controller->lastEnvironment;
+		}
+
+		string sendMultiAppRequest(const string &environment, const string &fingerprint) {
+			string header =
+				"GET /hello HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"Connection: close\r\n"
+				"!~: \r\n"
+				"!~PASSENGER_APP_GROUP_NAME: foo\r\n"
+				"!~PASSENGER_APP_ROOT: stub/rack\r\n"
+				"!~PASSENGER_APP_TYPE: rack\r\n"
+				"!~PASSENGER_APP_ENV: " + environment + "\r\n";
+			if (!fingerprint.empty()) {
+				header.append("!~PASSENGER_CONFIG_FINGERPRINT: " + fingerprint + "\r\n");
+			}
+			header.append("\r\n");
+
+			connectToServer();
+			sendRequest(header);
+			readResponseHeader();
+			readResponseBody();
+			return getLastEnvironment();
+		}
+
+		string sendCachedConfigRequest(const string &fingerprint) {
+			connectToServer();
+			sendRequest(
+				"GET /hello HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"Connection: close\r\n"
+				"!~: \r\n"
+				"!~PASSENGER_APP_TYPE: rack\r\n"
+				"!~PASSENGER_CACHED_CONFIG_FINGERPRINT: " + fingerprint + "\r\n"
+				"\r\n");
+			string header = readResponseHeader();
+			readResponseBody();
+			return header;
+		}
+
+		string sendTurbocacheRequest(const string &acceptEncoding, string &body) {
+			string request =
+				"GET /hello HTTP/1.1\r\n"
+				"Host: localhost\r\n"
+				"Connection: close\r\n";
+			if (!acceptEncoding.empty()) {
+				request.append("Accept-Encoding: " + acceptEncoding + "\r\n");
+			}
+			request.append("\r\n");
+
+			connectToServer();
+			sendRequest(request);
+			string header = readResponseHeader();
+			body = readResponseBody();
+			return header;
+		}
+
+		static string gunzip(const string &data) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+			int ret;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure(inflateInit2(&stream, 15 + 16) == Z_OK);
+			stream.next_in = (Bytef *) data.data();
+			stream.avail_in = data.size();
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_NO_FLUSH);
+				ensure(ret == Z_OK || ret == Z_STREAM_END);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret != Z_STREAM_END);
+			inflateEnd(&stream);
+			return result;
+		}
+
+		// A body that is large enough to be spliced, and in which every
+		// offset has distinct content so that corruption is detected.
+		static string createLargeBody() {
+			string body;
+			body.reserve(4 * 1024 * 1024);
+			for (unsigned int i = 0; body.size() < 4 * 1024 * 1024; i++) {
+				body.append(toString(i));
+				body.append(1, ',');
+			}
+			return body;
+		}
+
+		Json::Value inspectState() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&Core_ControllerTest::_inspectState,
+				this, &result));
+			return result;
+		}
+
+		void _inspectState(Json::Value *result) {
+			*result = controller->inspectStateAsJson();
+		}
+
 		string readPeerRequestHeader(string *peerRequestHeader = NULL) {
 			if (peerRequestHeader == NULL) {
 				peerRequestHeader = &this->peerRequestHeader;
@@ -248,7 +375,7 @@ namespace tut {
 		}
 	};
 
-	DEFINE_TEST_GROUP(Core_ControllerTest);
+	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ControllerTest, 70);
 
 
 	/***** Passing request information to the app *****/
@@ -853,4 +980,362 @@ namespace tut {
 		string header = readResponseHeader();
 		ensure(containsSubstring(header, "HTTP/1.1 502"));
 	}
+
+
+	/***** Client connection keep-alive *****/
+
+	TEST_METHOD(42) {
+		set_test_name("Keeps the client connection alive after a response with a"
+			" Content-Length, as used by the Apache module's connection pool");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"!~: \r\n"
+			"!~FLAGS: CD\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Content-Length: 2\r\n\r\n"
+			"ok");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Content-Length: 2\r\n"));
+		ensure("(3)", !containsSubstring(header, "Connection: close\r\n"));
+		char body[2];
+		ensure_equals("(4)", clientConnectionIO.read(body, sizeof(body)), 2u);
+		ensure_equals("(5)", StaticString(body, 2), "ok");
+
+		unsigned long long timeout = 100000;
+		ensure("(6)", !waitUntilReadable(clientConnection, &timeout));
+	}
+
+	TEST_METHOD(43) {
+		set_test_name("Closes the client connection after a dechunked response,"
+			" whose end the client can only detect through EOF");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"!~: \r\n"
+			"!~FLAGS: CD\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Type: text/plain\r\n"
+			"Transfer-Encoding: chunked\r\n\r\n"
+			"2\r\nok\r\n0\r\n\r\n");
+
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(2)", containsSubstring(header, "Connection: close\r\n"));
+		ensure_equals("(3)", readResponseBody(), "ok");
+	}
+
+
+	/***** Latency statistics *****/
+
+	TEST_METHOD(50) {
+		set_test_name("It records the latency of every request phase, overall and per app group");
+
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 5\r\n\r\n"
+			"hello");
+		readResponseHeader();
+		ensure_equals(readResponseBody(), "hello");
+
+		Json::Value doc;
+		EVENTUALLY(5,
+			doc = getLatencyStats();
+			result = doc["total"]["count"].asUInt() == 1;
+		);
+		ensure_equals("(1)", doc["header_parse"]["count"].asUInt(), 1u);
+		ensure_equals("(2)", doc["pool_checkout"]["count"].asUInt(), 1u);
+		ensure_equals("(3)", doc["app_connect"]["count"].asUInt(), 1u);
+		ensure_equals("(4)", doc["time_to_first_byte"]["count"].asUInt(), 1u);
+		ensure_equals("(5)", doc["response_forwarding"]["count"].asUInt(), 1u);
+		ensure("(6)", doc["total"].isMember("p99"));
+		ensure_equals("(7)", doc["app_groups"].size(), 1u);
+		ensure_equals("(8)", doc["app_groups"].begin()->operator[]("total")["count"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(51) {
+		set_test_name("Per app group latency stats are kept for a limited number of app groups,"
+			" dropping the least recently recorded one first");
+
+		RequestLatencyStatsSet stats;
+		const unsigned int max = RequestLatencyStatsSet::MAX_APP_GROUPS;
+		vector<string> names;
+
+		for (unsigned int i = 0; i <= max; i++) {
+			names.push_back("group" + toString(i));
+		}
+		for (unsigned int i = 0; i < max; i++) {
+			stats.getForAppGroup(names[i], 1000 + i).total.record(1);
+		}
+		ensure_equals("(1)", stats.getAppGroupCount(), max);
+
+		// Make group0 recently used, so that group1 is the oldest.
+		stats.getForAppGroup(names[0], 5000).total.record(1);
+		stats.getForAppGroup(names[max], 5001).total.record(1);
+		ensure_equals("(2)", stats.getAppGroupCount(), max);
+		ensure("(3)", stats.hasAppGroup(names[0]));
+		ensure("(4)", !stats.hasAppGroup(names[1]));
+		ensure("(5)", stats.hasAppGroup(names[2]));
+		ensure("(6)", stats.hasAppGroup(names[max]));
+		ensure_equals("(7)", stats.inspectAsJson()["app_groups"]["group0"]["total"]["count"].asUInt(), 2u);
+	}
+
+
+	/***** Request body splicing *****/
+
+	TEST_METHOD(55) {
+		set_test_name("Large request bodies are forwarded to the app with splice()"
+			" and arrive intact");
+
+		options.setUint("splice_threshold", 1024);
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		string body = createLargeBody();
+
+		connectToServer();
+		sendRequest(
+			"POST /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		boost::thread writer(boost::bind(&Core_ControllerTest::sendRequest,
+			this, StaticString(body)));
+		string received(body.size(), '\0');
+		ensure_equals("(1)", readExact(testSession.peerFd(), &received[0], body.size()),
+			(unsigned int) body.size());
+		writer.join();
+		ensure("(2)", received == body);
+
+		#ifdef __linux__
+			Json::Value doc = inspectState();
+			ensure("(3)", doc.isMember("splice"));
+			ensure_equals("(4)", doc["splice"]["request_bodies"].asUInt(), 1u);
+			ensure("(5)", doc["splice"]["request_body_bytes"]["bytes"].asUInt64() > 0);
+		#endif
+
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Content-Length: 2\r\n\r\n"
+			"ok");
+		waitUntilSessionClosed();
+		ensure("(6)", testSession.isSuccessful());
+	}
+
+	TEST_METHOD(56) {
+		set_test_name("Large response bodies are forwarded to the client with splice()"
+			" and arrive intact");
+
+		options.setUint("splice_threshold", 1024);
+		init();
+		useTestSessionObject();
+		testSession.setProtocol("http_session");
+
+		string body = createLargeBody();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		string response = "HTTP/1.1 200 OK\r\n"
+			"Content-Length: " + toString(body.size()) + "\r\n\r\n"
+			+ body;
+		boost::thread writer(boost::bind(&Core_ControllerTest::sendPeerResponse,
+			this, StaticString(response)));
+		string header = readResponseHeader();
+		string received = readResponseBody();
+		writer.join();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure_equals("(2)", received.size(), body.size());
+		ensure("(3)", received == body);
+
+		waitUntilSessionClosed();
+		ensure("(4)", testSession.isSuccessful());
+		#ifdef __linux__
+			Json::Value doc = inspectState();
+			ensure("(5)", doc.isMember("splice"));
+			ensure_equals("(6)", doc["splice"]["response_bodies"].asUInt(), 1u);
+			ensure("(7)", doc["splice"]["response_body_bytes"]["bytes"].asUInt64() > 0);
+		#endif
+	}
+
+	/***** Pool options *****/
+
+	TEST_METHOD(57) {
+		set_test_name("Pool options are cached per app group name and configuration"
+			" fingerprint");
+
+		options.setBool("multi_app", true);
+		options.set("friendly_error_pages", "false");
+		init();
+		// We only care about the options that the controller checks out a
+		// session with, so let all checkouts fail.
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_returnCheckoutErrors, this));
+
+		ensure_equals("(1)", sendMultiAppRequest("production", ""), "production");
+		ensure_equals("(2)", sendMultiAppRequest("staging", ""), "production");
+		ensure_equals("(3)", sendMultiAppRequest("staging", "00000000aaaaaaaa"), "staging");
+		ensure_equals("(4)", sendMultiAppRequest("development", "00000000aaaaaaaa"), "staging");
+		ensure_equals("(5)", sendMultiAppRequest("development", "00000000bbbbbbbb"), "development");
+		// Both fingerprints of the app group remain cached.
+		ensure_equals("(6)", sendMultiAppRequest("production", "00000000aaaaaaaa"), "staging");
+		ensure_equals("(7)", sendMultiAppRequest("production", "00000000bbbbbbbb"), "development");
+		ensure_equals("(8)", sendMultiAppRequest("staging", ""), "production");
+	}
+
+	TEST_METHOD(58) {
+		set_test_name("If the web server only sends a configuration fingerprint, then"
+			" the option headers that it sent earlier along with that fingerprint"
+			" are used, and if there are none then we ask the web server to resend"
+			" the options");
+
+		options.setBool("multi_app", true);
+		options.set("friendly_error_pages", "false");
+		init();
+		bg.safe->runSync(boost::bind(&Core_ControllerTest::_returnCheckoutErrors, this));
+
+		string header = sendCachedConfigRequest("00000000cccccccc");
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 503"));
+		ensure("(2)", containsSubstring(header,
+			"x-passenger-config-miss: 00000000cccccccc\r\n"));
+
+		ensure_equals("(3)", sendMultiAppRequest("staging", "00000000cccccccc"), "staging");
+		ensure_equals("(4)", sendMultiAppRequest("development", ""), "development");
+
+		header = sendCachedConfigRequest("00000000cccccccc");
+		ensure("(5)", !containsSubstring(header, "x-passenger-config-miss"));
+		ensure_equals("(6)", getLastEnvironment(), "staging");
+	}
+
+
+	/***** Turbocaching *****/
+
+	TEST_METHOD(59) {
+		set_test_name("If turbocache_gzip is enabled, then cached responses are served"
+			" gzip-compressed to clients that accept gzip, and as-is to other clients");
+
+		string content;
+		for (unsigned int i = 0; i < 100; i++) {
+			content.append("hello world\n");
+		}
+
+		options.setBool("turbocache_gzip", true);
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+		sendPeerResponse(
+			"HTTP/1.1 200 OK\r\n"
+			"Connection: close\r\n"
+			"Content-Type: text/plain\r\n"
+			"Cache-Control: public, max-age=60\r\n"
+			"Content-Length: " + toString(content.size()) + "\r\n\r\n"
+			+ content);
+		string body;
+		readResponseHeader();
+		ensure_equals("(1)", readResponseBody(), content);
+
+		string header = sendTurbocacheRequest("gzip, deflate", body);
+		ensure("(2)", containsSubstring(header, "HTTP/1.1 200 OK\r\n"));
+		ensure("(3)", containsSubstring(header, "Age: "));
+		ensure("(4)", containsSubstring(header, "Content-Encoding: gzip\r\n"));
+		ensure("(5)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure_equals("(6)", gunzip(body), content);
+
+		header = sendTurbocacheRequest("identity", body);
+		ensure("(7)", containsSubstring(header, "Age: "));
+		ensure("(8)", !containsSubstring(header, "Content-Encoding"));
+		ensure("(9)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure_equals("(10)", body, content);
+
+		header = sendTurbocacheRequest("*, gzip;q=0", body);
+		ensure("(11)", containsSubstring(header, "Age: "));
+		ensure("(12)", !containsSubstring(header, "Content-Encoding"));
+		ensure("(13)", containsSubstring(header, "Vary: Accept-Encoding\r\n"));
+		ensure_equals("(14)", body, content);
+
+		header = sendTurbocacheRequest("", body);
+		ensure("(15)", containsSubstring(header, "Age: "));
+		ensure("(16)", !containsSubstring(header, "Content-Encoding"));
+		ensure_equals("(17)", body, content);
+	}
+
+
+	/***** App response timeout *****/
+
+	TEST_METHOD(60) {
+		set_test_name("If the application doesn't begin its response within the"
+			" app response timeout, we send a 504");
+
+		options.setUint("app_response_timeout", 1);
+		init();
+		useTestSessionObject();
+
+		connectToServer();
+		sendRequest(
+			"GET /hello HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Connection: close\r\n"
+			"\r\n");
+		waitUntilSessionInitiated();
+		readPeerRequestHeader();
+
+		setLogLevel(LVL_ERROR);
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "HTTP/1.1 504"));
+		ensure_equals("(2)", inspectState()["timed_out_clients"]["app_response"].asUInt(), 1u);
+	}
 }
@@ -5,6 +5,8 @@
 #include <Core/Controller/Request.h>
 #include <Core/Controller/AppResponse.h>
 #include <Core/ResponseCache.h>
+#include <Core/Controller/TurboCaching.h>
+#include <zlib.h>
 
 using namespace Passenger;
 using namespace Passenger::Core;
@@ -145,6 +147,92 @@ namespace tut {
 			req.appResponse.bodyType = AppResponse::RBT_CONTENT_LENGTH;
 			req.appResponse.aux.bodyInfo.contentLength = body.size();
 		}
+
+		void setPath(const string &path) {
+			psg_lstr_init(&req.path);
+			psg_lstr_append(&req.path, req.pool, path.data(), path.size());
+		}
+
+		ResponseCacheType::Entry storeResponse(const string &path, const string &body) {
+			reset();
+			setPath(path);
+			initCacheableResponse();
+			initResponseBody(body);
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsStoring(&req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+
+			ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
+				2, body.size()));
+			if (entry.valid()) {
+				memcpy(entry.body->httpHeaderData, "\r\n", 2);
+				memcpy(entry.body->httpBodyData, body.data(), body.size());
+			}
+			return entry;
+		}
+
+		bool acceptsGzip(const StaticString &acceptEncoding) {
+			reset();
+			insertReqHeader(createHeader("accept-encoding", acceptEncoding), req.pool);
+			return responseCache.requestAcceptsGzip(&req);
+		}
+
+		bool allowsCompression(const StaticString &contentType,
+			const StaticString &extraHeader = StaticString(),
+			const StaticString &extraHeaderValue = StaticString())
+		{
+			reset();
+			initCacheableResponse();
+			if (!contentType.empty()) {
+				insertAppResponseHeader(createHeader("content-type", contentType),
+					req.pool);
+			}
+			if (!extraHeader.empty()) {
+				insertAppResponseHeader(createHeader(extraHeader, extraHeaderValue),
+					req.pool);
+			}
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.prepareRequestForStoring(&req));
+			return responseCache.responseAllowsCompression(&req);
+		}
+
+		string gunzip(const char *data, unsigned int size) {
+			z_stream stream;
+			char buf[1024];
+			string result;
+			int ret;
+
+			memset(&stream, 0, sizeof(stream));
+			ensure(inflateInit2(&stream, 15 + 16) == Z_OK);
+			stream.next_in = (Bytef *) data;
+			stream.avail_in = size;
+			do {
+				stream.next_out = (Bytef *) buf;
+				stream.avail_out = sizeof(buf);
+				ret = inflate(&stream, Z_NO_FLUSH);
+				ensure(ret == Z_OK || ret == Z_STREAM_END);
+				result.append(buf, sizeof(buf) - stream.avail_out);
+			} while (ret != Z_STREAM_END);
+			inflateEnd(&stream);
+			return result;
+		}
+
+		ResponseCacheType::Entry fetchResponse(const string &path) {
+			reset();
+			setPath(path);
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsFetching(&req));
+			return responseCache.fetch(&req, time(NULL));
+		}
+
+		void invalidateResponse(const string &path) {
+			reset();
+			setPath(path);
+			req.method = HTTP_POST;
+			ensure(responseCache.prepareRequest(this, &req));
+			ensure(responseCache.requestAllowsInvalidating(&req));
+			responseCache.invalidate(&req);
+		}
 	};
 
 	DEFINE_TEST_GROUP_WITH_LIMIT(Core_ResponseCacheTest, 100);
@@ -564,4 +652,225 @@ namespace tut {
 		ResponseCacheType::Entry entry2(responseCache.fetch(&req, time(NULL)));
 		ensure("(22)", !entry2.valid());
 	}
+
+
+	/***** Capacity and eviction *****/
+
+	TEST_METHOD(70) {
+		set_test_name("It can store up to the configured maximum number of entries");
+		responseCache.configure(100, 1024, 1024 * 1024);
+		for (unsigned int i = 0; i < 100; i++) {
+			ensure("(1)", storeResponse("/" + toString(i), "hello").valid());
+		}
+		ensure_equals("(2)", responseCache.getCount(), 100u);
+		ensure_equals("(3)", responseCache.getTotalEvictions(), 0u);
+		for (unsigned int i = 0; i < 100; i++) {
+			ResponseCacheType::Entry entry(fetchResponse("/" + toString(i)));
+			ensure("(4)", entry.valid());
+			ensure_equals("(5)", StaticString(entry.body->httpBodyData,
+				entry.body->httpBodySize), "hello");
+		}
+	}
+
+	TEST_METHOD(71) {
+		set_test_name("When full, it evicts entries that have not been fetched recently");
+		responseCache.configure(4, 1024, 1024 * 1024);
+		ensure("(1)", storeResponse("/1", "hello").valid());
+		ensure("(2)", storeResponse("/2", "hello").valid());
+		ensure("(3)", storeResponse("/3", "hello").valid());
+		ensure("(4)", storeResponse("/4", "hello").valid());
+		ensure("(5)", fetchResponse("/1").valid());
+		ensure("(6)", fetchResponse("/2").valid());
+		ensure("(7)", fetchResponse("/4").valid());
+
+		ensure("(10)", storeResponse("/5", "hello").valid());
+		ensure_equals("(11)", responseCache.getCount(), 4u);
+		ensure_equals("(12)", responseCache.getTotalEvictions(), 1u);
+		ensure("(13)", fetchResponse("/1").valid());
+		ensure("(14)", fetchResponse("/2").valid());
+		ensure("(15)", !fetchResponse("/3").valid());
+		ensure("(16)", fetchResponse("/4").valid());
+		ensure("(17)", fetchResponse("/5").valid());
+	}
+
+	TEST_METHOD(72) {
+		set_test_name("It does not store bodies larger than the configured maximum body size");
+		responseCache.configure(8, 100, 1024 * 1024);
+		ensure("(1)", storeResponse("/small", string(100, 'x')).valid());
+		ensure("(2)", !storeResponse("/large", string(101, 'x')).valid());
+		ensure("(3)", fetchResponse("/small").valid());
+		ensure("(4)", !fetchResponse("/large").valid());
+	}
+
+	TEST_METHOD(73) {
+		set_test_name("It stays within the memory limit by evicting entries");
+		responseCache.configure(100, 1024 * 32, 1024 * 16);
+		for (unsigned int i = 0; i < 10; i++) {
+			ensure("(1)", storeResponse("/" + toString(i), string(3000, 'x')).valid());
+			ensure("(2)", responseCache.getMemoryUsage() <= 1024 * 16);
+		}
+		ensure_equals("(3)", responseCache.getCount(), 4u);
+		ensure_equals("(4)", responseCache.getTotalEvictions(), 6u);
+		ensure("(5)", fetchResponse("/9").valid());
+		ensure("(6)", !fetchResponse("/0").valid());
+
+		// A response that can never fit is not stored.
+		ensure("(10)", !storeResponse("/big", string(1024 * 17, 'x')).valid());
+		ensure("(11)", fetchResponse("/9").valid());
+	}
+
+	TEST_METHOD(74) {
+		set_test_name("It reuses the memory of erased entries for entries of other sizes");
+		responseCache.configure(100, 1024 * 64, 1024 * 64);
+		ensure("(1)", storeResponse("/small1", "hello").valid());
+		ensure("(2)", storeResponse("/small2", "hello").valid());
+		invalidateResponse("/small1");
+		invalidateResponse("/small2");
+		ResponseCacheType::Entry entry(storeResponse("/large", string(1024 * 60, 'x')));
+		ensure("(3)", entry.valid());
+		ensure("(4)", responseCache.getMemoryUsage() <= 1024 * 64);
+		ensure_equals("(5)", responseCache.getTotalEvictions(), 0u);
+
+		entry = fetchResponse("/large");
+		ensure("(10)", entry.valid());
+		ensure_equals("(11)", StaticString(entry.body->httpBodyData,
+			entry.body->httpBodySize), string(1024 * 60, 'x'));
+	}
+
+	TEST_METHOD(75) {
+		set_test_name("Erasing entries does not make other entries unreachable");
+		responseCache.configure(1000, 1024, 1024 * 1024 * 4);
+		for (unsigned int i = 0; i < 1000; i++) {
+			ensure("(1)", storeResponse("/" + toString(i), toString(i)).valid());
+		}
+		for (unsigned int i = 0; i < 1000; i += 3) {
+			invalidateResponse("/" + toString(i));
+		}
+		for (unsigned int i = 0; i < 1000; i++) {
+			ResponseCacheType::Entry entry(fetchResponse("/" + toString(i)));
+			if (i % 3 == 0) {
+				ensure("(2)", !entry.valid());
+			} else {
+				ensure("(3)", entry.valid());
+				ensure_equals("(4)", StaticString(entry.body->httpBodyData,
+					entry.body->httpBodySize), toString(i));
+			}
+		}
+	}
+
+	TEST_METHOD(76) {
+		set_test_name("It keeps track of the total number of hits and misses");
+		ensure("(1)", storeResponse("/", "hello").valid());
+		ensure("(2)", fetchResponse("/").valid());
+		ensure("(3)", fetchResponse("/").valid());
+		ensure("(4)", !fetchResponse("/foo").valid());
+		ensure_equals("(5)", responseCache.getTotalHits(), 2u);
+		ensure_equals("(6)", responseCache.getTotalMisses(), 1u);
+	}
+
+
+	/***** Compressed variants *****/
+
+	TEST_METHOD(80) {
+		set_test_name("requestAcceptsGzip() checks the Accept-Encoding header");
+		reset();
+		ensure("(1)", !responseCache.requestAcceptsGzip(&req));
+		ensure("(2)", acceptsGzip("gzip"));
+		ensure("(3)", acceptsGzip("gzip, deflate, br"));
+		ensure("(4)", acceptsGzip("deflate, GZIP;q=0.8"));
+		ensure("(5)", acceptsGzip("x-gzip"));
+		ensure("(6)", acceptsGzip("*"));
+		ensure("(7)", acceptsGzip(" br , gzip ; q=1"));
+		ensure("(8)", !acceptsGzip(""));
+		ensure("(9)", !acceptsGzip("identity"));
+		ensure("(10)", !acceptsGzip("deflate, br"));
+		ensure("(11)", !acceptsGzip("gzip;q=0"));
+		ensure("(12)", !acceptsGzip("gzip; q=0.000, deflate"));
+		ensure("(13)", !acceptsGzip("gzipper"));
+		ensure("(14)", !acceptsGzip("*;q=0"));
+		ensure("(15)", !acceptsGzip("*, gzip;q=0"));
+		ensure("(16)", !acceptsGzip("gzip;q=0, *"));
+		ensure("(17)", acceptsGzip("*;q=0, gzip"));
+		ensure("(18)", acceptsGzip("deflate, *"));
+	}
+
+	TEST_METHOD(81) {
+		set_test_name("responseAllowsCompression() only allows textual, unencoded responses");
+		ensure("(1)", allowsCompression("text/html"));
+		ensure("(2)", allowsCompression("text/html; charset=utf-8"));
+		ensure("(3)", allowsCompression("Application/JSON"));
+		ensure("(4)", allowsCompression("application/vnd.api+json"));
+		ensure("(5)", allowsCompression("application/atom+xml"));
+		ensure("(6)", allowsCompression("image/svg+xml"));
+		ensure("(7)", !allowsCompression(""));
+		ensure("(8)", !allowsCompression("image/png"));
+		ensure("(9)", !allowsCompression("application/octet-stream"));
+		ensure("(10)", !allowsCompression("text/html", "content-encoding", "gzip"));
+		ensure("(11)", !allowsCompression("text/html", "etag", "\"abc\""));
+		ensure("(12)", allowsCompression("text/html", "etag", "W/\"abc\""));
+	}
+
+	TEST_METHOD(82) {
+		set_test_name("It stores the gzip variant in the same entry as the uncompressed body");
+		string body = "hello world";
+		string gzipBody = "compressed";
+
+		reset();
+		setPath("/");
+		initCacheableResponse();
+		initResponseBody(body);
+		ensure("(1)", responseCache.prepareRequest(this, &req));
+		ensure("(2)", responseCache.prepareRequestForStoring(&req));
+		ResponseCacheType::Entry entry(responseCache.store(&req, time(NULL),
+			2, body.size(), gzipBody.size()));
+		ensure("(3)", entry.valid());
+		memcpy(entry.body->httpHeaderData, "\r\n", 2);
+		memcpy(entry.body->httpBodyData, body.data(), body.size());
+		memcpy(entry.body->httpGzipBodyData, gzipBody.data(), gzipBody.size());
+
+		entry = fetchResponse("/");
+		ensure("(4)", entry.valid());
+		ensure_equals("(5)", StaticString(entry.body->httpBodyData,
+			entry.body->httpBodySize), body);
+		ensure_equals("(6)", StaticString(entry.body->httpGzipBodyData,
+			entry.body->httpGzipBodySize), gzipBody);
+
+		entry = storeResponse("/plain", body);
+		ensure("(7)", entry.valid());
+		ensure_equals("(8)", entry.body->httpGzipBodySize, 0u);
+		ensure("(9)", entry.body->httpGzipBodyData == NULL);
+	}
+
+	TEST_METHOD(83) {
+		set_test_name("TurboCaching::compressBody() gzips bodies that are worth compressing");
+		TurboCaching<Request> turboCaching;
+		string body;
+		char *output = NULL;
+		unsigned int size;
+
+		for (unsigned int i = 0; i < 100; i++) {
+			body.append("<p>Hello world " + toString(i) + "</p>\n");
+		}
+
+		reset();
+		// Split the body over multiple parts.
+		psg_lstr_append(&req.appResponse.bodyCacheBuffer, req.pool,
+			body.data(), body.size() / 2);
+		psg_lstr_append(&req.appResponse.bodyCacheBuffer, req.pool,
+			body.data() + body.size() / 2, body.size() - body.size() / 2);
+		size = turboCaching.compressBody(&req, &req.appResponse.bodyCacheBuffer, &output);
+		ensure("(1)", size > 0);
+		ensure("(2)", size < body.size());
+		ensure_equals("(3)", gunzip(output, size), body);
+
+		// It can be reused.
+		size = turboCaching.compressBody(&req, &req.appResponse.bodyCacheBuffer, &output);
+		ensure_equals("(4)", gunzip(output, size), body);
+
+		// Small bodies are not compressed.
+		reset();
+		psg_lstr_append(&req.appResponse.bodyCacheBuffer, req.pool, "hello");
+		ensure_equals("(5)", turboCaching.compressBody(&req,
+			&req.appResponse.bodyCacheBuffer, &output), 0u);
+	}
 }
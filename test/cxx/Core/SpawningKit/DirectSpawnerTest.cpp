@@ -123,4 +123,26 @@ namespace tut {
 		writeExact(fd, "ping\n");
 		ensure_equals(readAll(fd), "pong\n");
 	}
+
+	TEST_METHOD(83) {
+		set_test_name("If spawn diagnostics are deferred, then they are "
+			"still collected when spawning fails");
+		Options options = createOptions();
+		options.appRoot      = "stub";
+		options.startCommand = "perl\t" "-e\t" "print STDERR \"hello world\\n\"";
+		options.startupFile  = ".";
+		config->deferSpawnDiagnostics = true;
+
+		DirectSpawner spawner(config);
+		setLogLevel(LVL_CRIT);
+
+		try {
+			spawner.spawn(options);
+			fail("SpawnException expected");
+		} catch (const SpawnException &e) {
+			ensure("(1)", !e.get("envvars").empty());
+			ensure("(2)", !e.get("user_info").empty());
+			ensure("(3)", !e.get("ulimit").empty());
+		}
+	}
 }
@@ -0,0 +1,77 @@
+#include <TestSupport.h>
+#include <Core/SpawningKit/ShellEnvironmentCache.h>
+#include <Utils/SystemTime.h>
+
+using namespace Passenger;
+using namespace Passenger::SpawningKit;
+using namespace std;
+
+namespace tut {
+	struct Core_SpawningKit_ShellEnvironmentCacheTest {
+		ShellEnvironmentCache cache;
+		string envvars;
+
+		Core_SpawningKit_ShellEnvironmentCacheTest()
+			: cache(60)
+			{ }
+
+		~Core_SpawningKit_ShellEnvironmentCacheTest() {
+			SystemTime::releaseAll();
+		}
+	};
+
+	DEFINE_TEST_GROUP(Core_SpawningKit_ShellEnvironmentCacheTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Lookups succeed after storing an entry with the same fingerprint");
+		ensure("(1)", !cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+		cache.store(1, "/bin/bash", "/app", "fp", string("A\0B\0", 4));
+		ensure("(2)", cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+		ensure_equals("(3)", envvars, string("A\0B\0", 4));
+		ensure_equals("(4)", cache.getHits(), 1u);
+		ensure_equals("(5)", cache.getMisses(), 1u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Entries are keyed by user, shell and app root");
+		cache.store(1, "/bin/bash", "/app", "fp", "x");
+		ensure("(1)", !cache.lookup(2, "/bin/bash", "/app", "fp", envvars));
+		ensure("(2)", !cache.lookup(1, "/bin/zsh", "/app", "fp", envvars));
+		ensure("(3)", !cache.lookup(1, "/bin/bash", "/app2", "fp", envvars));
+		ensure("(4)", cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Entries are invalidated when the fingerprint changes");
+		cache.store(1, "/bin/bash", "/app", "fp", "x");
+		ensure("(1)", !cache.lookup(1, "/bin/bash", "/app", "fp2", envvars));
+		ensure_equals("(2)", cache.getInvalidations(), 1u);
+		ensure("(3)", !cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Entries are invalidated after the TTL");
+		SystemTime::forceAll(1000000);
+		cache.store(1, "/bin/bash", "/app", "fp", "x");
+		SystemTime::forceAll(1000000 + 59 * 1000000ull);
+		ensure("(1)", cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+		SystemTime::forceAll(1000000 + 60 * 1000000ull);
+		ensure("(2)", !cache.lookup(1, "/bin/bash", "/app", "fp", envvars));
+		ensure_equals("(3)", cache.getInvalidations(), 1u);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("The fingerprint changes when a shell startup file in "
+			"the home directory is created or modified");
+		TempDir home("tmp.home");
+		string fingerprint1 = ShellEnvironmentCache::createFingerprint("tmp.home", "/");
+		createFile("tmp.home/.bashrc", "export FOO=1\n");
+		string fingerprint2 = ShellEnvironmentCache::createFingerprint("tmp.home", "/");
+		ensure("(1)", fingerprint1 != fingerprint2);
+		ensure_equals("(2)", ShellEnvironmentCache::createFingerprint("tmp.home", "/"),
+			fingerprint2);
+		createFile("tmp.home/.bashrc", "export FOO=12\n");
+		ensure("(3)", ShellEnvironmentCache::createFingerprint("tmp.home", "/")
+			!= fingerprint2);
+	}
+}
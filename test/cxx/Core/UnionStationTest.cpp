@@ -32,6 +32,7 @@ namespace tut {
 		FileDescriptor serverFd;
 		VariantMap controllerOptions;
 		boost::shared_ptr<UstRouter::Controller> controller;
+		BatchWriterPtr writer;
 		ContextPtr context, context2, context3, context4;
 
 		Core_UnionStationTest()
@@ -46,14 +47,17 @@ namespace tut {
 			controllerOptions.setBool("ust_router_dev_mode", true);
 			controllerOptions.set("ust_router_dump_dir", tmpdir.getPath());
 
+			// The tests continue transactions in other contexts, which
+			// relies on the ordering guarantees of a shared writer.
+			writer = boost::make_shared<BatchWriter>();
 			context = boost::make_shared<Context>(socketAddress, "test", "1234",
-				"localhost");
+				"localhost", writer);
 			context2 = boost::make_shared<Context>(socketAddress, "test", "1234",
-				"localhost");
+				"localhost", writer);
 			context3 = boost::make_shared<Context>(socketAddress, "test", "1234",
-				"localhost");
+				"localhost", writer);
 			context4 = boost::make_shared<Context>(socketAddress, "test", "1234",
-				"localhost");
+				"localhost", writer);
 		}
 
 		~Core_UnionStationTest() {
@@ -564,5 +568,90 @@ namespace tut {
 		ensureSubstringNotInDumpFile("transaction 2\n");
 	}
 
+	TEST_METHOD(23) {
+		set_test_name("Logging does not block if the UstRouter does not read,"
+			" but drops log messages once the writer's queue is full");
+		SocketPair sockets = createUnixSocketPair(__FILE__, __LINE__);
+		ConnectionPtr connection = boost::make_shared<Connection>(sockets.first.detach());
+		BatchWriterPtr smallWriter = boost::make_shared<BatchWriter>(16);
+		ContextPtr ctx = boost::make_shared<Context>(socketAddress, "test", "1234",
+			"localhost", smallWriter);
+		TransactionPtr log = boost::make_shared<Transaction>(ctx, connection,
+			"txn-id", "foobar", "requests", "-");
+		string text(1024 * 16, 'x');
+		unsigned long long startTime = SystemTime::getMonotonicUsec();
+
+		// Nobody reads from sockets.second, so the writer thread
+		// will block once the socket buffer is full.
+		for (unsigned int i = 0; i < 1000; i++) {
+			log->message(text);
+		}
+		ensure("Logging does not block",
+			SystemTime::getMonotonicUsec() - startTime < 1000000);
+		ensure("Messages are dropped", smallWriter->getStats().dropped > 0);
+		ensure("The queue is bounded", smallWriter->getStats().peakQueued <= 16);
+
+		// Unblock the writer thread.
+		sockets.second.close();
+		log.reset();
+		EVENTUALLY(5,
+			result = smallWriter->getStats().queued == 0;
+		);
+		BatchWriter::Stats stats = smallWriter->getStats();
+		ensure(stats.failed > 0);
+		ensure_equals(stats.written + stats.dropped + stats.failed, (boost::uint64_t) 1001);
+	}
+
+	TEST_METHOD(24) {
+		set_test_name("Messages that are too large for the UstRouter protocol are rejected"
+			" without corrupting the connection");
+		init();
+		SystemTime::forceAll(YESTERDAY);
+
+		TransactionPtr log = context->continueTransaction(string(1024 * 70, 'x'), "foobar");
+		ensure("(1)", log->isNull());
+		ensure_equals("(2)", writer->getStats().rejected, (boost::uint64_t) 1);
+
+		log = context->newTransaction("foobar");
+		ensure("(3)", !log->isNull());
+		log->message("hello");
+		log.reset();
+		ensureSubstringInDumpFile("hello\n");
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("A connection is checked back into the pool only after"
+			" everything queued for it has been written");
+		SocketPair sockets = createUnixSocketPair(__FILE__, __LINE__);
+		ConnectionPtr connection = boost::make_shared<Connection>(sockets.first.detach());
+		TransactionPtr log = boost::make_shared<Transaction>(context, connection,
+			"txn-id", "foobar", "requests", "-");
+		string text(1024 * 16, 'x');
+		ConnectionPtr connection2;
+
+		// Nobody reads from sockets.second yet, so the writer thread
+		// blocks once the socket buffer is full.
+		for (unsigned int i = 0; i < 100; i++) {
+			log->message(text);
+		}
+		log.reset();
+		// There is no UstRouter, so this can't create a new connection either.
+		ensure("(1)", context->checkoutConnection() == NULL);
+
+		setNonBlocking(sockets.second);
+		EVENTUALLY(5,
+			char buf[1024 * 16];
+			while (syscalls::read(sockets.second, buf, sizeof(buf)) > 0) {
+				// Discard.
+			}
+			connection2 = context->checkoutConnection();
+			result = connection2 != NULL;
+		);
+		ensure("(2)", connection2 == connection);
+		BatchWriter::Stats stats = writer->getStats();
+		ensure_equals("(3)", stats.written, (boost::uint64_t) 101);
+		ensure_equals("(4)", stats.queued, 0u);
+	}
+
 	/************************************/
 }
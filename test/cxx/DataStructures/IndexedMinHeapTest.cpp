@@ -0,0 +1,121 @@
+#include <TestSupport.h>
+#include <vector>
+#include <cstdlib>
+#include <DataStructures/IndexedMinHeap.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct DataStructures_IndexedMinHeapTest {
+		IndexedMinHeap heap;
+
+		/** Returns the first slot with the smallest key, by linear scan. */
+		unsigned int linearMin(const vector<int> &keys) {
+			unsigned int result = 0;
+			for (unsigned int i = 1; i < keys.size(); i++) {
+				if (keys[i] < keys[result]) {
+					result = i;
+				}
+			}
+			return result;
+		}
+
+		void ensureConsistent(const vector<int> &keys) {
+			ensure_equals("size", heap.size(), (unsigned int) keys.size());
+			for (unsigned int i = 0; i < keys.size(); i++) {
+				ensure_equals("key", heap[i], keys[i]);
+				ensure_equals("data", heap.data()[i], keys[i]);
+			}
+			if (!keys.empty()) {
+				ensure_equals("top", heap.top(), linearMin(keys));
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(DataStructures_IndexedMinHeapTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Initial state");
+		ensure(heap.empty());
+		ensure_equals(heap.size(), 0u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("top() returns the slot with the smallest key");
+		heap.push_back(5);
+		heap.push_back(3);
+		heap.push_back(8);
+		ensure_equals("(1)", heap.top(), 1u);
+		heap.push_back(1);
+		ensure_equals("(2)", heap.top(), 3u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("If multiple slots have the smallest key, then top() returns the lowest one");
+		heap.push_back(2);
+		heap.push_back(1);
+		heap.push_back(1);
+		heap.push_back(1);
+		ensure_equals("(1)", heap.top(), 1u);
+		heap.set(1, 2);
+		ensure_equals("(2)", heap.top(), 2u);
+		heap.set(0, 1);
+		ensure_equals("(3)", heap.top(), 0u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("set() moves slots up and down the heap");
+		heap.push_back(0);
+		heap.push_back(0);
+		heap.push_back(0);
+		heap.set(0, 10);
+		ensure_equals("(1)", heap.top(), 1u);
+		heap.set(1, 10);
+		ensure_equals("(2)", heap.top(), 2u);
+		heap.set(2, 10);
+		ensure_equals("(3)", heap.top(), 0u);
+		heap.set(2, 9);
+		ensure_equals("(4)", heap.top(), 2u);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("erase() shifts subsequent slots down");
+		heap.push_back(4);
+		heap.push_back(1);
+		heap.push_back(3);
+		heap.push_back(2);
+		heap.erase(1);
+		ensure_equals("(1)", heap.size(), 3u);
+		ensure_equals("(2)", heap[0], 4);
+		ensure_equals("(3)", heap[1], 3);
+		ensure_equals("(4)", heap[2], 2);
+		ensure_equals("(5)", heap.top(), 2u);
+		heap.set(0, 0);
+		ensure_equals("(6)", heap.top(), 0u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Random operations give the same results as a linear scan");
+		vector<int> keys;
+		srand(1234);
+		for (unsigned int i = 0; i < 5000; i++) {
+			unsigned int op = rand() % 10;
+			if (keys.empty() || op < 3) {
+				int key = rand() % 20;
+				keys.push_back(key);
+				heap.push_back(key);
+			} else if (op < 9) {
+				unsigned int slot = rand() % keys.size();
+				int key = rand() % 20;
+				keys[slot] = key;
+				heap.set(slot, key);
+			} else {
+				unsigned int slot = rand() % keys.size();
+				keys.erase(keys.begin() + slot);
+				heap.erase(slot);
+			}
+			ensureConsistent(keys);
+		}
+	}
+}
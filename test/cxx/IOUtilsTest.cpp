@@ -4,6 +4,8 @@
 #include <oxt/system_calls.hpp>
 #include <boost/bind.hpp>
 #include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 #include <cerrno>
 #include <string>
 
@@ -844,6 +846,30 @@ namespace tut {
 		}
 	}
 
+	/***** Test createTcpServer() *****/
+
+	TEST_METHOD(75) {
+		// With reusePort, multiple sockets can listen on the same address and port.
+		#ifdef SO_REUSEPORT
+			struct sockaddr_in addr;
+			socklen_t len = sizeof(addr);
+			FileDescriptor fd1(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__, true),
+				NULL, 0);
+			getsockname(fd1, (struct sockaddr *) &addr, &len);
+			unsigned short port = ntohs(addr.sin_port);
+			FileDescriptor fd2(createTcpServer("127.0.0.1", port, 0, __FILE__, __LINE__, true),
+				NULL, 0);
+			ensure(fd2 != -1);
+			try {
+				FileDescriptor fd3(createTcpServer("127.0.0.1", port, 0, __FILE__, __LINE__),
+					NULL, 0);
+				fail("SystemException expected");
+			} catch (const SystemException &) {
+				// Pass.
+			}
+		#endif
+	}
+
 	/***** Test readFileDescriptor() and writeFileDescriptor() *****/
 
 	TEST_METHOD(80) {
@@ -0,0 +1,129 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how many log lines per second N threads can log, with
+ * synchronous logging and with the asynchronous log writer. Log output
+ * is written to the given file (default: tmp.logging_benchmark.log).
+ * For the asynchronous writer, it reports both the time that the logging
+ * threads spent and the time until all lines were written, as well as
+ * the number of lines that were dropped because a buffer was full.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/LoggingBenchmark [THREADS] [LINES_PER_THREAD] [LOG_FILE]
+ */
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <Logging.h>
+#include <Constants.h>
+#include <Utils/SystemTime.h>
+
+using namespace std;
+using namespace Passenger;
+
+namespace {
+
+void
+logLines(unsigned int count) {
+	for (unsigned int i = 0; i < count; i++) {
+		P_NOTICE("Benchmark log line " << i << " of " << count
+			<< ": the quick brown fox jumps over the lazy dog");
+	}
+}
+
+void
+runThreads(unsigned int threads, unsigned int linesPerThread) {
+	boost::thread_group group;
+	for (unsigned int i = 0; i < threads; i++) {
+		group.create_thread(boost::bind(logLines, linesPerThread));
+	}
+	group.join_all();
+}
+
+void
+report(const char *name, unsigned long long lines, unsigned long long usec) {
+	printf("  %-26s  %12.0f lines/sec  (%.1f ms)\n", name,
+		lines * 1000000.0 / std::max<unsigned long long>(usec, 1),
+		usec / 1000.0);
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int threads = (argc > 1) ? atoi(argv[1]) : 4;
+	unsigned int linesPerThread = (argc > 2) ? atoi(argv[2]) : 100000;
+	const char *logFile = (argc > 3) ? argv[3] : "tmp.logging_benchmark.log";
+	unsigned long long totalLines = (unsigned long long) threads * linesPerThread;
+	unsigned long long startTime, loggedTime, writtenTime, dropped;
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_NOTICE);
+
+	int fd = open(logFile, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+	if (fd == -1) {
+		perror("Cannot open log file");
+		return 1;
+	}
+	dup2(fd, STDERR_FILENO);
+	close(fd);
+
+	printf("%u threads, %u lines per thread, logging to %s\n",
+		threads, linesPerThread, logFile);
+
+	startTime = SystemTime::getMonotonicUsec();
+	runThreads(threads, linesPerThread);
+	report("Synchronous", totalLines, SystemTime::getMonotonicUsec() - startTime);
+
+	startAsyncLogWriter(DEFAULT_LOG_BUFFER_SIZE);
+	startTime = SystemTime::getMonotonicUsec();
+	runThreads(threads, linesPerThread);
+	loggedTime = SystemTime::getMonotonicUsec();
+	stopAsyncLogWriter();
+	writtenTime = SystemTime::getMonotonicUsec();
+	dropped = getDroppedLogEntryCount();
+
+	report("Asynchronous (logging)", totalLines, loggedTime - startTime);
+	report("Asynchronous (written)", totalLines - dropped, writtenTime - startTime);
+	printf("  %llu lines dropped (%.1f%%)\n", dropped, dropped * 100.0 / totalLines);
+
+	if (argc <= 3) {
+		unlink(logFile);
+	}
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include <TestSupport.h>
+#include <Logging.h>
+#include <Utils/IOUtils.h>
+#include <Utils/StrIntUtils.h>
+#include <boost/thread.hpp>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct LoggingTest {
+		int savedStderr;
+		int oldLogLevel;
+		unsigned long long oldDroppedCount;
+
+		LoggingTest() {
+			int fd = open("tmp.log", O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+			savedStderr = dup(STDERR_FILENO);
+			dup2(fd, STDERR_FILENO);
+			close(fd);
+			oldLogLevel = getLogLevel();
+			setLogLevel(LVL_NOTICE);
+			oldDroppedCount = getDroppedLogEntryCount();
+		}
+
+		~LoggingTest() {
+			stopAsyncLogWriter();
+			setLogLevel(oldLogLevel);
+			dup2(savedStderr, STDERR_FILENO);
+			close(savedStderr);
+			unlink("tmp.log");
+		}
+
+		string readLog() {
+			return readAll("tmp.log");
+		}
+
+		// Checks that all log lines are intact and returns the
+		// number of lines that contain the given text.
+		unsigned int countEntries(const StaticString &text) {
+			vector<string> lines;
+			unsigned int result = 0;
+
+			split(readLog(), '\n', lines);
+			for (unsigned int i = 0; i < lines.size(); i++) {
+				if (lines[i].empty()) {
+					continue;
+				}
+				ensure("Line " + toString(i) + " is intact",
+					startsWith(lines[i], "[ "));
+				if (lines[i].find(text.data(), 0, text.size()) != string::npos) {
+					result++;
+				}
+			}
+			return result;
+		}
+
+		static void logEntries(unsigned int count) {
+			for (unsigned int i = 0; i < count; i++) {
+				P_WARN("entry " << i);
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(LoggingTest);
+
+	TEST_METHOD(1) {
+		set_test_name("The asynchronous writer writes buffered entries in the background");
+		startAsyncLogWriter(1024 * 4);
+		P_WARN("hello world");
+		EVENTUALLY(2,
+			result = readLog().find("hello world") != string::npos;
+		);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Stopping the asynchronous writer writes all buffered entries");
+		startAsyncLogWriter(1024 * 64);
+		logEntries(100);
+		stopAsyncLogWriter();
+		ensure_equals(countEntries("entry "), 100u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Critical entries are written synchronously, after the entries that were buffered before");
+		startAsyncLogWriter(1024 * 64);
+		P_WARN("first");
+		P_CRITICAL("second");
+		string log = readLog();
+		ensure("(1)", log.find("first") != string::npos);
+		ensure("(2)", log.find("second") != string::npos);
+		ensure("(3)", log.find("first") < log.find("second"));
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Entries that are too large for the buffer are written synchronously");
+		startAsyncLogWriter(256);
+		P_WARN(string(100, 'x'));
+		ensure(readLog().find(string(100, 'x')) != string::npos);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Entries that don't fit in the buffer are dropped and counted");
+		startAsyncLogWriter(1024);
+		logEntries(1000);
+		stopAsyncLogWriter();
+
+		unsigned long long dropped = getDroppedLogEntryCount() - oldDroppedCount;
+		ensure_equals(countEntries("entry ") + dropped, 1000ull);
+		if (dropped > 0) {
+			ensure(readLog().find("log entries were dropped") != string::npos);
+		}
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Entries from multiple threads are written intact");
+		boost::thread_group threads;
+
+		startAsyncLogWriter(1024 * 64);
+		for (unsigned int i = 0; i < 4; i++) {
+			threads.create_thread(boost::bind(logEntries, 1000));
+		}
+		threads.join_all();
+		stopAsyncLogWriter();
+
+		unsigned long long dropped = getDroppedLogEntryCount() - oldDroppedCount;
+		ensure_equals(countEntries("entry ") + dropped, 4000ull);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("Child processes log synchronously");
+		startAsyncLogWriter(1024 * 64);
+		pid_t pid = fork();
+		if (pid == 0) {
+			P_WARN("hello from child");
+			_exit(0);
+		} else {
+			waitpid(pid, NULL, 0);
+			ensure(readLog().find("hello from child") != string::npos);
+		}
+	}
+}
@@ -264,4 +264,132 @@ namespace tut {
 		ensure_equals("(5)", pool.nfree_mbuf_blockq, 0u);
 		ensure_equals("(6)", pool.nactive_mbuf_blockq, 0u);
 	}
+
+	TEST_METHOD(24) {
+		set_test_name("mbuf_pool_release()");
+		mbuf buffer(mbuf_get(&pool));
+		mbuf buffer2(mbuf_get(&pool));
+		mbuf buffer3(mbuf_get(&pool));
+		buffer = mbuf();
+		buffer2 = mbuf();
+		buffer3 = mbuf();
+		ensure_equals("(1)", pool.nfree_mbuf_blockq, 3u);
+
+		ensure_equals("(2)", mbuf_pool_release(&pool, 2), 2u);
+		ensure_equals("(3)", pool.nfree_mbuf_blockq, 1u);
+		ensure_equals("(4)", mbuf_pool_release(&pool, 2), 1u);
+		ensure_equals("(5)", pool.nfree_mbuf_blockq, 0u);
+		ensure_equals("(6)", pool.nactive_mbuf_blockq, 0u);
+	}
+
+	TEST_METHOD(25) {
+		set_test_name("The pool tracks the peak number of active mbuf_blocks");
+		{
+			mbuf buffer(mbuf_get(&pool));
+			mbuf buffer2(mbuf_get(&pool));
+		}
+		mbuf buffer3(mbuf_get(&pool));
+		ensure_equals("(1)", pool.nactive_mbuf_blockq, 1u);
+		ensure_equals("(2)", pool.peak_nactive_mbuf_blockq, 2u);
+	}
+
+	/***** Size classes *****/
+
+	struct SizeClassFixture {
+		struct mbuf_pool pools[MBUF_SIZE_CLASS_COUNT];
+		struct mbuf_pool_set set;
+		struct mbuf_size_class_tracker tracker;
+
+		SizeClassFixture() {
+			pools[MBUF_SIZE_CLASS_SMALL].mbuf_block_chunk_size = 1024;
+			pools[MBUF_SIZE_CLASS_MEDIUM].mbuf_block_chunk_size = 4096;
+			pools[MBUF_SIZE_CLASS_LARGE].mbuf_block_chunk_size = 65536;
+			for (unsigned int i = 0; i < MBUF_SIZE_CLASS_COUNT; i++) {
+				mbuf_pool_init(&pools[i]);
+				set.pools[i] = &pools[i];
+			}
+			mbuf_size_class_tracker_init(&tracker, MBUF_SIZE_CLASS_SMALL);
+		}
+
+		~SizeClassFixture() {
+			for (unsigned int i = 0; i < MBUF_SIZE_CLASS_COUNT; i++) {
+				mbuf_pool_deinit(&pools[i]);
+			}
+		}
+
+		void read(size_t size, size_t bufferSize) {
+			mbuf_size_class_tracker_update(&tracker, &set, size, bufferSize);
+		}
+
+		size_t dataSize(enum mbuf_size_class sizeClass) {
+			return mbuf_pool_data_size(&pools[sizeClass]);
+		}
+	};
+
+	TEST_METHOD(26) {
+		set_test_name("The size class tracker moves up a size class after a read that filled the buffer");
+		SizeClassFixture f;
+
+		f.read(f.dataSize(MBUF_SIZE_CLASS_SMALL), f.dataSize(MBUF_SIZE_CLASS_SMALL));
+		ensure_equals("(1)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_MEDIUM);
+		f.read(f.dataSize(MBUF_SIZE_CLASS_MEDIUM), f.dataSize(MBUF_SIZE_CLASS_MEDIUM));
+		ensure_equals("(2)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_LARGE);
+		f.read(f.dataSize(MBUF_SIZE_CLASS_LARGE), f.dataSize(MBUF_SIZE_CLASS_LARGE));
+		ensure_equals("(3)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_LARGE);
+	}
+
+	TEST_METHOD(27) {
+		set_test_name("The size class tracker does not move up after filling a small leftover buffer");
+		SizeClassFixture f;
+
+		f.read(10, 10);
+		ensure_equals((int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_SMALL);
+	}
+
+	TEST_METHOD(28) {
+		set_test_name("The size class tracker moves down a size class only after several consecutive small reads");
+		SizeClassFixture f;
+		unsigned int i;
+
+		mbuf_size_class_tracker_init(&f.tracker, MBUF_SIZE_CLASS_LARGE);
+		for (i = 0; i < MBUF_SIZE_CLASS_DOWNGRADE_READS - 1; i++) {
+			f.read(100, f.dataSize(MBUF_SIZE_CLASS_LARGE));
+		}
+		ensure_equals("(1)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_LARGE);
+
+		// A read that needs the current size class resets the count.
+		f.read(f.dataSize(MBUF_SIZE_CLASS_MEDIUM) + 1, f.dataSize(MBUF_SIZE_CLASS_LARGE));
+		for (i = 0; i < MBUF_SIZE_CLASS_DOWNGRADE_READS - 1; i++) {
+			f.read(100, f.dataSize(MBUF_SIZE_CLASS_LARGE));
+		}
+		ensure_equals("(2)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_LARGE);
+
+		f.read(100, f.dataSize(MBUF_SIZE_CLASS_LARGE));
+		ensure_equals("(3)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_MEDIUM);
+		for (i = 0; i < MBUF_SIZE_CLASS_DOWNGRADE_READS; i++) {
+			f.read(100, f.dataSize(MBUF_SIZE_CLASS_MEDIUM));
+		}
+		ensure_equals("(4)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_SMALL);
+		for (i = 0; i < MBUF_SIZE_CLASS_DOWNGRADE_READS; i++) {
+			f.read(100, f.dataSize(MBUF_SIZE_CLASS_SMALL));
+		}
+		ensure_equals("(5)", (int) f.tracker.size_class, (int) MBUF_SIZE_CLASS_SMALL);
+	}
+
+	TEST_METHOD(29) {
+		set_test_name("mbufs from different size classes return to their own pool");
+		SizeClassFixture f;
+		{
+			mbuf small(mbuf_get(f.set.pools[MBUF_SIZE_CLASS_SMALL]));
+			mbuf large(mbuf_get(f.set.pools[MBUF_SIZE_CLASS_LARGE]));
+			mbuf slice(large, 0, 10);
+			ensure_equals("(1)", small.size(), f.dataSize(MBUF_SIZE_CLASS_SMALL));
+			ensure_equals("(2)", large.size(), f.dataSize(MBUF_SIZE_CLASS_LARGE));
+			ensure_equals("(3)", f.pools[MBUF_SIZE_CLASS_LARGE].nactive_mbuf_blockq, 1u);
+		}
+		ensure_equals("(4)", f.pools[MBUF_SIZE_CLASS_SMALL].nfree_mbuf_blockq, 1u);
+		ensure_equals("(5)", f.pools[MBUF_SIZE_CLASS_MEDIUM].nfree_mbuf_blockq, 0u);
+		ensure_equals("(6)", f.pools[MBUF_SIZE_CLASS_LARGE].nfree_mbuf_blockq, 1u);
+		ensure_equals("(7)", f.pools[MBUF_SIZE_CLASS_LARGE].nactive_mbuf_blockq, 0u);
+	}
 }
@@ -0,0 +1,134 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how long ProcessMetricsCollector::collect() takes for a large
+ * number of processes, for each backend that is available on this platform.
+ * Optionally, this program allocates (and touches) a given amount of memory
+ * before measuring, to simulate the cost of forking a large agent process.
+ *
+ *   ../buildout/test/cxx/ProcessMetricsCollectorBenchmark [NUM_PROCESSES] [MEMORY_MB] [ITERATIONS]
+ */
+#include <oxt/initialize.hpp>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <Utils/SystemTime.h>
+#include <Utils/ProcessMetricsCollector.h>
+
+using namespace std;
+using namespace Passenger;
+
+namespace {
+
+vector<pid_t>
+spawnChildren(unsigned int count) {
+	vector<pid_t> pids;
+	for (unsigned int i = 0; i < count; i++) {
+		pid_t pid = fork();
+		if (pid == 0) {
+			pause();
+			_exit(0);
+		} else if (pid == -1) {
+			int e = errno;
+			fprintf(stderr, "*** ERROR: cannot fork: %s\n", strerror(e));
+			break;
+		} else {
+			pids.push_back(pid);
+		}
+	}
+	return pids;
+}
+
+void
+killChildren(const vector<pid_t> &pids) {
+	for (unsigned int i = 0; i < pids.size(); i++) {
+		kill(pids[i], SIGKILL);
+	}
+	for (unsigned int i = 0; i < pids.size(); i++) {
+		waitpid(pids[i], NULL, 0);
+	}
+}
+
+void
+measure(const char *name, ProcessMetricsCollector &collector,
+	const vector<pid_t> &pids, unsigned int iterations)
+{
+	unsigned long long startTime, endTime;
+	size_t collected = 0;
+
+	startTime = SystemTime::getMonotonicUsec();
+	for (unsigned int i = 0; i < iterations; i++) {
+		collected = collector.collect(pids).size();
+	}
+	endTime = SystemTime::getMonotonicUsec();
+
+	printf("%-8s  %10.2f ms/collection  (%u of %u processes)\n", name,
+		(endTime - startTime) / 1000.0 / iterations,
+		(unsigned int) collected, (unsigned int) pids.size());
+	fflush(stdout);
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int count = (argc > 1) ? atoi(argv[1]) : 500;
+	unsigned int memoryMb = (argc > 2) ? atoi(argv[2]) : 0;
+	unsigned int iterations = (argc > 3) ? atoi(argv[3]) : 10;
+	char *memory = NULL;
+
+	oxt::initialize();
+	SystemTime::initialize();
+
+	// Children are spawned first so that they don't inherit the extra memory.
+	vector<pid_t> pids = spawnChildren(count);
+	if (memoryMb > 0) {
+		memory = (char *) malloc(memoryMb * 1024 * 1024);
+		memset(memory, 1, memoryMb * 1024 * 1024);
+	}
+	ProcessMetricsCollector collector;
+
+	collector.setBackend(ProcessMetricsCollector::PS_BACKEND);
+	measure("ps", collector, pids, iterations);
+	#ifdef __linux__
+		collector.setBackend(ProcessMetricsCollector::PROCFS_BACKEND);
+		measure("/proc", collector, pids, iterations);
+	#endif
+
+	killChildren(pids);
+	free(memory);
+	oxt::shutdown();
+	return 0;
+}
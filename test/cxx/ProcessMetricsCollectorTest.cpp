@@ -120,4 +120,52 @@ namespace tut {
 			ensure(swap < 10000 || swap == -1);
 		#endif
 	}
+
+	#ifdef __linux__
+		TEST_METHOD(4) {
+			// The /proc backend collects the same metrics as the ps backend.
+			child = spawnChild(20);
+			usleep(500000);
+			vector<pid_t> pids;
+			pids.push_back(child);
+
+			collector.setBackend(ProcessMetricsCollector::PS_BACKEND);
+			ProcessMetricMap psResult = collector.collect(pids);
+			collector.setBackend(ProcessMetricsCollector::PROCFS_BACKEND);
+			ProcessMetricMap procResult = collector.collect(pids);
+
+			ensure_equals(psResult.size(), 1u);
+			ensure_equals(procResult.size(), 1u);
+			const ProcessMetrics &expected = psResult[child];
+			const ProcessMetrics &actual = procResult[child];
+			ensure_equals("pid", actual.pid, child);
+			ensure_equals("ppid", actual.ppid, getpid());
+			ensure_equals("processGroupId", actual.processGroupId, expected.processGroupId);
+			ensure_equals("uid", actual.uid, geteuid());
+			ensure_equals("command", actual.command, expected.command);
+			ensure("rss", actual.rss > 20000 && actual.rss < 30000);
+			ensure("vmsize", actual.vmsize >= actual.rss);
+			ensure("Private dirty", actual.privateDirty > 20000 && actual.privateDirty < 30000);
+		}
+
+		TEST_METHOD(5) {
+			// The /proc backend does not collect the metrics for PIDs that don't exist.
+			pid_t nonexistant;
+			child = spawnChild(1);
+			nonexistant = child;
+			kill(child, SIGKILL);
+			waitpid(child, NULL, 0);
+			child = -1;
+
+			vector<pid_t> pids;
+			pids.push_back(getpid());
+			pids.push_back(nonexistant);
+			collector.setBackend(ProcessMetricsCollector::PROCFS_BACKEND);
+			ProcessMetricMap result = collector.collect(pids);
+
+			ensure_equals(result.size(), 1u);
+			ensure(result.find(getpid()) != result.end());
+			ensure(result.find(nonexistant) == result.end());
+		}
+	#endif
 }
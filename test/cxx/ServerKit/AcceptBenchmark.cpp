@@ -0,0 +1,260 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how many short-lived TCP connections per second N ServerKit
+ * servers (one event loop thread each) can accept. Two accept modes are
+ * measured: a single server socket whose connections are distributed by
+ * the AcceptLoadBalancer, and one SO_REUSEPORT socket per server, in which
+ * case the kernel distributes the connections. This mirrors what the core
+ * does without and with `--reuse-port`.
+ *
+ * Every accepted connection is closed by the server immediately. The
+ * clients wait for that close before opening the next connection, so the
+ * numbers include the full accept path.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/ServerKit/AcceptBenchmark [MAX_SERVERS] [CLIENT_THREADS] [MSEC_PER_RUN]
+ */
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/initialize.hpp>
+#include <oxt/thread.hpp>
+#include <oxt/system_calls.hpp>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <Logging.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/Server.h>
+#include <ServerKit/AcceptLoadBalancer.h>
+#include <Utils/IOUtils.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+namespace {
+
+class AcceptServer: public Server<Client> {
+protected:
+	virtual void onClientAccepted(Client *client) {
+		accepted.fetch_add(1, boost::memory_order_relaxed);
+		disconnect(&client);
+	}
+
+public:
+	boost::atomic<unsigned long long> accepted;
+
+	AcceptServer(Context *context)
+		: Server<Client>(context),
+		  accepted(0)
+		{ }
+};
+
+struct Worker {
+	BackgroundEventLoop *bg;
+	Context *context;
+	AcceptServer *server;
+};
+
+boost::atomic<bool> stopped;
+
+
+int
+createListener(unsigned short &port, bool reusePort) {
+	struct sockaddr_in addr;
+	socklen_t len = sizeof(addr);
+	int fd = createTcpServer("127.0.0.1", port, 0, __FILE__, __LINE__, reusePort);
+	getsockname(fd, (struct sockaddr *) &addr, &len);
+	port = ntohs(addr.sin_port);
+	return fd;
+}
+
+void
+clientLoop(unsigned short port, unsigned long long *errors) {
+	struct sockaddr_in addr;
+	char buf[16];
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	while (!stopped.load(boost::memory_order_relaxed)) {
+		int fd = socket(PF_INET, SOCK_STREAM, 0);
+		if (fd == -1) {
+			(*errors)++;
+			continue;
+		}
+		if (connect(fd, (const struct sockaddr *) &addr, sizeof(addr)) == -1) {
+			(*errors)++;
+		} else {
+			// Wait until the server has accepted and closed the connection.
+			while (read(fd, buf, sizeof(buf)) > 0) { }
+		}
+		close(fd);
+	}
+}
+
+void
+shutdownServer(AcceptServer *server) {
+	server->shutdown(true);
+}
+
+void
+getServerState(AcceptServer *server, AcceptServer::State *state) {
+	*state = server->serverState;
+}
+
+void
+destroyServer(Worker *worker) {
+	delete worker->server;
+	worker->server = NULL;
+}
+
+double
+measure(unsigned int nservers, unsigned int nclients, unsigned int msec,
+	bool reusePort)
+{
+	vector<Worker> workers(nservers);
+	vector<int> fds;
+	vector<oxt::thread *> threads;
+	vector<unsigned long long> errors(nclients, 0);
+	AcceptLoadBalancer<AcceptServer> loadBalancer;
+	unsigned short port = 0;
+	unsigned long long total = 0, totalErrors = 0;
+	unsigned long long startTime, endTime;
+
+	if (reusePort) {
+		for (unsigned int i = 0; i < nservers; i++) {
+			fds.push_back(createListener(port, true));
+		}
+	} else {
+		fds.push_back(createListener(port, false));
+	}
+
+	for (unsigned int i = 0; i < nservers; i++) {
+		Worker &worker = workers[i];
+		worker.bg = new BackgroundEventLoop(false, true);
+		worker.context = new Context(worker.bg->safe, worker.bg->libuv_loop);
+		worker.server = new AcceptServer(worker.context);
+		if (reusePort) {
+			worker.server->listen(fds[i]);
+		} else {
+			loadBalancer.servers.push_back(worker.server);
+		}
+		worker.bg->start("Server " + toString(i + 1), 0);
+	}
+	if (!reusePort) {
+		loadBalancer.listen(fds[0]);
+		loadBalancer.start();
+	}
+
+	stopped.store(false);
+	startTime = SystemTime::getMonotonicUsec();
+	for (unsigned int i = 0; i < nclients; i++) {
+		threads.push_back(new oxt::thread(
+			boost::bind(clientLoop, port, &errors[i]),
+			"Client thread " + toString(i + 1),
+			1024 * 128));
+	}
+	usleep(msec * 1000);
+	for (unsigned int i = 0; i < nservers; i++) {
+		total += workers[i].server->accepted.load();
+	}
+	endTime = SystemTime::getMonotonicUsec();
+
+	stopped.store(true);
+	for (unsigned int i = 0; i < nclients; i++) {
+		threads[i]->join();
+		delete threads[i];
+		totalErrors += errors[i];
+	}
+	loadBalancer.shutdown();
+
+	for (unsigned int i = 0; i < nservers; i++) {
+		Worker &worker = workers[i];
+		AcceptServer::State state;
+
+		worker.bg->safe->runSync(boost::bind(shutdownServer, worker.server));
+		do {
+			usleep(1000);
+			worker.bg->safe->runSync(boost::bind(getServerState, worker.server, &state));
+		} while (state != AcceptServer::FINISHED_SHUTDOWN);
+		worker.bg->safe->runSync(boost::bind(destroyServer, &worker));
+		worker.bg->stop();
+		delete worker.context;
+		delete worker.bg;
+	}
+	for (unsigned int i = 0; i < fds.size(); i++) {
+		safelyClose(fds[i]);
+	}
+
+	if (totalErrors > 0) {
+		fprintf(stderr, "*** WARNING: %llu connections failed\n", totalErrors);
+	}
+	return total / ((endTime - startTime) / 1000000.0);
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int maxServers = (argc > 1) ? atoi(argv[1]) : 8;
+	unsigned int nclients = (argc > 2) ? atoi(argv[2]) : 32;
+	unsigned int msec = (argc > 3) ? atoi(argv[3]) : 2000;
+
+	signal(SIGPIPE, SIG_IGN);
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	printf("%-8s  %30s  %30s\n", "Servers",
+		"Load balancer (accepts/sec)", "SO_REUSEPORT (accepts/sec)");
+	for (unsigned int nservers = 1; nservers <= maxServers; nservers *= 2) {
+		double loadBalancerRate = measure(nservers, nclients, msec, false);
+		double reusePortRate = measure(nservers, nclients, msec, true);
+		printf("%-8u  %30.0f  %30.0f\n", nservers, loadBalancerRate, reusePortRate);
+		fflush(stdout);
+	}
+
+	oxt::shutdown();
+	return 0;
+}
@@ -0,0 +1,231 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Measures how fast HttpHeaderParser parses request headers, with each
+ * of the HTTP scanning implementations (see ServerKit/HttpScanning.h)
+ * that the CPU supports.
+ *
+ * Two requests are parsed: one with the headers from
+ * test/stub/http_request.yml, and a header-heavy one with large cookies and
+ * proxy headers, as seen behind load balancers.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/ServerKit/HeaderParsingBenchmark [ITERATIONS]
+ */
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <Logging.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/HttpRequest.h>
+#include <ServerKit/HttpHeaderParser.h>
+#include <ServerKit/HttpScanning.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+namespace {
+
+// Converts e.g. "HTTP_ACCEPT_ENCODING" to "Accept-Encoding".
+string
+cgiNameToHeaderName(const string &name) {
+	string result;
+	bool capitalize = true;
+
+	for (string::size_type i = strlen("HTTP_"); i < name.size(); i++) {
+		if (name[i] == '_') {
+			result.append(1, '-');
+			capitalize = true;
+		} else if (capitalize) {
+			result.append(1, name[i]);
+			capitalize = false;
+		} else {
+			result.append(1, name[i] | 0x20);
+		}
+	}
+	return result;
+}
+
+// Parses the HTTP_* keys in the given YAML file. Only supports the
+// simple "KEY: value" and "KEY: \"value\"" forms that the stub uses.
+string
+loadStubHeaders(const string &filename) {
+	ifstream f(filename.c_str());
+	string line, result;
+
+	if (!f) {
+		fprintf(stderr, "Cannot open %s\n", filename.c_str());
+		exit(1);
+	}
+	while (getline(f, line)) {
+		string::size_type pos = line.find(": ");
+		if (!startsWith(line, "HTTP_") || pos == string::npos) {
+			continue;
+		}
+
+		string value = line.substr(pos + 2);
+		if (value.size() >= 2 && value[0] == '"' && value[value.size() - 1] == '"') {
+			value = replaceAll(value.substr(1, value.size() - 2), "\\\"", "\"");
+		}
+		result.append(cgiNameToHeaderName(line.substr(0, pos)));
+		result.append(": ");
+		result.append(value);
+		result.append("\r\n");
+	}
+	return result;
+}
+
+string
+createStubRequest() {
+	return "GET /projects/app1-foobar/index.html?page=1 HTTP/1.1\r\n"
+		+ loadStubHeaders("stub/http_request.yml")
+		+ "\r\n";
+}
+
+string
+createHeaderHeavyRequest() {
+	string cookie;
+
+	for (unsigned int i = 0; i < 20; i++) {
+		if (i > 0) {
+			cookie.append("; ");
+		}
+		cookie.append("_tracking_cookie_" + toString(i) + "=" + string(80, 'A' + i % 26));
+	}
+
+	return "GET /api/v1/users/12345/notifications?since=1488000000&limit=50 HTTP/1.1\r\n"
+		"Host: www.example.com\r\n"
+		"User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_12_3) AppleWebKit/537.36"
+			" (KHTML, like Gecko) Chrome/56.0.2924.87 Safari/537.36\r\n"
+		"Accept: application/json, text/javascript, */*; q=0.01\r\n"
+		"Accept-Encoding: gzip, deflate, sdch, br\r\n"
+		"Accept-Language: en-US,en;q=0.8,nl;q=0.6\r\n"
+		"Referer: https://www.example.com/dashboard/notifications/unread\r\n"
+		"X-Requested-With: XMLHttpRequest\r\n"
+		"X-CSRF-Token: " + string(88, 'x') + "\r\n"
+		"X-Forwarded-For: 203.0.113.195, 70.41.3.18, 150.172.238.178\r\n"
+		"X-Forwarded-Proto: https\r\n"
+		"X-Forwarded-Port: 443\r\n"
+		"X-Forwarded-Host: www.example.com\r\n"
+		"X-Real-IP: 203.0.113.195\r\n"
+		"X-Request-Start: t=1488000000123456\r\n"
+		"X-Amzn-Trace-Id: Root=1-58b5c2a0-2b8a7e0e1c7c7a3e4b5f6a7d\r\n"
+		"Cookie: " + cookie + "\r\n"
+		"Connection: keep-alive\r\n"
+		"\r\n";
+}
+
+void
+deinitializeRequest(BaseHttpRequest *req) {
+	HeaderTable::Iterator it(req->headers);
+	while (*it != NULL) {
+		psg_lstr_deinit(&it->header->key);
+		psg_lstr_deinit(&it->header->origKey);
+		psg_lstr_deinit(&it->header->val);
+		it.next();
+	}
+	psg_lstr_deinit(&req->path);
+}
+
+// Returns the number of nanoseconds per parsed request.
+double
+measure(ServerKit::Context *context, const string &data, unsigned int iterations) {
+	MemoryKit::mbuf buffer(MemoryKit::mbuf_get_with_size(&context->mbuf_pool, data.size()));
+	memcpy(buffer.start, data.data(), data.size());
+	unsigned long long startTime = SystemTime::getMonotonicUsec();
+
+	for (unsigned int i = 0; i < iterations; i++) {
+		psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		BaseHttpRequest req;
+		HttpHeaderParserState state;
+
+		req.pool = pool;
+		req.httpState = BaseHttpRequest::PARSING_HEADERS;
+		req.bodyType = BaseHttpRequest::RBT_NO_BODY;
+		req.parserState.headerParser = &state;
+		HttpHeaderParser<BaseHttpRequest> parser(context, &state, &req, pool);
+		parser.initialize();
+		parser.feed(buffer);
+		if (req.httpState != BaseHttpRequest::COMPLETE) {
+			fprintf(stderr, "Parse error: %s\n", req.getHttpStateString());
+			exit(1);
+		}
+		deinitializeRequest(&req);
+		psg_destroy_pool(pool);
+	}
+
+	return (SystemTime::getMonotonicUsec() - startTime) * 1000.0 / iterations;
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int iterations = (argc > 1) ? atoi(argv[1]) : 200000;
+	const char *implementations[] = { "generic", "ssse3", "avx2" };
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	BackgroundEventLoop bg(false, true);
+	ServerKit::Context context(bg.safe, bg.libuv_loop);
+	string stubRequest = createStubRequest();
+	string headerHeavyRequest = createHeaderHeavyRequest();
+
+	printf("Default implementation: %s\n", getHttpScanningImplementation());
+	printf("%-16s  %30s  %30s\n", "Implementation",
+		("Stub, " + toString(stubRequest.size()) + " bytes (ns/req)").c_str(),
+		("Header-heavy, " + toString(headerHeavyRequest.size()) + " bytes (ns/req)").c_str());
+	for (unsigned int i = 0; i < sizeof(implementations) / sizeof(const char *); i++) {
+		if (!setHttpScanningImplementation(implementations[i])) {
+			printf("%-16s  %30s  %30s\n", implementations[i], "unsupported", "unsupported");
+			continue;
+		}
+		// Warm up.
+		measure(&context, stubRequest, iterations / 10);
+		measure(&context, headerHeavyRequest, iterations / 10);
+		printf("%-16s  %30.0f  %30.0f\n", implementations[i],
+			measure(&context, stubRequest, iterations),
+			measure(&context, headerHeavyRequest, iterations));
+	}
+
+	return 0;
+}
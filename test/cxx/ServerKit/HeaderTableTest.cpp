@@ -191,4 +191,27 @@ namespace tut {
 
 		ensure_equals<void *>("(3)", table.lookup("Content-Length"), NULL);
 	}
+
+	TEST_METHOD(11) {
+		set_test_name("shrink() shrinks the array if the elements fit");
+		for (unsigned int i = 0; i < 100; i++) {
+			table.insert(pool, "X-Header-" + toString(i), "value");
+		}
+		ensure_equals("(1)", table.arraySize(), 256u);
+
+		table.clear();
+		for (unsigned int i = 0; i < 20; i++) {
+			table.insert(pool, "X-Header-" + toString(i), "value");
+		}
+		ensure_equals("(2)", table.shrink(16), (size_t) 0);
+		ensure_equals("(3)", table.arraySize(), 256u);
+		ensure_equals("(4)", table.shrink(32), (256 - 32) * sizeof(HeaderTable::Cell));
+		ensure_equals("(5)", table.arraySize(), 32u);
+		ensure_equals("(6)", table.size(), 20u);
+		for (unsigned int i = 0; i < 20; i++) {
+			ensure("(7)", psg_lstr_cmp(table.lookup("x-header-" + toString(i)), "value"));
+		}
+		ensure_equals("(8)", table.shrink(64), (size_t) 0);
+		ensure_equals("(9)", table.arraySize(), 32u);
+	}
 }
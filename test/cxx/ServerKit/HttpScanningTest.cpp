@@ -0,0 +1,267 @@
+#include <TestSupport.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/HttpRequest.h>
+#include <ServerKit/HttpHeaderParser.h>
+#include <ServerKit/HttpScanning.h>
+#include <Utils/StrIntUtils.h>
+#include <Utils/Hasher.h>
+#include <vector>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace Passenger::MemoryKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_HttpScanningTest {
+		BackgroundEventLoop bg;
+		ServerKit::Context context;
+		string originalImplementation;
+		vector<string> implementations;
+
+		ServerKit_HttpScanningTest()
+			: bg(false, true),
+			  context(bg.safe, bg.libuv_loop)
+		{
+			const char *names[] = { "avx2", "ssse3", "generic" };
+			originalImplementation = getHttpScanningImplementation();
+			for (unsigned int i = 0; i < sizeof(names) / sizeof(const char *); i++) {
+				if (setHttpScanningImplementation(names[i])) {
+					implementations.push_back(names[i]);
+				}
+			}
+			setHttpScanningImplementation(originalImplementation);
+		}
+
+		~ServerKit_HttpScanningTest() {
+			setHttpScanningImplementation(originalImplementation);
+		}
+
+		static string toStr(const LString *str) {
+			const LString::Part *part = str->start;
+			string result;
+
+			while (part != NULL) {
+				result.append(part->data, part->size);
+				part = part->next;
+			}
+			return result;
+		}
+
+		static void deinitializeRequest(BaseHttpRequest *req) {
+			HeaderTable::Iterator it(req->headers);
+			while (*it != NULL) {
+				psg_lstr_deinit(&it->header->key);
+				psg_lstr_deinit(&it->header->origKey);
+				psg_lstr_deinit(&it->header->val);
+				it.next();
+			}
+			psg_lstr_deinit(&req->path);
+		}
+
+		// Parses `data`, fed in pieces of `pieceSize` bytes, and returns
+		// a textual description of the result.
+		string parse(const string &data, unsigned int pieceSize) {
+			psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+			BaseHttpRequest req;
+			HttpHeaderParserState state;
+			string result;
+			unsigned int pos = 0;
+
+			req.pool = pool;
+			req.httpState = BaseHttpRequest::PARSING_HEADERS;
+			req.bodyType = BaseHttpRequest::RBT_NO_BODY;
+			req.parserState.headerParser = &state;
+			HttpHeaderParser<BaseHttpRequest> parser(&context, &state, &req, pool);
+			parser.initialize();
+
+			while (pos < data.size() && req.httpState == BaseHttpRequest::PARSING_HEADERS) {
+				unsigned int len = std::min<unsigned int>(pieceSize, data.size() - pos);
+				mbuf buffer(mbuf_get_with_size(&context.mbuf_pool, len));
+				memcpy(buffer.start, data.data() + pos, len);
+				size_t ret = parser.feed(buffer);
+				result.append("fed " + toString(ret) + "\n");
+				pos += len;
+			}
+
+			result.append("state " + string(req.getHttpStateString()) + "\n");
+			if (req.httpState == BaseHttpRequest::ERROR) {
+				result.append("error " + toString(req.aux.parseError) + "\n");
+			} else {
+				result.append("path " + toStr(&req.path) + "\n");
+				HeaderTable::Iterator it(req.headers);
+				while (*it != NULL) {
+					result.append("header " + toString(it->header->hash)
+						+ " " + toStr(&it->header->key)
+						+ " " + toStr(&it->header->origKey)
+						+ ": " + toStr(&it->header->val));
+					result.append("\n");
+					it.next();
+				}
+			}
+
+			deinitializeRequest(&req);
+			psg_destroy_pool(pool);
+			return result;
+		}
+
+		void ensureSameParseResults(const string &data) {
+			const unsigned int pieceSizes[] = { 1, 7, 16, 33, 4096, 1024 * 1024 };
+
+			for (unsigned int i = 0; i < sizeof(pieceSizes) / sizeof(unsigned int); i++) {
+				setHttpScanningImplementation("generic");
+				string expected = parse(data, pieceSizes[i]);
+				for (unsigned int j = 0; j < implementations.size(); j++) {
+					setHttpScanningImplementation(implementations[j]);
+					ensure_equals((implementations[j] + ", piece size " + toString(pieceSizes[i])).c_str(),
+						parse(data, pieceSizes[i]), expected);
+				}
+			}
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_HttpScanningTest);
+
+	TEST_METHOD(1) {
+		set_test_name("All implementations find the same CR or LF, for all byte values,"
+			" positions and lengths");
+		char buf[100];
+
+		for (unsigned int ch = 0; ch < 256; ch++) {
+			for (unsigned int pos = 0; pos < sizeof(buf); pos++) {
+				memset(buf, 'x', sizeof(buf));
+				buf[pos] = (char) ch;
+				for (unsigned int len = 0; len <= sizeof(buf); len += 1 + len / 8) {
+					setHttpScanningImplementation("generic");
+					const char *expected = httpFindCrOrLf(buf, buf + len);
+					for (unsigned int i = 0; i < implementations.size(); i++) {
+						setHttpScanningImplementation(implementations[i]);
+						ensure_equals(implementations[i].c_str(),
+							httpFindCrOrLf(buf, buf + len) - buf,
+							expected - buf);
+					}
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("All implementations find the same non-token character, for all byte values,"
+			" positions and lengths");
+		char buf[100];
+
+		for (unsigned int ch = 0; ch < 256; ch++) {
+			for (unsigned int pos = 0; pos < sizeof(buf); pos++) {
+				memset(buf, 'x', sizeof(buf));
+				buf[pos] = (char) ch;
+				for (unsigned int len = 0; len <= sizeof(buf); len += 1 + len / 8) {
+					setHttpScanningImplementation("generic");
+					const char *expected = httpFindNonTokenChar(buf, buf + len);
+					for (unsigned int i = 0; i < implementations.size(); i++) {
+						setHttpScanningImplementation(implementations[i]);
+						ensure_equals((implementations[i] + ", char " + toString(ch)).c_str(),
+							httpFindNonTokenChar(buf, buf + len) - buf,
+							expected - buf);
+					}
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("The generic implementation accepts exactly the RFC 2616 token characters");
+		const string tokenChars = "!#$%&'*+-.^_`|~0123456789"
+			"abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+		setHttpScanningImplementation("generic");
+		for (unsigned int ch = 0; ch < 256; ch++) {
+			char c = (char) ch;
+			bool isToken = tokenChars.find(c) != string::npos;
+			ensure_equals(("char " + toString(ch)).c_str(),
+				httpFindNonTokenChar(&c, &c + 1) == &c + 1,
+				isToken);
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("All implementations produce the same parse results for ordinary requests");
+		ensureSameParseResults(
+			"GET /foo/bar?hello=world HTTP/1.1\r\n"
+			"Host: www.example.com\r\n"
+			"User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:50.0) Gecko/20100101 Firefox/50.0\r\n"
+			"Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+			"Accept-Language: en-US,en;q=0.5\r\n"
+			"Accept-Encoding: gzip, deflate, br\r\n"
+			"X-FORWARDED-FOR: 1.2.3.4, 5.6.7.8\r\n"
+			"x-Mixed-CASE-Header-Name-That-Is-Longer-Than-Thirty-Two-Bytes: v\r\n"
+			"Cookie: " + string(300, 'c') + "=" + string(200, 'v') + "\r\n"
+			"Empty:\r\n"
+			"Folded: foo\r\n"
+			"  bar\r\n"
+			"Connection: keep-alive\r\n"
+			"\r\n");
+		ensureSameParseResults(
+			"GET / HTTP/1.0\n"
+			"Host: bare-lf\n"
+			"\n");
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("All implementations produce the same parse results for headers with"
+			" non-ASCII bytes and invalid header names");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-Utf8: \xc3\xa9\xe2\x82\xac \xff\x80 tab\there\r\n"
+			"\r\n");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-Very-Long-Header-Name-Invalid(Char): foo\r\n"
+			"\r\n");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-Very-Long-Header-Name-With-High-Byte-\xc3\xa9: foo\r\n"
+			"\r\n");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-Very-Long-Header-Name-With-A-Space-Before-The-Colon : foo\r\n"
+			"\r\n");
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("All implementations detect header overflow at the same point");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-Big: " + string(HTTP_MAX_HEADER_SIZE, 'x') + "\r\n"
+			"\r\n");
+		ensureSameParseResults(
+			"GET / HTTP/1.1\r\n"
+			"X-" + string(HTTP_MAX_HEADER_SIZE, 'x') + ": foo\r\n"
+			"\r\n");
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("Hasher::updateWithLowerCase() produces the same results as"
+			" convertLowerCase() followed by update()");
+		string input;
+		for (unsigned int i = 0; i < 256; i++) {
+			input.push_back((char) i);
+		}
+		input.append("Content-Type X-Forwarded-For");
+
+		for (unsigned int len = 0; len <= input.size(); len++) {
+			char expectedOutput[300], output[300];
+			Hasher expectedHash, hash;
+
+			convertLowerCase((const unsigned char *) input.data(),
+				(unsigned char *) expectedOutput, len);
+			expectedHash.update(expectedOutput, len);
+			hash.updateWithLowerCase(input.data(), output, len);
+
+			ensure_equals(("output for length " + toString(len)).c_str(),
+				StaticString(output, len), StaticString(expectedOutput, len));
+			ensure_equals(("hash for length " + toString(len)).c_str(),
+				hash.finalize(), expectedHash.finalize());
+		}
+	}
+}
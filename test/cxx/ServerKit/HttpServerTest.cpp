@@ -433,6 +433,25 @@ namespace tut {
 			*result = server->clientDataErrors;
 		}
 
+		Json::Value inspectState() {
+			Json::Value result;
+			bg.safe->runSync(boost::bind(&ServerKit_HttpServerTest::_inspectState,
+				this, &result));
+			return result;
+		}
+
+		void _inspectState(Json::Value *result) {
+			*result = server->inspectStateAsJson();
+		}
+
+		void setTimeouts(unsigned int keepAlive, unsigned int header, unsigned int body) {
+			Json::Value doc;
+			doc["keep_alive_timeout"] = keepAlive;
+			doc["request_header_timeout"] = header;
+			doc["request_body_timeout"] = body;
+			server->configure(doc);
+		}
+
 		void startAcceptingBody() {
 			bg.safe->runLater(boost::bind(&ServerKit_HttpServerTest::_startAcceptingBody,
 				this));
@@ -480,7 +499,7 @@ namespace tut {
 		}
 	};
 
-	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 100);
+	DEFINE_TEST_GROUP_WITH_LIMIT(ServerKit_HttpServerTest, 110);
 
 
 	/***** Valid HTTP header parsing *****/
@@ -1727,4 +1746,73 @@ namespace tut {
 			result = getActiveClientCount() == 0;
 		);
 	}
+
+
+	/***** Client timeouts *****/
+
+	TEST_METHOD(100) {
+		set_test_name("Idle kept-alive clients are disconnected after the keep-alive timeout");
+
+		setTimeouts(1, 0, 0);
+		connectToServer();
+		sendRequest(
+			"GET / HTTP/1.1\r\n"
+			"Connection: keep-alive\r\n"
+			"Host: foo\r\n\r\n");
+		string header = readResponseHeader();
+		ensure("(1)", containsSubstring(header, "Connection: keep-alive"));
+		EVENTUALLY(5,
+			result = getActiveClientCount() == 0;
+		);
+		ensure_equals("(2)", inspectState()["timed_out_clients"]["keep_alive"].asUInt(), 1u);
+		ensure_equals("(3)", inspectState()["timed_out_clients"]["request_header"].asUInt(), 0u);
+	}
+
+	TEST_METHOD(101) {
+		set_test_name("Clients that don't send a complete header in time are disconnected");
+
+		setTimeouts(0, 1, 0);
+		connectToServer();
+		sendRequest(
+			"GET / HTTP/1.1\r\n"
+			"Host: foo\r\n");
+		string response = readAll(fd);
+		ensure_equals("(1)", response, "");
+		ensure_equals("(2)", inspectState()["timed_out_clients"]["request_header"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(102) {
+		set_test_name("Clients that stop sending the request body are disconnected"
+			" after the body timeout");
+
+		setTimeouts(0, 0, 1);
+		connectToServer();
+		sendRequest(
+			"GET /body_test HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 10\r\n\r\n"
+			"abc");
+		string response = readAll(fd);
+		ensure_equals("(1)", response, "");
+		ensure_equals("(2)", getBodyBytesRead(), 3u);
+		ensure_equals("(3)", inspectState()["timed_out_clients"]["request_body"].asUInt(), 1u);
+	}
+
+	TEST_METHOD(103) {
+		set_test_name("The body timeout doesn't apply while the server is not reading the body");
+
+		setTimeouts(0, 0, 1);
+		connectToServer();
+		sendRequest(
+			"GET /body_stop_test HTTP/1.1\r\n"
+			"Connection: close\r\n"
+			"Content-Length: 3\r\n\r\n");
+		EVENTUALLY(5,
+			result = getNumRequestsWaitingToStartAcceptingBody() == 1;
+		);
+		SHOULD_NEVER_HAPPEN(2500,
+			result = getActiveClientCount() == 0;
+		);
+		ensure_equals(inspectState()["timed_out_clients"]["request_body"].asUInt(), 0u);
+	}
 }
@@ -0,0 +1,246 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Compares reading sockets into blocks of the default mbuf size class only
+ * against picking a size class per channel from its recent read sizes
+ * (see MemoryKit/mbuf.h), by feeding FdSourceChannels:
+ *
+ *  - Memory per idle keep-alive connection: each channel reads a single
+ *    request header and then goes idle, keeping the remainder of its last
+ *    block around for the next read.
+ *  - Throughput on large bodies: a single channel reads a large body that
+ *    another thread writes into a socket pair.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/ServerKit/MbufSizeClassBenchmark [CONNECTIONS] [BODY_MB]
+ */
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <Logging.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/Context.h>
+#include <ServerKit/FdSourceChannel.h>
+#include <Utils/IOUtils.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+
+using namespace std;
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+
+namespace {
+
+const char REQUEST[] =
+	"GET /api/v1/users/12345/notifications?since=1488000000&limit=50 HTTP/1.1\r\n"
+	"Host: www.example.com\r\n"
+	"User-Agent: Mozilla/5.0 (Macintosh; Intel Mac OS X 10_12_3) AppleWebKit/537.36"
+		" (KHTML, like Gecko) Chrome/56.0.2924.87 Safari/537.36\r\n"
+	"Accept: application/json, text/javascript, */*; q=0.01\r\n"
+	"Accept-Encoding: gzip, deflate, sdch, br\r\n"
+	"Accept-Language: en-US,en;q=0.8,nl;q=0.6\r\n"
+	"Referer: https://www.example.com/dashboard/notifications/unread\r\n"
+	"X-Requested-With: XMLHttpRequest\r\n"
+	"Connection: keep-alive\r\n"
+	"\r\n";
+
+boost::mutex syncher;
+boost::condition_variable cond;
+unsigned long long bytesRead;
+unsigned int feeds;
+bool eof;
+
+// Makes every size class use the default pool, like before size classes existed.
+void
+setAdaptive(Context *context, bool adaptive) {
+	context->mbuf_pools.pools[MemoryKit::MBUF_SIZE_CLASS_SMALL] =
+		adaptive ? &context->small_mbuf_pool : &context->mbuf_pool;
+	context->mbuf_pools.pools[MemoryKit::MBUF_SIZE_CLASS_LARGE] =
+		adaptive ? &context->large_mbuf_pool : &context->mbuf_pool;
+}
+
+size_t
+activeMemory(Context *context) {
+	return context->small_mbuf_pool.nactive_mbuf_blockq * context->small_mbuf_pool.mbuf_block_chunk_size
+		+ context->mbuf_pool.nactive_mbuf_blockq * context->mbuf_pool.mbuf_block_chunk_size
+		+ context->large_mbuf_pool.nactive_mbuf_blockq * context->large_mbuf_pool.mbuf_block_chunk_size;
+}
+
+Channel::Result
+onData(Channel *channel, const MemoryKit::mbuf &buffer, int errcode) {
+	boost::lock_guard<boost::mutex> l(syncher);
+	if (buffer.empty()) {
+		eof = true;
+		cond.notify_one();
+	} else {
+		bytesRead += buffer.size();
+		feeds++;
+	}
+	return Channel::Result(buffer.size(), false);
+}
+
+// Sets `*result` to the number of bytes of mbuf blocks in use per idle connection.
+void
+measureIdleConnections(Context *context, unsigned int connections, double *result) {
+	FdSourceChannel *channels = new FdSourceChannel[connections];
+	size_t memory;
+	int fds[2];
+
+	if (pipe(fds) == -1) {
+		perror("pipe");
+		exit(1);
+	}
+	setNonBlocking(fds[0]);
+	for (unsigned int i = 0; i < connections; i++) {
+		writeExact(fds[1], REQUEST, sizeof(REQUEST) - 1);
+		channels[i].setContext(context);
+		channels[i].setDataCallback(onData);
+		channels[i].reinitialize(fds[0]);
+		channels[i].startReading();
+	}
+	memory = activeMemory(context);
+
+	for (unsigned int i = 0; i < connections; i++) {
+		channels[i].deinitialize();
+	}
+	delete[] channels;
+	close(fds[0]);
+	close(fds[1]);
+	*result = (double) memory / connections;
+}
+
+void
+writeBody(int fd, unsigned long long size) {
+	string chunk(64 * 1024, 'x');
+	while (size > 0) {
+		size_t n = (size < chunk.size()) ? size : chunk.size();
+		writeExact(fd, chunk.data(), n);
+		size -= n;
+	}
+	close(fd);
+}
+
+void
+startReadingBody(FdSourceChannel *channel, int fd) {
+	channel->reinitialize(fd);
+	channel->startReadingInNextTick();
+}
+
+// Returns the throughput in MB/s.
+double
+measureLargeBody(BackgroundEventLoop *bg, Context *context, unsigned int bodyMb,
+	unsigned int *feedsResult)
+{
+	FdSourceChannel channel(context);
+	unsigned long long size = (unsigned long long) bodyMb * 1024 * 1024;
+	unsigned long long startTime, endTime;
+	int fds[2];
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+		perror("socketpair");
+		exit(1);
+	}
+	setNonBlocking(fds[0]);
+	channel.burstReadCount = 16;
+	channel.setDataCallback(onData);
+	bytesRead = 0;
+	feeds = 0;
+	eof = false;
+
+	startTime = SystemTime::getMonotonicUsec();
+	bg->safe->runSync(boost::bind(startReadingBody, &channel, fds[0]));
+	boost::thread writer(boost::bind(writeBody, fds[1], size));
+	{
+		boost::unique_lock<boost::mutex> l(syncher);
+		while (!eof) {
+			cond.wait(l);
+		}
+	}
+	endTime = SystemTime::getMonotonicUsec();
+	writer.join();
+
+	bg->safe->runSync(boost::bind(&FdSourceChannel::deinitialize, &channel));
+	close(fds[0]);
+	if (bytesRead != size) {
+		fprintf(stderr, "Read %llu bytes instead of %llu\n", bytesRead, size);
+		exit(1);
+	}
+	*feedsResult = feeds;
+	return bytesRead / 1024.0 / 1024.0 / ((endTime - startTime) / 1000000.0);
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int connections = (argc > 1) ? atoi(argv[1]) : 10000;
+	unsigned int bodyMb = (argc > 2) ? atoi(argv[2]) : 1024;
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	BackgroundEventLoop bg(false, true);
+	ServerKit::Context context(bg.safe, bg.libuv_loop);
+	bg.start("Main event loop", 0);
+
+	printf("%-24s  %32s  %24s  %10s\n", "Size classes",
+		("Memory per " + toString(connections) + " idle conns").c_str(),
+		(toString(bodyMb) + " MB body (MB/s)").c_str(),
+		"Reads");
+	for (unsigned int i = 0; i < 2; i++) {
+		bool adaptive = i == 1;
+		double idleMemory;
+		double throughput;
+		unsigned int reads;
+
+		bg.safe->runSync(boost::bind(setAdaptive, &context, adaptive));
+		bg.safe->runSync(boost::bind(measureIdleConnections, &context,
+			connections, &idleMemory));
+		throughput = measureLargeBody(&bg, &context, bodyMb, &reads);
+
+		printf("%-24s  %29.1f MB  %24.1f  %10u\n",
+			adaptive ? "adaptive (1K/4K/64K)" : "fixed (4K)",
+			idleMemory * connections / 1024 / 1024,
+			throughput, reads);
+	}
+
+	bg.stop();
+	return 0;
+}
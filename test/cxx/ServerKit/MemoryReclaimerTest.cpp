@@ -0,0 +1,246 @@
+#include <TestSupport.h>
+#include <BackgroundEventLoop.h>
+#include <ServerKit/MemoryReclaimer.h>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_MemoryReclaimerTest {
+		struct FakeFreelist {
+			ReclaimableResource resource;
+			unsigned int active, peak, spare, floor, releaseCalls;
+
+			FakeFreelist()
+				: active(0),
+				  peak(0),
+				  spare(0),
+				  floor(0),
+				  releaseCalls(0)
+			{
+				resource.name = "fake";
+				resource.userData = this;
+				resource.getActiveCount = getActiveCount;
+				resource.takePeakActiveCount = takePeakActiveCount;
+				resource.getSpareCount = getSpareCount;
+				resource.release = release;
+			}
+
+			void use(unsigned int count) {
+				unsigned int fromFreelist = std::min(count, spare);
+				spare -= fromFreelist;
+				active += count;
+				peak = std::max(peak, active);
+			}
+
+			void unuse(unsigned int count) {
+				active -= count;
+				spare += count;
+			}
+
+			static unsigned int getActiveCount(ReclaimableResource *resource) {
+				return static_cast<FakeFreelist *>(resource->userData)->active;
+			}
+
+			static unsigned int takePeakActiveCount(ReclaimableResource *resource) {
+				FakeFreelist *self = static_cast<FakeFreelist *>(resource->userData);
+				unsigned int result = self->peak;
+				self->peak = self->active;
+				return result;
+			}
+
+			static unsigned int getSpareCount(ReclaimableResource *resource) {
+				FakeFreelist *self = static_cast<FakeFreelist *>(resource->userData);
+				return (self->spare > self->floor) ? self->spare - self->floor : 0;
+			}
+
+			static size_t release(ReclaimableResource *resource, unsigned int count) {
+				FakeFreelist *self = static_cast<FakeFreelist *>(resource->userData);
+				self->spare -= count;
+				self->releaseCalls++;
+				return count * 100;
+			}
+		};
+
+		BackgroundEventLoop bg;
+		MemoryReclaimer reclaimer;
+		FakeFreelist freelist;
+
+		ServerKit_MemoryReclaimerTest()
+			: bg(false, false),
+			  reclaimer(bg.libev_loop)
+		{
+			reclaimer.add(&freelist.resource);
+		}
+
+		~ServerKit_MemoryReclaimerTest() {
+			reclaimer.remove(&freelist.resource);
+		}
+
+		void releaseAll() {
+			while (reclaimer.releaseNextIncrement()) { }
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_MemoryReclaimerTest);
+
+	TEST_METHOD(1) {
+		set_test_name("Spare items beyond the high-water mark are released in increments");
+		reclaimer.setWindowSize(1);
+		reclaimer.setReleaseIncrement(10);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		ensure_equals("(1)", freelist.resource.highWaterMark, 100u);
+		ensure_equals("(2)", freelist.resource.surplus, 0u);
+		ensure("(3)", !reclaimer.isReleasing());
+
+		reclaimer.sample();
+		ensure_equals("(4)", freelist.resource.highWaterMark, 0u);
+		ensure_equals("(5)", freelist.resource.surplus, 100u);
+		ensure("(6)", reclaimer.isReleasing());
+
+		ensure("(7)", reclaimer.releaseNextIncrement());
+		ensure_equals("(8)", freelist.spare, 90u);
+		releaseAll();
+		ensure_equals("(9)", freelist.spare, 0u);
+		ensure_equals("(10)", freelist.releaseCalls, 10u);
+		ensure_equals("(11)", freelist.resource.totalReleased, (boost::uint64_t) 100);
+		ensure_equals("(12)", reclaimer.getTotalBytesReclaimed(), (boost::uint64_t) 10000);
+		ensure("(13)", !reclaimer.isReleasing());
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Enough spare items are kept to serve the peak in the window again");
+		reclaimer.setWindowSize(3);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		freelist.use(30);
+		reclaimer.sample();
+		reclaimer.sample();
+		ensure_equals("(1)", freelist.resource.highWaterMark, 100u);
+		ensure_equals("(2)", freelist.resource.surplus, 0u);
+
+		// The first sample has now left the window.
+		reclaimer.sample();
+		ensure_equals("(3)", freelist.resource.highWaterMark, 30u);
+		ensure_equals("(4)", freelist.resource.surplus, 70u);
+		releaseAll();
+		ensure_equals("(5)", freelist.spare, 0u);
+		ensure_equals("(6)", freelist.active, 30u);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("The owner's floor is never released");
+		reclaimer.setWindowSize(1);
+		freelist.floor = 20;
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		releaseAll();
+		ensure_equals(freelist.spare, 20u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Spare items that were put to use after the sample are not released");
+		reclaimer.setWindowSize(1);
+		reclaimer.setReleaseIncrement(10);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		ensure_equals("(1)", freelist.resource.surplus, 100u);
+		freelist.use(95);
+		releaseAll();
+		ensure_equals("(2)", freelist.spare, 0u);
+		ensure_equals("(3)", freelist.active, 95u);
+		ensure_equals("(4)", freelist.resource.totalReleased, (boost::uint64_t) 5);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Resources without usage tracking have all spare items released");
+		FakeFreelist untracked;
+		untracked.resource.getActiveCount = NULL;
+		untracked.resource.takePeakActiveCount = NULL;
+		untracked.spare = 50;
+		reclaimer.add(&untracked.resource);
+		reclaimer.sample();
+		releaseAll();
+		reclaimer.remove(&untracked.resource);
+		ensure_equals(untracked.spare, 0u);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Reclamation is driven by the event loop");
+		reclaimer.setWindowSize(1);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.setInterval(0.01);
+		bg.start();
+		EVENTUALLY(5,
+			result = freelist.spare == 0;
+		);
+		bg.stop();
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("inspectStateAsJson() reports reclaimed memory");
+		reclaimer.setWindowSize(1);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		releaseAll();
+
+		Json::Value doc = reclaimer.inspectStateAsJson();
+		ensure_equals("(1)", doc["total_reclaimed_memory"]["bytes"].asUInt64(),
+			(Json::UInt64) 10000);
+		ensure_equals("(2)", doc["resources"].size(), 1u);
+		ensure_equals("(3)", doc["resources"][0]["name"].asString(), "fake");
+		ensure_equals("(4)", doc["resources"][0]["total_released"].asUInt(), 100u);
+		#ifdef __linux__
+			ensure("(5)", doc["rss"]["bytes"].asUInt64() > 0);
+			ensure("(6)", doc["steady_state_rss"]["bytes"].asUInt64() > 0);
+		#endif
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("malloc_trim() is rate limited");
+		reclaimer.setWindowSize(1);
+		reclaimer.setMinTrimInterval(0.05);
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		releaseAll();
+		ensure_equals("(1)", reclaimer.getTotalTrims(), 1ul);
+		ensure("(2)", !reclaimer.isTrimPending());
+
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		releaseAll();
+		ensure_equals("(3)", reclaimer.getTotalTrims(), 1ul);
+		ensure("(4)", reclaimer.isTrimPending());
+
+		// A round that finishes while a trim is pending doesn't trim either.
+		freelist.use(100);
+		freelist.unuse(100);
+		reclaimer.sample();
+		reclaimer.sample();
+		releaseAll();
+		ensure_equals("(5)", reclaimer.getTotalTrims(), 1ul);
+
+		bg.start();
+		EVENTUALLY(5,
+			result = reclaimer.getTotalTrims() == 2;
+		);
+		bg.stop();
+		ensure("(6)", !reclaimer.isTrimPending());
+	}
+}
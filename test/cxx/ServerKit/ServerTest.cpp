@@ -423,4 +423,35 @@ namespace tut {
 			result = !clientIsConnected(client.get());
 		);
 	}
+
+	TEST_METHOD(29) {
+		set_test_name("Spare client objects beyond the recent peak and minSpareClients "
+			"are released by the memory reclaimer");
+
+		server->clientFreelistLimit = 10;
+		server->minSpareClients = 1;
+		context.memoryReclaimer.setWindowSize(1);
+		startServer();
+
+		FileDescriptor fd1(connectToServer1());
+		FileDescriptor fd2(connectToServer1());
+		FileDescriptor fd3(connectToServer1());
+		EVENTUALLY(5,
+			result = getActiveClientCount() == 3u;
+		);
+		fd1.close();
+		fd2.close();
+		fd3.close();
+		EVENTUALLY(5,
+			result = getActiveClientCount() == 0u;
+		);
+		ensure_equals("(1)", getFreeClientCount(), 3u);
+
+		// The first sample still sees the peak of 3 clients.
+		bg.safe->runSync(boost::bind(&MemoryReclaimer::sample, &context.memoryReclaimer));
+		bg.safe->runSync(boost::bind(&MemoryReclaimer::sample, &context.memoryReclaimer));
+		EVENTUALLY(5,
+			result = getFreeClientCount() == 1u;
+		);
+	}
 }
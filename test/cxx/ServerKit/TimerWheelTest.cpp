@@ -0,0 +1,147 @@
+#include <TestSupport.h>
+#include <boost/bind.hpp>
+#include <BackgroundEventLoop.h>
+#include <SafeLibev.h>
+#include <ServerKit/TimerWheel.h>
+#include <vector>
+
+using namespace Passenger;
+using namespace Passenger::ServerKit;
+using namespace std;
+
+namespace tut {
+	struct ServerKit_TimerWheelTest {
+		BackgroundEventLoop bg;
+		TimerWheel wheel;
+		Timer timers[3];
+		vector<int> fired;
+
+		ServerKit_TimerWheelTest()
+			: bg(false, false),
+			  wheel(bg.libev_loop)
+		{
+			for (unsigned int i = 0; i < 3; i++) {
+				timers[i].callback = onTimeout;
+				timers[i].userData = this;
+			}
+		}
+
+		static void onTimeout(Timer *timer) {
+			ServerKit_TimerWheelTest *self =
+				static_cast<ServerKit_TimerWheelTest *>(timer->userData);
+			self->fired.push_back(timer - self->timers);
+		}
+
+		static void onTimeoutCancelNext(Timer *timer) {
+			ServerKit_TimerWheelTest *self =
+				static_cast<ServerKit_TimerWheelTest *>(timer->userData);
+			self->fired.push_back(timer - self->timers);
+			self->wheel.cancel(&self->timers[1]);
+		}
+	};
+
+	DEFINE_TEST_GROUP(ServerKit_TimerWheelTest);
+
+	TEST_METHOD(1) {
+		set_test_name("A timer fires after its timeout, but not before");
+		wheel.arm(&timers[0], 5);
+		ensure("(1)", timers[0].isArmed());
+		ensure_equals("(2)", wheel.getArmedCount(), 1u);
+
+		wheel.advance(5);
+		ensure("(3)", fired.empty());
+		wheel.advance(1);
+		ensure_equals("(4)", fired.size(), 1u);
+		ensure("(5)", !timers[0].isArmed());
+		ensure_equals("(6)", wheel.getArmedCount(), 0u);
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("Timers fire in order of expiry");
+		wheel.arm(&timers[0], 30);
+		wheel.arm(&timers[1], 10);
+		wheel.arm(&timers[2], 20);
+
+		wheel.advance(100);
+		ensure_equals("(1)", fired.size(), 3u);
+		ensure_equals("(2)", fired[0], 1);
+		ensure_equals("(3)", fired[1], 2);
+		ensure_equals("(4)", fired[2], 0);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("Re-arming a timer postpones it");
+		wheel.arm(&timers[0], 5);
+		wheel.advance(4);
+		wheel.arm(&timers[0], 5);
+		wheel.advance(4);
+		ensure("(1)", fired.empty());
+		ensure_equals("(2)", wheel.getArmedCount(), 1u);
+		wheel.advance(2);
+		ensure_equals("(3)", fired.size(), 1u);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("A cancelled timer does not fire");
+		wheel.arm(&timers[0], 5);
+		wheel.arm(&timers[1], 5);
+		wheel.cancel(&timers[0]);
+		wheel.cancel(&timers[2]);
+		ensure("(1)", !timers[0].isArmed());
+		ensure_equals("(2)", wheel.getArmedCount(), 1u);
+
+		wheel.advance(10);
+		ensure_equals("(3)", fired.size(), 1u);
+		ensure_equals("(4)", fired[0], 1);
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("Timers in higher levels are cascaded down and fire on time");
+		const unsigned int timeouts[] = { 100, 5000, 300000 };
+		unsigned int now = 0;
+
+		for (unsigned int i = 0; i < 3; i++) {
+			wheel.arm(&timers[i], timeouts[i]);
+		}
+		for (unsigned int i = 0; i < 3; i++) {
+			wheel.advance(timeouts[i] - now);
+			ensure_equals("(1)", fired.size(), (size_t) i);
+			wheel.advance(1);
+			ensure_equals("(2)", fired.size(), (size_t) i + 1);
+			ensure_equals("(3)", fired[i], (int) i);
+			now = timeouts[i] + 1;
+		}
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Timeouts beyond the wheel's range are capped");
+		wheel.arm(&timers[0], TimerWheel::MAX_TICKS * 2);
+		wheel.advance(TimerWheel::MAX_TICKS - 2);
+		ensure("(1)", fired.empty());
+		wheel.advance(1);
+		ensure_equals("(2)", fired.size(), 1u);
+	}
+
+	TEST_METHOD(7) {
+		set_test_name("A callback may cancel another timer in the same slot");
+		timers[0].callback = onTimeoutCancelNext;
+		wheel.arm(&timers[0], 5);
+		wheel.arm(&timers[1], 5);
+		wheel.advance(6);
+		ensure_equals("(1)", fired.size(), 1u);
+		ensure_equals("(2)", fired[0], 0);
+		ensure_equals("(3)", wheel.getArmedCount(), 0u);
+	}
+
+	TEST_METHOD(8) {
+		set_test_name("The wheel is driven by the event loop");
+		wheel.setResolution(0.01);
+		bg.start();
+		bg.safe->runSync(boost::bind(&TimerWheel::arm, &wheel, &timers[0], 0.05));
+		EVENTUALLY(5,
+			result = wheel.getArmedCount() == 0;
+		);
+		bg.stop();
+		ensure_equals(fired.size(), 1u);
+	}
+}
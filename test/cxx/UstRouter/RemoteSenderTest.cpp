@@ -0,0 +1,276 @@
+#include "TestSupport.h"
+#include <UstRouter/RemoteSender.h>
+#include <boost/bind.hpp>
+#include <boost/atomic.hpp>
+#include <oxt/thread.hpp>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <cstdlib>
+
+using namespace Passenger;
+using namespace std;
+using namespace oxt;
+
+namespace tut {
+	/**
+	 * A minimal HTTP server that behaves like a Union Station gateway.
+	 * Every connection is handled in its own thread, so that we can
+	 * observe how many uploads are in flight at the same time.
+	 */
+	struct StubGateway {
+		FileDescriptor serverFd;
+		unsigned short port;
+		oxt::thread *acceptThread;
+		vector<oxt::thread *> connectionThreads;
+		boost::atomic<bool> quit;
+		boost::atomic<unsigned int> sinkDelayMsec;
+		boost::atomic<unsigned int> pingDelayMsec;
+
+		boost::mutex syncher;
+		vector<string> bodies;
+		unsigned int concurrentUploads;
+		unsigned int maxConcurrentUploads;
+
+		StubGateway()
+			: quit(false),
+			  sinkDelayMsec(0),
+			  pingDelayMsec(0),
+			  concurrentUploads(0),
+			  maxConcurrentUploads(0)
+		{
+			struct sockaddr_in addr;
+			socklen_t len = sizeof(addr);
+
+			serverFd.assign(createTcpServer("127.0.0.1", 0, 0, __FILE__, __LINE__),
+				NULL, 0);
+			getsockname(serverFd, (struct sockaddr *) &addr, &len);
+			port = ntohs(addr.sin_port);
+			acceptThread = new oxt::thread(boost::bind(&StubGateway::acceptMain, this),
+				"Stub gateway", 1024 * 128);
+		}
+
+		~StubGateway() {
+			quit.store(true);
+			acceptThread->join();
+			delete acceptThread;
+			boost::lock_guard<boost::mutex> l(syncher);
+			for (unsigned int i = 0; i < connectionThreads.size(); i++) {
+				connectionThreads[i]->join();
+				delete connectionThreads[i];
+			}
+		}
+
+		void acceptMain() {
+			while (!quit.load()) {
+				struct pollfd pfd;
+				pfd.fd = serverFd;
+				pfd.events = POLLIN;
+				if (poll(&pfd, 1, 10) <= 0) {
+					continue;
+				}
+
+				int fd = accept(serverFd, NULL, NULL);
+				if (fd != -1) {
+					boost::lock_guard<boost::mutex> l(syncher);
+					connectionThreads.push_back(new oxt::thread(
+						boost::bind(&StubGateway::connectionMain, this, fd),
+						"Stub gateway connection", 1024 * 128));
+				}
+			}
+		}
+
+		void connectionMain(int fd) {
+			FileDescriptor guard(fd, NULL, 0);
+			string request, response;
+			string::size_type headerEnd;
+			char buf[1024 * 16];
+			ssize_t ret;
+
+			while ((headerEnd = request.find("\r\n\r\n")) == string::npos) {
+				ret = ::read(fd, buf, sizeof(buf));
+				if (ret <= 0) {
+					return;
+				}
+				request.append(buf, ret);
+			}
+
+			string::size_type pos = request.find("Content-Length: ");
+			size_t contentLength = 0;
+			if (pos != string::npos && pos < headerEnd) {
+				contentLength = atoi(request.c_str() + pos + sizeof("Content-Length: ") - 1);
+			}
+			while (request.size() < headerEnd + 4 + contentLength) {
+				ret = ::read(fd, buf, sizeof(buf));
+				if (ret <= 0) {
+					return;
+				}
+				request.append(buf, ret);
+			}
+
+			if (startsWith(request, "GET /ping ")) {
+				usleep(pingDelayMsec.load() * 1000);
+				response = "pong";
+			} else {
+				{
+					boost::lock_guard<boost::mutex> l(syncher);
+					concurrentUploads++;
+					maxConcurrentUploads = std::max(maxConcurrentUploads, concurrentUploads);
+				}
+				usleep(sinkDelayMsec.load() * 1000);
+				{
+					boost::lock_guard<boost::mutex> l(syncher);
+					concurrentUploads--;
+					bodies.push_back(request.substr(headerEnd + 4));
+				}
+				response = "{\"status\":\"ok\"}";
+			}
+
+			response = "HTTP/1.1 200 OK\r\n"
+				"Connection: close\r\n"
+				"Content-Length: " + toString(response.size()) + "\r\n"
+				"\r\n" + response;
+			writeExact(fd, response);
+		}
+
+		unsigned int getMaxConcurrentUploads() {
+			boost::lock_guard<boost::mutex> l(syncher);
+			return maxConcurrentUploads;
+		}
+
+		vector<string> getBodies() {
+			boost::lock_guard<boost::mutex> l(syncher);
+			return bodies;
+		}
+	};
+
+	struct UstRouter_RemoteSenderTest {
+		StubGateway gateway;
+		RemoteSender::Config config;
+		boost::shared_ptr<RemoteSender> sender;
+
+		UstRouter_RemoteSenderTest() {
+			config.gatewayAddress = "127.0.0.1";
+			config.gatewayPort = gateway.port;
+			config.useHttps = false;
+			setLogLevel(LVL_CRIT);
+		}
+
+		~UstRouter_RemoteSenderTest() {
+			sender.reset();
+			SystemTime::releaseAll();
+			setLogLevel(DEFAULT_LOG_LEVEL);
+		}
+
+		void init() {
+			sender = boost::make_shared<RemoteSender>(config);
+		}
+
+		void schedule(const string &key, const string &data) {
+			StaticString str(data);
+			sender->schedule(key, "localhost", "requests", &str, 1);
+		}
+
+		unsigned int getStat(const char *name) {
+			return sender->inspectStateAsJson()[name].asUInt();
+		}
+
+		static string incompressibleData(unsigned int size) {
+			string result;
+			result.reserve(size);
+			for (unsigned int i = 0; i < size; i++) {
+				result.append(1, (char) (rand() % 256));
+			}
+			return result;
+		}
+	};
+
+	DEFINE_TEST_GROUP(UstRouter_RemoteSenderTest);
+
+	TEST_METHOD(1) {
+		set_test_name("It compresses and uploads scheduled packets");
+		init();
+		schedule("key1", "hello world");
+		EVENTUALLY(5,
+			result = getStat("packets_accepted") == 1;
+		);
+
+		vector<string> bodies = gateway.getBodies();
+		ensure_equals(bodies.size(), 1u);
+		ensure(bodies[0].find("key1") != string::npos);
+		ensure(bodies[0].find("name=\"compressed\"") != string::npos);
+
+		Json::Value doc = sender->inspectStateAsJson();
+		ensure_equals(doc["queue_size"].asUInt(), 0u);
+		ensure_equals(doc["queue"]["memory_usage"]["bytes"].asUInt(), 0u);
+		ensure(!doc["latency"].isNull());
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("It keeps multiple uploads in flight, up to maxConcurrentUploads");
+		config.maxConcurrentUploads = 3;
+		gateway.sinkDelayMsec.store(200);
+		init();
+
+		for (unsigned int i = 0; i < 9; i++) {
+			schedule("key" + toString(i), "hello world");
+		}
+		EVENTUALLY(10,
+			result = getStat("packets_accepted") == 9;
+		);
+		ensure("More than one upload in flight", gateway.getMaxConcurrentUploads() > 1);
+		ensure("At most maxConcurrentUploads in flight", gateway.getMaxConcurrentUploads() <= 3);
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("It drops the oldest packets when the memory limit is exceeded");
+		config.maxConcurrentUploads = 1;
+		config.memoryLimit = 1024 * 4;
+		gateway.sinkDelayMsec.store(100);
+		init();
+
+		for (unsigned int i = 0; i < 20; i++) {
+			schedule("key" + toString(i), incompressibleData(1024));
+		}
+		ensure(getStat("packets_dropped_by_memory_limit") > 0);
+		ensure(sender->inspectStateAsJson()["queue"]["memory_usage"]["bytes"].asUInt()
+			<= config.memoryLimit);
+		EVENTUALLY(10,
+			result = getStat("packets_accepted") + getStat("packets_dropped_by_memory_limit") == 20;
+		);
+
+		// The newest packet is never the one that is dropped.
+		vector<string> bodies = gateway.getBodies();
+		bool found = false;
+		for (unsigned int i = 0; i < bodies.size(); i++) {
+			found = found || bodies[i].find("key19") != string::npos;
+		}
+		ensure(found);
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("Uploads continue while the servers are being rechecked");
+		init();
+		schedule("key1", "hello world");
+		EVENTUALLY(5,
+			result = getStat("packets_accepted") == 1;
+		);
+
+		// Make the next checkup due, and make its ping slow.
+		Json::Value lastCheckupTime = sender->inspectStateAsJson()["last_server_checkup_time"];
+		gateway.pingDelayMsec.store(3000);
+		SystemTime::force(time(NULL) + 4 * 60 * 60);
+		unsigned long long startTime = SystemTime::getMonotonicUsec();
+		schedule("key2", "hello world");
+		EVENTUALLY(5,
+			result = getStat("packets_accepted") == 2;
+		);
+		ensure("The upload did not wait for the ping",
+			SystemTime::getMonotonicUsec() - startTime < 2000000);
+		EVENTUALLY(5,
+			Json::Value doc = sender->inspectStateAsJson();
+			result = doc["last_server_checkup_time"] != lastCheckupTime
+				&& doc["up_servers"].size() == 1;
+		);
+	}
+}
@@ -0,0 +1,265 @@
+/*
+ *  Phusion Passenger - https://www.phusionpassenger.com/
+ *  Copyright (c) 2017 Phusion Holding B.V.
+ *
+ *  "Passenger", "Phusion Passenger" and "Union Station" are registered
+ *  trademarks of Phusion Holding B.V.
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the "Software"), to deal
+ *  in the Software without restriction, including without limitation the rights
+ *  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *  copies of the Software, and to permit persons to whom the Software is
+ *  furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ *  all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ *  THE SOFTWARE.
+ */
+
+/*
+ * Compares the string hash in Utils/Hasher.h with the Jenkins one-at-a-time
+ * hash that it replaced, on keys that resemble what the core hashes:
+ * HTTP header names, secure header names, app group names and turbocache
+ * keys. For every key set it reports the time per hash, the number of
+ * 32-bit hash collisions, and the average number of probes that a linear
+ * probing table of twice the number of keys (like StringKeyTable and
+ * ResponseCache use) needs per successful lookup.
+ *
+ * Must be run from the 'test' directory:
+ *
+ *   ../buildout/test/cxx/Utils/HasherBenchmark [ITERATIONS]
+ */
+#include <oxt/initialize.hpp>
+#include <oxt/system_calls.hpp>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+
+#include <Logging.h>
+#include <Utils/Hasher.h>
+#include <Utils/SystemTime.h>
+#include <Utils/StrIntUtils.h>
+
+using namespace std;
+using namespace Passenger;
+
+namespace {
+
+struct JenkinsHash {
+	boost::uint32_t hash;
+
+	JenkinsHash()
+		: hash(0)
+		{ }
+
+	void update(const char *data, unsigned int size) {
+		const char *end = data + size;
+
+		while (data < end) {
+			hash += *data;
+			hash += (hash << 10);
+			hash ^= (hash >> 6);
+			data++;
+		}
+	}
+
+	boost::uint32_t finalize() {
+		hash += (hash << 3);
+		hash ^= (hash >> 11);
+		hash += (hash << 15);
+		return hash;
+	}
+};
+
+struct KeySet {
+	string name;
+	vector<string> keys;
+};
+
+// Prevents the compiler from optimizing the hash computations away.
+volatile boost::uint32_t sink;
+
+template<typename HashFunction>
+boost::uint32_t
+hashKey(const string &key) {
+	HashFunction h;
+	h.update(key.data(), key.size());
+	return h.finalize();
+}
+
+KeySet
+createHeaderNames() {
+	static const char *names[] = {
+		"host", "user-agent", "accept", "accept-encoding", "accept-language",
+		"accept-charset", "cache-control", "connection", "cookie", "content-type",
+		"content-length", "date", "expect", "if-modified-since", "if-none-match",
+		"pragma", "referer", "transfer-encoding", "upgrade", "authorization",
+		"origin", "x-requested-with", "x-forwarded-for", "x-forwarded-proto",
+		"x-forwarded-host", "x-forwarded-port", "x-real-ip", "x-request-id",
+		"x-request-start", "x-csrf-token", "x-amzn-trace-id", "dnt", "te",
+		"via", "forwarded", "keep-alive", "range", "if-range", "set-cookie",
+		"status", "x-sendfile", "x-accel-redirect", "location", "vary",
+		"expires", "last-modified", "content-location", "www-authenticate"
+	};
+	KeySet set;
+	set.name = "Header names";
+	set.keys.assign(names, names + sizeof(names) / sizeof(const char *));
+	return set;
+}
+
+KeySet
+createSecureHeaderNames() {
+	static const char *names[] = {
+		"!~", "!~PASSENGER_APP_GROUP_NAME", "!~PASSENGER_APP_ROOT",
+		"!~PASSENGER_APP_TYPE", "!~PASSENGER_ENV_VARS", "!~PASSENGER_MAX_REQUESTS",
+		"!~PASSENGER_SHOW_VERSION_IN_HEADER", "!~PASSENGER_STICKY_SESSIONS",
+		"!~PASSENGER_STICKY_SESSIONS_COOKIE_NAME", "!~UNION_STATION_SUPPORT",
+		"!~UNION_STATION_KEY", "!~UNION_STATION_FILTERS", "!~REMOTE_ADDR",
+		"!~REMOTE_PORT", "!~REMOTE_USER", "!~FLAGS", "!~SCRIPT_NAME",
+		"!~DOCUMENT_ROOT", "!~SERVER_NAME", "!~SERVER_PORT", "!~PASSENGER_RUBY",
+		"!~PASSENGER_NODEJS", "!~PASSENGER_PYTHON", "!~PASSENGER_MIN_PROCESSES"
+	};
+	KeySet set;
+	set.name = "Secure header names";
+	set.keys.assign(names, names + sizeof(names) / sizeof(const char *));
+	return set;
+}
+
+KeySet
+createAppGroupNames() {
+	static const char *environments[] = { "production", "staging", "development" };
+	KeySet set;
+	set.name = "App group names";
+	for (unsigned int i = 0; i < 3000; i++) {
+		set.keys.push_back("/var/www/apps/customer-" + toString(i / 3)
+			+ "/current (" + environments[i % 3] + ")");
+	}
+	return set;
+}
+
+KeySet
+createTurbocacheKeys() {
+	KeySet set;
+	set.name = "Turbocache keys";
+	for (unsigned int i = 0; i < 20000; i++) {
+		string key = "GET";
+		key.append(1, '\0');
+		key.append("www.example.com");
+		key.append("/api/v1/products/" + toString(i % 2000)
+			+ "?page=" + toString(i / 2000));
+		set.keys.push_back(key);
+	}
+	return set;
+}
+
+template<typename HashFunction>
+double
+measureNsPerHash(const KeySet &set, unsigned int iterations) {
+	unsigned long long startTime = SystemTime::getMonotonicUsec();
+	boost::uint32_t result = 0;
+
+	for (unsigned int i = 0; i < iterations; i++) {
+		for (unsigned int j = 0; j < set.keys.size(); j++) {
+			result ^= hashKey<HashFunction>(set.keys[j]);
+		}
+	}
+	sink = result;
+
+	return (SystemTime::getMonotonicUsec() - startTime) * 1000.0
+		/ ((double) iterations * set.keys.size());
+}
+
+template<typename HashFunction>
+unsigned int
+countCollisions(const KeySet &set) {
+	std::set<boost::uint32_t> seen;
+	unsigned int collisions = 0;
+
+	for (unsigned int i = 0; i < set.keys.size(); i++) {
+		if (!seen.insert(hashKey<HashFunction>(set.keys[i])).second) {
+			collisions++;
+		}
+	}
+	return collisions;
+}
+
+template<typename HashFunction>
+double
+averageProbeLength(const KeySet &set) {
+	unsigned int size = 1;
+	while (size < set.keys.size() * 2) {
+		size *= 2;
+	}
+
+	vector<bool> used(size, false);
+	unsigned long long totalProbes = 0;
+
+	for (unsigned int i = 0; i < set.keys.size(); i++) {
+		unsigned int pos = hashKey<HashFunction>(set.keys[i]) & (size - 1);
+		unsigned int probes = 1;
+		while (used[pos]) {
+			pos = (pos + 1) & (size - 1);
+			probes++;
+		}
+		used[pos] = true;
+		totalProbes += probes;
+	}
+	return (double) totalProbes / set.keys.size();
+}
+
+template<typename HashFunction>
+void
+report(const char *hashName, const KeySet &set, unsigned int iterations) {
+	printf("  %-10s  %10.1f  %10u  %12.2f\n", hashName,
+		measureNsPerHash<HashFunction>(set, iterations),
+		countCollisions<HashFunction>(set),
+		averageProbeLength<HashFunction>(set));
+}
+
+} // anonymous namespace
+
+
+int
+main(int argc, char *argv[]) {
+	unsigned int iterations = (argc > 1) ? atoi(argv[1]) : 2000000;
+	vector<KeySet> sets;
+
+	oxt::initialize();
+	oxt::setup_syscall_interruption_support();
+	SystemTime::initialize();
+	setLogLevel(LVL_WARN);
+
+	sets.push_back(createHeaderNames());
+	sets.push_back(createSecureHeaderNames());
+	sets.push_back(createAppGroupNames());
+	sets.push_back(createTurbocacheKeys());
+
+	for (unsigned int i = 0; i < sets.size(); i++) {
+		const KeySet &set = sets[i];
+		unsigned int totalSize = 0;
+		unsigned int setIterations = std::max<unsigned int>(1,
+			iterations / set.keys.size());
+
+		for (unsigned int j = 0; j < set.keys.size(); j++) {
+			totalSize += set.keys[j].size();
+		}
+		printf("%s: %u keys, %.1f bytes on average\n", set.name.c_str(),
+			(unsigned int) set.keys.size(), (double) totalSize / set.keys.size());
+		printf("  %-10s  %10s  %10s  %12s\n", "Hash", "ns/hash", "Collisions",
+			"Probes/key");
+		report<JenkinsHash>("Jenkins", set, setIterations);
+		report<Hasher>("Murmur", set, setIterations);
+	}
+
+	return 0;
+}
@@ -0,0 +1,132 @@
+#include <TestSupport.h>
+#include <Utils/Hasher.h>
+#include <Utils/StrIntUtils.h>
+#include <DataStructures/HashedStaticString.h>
+#include <DataStructures/LString.h>
+#include <MemoryKit/palloc.h>
+#include <vector>
+
+using namespace Passenger;
+using namespace std;
+
+namespace tut {
+	struct Utils_HasherTest {
+		string input;
+
+		Utils_HasherTest() {
+			for (unsigned int i = 0; i < 256; i++) {
+				input.push_back((char) i);
+			}
+			input.append("Content-Type X-Forwarded-For Accept-Encoding");
+		}
+
+		static boost::uint32_t hash(const StaticString &data) {
+			Hasher h;
+			h.update(data.data(), data.size());
+			return h.finalize();
+		}
+	};
+
+	DEFINE_TEST_GROUP(Utils_HasherTest);
+
+	TEST_METHOD(1) {
+		set_test_name("The hash of the empty string is EMPTY_STRING_HASH");
+		ensure_equals("(1)", hash(""), Hasher::EMPTY_STRING_HASH);
+		ensure_equals("(2)", HashedStaticString().hash(), HashedStaticString("").hash());
+	}
+
+	TEST_METHOD(2) {
+		set_test_name("The hash doesn't depend on how the data is split over update() calls");
+		for (unsigned int len = 0; len <= 40; len++) {
+			StaticString data(input.data() + 60, len);
+			boost::uint32_t expected = hash(data);
+
+			for (unsigned int i = 0; i <= len; i++) {
+				for (unsigned int j = i; j <= len; j++) {
+					Hasher h;
+					h.update(data.data(), i);
+					h.update(data.data() + i, j - i);
+					h.update(data.data() + j, len - j);
+					ensure_equals(("length " + toString(len) + ", split at "
+						+ toString(i) + " and " + toString(j)).c_str(),
+						h.finalize(), expected);
+				}
+			}
+		}
+	}
+
+	TEST_METHOD(3) {
+		set_test_name("updateWithLowerCase() produces the same results as"
+			" convertLowerCase() followed by update(), for all byte values");
+		for (unsigned int len = 0; len <= input.size(); len++) {
+			char expectedOutput[400], output[400];
+			Hasher expectedHash, hash;
+
+			convertLowerCase((const unsigned char *) input.data(),
+				(unsigned char *) expectedOutput, len);
+			expectedHash.update(expectedOutput, len);
+			hash.updateWithLowerCase(input.data(), output, len);
+
+			ensure_equals(("output for length " + toString(len)).c_str(),
+				StaticString(output, len), StaticString(expectedOutput, len));
+			ensure_equals(("hash for length " + toString(len)).c_str(),
+				hash.finalize(), expectedHash.finalize());
+		}
+	}
+
+	TEST_METHOD(4) {
+		set_test_name("updateWithLowerCase() can be mixed with update() and split arbitrarily");
+		StaticString data("X-Forwarded-For-Some-Long-Header");
+		string lower = data;
+		convertLowerCase((const unsigned char *) data.data(),
+			(unsigned char *) &lower[0], data.size());
+		boost::uint32_t expected = hash(lower);
+
+		for (unsigned int i = 0; i <= data.size(); i++) {
+			char output[64];
+			Hasher h;
+			h.update(lower.data(), i);
+			h.updateWithLowerCase(data.data() + i, output, data.size() - i);
+			ensure_equals(("split at " + toString(i)).c_str(), h.finalize(), expected);
+			ensure_equals(("output when split at " + toString(i)).c_str(),
+				StaticString(output, data.size() - i),
+				StaticString(lower.data() + i, data.size() - i));
+		}
+	}
+
+	TEST_METHOD(5) {
+		set_test_name("psg_lstr_hash() on a multi-part LString equals the hash of the"
+			" contiguous string");
+		psg_pool_t *pool = psg_create_pool(PSG_DEFAULT_POOL_SIZE);
+		LString str;
+
+		psg_lstr_init(&str);
+		psg_lstr_append(&str, pool, "accept-");
+		psg_lstr_append(&str, pool, "enc");
+		psg_lstr_append(&str, pool, "oding");
+		ensure_equals(psg_lstr_hash(&str), HashedStaticString("accept-encoding").hash());
+		psg_lstr_deinit(&str);
+		psg_destroy_pool(pool);
+	}
+
+	TEST_METHOD(6) {
+		set_test_name("Similar keys are spread evenly over the buckets of a small table");
+		const unsigned int NBUCKETS = 256;
+		const unsigned int NKEYS = NBUCKETS * 8;
+		vector<unsigned int> buckets(NBUCKETS, 0);
+		unsigned int maxLoad = 0;
+
+		// Keys that only differ in a few bits, and in their lengths,
+		// stress the final mixing step.
+		for (unsigned int i = 0; i < NKEYS; i++) {
+			string key = "x-custom-header-" + toString(i % 64)
+				+ string(i / 64, 'a');
+			unsigned int &load = buckets[hash(key) & (NBUCKETS - 1)];
+			load++;
+			maxLoad = std::max(maxLoad, load);
+		}
+
+		// With an ideal hash, the maximum load is about 18.
+		ensure("Maximum bucket load is " + toString(maxLoad), maxLoad <= 24);
+	}
+}